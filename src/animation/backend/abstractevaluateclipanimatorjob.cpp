@@ -56,7 +56,8 @@ public:
 
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
-    AnimationRecord m_record;
+    // One record per animator evaluated by the job this frame
+    QVector<AnimationRecord> m_records;
     QVector<AnimationCallbackAndValue> m_callbacks;
 };
 
@@ -65,50 +66,58 @@ AbstractEvaluateClipAnimatorJob::AbstractEvaluateClipAnimatorJob()
 {
 }
 
-void AbstractEvaluateClipAnimatorJob::setPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks)
+void AbstractEvaluateClipAnimatorJob::clearFrameData()
 {
-    auto mainThreadCB = callbacks;
-    mainThreadCB.erase(std::remove_if(mainThreadCB.begin(), mainThreadCB.end(), [](const AnimationCallbackAndValue &callback) {
-                        if (callback.flags.testFlag(QAnimationCallback::OnThreadPool)) {
-                            // call these now and remove them from the list
-                            callback.callback->valueChanged(callback.value);
-                            return true;
-                        }
-                        return false;
-                    }), mainThreadCB.end());
-    // Should now only have callbacks to be called on main thread
+    Q_D(AbstractEvaluateClipAnimatorJob);
+    d->m_records.clear();
+    d->m_callbacks.clear();
+}
 
+void AbstractEvaluateClipAnimatorJob::addPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks)
+{
     Q_D(AbstractEvaluateClipAnimatorJob);
-    d->m_record = record;
-    d->m_callbacks = mainThreadCB;
+    for (const AnimationCallbackAndValue &callback : callbacks) {
+        if (callback.flags.testFlag(QAnimationCallback::OnThreadPool))
+            callback.callback->valueChanged(callback.value);
+        else
+            d->m_callbacks.push_back(callback); // Called on the main thread
+    }
+
+    if (!record.animatorId.isNull())
+        d->m_records.push_back(record);
 }
 
-void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
+QVector<AnimationRecord> AbstractEvaluateClipAnimatorJob::records() const
 {
-    if (m_record.animatorId.isNull())
-        return;
+    Q_D(const AbstractEvaluateClipAnimatorJob);
+    return d->m_records;
+}
 
-    for (auto targetData : qAsConst(m_record.targetChanges)) {
-        Qt3DCore::QNode *node = manager->lookupNode(targetData.targetId);
-        if (node)
-            node->setProperty(targetData.propertyName, targetData.value);
-    }
+void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
+{
+    for (const AnimationRecord &record : qAsConst(m_records)) {
+        for (const AnimationRecord::TargetChange &targetData : qAsConst(record.targetChanges)) {
+            Qt3DCore::QNode *node = manager->lookupNode(targetData.targetId);
+            if (node)
+                applyTargetChange(node, record, targetData);
+        }
 
-    for (auto skeletonData : qAsConst(m_record.skeletonChanges)) {
-        Qt3DCore::QAbstractSkeleton *node = qobject_cast<Qt3DCore::QAbstractSkeleton *>(manager->lookupNode(skeletonData.first));
-        if (node) {
-            auto d = Qt3DCore::QAbstractSkeletonPrivate::get(node);
-            d->m_localPoses = skeletonData.second;
-            d->update();
+        for (auto skeletonData : qAsConst(record.skeletonChanges)) {
+            Qt3DCore::QAbstractSkeleton *node = qobject_cast<Qt3DCore::QAbstractSkeleton *>(manager->lookupNode(skeletonData.first));
+            if (node) {
+                auto d = Qt3DCore::QAbstractSkeletonPrivate::get(node);
+                d->m_localPoses = skeletonData.second;
+                d->update();
+            }
         }
-    }
 
-    QAbstractClipAnimator *animator = qobject_cast<QAbstractClipAnimator *>(manager->lookupNode(m_record.animatorId));
-    if (animator) {
-        if (isValidNormalizedTime(m_record.normalizedTime))
-            animator->setNormalizedTime(m_record.normalizedTime);
-        if (m_record.finalFrame)
-            animator->setRunning(false);
+        QAbstractClipAnimator *animator = qobject_cast<QAbstractClipAnimator *>(manager->lookupNode(record.animatorId));
+        if (animator) {
+            if (isValidNormalizedTime(record.normalizedTime))
+                animator->setNormalizedTime(record.normalizedTime);
+            if (record.finalFrame)
+                animator->setRunning(false);
+        }
     }
 
     for (const AnimationCallbackAndValue &callback: qAsConst(m_callbacks)) {
@@ -116,7 +125,8 @@ void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager
             callback.callback->valueChanged(callback.value);
     }
 
-    m_record = {};
+    m_records.clear();
+    m_callbacks.clear();
 }
 
 } // Animation
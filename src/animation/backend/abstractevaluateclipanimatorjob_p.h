@@ -61,12 +61,14 @@ namespace Animation {
 
 class AbstractEvaluateClipAnimatorJobPrivate;
 
-class AbstractEvaluateClipAnimatorJob : public Qt3DCore::QAspectJob
+class Q_AUTOTEST_EXPORT AbstractEvaluateClipAnimatorJob : public Qt3DCore::QAspectJob
 {
 protected:
     AbstractEvaluateClipAnimatorJob();
 
-    void setPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks);
+    void clearFrameData();
+    void addPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks);
+    QVector<AnimationRecord> records() const;
 
 private:
     Q_DECLARE_PRIVATE(AbstractEvaluateClipAnimatorJob)
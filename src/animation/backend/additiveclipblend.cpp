@@ -40,6 +40,7 @@
 #include "additiveclipblend_p.h"
 #include <Qt3DAnimation/qadditiveclipblend.h>
 #include <Qt3DAnimation/private/qadditiveclipblend_p.h>
+#include <Qt3DAnimation/private/animationsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -72,16 +73,22 @@ void AdditiveClipBlend::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool f
 }
 
 ClipResults AdditiveClipBlend::doBlend(const QList<ClipResults> &blendData) const
+{
+    ClipResults blendResults;
+    doBlendInto(blendData, blendResults);
+    return blendResults;
+}
+
+void AdditiveClipBlend::doBlendInto(const QList<ClipResults> &blendData, ClipResults &results) const
 {
     Q_ASSERT(blendData.size() == 2);
     Q_ASSERT(blendData[0].size() == blendData[1].size());
     const int elementCount = blendData.first().size();
-    ClipResults blendResults(elementCount);
-
-    for (int i = 0; i < elementCount; ++i)
-        blendResults[i] = blendData[0][i] + m_additiveFactor * blendData[1][i];
+    results.resize(elementCount);
 
-    return blendResults;
+    weightedSum(blendData[0].constData(), 1.0f,
+                blendData[1].constData(), m_additiveFactor,
+                results.data(), elementCount);
 }
 
 } // Animation
@@ -95,6 +95,7 @@ public:
 
 protected:
     ClipResults doBlend(const QList<ClipResults> &blendData) const final;
+    void doBlendInto(const QList<ClipResults> &blendData, ClipResults &results) const final;
 
 private:
     Qt3DCore::QNodeId m_baseClipId;
@@ -54,11 +54,17 @@
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qurlquery.h>
 
+#include <cmath>
+
 QT_BEGIN_NAMESPACE
 
 #define ANIMATION_INDEX_KEY     QLatin1String("animationIndex")
 #define ANIMATION_NAME_KEY      QLatin1String("animationName")
 
+namespace {
+const auto slerpThreshold = 0.01f;
+}
+
 namespace Qt3DAnimation {
 namespace Animation {
 
@@ -157,6 +163,7 @@ void AnimationClip::loadAnimation()
     setDuration(t);
 
     m_channelComponentCount = findChannelComponentCount();
+    packChannels();
 
     // If using a loader inform the frontend of the status change
     if (m_source.isEmpty()) {
@@ -352,6 +359,8 @@ void AnimationClip::clearData()
 {
     m_name.clear();
     m_channels.clear();
+    m_packedChannelGroups.clear();
+    m_unpackedChannels.clear();
 }
 
 float AnimationClip::findDuration()
@@ -376,6 +385,166 @@ int AnimationClip::findChannelComponentCount()
     return channelCount;
 }
 
+namespace {
+
+bool isRotationChannel(const Channel &channel)
+{
+    return channel.name.contains(QStringLiteral("Rotation"))
+            && channel.channelComponents.size() == 4;
+}
+
+// Returns false if the components of the channel do not share the same
+// strictly increasing keyframe times and interpolations, or use Bezier
+// interpolation
+bool findSharedKeyframes(const Channel &channel, QVector<float> *times,
+                         QVector<bool> *constantKeyframes)
+{
+    if (channel.channelComponents.isEmpty())
+        return false;
+
+    const FCurve &firstCurve = channel.channelComponents.first().fcurve;
+    const int keyframeCount = firstCurve.keyframeCount();
+    if (keyframeCount == 0)
+        return false;
+
+    times->resize(keyframeCount);
+    constantKeyframes->resize(keyframeCount);
+    for (int i = 0; i < keyframeCount; ++i) {
+        const float t = firstCurve.localTime(i);
+        if (i > 0 && !(t > (*times)[i - 1]))
+            return false;
+        const QKeyFrame::InterpolationType interpolation = firstCurve.keyframe(i).interpolation;
+        if (interpolation == QKeyFrame::BezierInterpolation)
+            return false;
+        (*times)[i] = t;
+        (*constantKeyframes)[i] = interpolation == QKeyFrame::ConstantInterpolation;
+    }
+
+    for (const ChannelComponent &channelComponent : channel.channelComponents) {
+        const FCurve &fcurve = channelComponent.fcurve;
+        if (fcurve.keyframeCount() != keyframeCount)
+            return false;
+        for (int i = 0; i < keyframeCount; ++i) {
+            if (fcurve.localTime(i) != (*times)[i]
+                || fcurve.keyframe(i).interpolation != firstCurve.keyframe(i).interpolation)
+                return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous
+
+PackedChannelGroup::SlerpSegment PackedChannelGroup::SlerpSegment::fromQuaternions(const QQuaternion &q0,
+                                                                                  const QQuaternion &q1)
+{
+    SlerpSegment segment = { Equal, 1.0f, 0.0f, 0.0f };
+    float cosHalfTheta = QQuaternion::dotProduct(q0, q1);
+    if (std::abs(cosHalfTheta) >= 1.0f)
+        return segment;
+
+    segment.sinHalfTheta = std::sqrt(1.0f - std::pow(cosHalfTheta, 2.0f));
+    if (std::abs(segment.sinHalfTheta) < ::slerpThreshold) {
+        segment.mode = Lerp;
+        return segment;
+    }
+
+    segment.mode = Slerp;
+    segment.reverse = cosHalfTheta < 0 ? -1.0f : 1.0f;
+    cosHalfTheta *= segment.reverse;
+    segment.halfTheta = std::acos(cosHalfTheta);
+    return segment;
+}
+
+/*!
+    \internal
+
+    Groups the channels whose components share their keyframe times and
+    interpolations into PackedChannelGroups, so that evaluating the clip
+    interpolates all of their components together instead of looking up
+    every FCurve on its own. Rotation channels are only grouped together.
+    Channels that cannot be packed are evaluated per component.
+ */
+void AnimationClip::packChannels()
+{
+    m_packedChannelGroups.clear();
+    m_unpackedChannels.clear();
+
+    // Find which channels go in which group first so that the values of
+    // each group are only laid out once
+    QVector<QVector<int>> groupChannels;
+    QVector<int> channelResultOffsets(m_channels.size());
+    QVector<float> times;
+    QVector<bool> constantKeyframes;
+    int resultOffset = 0;
+    for (int channelIndex = 0; channelIndex < m_channels.size(); ++channelIndex) {
+        const Channel &channel = m_channels[channelIndex];
+        channelResultOffsets[channelIndex] = resultOffset;
+        resultOffset += channel.channelComponents.size();
+
+        if (!findSharedKeyframes(channel, &times, &constantKeyframes)) {
+            m_unpackedChannels.push_back({ channelIndex, channelResultOffsets[channelIndex] });
+            continue;
+        }
+
+        const bool rotations = isRotationChannel(channel);
+        int groupIndex = 0;
+        for (; groupIndex < m_packedChannelGroups.size(); ++groupIndex) {
+            const PackedChannelGroup &group = m_packedChannelGroups[groupIndex];
+            if (group.rotations == rotations && group.times == times
+                && group.constantKeyframes == constantKeyframes)
+                break;
+        }
+
+        if (groupIndex == m_packedChannelGroups.size()) {
+            PackedChannelGroup group;
+            group.rotations = rotations;
+            group.times = times;
+            group.constantKeyframes = constantKeyframes;
+            m_packedChannelGroups.push_back(group);
+            groupChannels.push_back(QVector<int>());
+        }
+
+        PackedChannelGroup &group = m_packedChannelGroups[groupIndex];
+        const int componentCount = channel.channelComponents.size();
+        group.targets.push_back({ channelResultOffsets[channelIndex], group.componentCount, componentCount });
+        group.componentCount += componentCount;
+        groupChannels[groupIndex].push_back(channelIndex);
+    }
+
+    for (int groupIndex = 0; groupIndex < m_packedChannelGroups.size(); ++groupIndex) {
+        PackedChannelGroup &group = m_packedChannelGroups[groupIndex];
+        const int keyframeCount = group.times.size();
+        group.values.resize(keyframeCount * group.componentCount);
+
+        const QVector<int> &channelIndices = groupChannels[groupIndex];
+        for (int i = 0; i < channelIndices.size(); ++i) {
+            const Channel &channel = m_channels[channelIndices[i]];
+            const int componentOffset = group.targets[i].componentOffset;
+            for (int c = 0; c < channel.channelComponents.size(); ++c) {
+                const FCurve &fcurve = channel.channelComponents[c].fcurve;
+                for (int k = 0; k < keyframeCount; ++k)
+                    group.values[k * group.componentCount + componentOffset + c] = fcurve.keyframe(k).value;
+            }
+        }
+
+        if (!group.rotations)
+            continue;
+
+        const int quaternionCount = group.componentCount / 4;
+        group.slerpSegments.reserve((keyframeCount - 1) * quaternionCount);
+        for (int k = 0; k < keyframeCount - 1; ++k) {
+            const float *q0 = group.values.constData() + k * group.componentCount;
+            const float *q1 = q0 + group.componentCount;
+            for (int q = 0; q < quaternionCount; ++q, q0 += 4, q1 += 4) {
+                const QQuaternion lowerQuat = QQuaternion(q0[0], q0[1], q0[2], q0[3]).normalized();
+                const QQuaternion higherQuat = QQuaternion(q1[0], q1[1], q1[2], q1[3]).normalized();
+                group.slerpSegments.push_back(PackedChannelGroup::SlerpSegment::fromQuaternions(lowerQuat, higherQuat));
+            }
+        }
+    }
+}
+
 } // namespace Animation
 } // namespace Qt3DAnimation
 
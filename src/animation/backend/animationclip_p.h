@@ -57,6 +57,7 @@
 #include <Qt3DAnimation/private/fcurve_p.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qmutex.h>
+#include <QtGui/qquaternion.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -65,6 +66,50 @@ namespace Animation {
 
 class Handler;
 
+// Channels whose components all share the same keyframe times and
+// interpolations, packed so that they can be interpolated in one pass.
+// values holds componentCount floats per keyframe.
+struct PackedChannelGroup
+{
+    struct Target {
+        int resultOffset;       // First clip result of the channel
+        int componentOffset;    // First component of the channel in a keyframe
+        int componentCount;
+    };
+
+    // How a quaternion is interpolated between two keyframes, decided when
+    // the clip is loaded so that evaluation does not need acos
+    struct SlerpSegment {
+        enum Mode : quint8 {
+            Equal,  // Both keyframes are the same rotation
+            Lerp,   // Too close to slerp, lerp and normalize instead
+            Slerp
+        };
+        Mode mode;
+        float reverse;
+        float halfTheta;
+        float sinHalfTheta;
+
+        static SlerpSegment fromQuaternions(const QQuaternion &q0, const QQuaternion &q1);
+    };
+
+    bool rotations = false;     // Every 4 components form a quaternion
+    int componentCount = 0;
+    QVector<float> times;
+    QVector<float> values;
+    QVector<bool> constantKeyframes;
+    QVector<Target> targets;
+    // (keyframe count - 1) segments per quaternion, keyframe after keyframe
+    QVector<SlerpSegment> slerpSegments;
+};
+
+// A channel evaluated per component, with the index of its first clip result
+struct UnpackedChannel
+{
+    int channelIndex;
+    int resultOffset;
+};
+
 class Q_AUTOTEST_EXPORT AnimationClip : public BackendNode
 {
 public:
@@ -90,6 +135,8 @@ public:
     int channelIndex(const QString &channelName, int jointIndex) const;
     int channelCount() const { return m_channelComponentCount; }
     int channelComponentBaseIndex(int channelGroupIndex) const;
+    const QVector<PackedChannelGroup> &packedChannelGroups() const { return m_packedChannelGroups; }
+    const QVector<UnpackedChannel> &unpackedChannels() const { return m_unpackedChannels; }
 
     // Allow unit tests to set the data type
 #if !defined(QT_BUILD_INTERNAL)
@@ -111,6 +158,7 @@ private:
     void clearData();
     float findDuration();
     int findChannelComponentCount();
+    void packChannels();
 
     QMutex m_mutex;
 
@@ -123,6 +171,8 @@ private:
     QVector<Channel> m_channels;
     float m_duration;
     int m_channelComponentCount;
+    QVector<PackedChannelGroup> m_packedChannelGroups;
+    QVector<UnpackedChannel> m_unpackedChannels;
 
     Qt3DCore::QNodeIdVector m_dependingAnimators;
     Qt3DCore::QNodeIdVector m_dependingBlendedAnimators;
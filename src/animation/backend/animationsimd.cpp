@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "animationsimd_p.h"
+#include <Qt3DCore/private/qt3dcore-config_p.h>
+#include <QtGui/qquaternion.h>
+#include <private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DAnimation {
+namespace Animation {
+
+void weightedSum(const float *a, float wa, const float *b, float wb, float *out, int count)
+{
+    int i = 0;
+#if QT_CONFIG(qt3d_simd_sse2) && (defined(__AVX2__) || defined(__SSE2__)) && defined(QT_COMPILER_SUPPORTS_SSE2)
+    const __m128 weightA = _mm_set1_ps(wa);
+    const __m128 weightB = _mm_set1_ps(wb);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 va = _mm_mul_ps(_mm_loadu_ps(a + i), weightA);
+        const __m128 vb = _mm_mul_ps(_mm_loadu_ps(b + i), weightB);
+        _mm_storeu_ps(out + i, _mm_add_ps(va, vb));
+    }
+#endif
+    for (; i < count; ++i)
+        out[i] = wa * a[i] + wb * b[i];
+}
+
+void normalizeQuaternions(float *quaternions, int quaternionCount)
+{
+    // Goes through QQuaternion so that the results match the per channel
+    // evaluation bit for bit
+    for (int i = 0; i < quaternionCount; ++i) {
+        float *q = quaternions + 4 * i;
+        QQuaternion quaternion(q[0], q[1], q[2], q[3]);
+        quaternion.normalize();
+        q[0] = quaternion.scalar();
+        q[1] = quaternion.x();
+        q[2] = quaternion.y();
+        q[3] = quaternion.z();
+    }
+}
+
+} // namespace Animation
+} // namespace Qt3DAnimation
+
+QT_END_NAMESPACE
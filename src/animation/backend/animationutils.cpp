@@ -43,6 +43,7 @@
 #include <Qt3DAnimation/private/clipblendnode_p.h>
 #include <Qt3DAnimation/private/clipblendnodevisitor_p.h>
 #include <Qt3DAnimation/private/clipblendvalue_p.h>
+#include <Qt3DAnimation/private/animationsimd_p.h>
 #include <QtGui/qvector2d.h>
 #include <QtGui/qvector3d.h>
 #include <QtGui/qvector4d.h>
@@ -52,14 +53,12 @@
 #include <QtCore/qvarlengtharray.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
 
+#include <algorithm>
+#include <cmath>
 #include <numeric>
 
 QT_BEGIN_NAMESPACE
 
-namespace {
-const auto slerpThreshold = 0.01f;
-}
-
 namespace Qt3DAnimation {
 namespace Animation {
 
@@ -228,99 +227,183 @@ ComponentIndices channelComponentsToIndicesHelper(const Channel &channel,
     return indices;
 }
 
-ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
-{
-    QVector<float> channelResults;
-    Q_ASSERT(clip);
+namespace {
 
-    // Ensure we have enough storage to hold the evaluations
-    channelResults.resize(clip->channelCount());
+// Same segment as FCurve::lowerKeyframeBound() for a localTime within the
+// keyframes, but without the cached state so that clips can be evaluated
+// concurrently
+int findKeyframeSegment(const QVector<float> &times, float localTime)
+{
+    const auto it = std::upper_bound(times.cbegin(), times.cend(), localTime);
+    return qBound(0, int(it - times.cbegin()) - 1, int(times.size()) - 2);
+}
 
-    // Iterate over channels and evaluate the fcurves
-    const auto &channels = clip->channels();
-    int i = 0;
-    for (const Channel &channel : channels) {
-        if (channel.name.contains(QStringLiteral("Rotation")) &&
-                        channel.channelComponents.size() == 4) {
-
-            // Try to SLERP
-            const int nbKeyframes = channel.channelComponents[0].fcurve.keyframeCount();
-            const bool canSlerp = std::find_if(std::begin(channel.channelComponents)+1,
-                                               std::end(channel.channelComponents),
-                                               [nbKeyframes](const ChannelComponent &v) {
-                return v.fcurve.keyframeCount() != nbKeyframes;
-            }) == std::end(channel.channelComponents);
-
-            if (!canSlerp) {
-                // Interpolate per component
-                for (const auto &channelComponent : qAsConst(channel.channelComponents)) {
-                    const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime);
-                    channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
-                }
+void evaluatePackedChannelGroup(const PackedChannelGroup &group, float localTime,
+                                float *channelResults)
+{
+    const QVector<float> &times = group.times;
+    const int stride = group.componentCount;
+    const float *values = group.values.constData();
+    const float *results = values;
+
+    QVarLengthArray<float, 64> interpolated;
+    if (localTime > times.last()) {
+        results = values + (times.size() - 1) * stride;
+    } else if (times.size() > 1 && localTime >= times.first()) {
+        const int k = findKeyframeSegment(times, localTime);
+        const float *v0 = values + k * stride;
+        const float *v1 = v0 + stride;
+        results = v0;
+
+        if (!group.constantKeyframes[k]) {
+            const float t = (localTime - times[k]) / (times[k + 1] - times[k]);
+            interpolated.resize(stride);
+            results = interpolated.constData();
+
+            if (!group.rotations) {
+                weightedSum(v0, 1.0f - t, v1, t, interpolated.data(), stride);
             } else {
-                // There's only one keyframe. We cant compute omega. Interpolate per component
-                if (channel.channelComponents[0].fcurve.keyframeCount() == 1) {
-                    for (const auto &channelComponent : qAsConst(channel.channelComponents))
-                        channelResults[i++] = channelComponent.fcurve.keyframe(0).value;
-                } else {
-                    auto quaternionFromChannel = [channel](const int keyframe) {
-                        const float w = channel.channelComponents[0].fcurve.keyframe(keyframe).value;
-                        const float x = channel.channelComponents[1].fcurve.keyframe(keyframe).value;
-                        const float y = channel.channelComponents[2].fcurve.keyframe(keyframe).value;
-                        const float z = channel.channelComponents[3].fcurve.keyframe(keyframe).value;
-                        QQuaternion quat{w,x,y,z};
-                        quat.normalize();
-                        return quat;
-                    };
-
-                    const int lowerKeyframeBound = std::max(0, channel.channelComponents[0].fcurve.lowerKeyframeBound(localTime));
-                    const auto lowerQuat = quaternionFromChannel(lowerKeyframeBound);
-                    const auto higherQuat = quaternionFromChannel(lowerKeyframeBound + 1);
-                    auto cosHalfTheta = QQuaternion::dotProduct(lowerQuat, higherQuat);
-                    // If the two keyframe quaternions are equal, just return the first one as the interpolated value.
-                    if (std::abs(cosHalfTheta) >= 1.0f) {
-                        channelResults[i++] = lowerQuat.scalar();
-                        channelResults[i++] = lowerQuat.x();
-                        channelResults[i++] = lowerQuat.y();
-                        channelResults[i++] = lowerQuat.z();
-                    } else {
-                        const auto sinHalfTheta = std::sqrt(1.0f - std::pow(cosHalfTheta,2.0f));
-                        if (std::abs(sinHalfTheta) < ::slerpThreshold) {
-                            auto initial_i = i;
-                            for (const auto &channelComponent : qAsConst(channel.channelComponents))
-                                channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
-
-                            // Normalize the resulting quaternion
-                            QQuaternion quat{channelResults[initial_i], channelResults[initial_i+1], channelResults[initial_i+2], channelResults[initial_i+3]};
-                            quat.normalize();
-                            channelResults[initial_i+0] = quat.scalar();
-                            channelResults[initial_i+1] = quat.x();
-                            channelResults[initial_i+2] = quat.y();
-                            channelResults[initial_i+3] = quat.z();
-                        } else {
-                            const auto reverseQ1 = cosHalfTheta < 0 ? -1.0f : 1.0f;
-                            cosHalfTheta *= reverseQ1;
-                            const auto halfTheta = std::acos(cosHalfTheta);
-                            for (const auto &channelComponent : qAsConst(channel.channelComponents))
-                                channelResults[i++] = channelComponent.fcurve.evaluateAtTimeAsSlerp(localTime,
-                                                                                                    lowerKeyframeBound,
-                                                                                                    halfTheta,
-                                                                                                    sinHalfTheta,
-                                                                                                    reverseQ1);
-                        }
+                const int quaternionCount = stride / 4;
+                const PackedChannelGroup::SlerpSegment *segments = group.slerpSegments.constData()
+                        + k * quaternionCount;
+                for (int q = 0; q < quaternionCount; ++q) {
+                    const PackedChannelGroup::SlerpSegment &segment = segments[q];
+                    float *out = interpolated.data() + 4 * q;
+                    switch (segment.mode) {
+                    case PackedChannelGroup::SlerpSegment::Equal:
+                        // Both keyframes are the same rotation, use the first one
+                        std::copy(v0 + 4 * q, v0 + 4 * q + 4, out);
+                        normalizeQuaternions(out, 1);
+                        break;
+                    case PackedChannelGroup::SlerpSegment::Lerp:
+                        weightedSum(v0 + 4 * q, 1.0f - t, v1 + 4 * q, t, out, 4);
+                        normalizeQuaternions(out, 1);
+                        break;
+                    case PackedChannelGroup::SlerpSegment::Slerp: {
+                        const float a = std::sin((1.0f - t) * segment.halfTheta) / segment.sinHalfTheta;
+                        const float b = std::sin(t * segment.halfTheta) / segment.sinHalfTheta;
+                        weightedSum(v0 + 4 * q, a, v1 + 4 * q, segment.reverse * b, out, 4);
+                        break;
+                    }
                     }
                 }
             }
-        } else {
-            // If the channel is not a Rotation, apply linear interpolation per channel component
-            // TODO How do we handle other interpolations. For exammple, color interpolation
-            // in a linear perceptual way or other non linear spaces?
+        }
+    }
+
+    // Keyframe values are used as is outside of the keyframes and for constant
+    // interpolation, rotations still have to come out normalized
+    if (group.rotations && results != interpolated.constData()) {
+        interpolated.resize(stride);
+        std::copy(results, results + stride, interpolated.data());
+        normalizeQuaternions(interpolated.data(), stride / 4);
+        results = interpolated.constData();
+    }
+
+    for (const PackedChannelGroup::Target &target : group.targets) {
+        std::copy(results + target.componentOffset,
+                  results + target.componentOffset + target.componentCount,
+                  channelResults + target.resultOffset);
+    }
+}
+
+void evaluateChannel(const Channel &channel, float localTime, float *channelResults)
+{
+    int i = 0;
+    if (channel.name.contains(QStringLiteral("Rotation")) &&
+                    channel.channelComponents.size() == 4) {
+
+        // Try to SLERP
+        const int nbKeyframes = channel.channelComponents[0].fcurve.keyframeCount();
+        const bool canSlerp = std::find_if(std::begin(channel.channelComponents)+1,
+                                           std::end(channel.channelComponents),
+                                           [nbKeyframes](const ChannelComponent &v) {
+            return v.fcurve.keyframeCount() != nbKeyframes;
+        }) == std::end(channel.channelComponents);
+
+        if (!canSlerp) {
+            // Interpolate per component
             for (const auto &channelComponent : qAsConst(channel.channelComponents)) {
                 const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime);
                 channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
             }
+        } else {
+            // There's only one keyframe. We cant compute omega. Interpolate per component
+            if (channel.channelComponents[0].fcurve.keyframeCount() == 1) {
+                for (const auto &channelComponent : qAsConst(channel.channelComponents))
+                    channelResults[i++] = channelComponent.fcurve.keyframe(0).value;
+            } else {
+                auto quaternionFromChannel = [&channel](const int keyframe) {
+                    const float w = channel.channelComponents[0].fcurve.keyframe(keyframe).value;
+                    const float x = channel.channelComponents[1].fcurve.keyframe(keyframe).value;
+                    const float y = channel.channelComponents[2].fcurve.keyframe(keyframe).value;
+                    const float z = channel.channelComponents[3].fcurve.keyframe(keyframe).value;
+                    QQuaternion quat{w,x,y,z};
+                    quat.normalize();
+                    return quat;
+                };
+
+                const int lowerKeyframeBound = std::max(0, channel.channelComponents[0].fcurve.lowerKeyframeBound(localTime));
+                const auto lowerQuat = quaternionFromChannel(lowerKeyframeBound);
+                const auto higherQuat = quaternionFromChannel(lowerKeyframeBound + 1);
+                const auto segment = PackedChannelGroup::SlerpSegment::fromQuaternions(lowerQuat, higherQuat);
+                switch (segment.mode) {
+                case PackedChannelGroup::SlerpSegment::Equal:
+                    // If the two keyframe quaternions are equal, just return the first one as the interpolated value.
+                    channelResults[i++] = lowerQuat.scalar();
+                    channelResults[i++] = lowerQuat.x();
+                    channelResults[i++] = lowerQuat.y();
+                    channelResults[i++] = lowerQuat.z();
+                    break;
+                case PackedChannelGroup::SlerpSegment::Lerp:
+                    for (const auto &channelComponent : qAsConst(channel.channelComponents))
+                        channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
+
+                    // Normalize the resulting quaternion
+                    normalizeQuaternions(channelResults, 1);
+                    break;
+                case PackedChannelGroup::SlerpSegment::Slerp:
+                    for (const auto &channelComponent : qAsConst(channel.channelComponents))
+                        channelResults[i++] = channelComponent.fcurve.evaluateAtTimeAsSlerp(localTime,
+                                                                                            lowerKeyframeBound,
+                                                                                            segment.halfTheta,
+                                                                                            segment.sinHalfTheta,
+                                                                                            segment.reverse);
+                    break;
+                }
+            }
+        }
+    } else {
+        // If the channel is not a Rotation, apply linear interpolation per channel component
+        // TODO How do we handle other interpolations. For exammple, color interpolation
+        // in a linear perceptual way or other non linear spaces?
+        for (const auto &channelComponent : qAsConst(channel.channelComponents)) {
+            const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime);
+            channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
         }
     }
+}
+
+} // anonymous
+
+ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
+{
+    QVector<float> channelResults;
+    Q_ASSERT(clip);
+
+    // Ensure we have enough storage to hold the evaluations
+    channelResults.resize(clip->channelCount());
+
+    // Interpolate the packed channels a whole group of components at a time
+    for (const PackedChannelGroup &group : clip->packedChannelGroups())
+        evaluatePackedChannelGroup(group, localTime, channelResults.data());
+
+    // And the remaining ones per channel component
+    const auto &channels = clip->channels();
+    for (const UnpackedChannel &unpacked : clip->unpackedChannels())
+        evaluateChannel(channels[unpacked.channelIndex], localTime,
+                        channelResults.data() + unpacked.resultOffset);
+
     return channelResults;
 }
 
@@ -331,87 +414,158 @@ ClipResults evaluateClipAtPhase(AnimationClip *clip, float phase)
     return evaluateClipAtLocalTime(clip, localTime);
 }
 
-template<typename Container>
-Container mapChannelResultsToContainer(const MappingData &mappingData,
-                                       const QVector<float> &channelResults)
-{
-    Container r;
-    r.reserve(channelResults.size());
-
-    const ComponentIndices channelIndices = mappingData.channelIndices;
-    for (const int channelIndex : channelIndices)
-        r.push_back(channelResults.at(channelIndex));
+namespace {
 
-    return r;
+bool isSupportedPropertyType(int type)
+{
+    switch (type) {
+    case QMetaType::Float:
+    case QMetaType::Double:
+    case QMetaType::QVector2D:
+    case QMetaType::QVector3D:
+    case QMetaType::QVector4D:
+    case QMetaType::QQuaternion:
+    case QMetaType::QColor:
+    case QMetaType::QVariantList:
+        return true;
+    default:
+        return type == qMetaTypeId<QList<float>>();
+    }
 }
 
-QVariant buildPropertyValue(const MappingData &mappingData, const QVector<float> &channelResults)
+// values holds the components of the property in channel order
+QVariant buildPropertyValue(int type, const float *values, int count)
 {
-    const int vectorOfFloatType = qMetaTypeId<QList<float>>();
-
-    if (mappingData.type == vectorOfFloatType)
-        return QVariant::fromValue(channelResults);
+    if (type == qMetaTypeId<QList<float>>())
+        return QVariant::fromValue(QList<float>(values, values + count));
 
-    switch (mappingData.type) {
+    switch (type) {
     case QMetaType::Float:
-    case QMetaType::Double: {
-        return QVariant::fromValue(channelResults[mappingData.channelIndices[0]]);
-    }
+    case QMetaType::Double:
+        return QVariant::fromValue(values[0]);
 
-    case QMetaType::QVector2D: {
-        const QVector2D vector(channelResults[mappingData.channelIndices[0]],
-                channelResults[mappingData.channelIndices[1]]);
-        return QVariant::fromValue(vector);
-    }
+    case QMetaType::QVector2D:
+        return QVariant::fromValue(QVector2D(values[0], values[1]));
 
-    case QMetaType::QVector3D: {
-        const QVector3D vector(channelResults[mappingData.channelIndices[0]],
-                channelResults[mappingData.channelIndices[1]],
-                channelResults[mappingData.channelIndices[2]]);
-        return QVariant::fromValue(vector);
-    }
+    case QMetaType::QVector3D:
+        return QVariant::fromValue(QVector3D(values[0], values[1], values[2]));
 
-    case QMetaType::QVector4D: {
-        const QVector4D vector(channelResults[mappingData.channelIndices[0]],
-                channelResults[mappingData.channelIndices[1]],
-                channelResults[mappingData.channelIndices[2]],
-                channelResults[mappingData.channelIndices[3]]);
-        return QVariant::fromValue(vector);
-    }
+    case QMetaType::QVector4D:
+        return QVariant::fromValue(QVector4D(values[0], values[1], values[2], values[3]));
 
     case QMetaType::QQuaternion: {
-        QQuaternion q(channelResults[mappingData.channelIndices[0]],
-                channelResults[mappingData.channelIndices[1]],
-                channelResults[mappingData.channelIndices[2]],
-                channelResults[mappingData.channelIndices[3]]);
+        QQuaternion q(values[0], values[1], values[2], values[3]);
         q.normalize();
         return QVariant::fromValue(q);
     }
 
     case QMetaType::QColor: {
         // A color can either be a vec3 or a vec4
-        const QColor color =
-                QColor::fromRgbF(channelResults[mappingData.channelIndices[0]],
-                channelResults[mappingData.channelIndices[1]],
-                channelResults[mappingData.channelIndices[2]],
-                mappingData.channelIndices.size() > 3 ? channelResults[mappingData.channelIndices[3]] : 1.0f);
+        const QColor color = QColor::fromRgbF(values[0], values[1], values[2],
+                                              count > 3 ? values[3] : 1.0f);
         return QVariant::fromValue(color);
     }
 
     case QMetaType::QVariantList: {
-        const QVariantList results = mapChannelResultsToContainer<QVariantList>(
-                    mappingData, channelResults);
+        QVariantList results;
+        results.reserve(count);
+        for (int i = 0; i < count; ++i)
+            results.push_back(values[i]);
         return QVariant::fromValue(results);
     }
 
     default:
-        qWarning() << "Unhandled animation type" << mappingData.type;
+        qWarning() << "Unhandled animation type" << type;
         break;
     }
 
     return QVariant();
 }
 
+QVariant buildPropertyValue(const MappingData &mappingData, const QVector<float> &channelResults)
+{
+    QVarLengthArray<float, 16> values;
+    for (const int channelIndex : mappingData.channelIndices)
+        values.push_back(channelResults[channelIndex]);
+    return buildPropertyValue(mappingData.type, values.constData(), int(values.size()));
+}
+
+inline QVector3D channelResultsToVector3D(const ComponentIndices &channelIndices,
+                                          const QVector<float> &channelResults)
+{
+    return QVector3D(channelResults[channelIndices[0]],
+                     channelResults[channelIndices[1]],
+                     channelResults[channelIndices[2]]);
+}
+
+inline QQuaternion channelResultsToQuaternion(const ComponentIndices &channelIndices,
+                                              const QVector<float> &channelResults)
+{
+    QQuaternion q(channelResults[channelIndices[0]],
+                  channelResults[channelIndices[1]],
+                  channelResults[channelIndices[2]],
+                  channelResults[channelIndices[3]]);
+    q.normalize();
+    return q;
+}
+
+// Same as QMetaProperty::write but without wrapping the value in a QVariant,
+// T has to be the type of the property
+template<typename T>
+void writeProperty(QObject *object, int propertyIndex, T value)
+{
+    QVariant unused;
+    int status = -1;
+    int flags = 0;
+    void *argv[] = { &value, &unused, &status, &flags };
+    QMetaObject::metacall(object, QMetaObject::WriteProperty, propertyIndex, argv);
+}
+
+} // anonymous
+
+QVariant propertyValue(const AnimationRecord &record, const AnimationRecord::TargetChange &change)
+{
+    return buildPropertyValue(change.type, record.values.constData() + change.valueOffset, change.valueCount);
+}
+
+void applyTargetChange(QObject *target, const AnimationRecord &record,
+                       const AnimationRecord::TargetChange &change)
+{
+    const float *v = record.values.constData() + change.valueOffset;
+    if (change.propertyIndex != -1) {
+        switch (change.type) {
+        case QMetaType::Float:
+            writeProperty(target, change.propertyIndex, v[0]);
+            return;
+        case QMetaType::Double:
+            writeProperty(target, change.propertyIndex, double(v[0]));
+            return;
+        case QMetaType::QVector2D:
+            writeProperty(target, change.propertyIndex, QVector2D(v[0], v[1]));
+            return;
+        case QMetaType::QVector3D:
+            writeProperty(target, change.propertyIndex, QVector3D(v[0], v[1], v[2]));
+            return;
+        case QMetaType::QVector4D:
+            writeProperty(target, change.propertyIndex, QVector4D(v[0], v[1], v[2], v[3]));
+            return;
+        case QMetaType::QQuaternion:
+            // Normalized by prepareAnimationRecord
+            writeProperty(target, change.propertyIndex, QQuaternion(v[0], v[1], v[2], v[3]));
+            return;
+        case QMetaType::QColor:
+            writeProperty(target, change.propertyIndex,
+                          QColor::fromRgbF(v[0], v[1], v[2], change.valueCount > 3 ? v[3] : 1.0f));
+            return;
+        default:
+            break;
+        }
+    }
+
+    // Unresolved properties and lists go through the meta object by name
+    target->setProperty(change.propertyName, propertyValue(record, change));
+}
+
 AnimationRecord prepareAnimationRecord(Qt3DCore::QNodeId animatorId,
                                        const QVector<MappingData> &mappingDataVec,
                                        const QVector<float> &channelResults,
@@ -422,6 +576,7 @@ AnimationRecord prepareAnimationRecord(Qt3DCore::QNodeId animatorId,
     record.finalFrame = finalFrame;
     record.animatorId = animatorId;
     record.normalizedTime = normalizedLocalTime;
+    record.values.reserve(channelResults.size());
 
     QVarLengthArray<Skeleton *, 4> dirtySkeletons;
 
@@ -430,14 +585,7 @@ AnimationRecord prepareAnimationRecord(Qt3DCore::QNodeId animatorId,
         if (!mappingData.propertyName)
             continue;
 
-        // Build the new value from the channel/fcurve evaluation results
-        const QVariant v = buildPropertyValue(mappingData, channelResults);
-        if (!v.isValid())
-            continue;
-
-        // TODO: Avoid wrapping joint transform components up in a variant, just
-        // to immediately unwrap them again. Refactor buildPropertyValue() to call
-        // helper functions that we can call directly here for joints.
+        const ComponentIndices &channelIndices = mappingData.channelIndices;
         if (mappingData.skeleton && mappingData.jointIndex != -1) {
             // Remember that this skeleton is dirty. We will ask each dirty skeleton
             // to send its set of local poses to observers below.
@@ -446,24 +594,54 @@ AnimationRecord prepareAnimationRecord(Qt3DCore::QNodeId animatorId,
 
             switch (mappingData.jointTransformComponent) {
             case Scale:
-                mappingData.skeleton->setJointScale(mappingData.jointIndex, v.value<QVector3D>());
+                mappingData.skeleton->setJointScale(mappingData.jointIndex,
+                                                    channelResultsToVector3D(channelIndices, channelResults));
                 break;
 
             case Rotation:
-                mappingData.skeleton->setJointRotation(mappingData.jointIndex, v.value<QQuaternion>());
+                mappingData.skeleton->setJointRotation(mappingData.jointIndex,
+                                                       channelResultsToQuaternion(channelIndices, channelResults));
                 break;
 
             case Translation:
-                mappingData.skeleton->setJointTranslation(mappingData.jointIndex, v.value<QVector3D>());
+                mappingData.skeleton->setJointTranslation(mappingData.jointIndex,
+                                                          channelResultsToVector3D(channelIndices, channelResults));
                 break;
 
             default:
                 Q_UNREACHABLE();
                 break;
             }
-        } else {
-            record.targetChanges.push_back({mappingData.targetId, mappingData.propertyName, v});
+            continue;
         }
+
+        if (!isSupportedPropertyType(mappingData.type)) {
+            qWarning() << "Unhandled animation type" << mappingData.type;
+            continue;
+        }
+
+        // Copy the components of the new value out of the channel/fcurve
+        // evaluation results, it is only assembled when applied to the target
+        AnimationRecord::TargetChange change;
+        change.targetId = mappingData.targetId;
+        change.propertyName = mappingData.propertyName;
+        change.propertyIndex = mappingData.propertyIndex;
+        change.type = mappingData.type;
+        change.valueOffset = record.values.size();
+        change.valueCount = channelIndices.size();
+        for (const int channelIndex : channelIndices)
+            record.values.push_back(channelResults[channelIndex]);
+
+        if (mappingData.type == QMetaType::QQuaternion) {
+            float *values = record.values.data() + change.valueOffset;
+            const QQuaternion q = channelResultsToQuaternion(channelIndices, channelResults);
+            values[0] = q.scalar();
+            values[1] = q.x();
+            values[2] = q.y();
+            values[3] = q.z();
+        }
+
+        record.targetChanges.push_back(change);
     }
 
     for (const auto skeleton : dirtySkeletons)
@@ -528,6 +706,7 @@ QVector<MappingData> buildPropertyMappings(const QVector<ChannelMapping *> &chan
             MappingData mappingData;
             mappingData.targetId = mapping->targetId();
             mappingData.propertyName = mapping->propertyName();
+            mappingData.propertyIndex = mapping->propertyIndex();
             mappingData.type = mapping->type();
             mappingData.callback = mapping->callback();
             mappingData.callbackFlags = mapping->callbackFlags();
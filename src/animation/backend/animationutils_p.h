@@ -59,6 +59,7 @@
 
 #include <QtCore/qbitarray.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qobject.h>
 #include <QtCore/QVariant>
 #include <qmath.h>
 
@@ -91,6 +92,7 @@ struct MappingData
     int jointIndex = -1;
     JointTransformComponent jointTransformComponent = NoTransformComponent;
     const char *propertyName;
+    int propertyIndex = -1;
     QAnimationCallback *callback = nullptr;
     QAnimationCallback::Flags callbackFlags;
     int type;
@@ -269,19 +271,20 @@ struct AnimationCallbackAndValue
 };
 
 struct AnimationRecord {
+    // The components of the new value are stored in values, starting at
+    // valueOffset. Quaternions are normalized, in scalar, x, y, z order.
     struct TargetChange {
-        TargetChange(Qt3DCore::QNodeId id, const char *name, QVariant v)
-            : targetId(id), propertyName(name), value(v) {
-
-        }
-
         Qt3DCore::QNodeId targetId;
         const char *propertyName = nullptr;
-        QVariant value;
+        int propertyIndex = -1;
+        int type = static_cast<int>(QMetaType::UnknownType);
+        int valueOffset = 0;
+        int valueCount = 0;
     };
 
     Qt3DCore::QNodeId animatorId;
     QList<TargetChange> targetChanges;
+    QVector<float> values;
     QList<QPair<Qt3DCore::QNodeId, QVector<Qt3DCore::Sqt>>> skeletonChanges;
     float normalizedTime = -1.f;
     bool finalFrame = false;
@@ -294,6 +297,15 @@ AnimationRecord prepareAnimationRecord(Qt3DCore::QNodeId animatorId,
                                        bool finalFrame,
                                        float normalizedLocalTime);
 
+Q_AUTOTEST_EXPORT
+QVariant propertyValue(const AnimationRecord &record, const AnimationRecord::TargetChange &change);
+
+// Writes the value of change to its property of target, through a typed
+// value when the property index is known
+Q_AUTOTEST_EXPORT
+void applyTargetChange(QObject *target, const AnimationRecord &record,
+                       const AnimationRecord::TargetChange &change);
+
 inline constexpr double toSecs(qint64 nsecs) { return nsecs / 1.0e9; }
 inline qint64 toNsecs(double seconds) { return qRound64(seconds * 1.0e9); }
 
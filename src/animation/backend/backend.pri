@@ -9,6 +9,7 @@ HEADERS += \
     $$PWD/keyframe_p.h \
     $$PWD/fcurve_p.h \
     $$PWD/bezierevaluator_p.h \
+    $$PWD/animationsimd_p.h \
     $$PWD/functionrangefinder_p.h \
     $$PWD/clipanimator_p.h \
     $$PWD/blendedclipanimator_p.h \
@@ -29,6 +30,7 @@ HEADERS += \
     $$PWD/clipblendvalue_p.h \
     $$PWD/animationclip_p.h \
     $$PWD/clock_p.h \
+    $$PWD/posecache_p.h \
     $$PWD/skeleton_p.h \
     $$PWD/gltfimporter_p.h
 
@@ -36,6 +38,7 @@ SOURCES += \
     $$PWD/handler.cpp \
     $$PWD/fcurve.cpp \
     $$PWD/bezierevaluator.cpp \
+    $$PWD/animationsimd.cpp \
     $$PWD/functionrangefinder.cpp \
     $$PWD/clipanimator.cpp \
     $$PWD/blendedclipanimator.cpp \
@@ -57,5 +60,6 @@ SOURCES += \
     $$PWD/clipblendvalue.cpp \
     $$PWD/animationclip.cpp \
     $$PWD/clock.cpp \
+    $$PWD/posecache.cpp \
     $$PWD/skeleton.cpp \
     $$PWD/gltfimporter.cpp
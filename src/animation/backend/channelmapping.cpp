@@ -60,6 +60,7 @@ ChannelMapping::ChannelMapping()
     , m_type(static_cast<int>(QMetaType::UnknownType))
     , m_componentCount(0)
     , m_propertyName(nullptr)
+    , m_propertyIndex(-1)
     , m_callback(nullptr)
     , m_skeletonId()
     , m_mappingType(MappingType::ChannelMappingType)
@@ -73,6 +74,7 @@ void ChannelMapping::cleanup()
     m_targetId = Qt3DCore::QNodeId();
     m_type = static_cast<int>(QMetaType::UnknownType);
     m_propertyName = nullptr;
+    m_propertyIndex = -1;
     m_componentCount = 0;
     m_callback = nullptr;
     m_callbackFlags = {};
@@ -95,6 +97,7 @@ void ChannelMapping::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firs
         QChannelMappingPrivate *d = static_cast<QChannelMappingPrivate *>(Qt3DCore::QNodePrivate::get(const_cast<QChannelMapping *>(channelMapping)));
         m_type = d->m_type;
         m_propertyName = d->m_propertyName;
+        m_propertyIndex = d->m_propertyIndex;
         m_componentCount = d->m_componentCount;
     }
 
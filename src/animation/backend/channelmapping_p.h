@@ -93,6 +93,11 @@ public:
     void setPropertyName(const char *propertyName) { m_propertyName = propertyName; }
     const char *propertyName() const { return m_propertyName; }
 
+    // Index of the property in the meta object of the target, -1 if its
+    // values have to be set through QVariant
+    void setPropertyIndex(int propertyIndex) { m_propertyIndex = propertyIndex; }
+    int propertyIndex() const { return m_propertyIndex; }
+
     void setComponentCount(int componentCount) { m_componentCount = componentCount; }
     int componentCount() const { return m_componentCount; }
 
@@ -116,6 +121,7 @@ private:
     int m_type;
     int m_componentCount;
     const char *m_propertyName;
+    int m_propertyIndex;
 
     // TODO: Properties from QCallbackMapping
     QAnimationCallback *m_callback;
@@ -144,9 +144,29 @@ void ClipBlendNode::blend(Qt3DCore::QNodeId animatorId)
     }
 
     // Ask the blend node to perform the actual blend operation on the data
-    // from the dependencies
-    ClipResults blendedResults = doBlend(blendData);
-    setClipResults(animatorId, blendedResults);
+    // from the dependencies. Blend into the results of the previous frame so
+    // that their storage is reused once nothing else references them.
+    const int animatorIndex = m_animatorIds.indexOf(animatorId);
+    if (animatorIndex != -1) {
+        doBlendInto(blendData, m_clipResults[animatorIndex]);
+    } else {
+        ClipResults blendedResults;
+        doBlendInto(blendData, blendedResults);
+        setClipResults(animatorId, blendedResults);
+    }
+}
+
+/*
+    \internal
+
+    Performs the same blend as doBlend() but stores the results in \a results,
+    whose storage can be reused when it already has the right size. Subclasses
+    blending every element in place should reimplement it, the default
+    implementation calls doBlend().
+*/
+void ClipBlendNode::doBlendInto(const QList<ClipResults> &blendData, ClipResults &results) const
+{
+    results = doBlend(blendData);
 }
 
 } // Animation
@@ -92,6 +92,7 @@ public:
 protected:
     explicit ClipBlendNode(BlendType blendType);
     virtual ClipResults doBlend(const QList<ClipResults> &blendData) const = 0;
+    virtual void doBlendInto(const QList<ClipResults> &blendData, ClipResults &results) const;
 
 private:
     ClipBlendNodeManager *m_manager;
@@ -45,6 +45,7 @@
 #include <Qt3DAnimation/private/managers_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
 #include <Qt3DAnimation/private/animationutils_p.h>
+#include <Qt3DAnimation/private/posecache_p.h>
 #include <Qt3DAnimation/private/clipblendvalue_p.h>
 #include <Qt3DAnimation/private/lerpclipblend_p.h>
 #include <Qt3DAnimation/private/clipblendnodevisitor_p.h>
@@ -63,6 +64,15 @@ EvaluateBlendClipAnimatorJob::EvaluateBlendClipAnimatorJob()
 }
 
 void EvaluateBlendClipAnimatorJob::run()
+{
+    Q_ASSERT(m_handler);
+
+    clearFrameData();
+    for (const HBlendedClipAnimator &blendClipAnimatorHandle : qAsConst(m_blendClipAnimatorHandles))
+        evaluateBlendClipAnimator(blendClipAnimatorHandle);
+}
+
+void EvaluateBlendClipAnimatorJob::evaluateBlendClipAnimator(const HBlendedClipAnimator &blendClipAnimatorHandle)
 {
     // Find the set of clips that need to be evaluated by querying each node
     // in the blend tree.
@@ -70,12 +80,12 @@ void EvaluateBlendClipAnimatorJob::run()
     // update when a node indicates its dependencies have changed as a result
     // of blend factors changing
 
-    BlendedClipAnimator *blendedClipAnimator = m_handler->blendedClipAnimatorManager()->data(m_blendClipAnimatorHandle);
+    BlendedClipAnimator *blendedClipAnimator = m_handler->blendedClipAnimatorManager()->data(blendClipAnimatorHandle);
     Q_ASSERT(blendedClipAnimator);
     const bool running = blendedClipAnimator->isRunning();
     const bool seeking = blendedClipAnimator->isSeeking();
     if (!running && !seeking) {
-        m_handler->setBlendedClipAnimatorRunning(m_blendClipAnimatorHandle, false);
+        m_handler->setBlendedClipAnimatorRunning(blendClipAnimatorHandle, false);
         return;
     }
 
@@ -112,7 +122,7 @@ void EvaluateBlendClipAnimatorJob::run()
         AnimationClip *clip = clipLoaderManager->lookupResource(valueNode->clipId());
         Q_ASSERT(clip);
 
-        ClipResults rawClipResults = evaluateClipAtPhase(clip, float(phase));
+        ClipResults rawClipResults = m_handler->poseCache()->evaluateClipAtPhase(clip, float(phase));
 
         // Reformat the clip results into the layout used by this animator/blend tree
         const ClipFormat format = valueNode->clipFormat(blendedClipAnimator->peerId());
@@ -147,7 +157,7 @@ void EvaluateBlendClipAnimatorJob::run()
     // unless the frontend normalized time really is different
     blendedClipAnimator->setNormalizedLocalTime(record.normalizedTime, false);
 
-    setPostFrameData(record, callbacks);
+    addPostFrameData(record, callbacks);
 }
 
 } // Animation
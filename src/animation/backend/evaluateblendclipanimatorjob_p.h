@@ -73,14 +73,17 @@ public:
     void setHandler(Handler *handler) { m_handler = handler; }
     Handler *handler() const { return m_handler; }
 
-    void setBlendClipAnimator(const HBlendedClipAnimator &blendClipAnimatorHandle) { m_blendClipAnimatorHandle = blendClipAnimatorHandle; }
-    HBlendedClipAnimator blendClipAnimator() const { return m_blendClipAnimatorHandle; }
+    // The animators evaluated by the job, typically a share of all the running ones
+    void setBlendClipAnimators(const QVector<HBlendedClipAnimator> &blendClipAnimatorHandles) { m_blendClipAnimatorHandles = blendClipAnimatorHandles; }
+    QVector<HBlendedClipAnimator> blendClipAnimators() const { return m_blendClipAnimatorHandles; }
 
 protected:
     void run() override;
 
 private:
-    HBlendedClipAnimator m_blendClipAnimatorHandle;
+    void evaluateBlendClipAnimator(const HBlendedClipAnimator &blendClipAnimatorHandle);
+
+    QVector<HBlendedClipAnimator> m_blendClipAnimatorHandles;
     Handler *m_handler;
 };
 
@@ -45,6 +45,7 @@
 #include <Qt3DAnimation/private/managers_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
 #include <Qt3DAnimation/private/animationutils_p.h>
+#include <Qt3DAnimation/private/posecache_p.h>
 #include <Qt3DAnimation/private/job_common_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -64,12 +65,19 @@ void EvaluateClipAnimatorJob::run()
 {
     Q_ASSERT(m_handler);
 
-    ClipAnimator *clipAnimator = m_handler->clipAnimatorManager()->data(m_clipAnimatorHandle);
+    clearFrameData();
+    for (const HClipAnimator &clipAnimatorHandle : qAsConst(m_clipAnimatorHandles))
+        evaluateClipAnimator(clipAnimatorHandle);
+}
+
+void EvaluateClipAnimatorJob::evaluateClipAnimator(const HClipAnimator &clipAnimatorHandle)
+{
+    ClipAnimator *clipAnimator = m_handler->clipAnimatorManager()->data(clipAnimatorHandle);
     Q_ASSERT(clipAnimator);
     const bool running = clipAnimator->isRunning();
     const bool seeking = clipAnimator->isSeeking();
     if (!running && !seeking) {
-        m_handler->setClipAnimatorRunning(m_clipAnimatorHandle, false);
+        m_handler->setClipAnimatorRunning(clipAnimatorHandle, false);
         return;
     }
 
@@ -90,7 +98,8 @@ void EvaluateClipAnimatorJob::run()
                                                                                     nsSincePreviousFrame);
 
     const ClipEvaluationData preEvaluationDataForClip = evaluationDataForClip(clip, animatorEvaluationData);
-    const ClipResults rawClipResults = evaluateClipAtPhase(clip, preEvaluationDataForClip.normalizedLocalTime);
+    // Animators playing the same clip in sync share the evaluation
+    const ClipResults rawClipResults = m_handler->poseCache()->evaluateClipAtPhase(clip, preEvaluationDataForClip.normalizedLocalTime);
 
     // Reformat the clip results into the layout used by this animator/blend tree
     const ClipFormat clipFormat = clipAnimator->clipFormat();
@@ -119,7 +128,7 @@ void EvaluateClipAnimatorJob::run()
     // unless the frontend normalized time really is different
     clipAnimator->setNormalizedLocalTime(record.normalizedTime, false);
 
-    setPostFrameData(record, callbacks);
+    addPostFrameData(record, callbacks);
 }
 
 } // namespace Animation
@@ -54,6 +54,10 @@
 #include <Qt3DAnimation/private/abstractevaluateclipanimatorjob_p.h>
 #include <Qt3DAnimation/private/handle_types_p.h>
 
+#if defined(QT_BUILD_INTERNAL)
+class tst_EvaluateClipAnimatorJob;
+#endif
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DAnimation {
@@ -61,7 +65,7 @@ namespace Animation {
 
 class Handler;
 
-class EvaluateClipAnimatorJob : public AbstractEvaluateClipAnimatorJob
+class Q_AUTOTEST_EXPORT EvaluateClipAnimatorJob : public AbstractEvaluateClipAnimatorJob
 {
 public:
     EvaluateClipAnimatorJob();
@@ -69,22 +73,30 @@ public:
     void setHandler(Handler *handler) { m_handler = handler; }
     Handler *handler() const { return m_handler; }
 
-    void setClipAnimator(const HClipAnimator &clipAnimatorHandle)
+    // The animators evaluated by the job, typically a share of all the running ones
+    void setClipAnimators(const QVector<HClipAnimator> &clipAnimatorHandles)
     {
-        m_clipAnimatorHandle = clipAnimatorHandle;
+        m_clipAnimatorHandles = clipAnimatorHandles;
     }
+    QVector<HClipAnimator> clipAnimators() const { return m_clipAnimatorHandles; }
 
-    void clearClipAnimator()
+    void clearClipAnimators()
     {
-        m_clipAnimatorHandle = HClipAnimator();
+        m_clipAnimatorHandles.clear();
     }
 
 protected:
     void run() override;
 
 private:
-    HClipAnimator m_clipAnimatorHandle;
+    void evaluateClipAnimator(const HClipAnimator &clipAnimatorHandle);
+
+    QVector<HClipAnimator> m_clipAnimatorHandles;
     Handler *m_handler;
+
+#if defined(QT_BUILD_INTERNAL)
+    friend class ::tst_EvaluateClipAnimatorJob;
+#endif
 };
 
 } // namespace Animation
@@ -45,16 +45,51 @@
 #include <Qt3DAnimation/private/buildblendtreesjob_p.h>
 #include <Qt3DAnimation/private/evaluateblendclipanimatorjob_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
+#include <Qt3DAnimation/private/posecache_p.h>
 #include <Qt3DAnimation/private/buildblendtreesjob_p.h>
 #include <Qt3DAnimation/private/evaluateblendclipanimatorjob_p.h>
 #include <Qt3DCore/private/qaspectjob_p.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
 #include <Qt3DCore/private/vector_helper_p.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DAnimation {
 namespace Animation {
 
+namespace {
+
+// Returns the batchIndex-th of batchCount contiguous ranges of similar sizes
+template<typename Handle>
+QVector<Handle> batchOf(const QVector<Handle> &handles, int batchIndex, int batchCount)
+{
+    const int begin = handles.size() * batchIndex / batchCount;
+    const int end = handles.size() * (batchIndex + 1) / batchCount;
+    return handles.mid(begin, end - begin);
+}
+
+// Batch jobs are kept across frames. Rewiring them bumps their dependency
+// revision, which forces the job graph to be compiled again, so only do it
+// when the jobs they depend upon actually changed.
+void setBatchDependencies(Qt3DCore::QAspectJob *job, const std::vector<Qt3DCore::QAspectJobPtr> &dependencies)
+{
+    const std::vector<QWeakPointer<Qt3DCore::QAspectJob>> &current = job->dependencies();
+    if (current.size() == dependencies.size()
+            && std::equal(current.begin(), current.end(), dependencies.begin(),
+                          [] (const QWeakPointer<Qt3DCore::QAspectJob> &a, const Qt3DCore::QAspectJobPtr &b) {
+                              return a == b;
+                          }))
+        return;
+
+    Qt3DCore::QAspectJobPrivate::get(job)->clearDependencies();
+    for (const Qt3DCore::QAspectJobPtr &dependency : dependencies)
+        job->addDependency(dependency);
+}
+
+} // anonymous
+
 Handler::Handler()
     : m_animationClipLoaderManager(new AnimationClipLoaderManager)
     , m_clockManager(new ClockManager)
@@ -64,6 +99,7 @@ Handler::Handler()
     , m_channelMapperManager(new ChannelMapperManager)
     , m_clipBlendNodeManager(new ClipBlendNodeManager)
     , m_skeletonManager(new SkeletonManager)
+    , m_poseCache(new PoseCache)
     , m_loadAnimationClipJob(new LoadAnimationClipJob)
     , m_findRunningClipAnimatorsJob(new FindRunningClipAnimatorsJob)
     , m_buildBlendTreesJob(new BuildBlendTreesJob)
@@ -191,6 +227,9 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
 
     QMutexLocker lock(&m_mutex);
 
+    // Poses are only shared within a frame
+    m_poseCache->clear();
+
     // If there are any dirty animation clips that need loading,
     // queue up a job for them
     const bool hasLoadAnimationClipJob = !m_dirtyAnimationClips.isEmpty();
@@ -227,7 +266,9 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
         jobs.push_back(m_buildBlendTreesJob);
     }
 
-    // TODO: Parallelise the animator evaluation and property building at a finer level
+    // Animators are evaluated in batches, as scheduling one job per
+    // animator costs more than evaluating it once there are thousands
+    const int maxBatchCount = Qt3DCore::QAspectJobManager::idealThreadCount();
 
     // If there are any running ClipAnimators, evaluate them for the current
     // time and send property changes
@@ -235,9 +276,9 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
     if (!m_runningClipAnimators.isEmpty()) {
         qCDebug(HandlerLogic) << "Added EvaluateClipAnimatorJobs";
 
-        // Ensure we have a job per clip animator
+        // Ensure we have a job per batch
         const int oldSize = m_evaluateClipAnimatorJobs.size();
-        const int newSize = m_runningClipAnimators.size();
+        const int newSize = std::min(int(m_runningClipAnimators.size()), maxBatchCount);
         if (oldSize < newSize) {
             m_evaluateClipAnimatorJobs.resize(newSize);
             for (int i = oldSize; i < newSize; ++i) {
@@ -246,14 +287,16 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
             }
         }
 
-        // Set each job up with an animator to process and set dependencies
+        std::vector<Qt3DCore::QAspectJobPtr> dependencies;
+        if (hasLoadAnimationClipJob)
+            dependencies.push_back(m_loadAnimationClipJob);
+        if (hasFindRunningClipAnimatorsJob)
+            dependencies.push_back(m_findRunningClipAnimatorsJob);
+
+        // Set each job up with a batch of animators to process and set dependencies
         for (int i = 0; i < newSize; ++i) {
-            m_evaluateClipAnimatorJobs[i]->setClipAnimator(m_runningClipAnimators[i]);
-            Qt3DCore::QAspectJobPrivate::get(m_evaluateClipAnimatorJobs[i].data())->clearDependencies();
-            if (hasLoadAnimationClipJob)
-                m_evaluateClipAnimatorJobs[i]->addDependency(m_loadAnimationClipJob);
-            if (hasFindRunningClipAnimatorsJob)
-                m_evaluateClipAnimatorJobs[i]->addDependency(m_findRunningClipAnimatorsJob);
+            m_evaluateClipAnimatorJobs[i]->setClipAnimators(batchOf(m_runningClipAnimators, i, newSize));
+            setBatchDependencies(m_evaluateClipAnimatorJobs[i].data(), dependencies);
             jobs.push_back(m_evaluateClipAnimatorJobs[i]);
         }
     }
@@ -261,9 +304,9 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
     // BlendClipAnimator execution
     cleanupHandleList(&m_runningBlendedClipAnimators);
     if (!m_runningBlendedClipAnimators.isEmpty()) {
-        // Ensure we have a job per clip animator
+        // Ensure we have a job per batch
         const int oldSize = m_evaluateBlendClipAnimatorJobs.size();
-        const int newSize = m_runningBlendedClipAnimators.size();
+        const int newSize = std::min(int(m_runningBlendedClipAnimators.size()), maxBatchCount);
         if (oldSize < newSize) {
             m_evaluateBlendClipAnimatorJobs.resize(newSize);
             for (int i = oldSize; i < newSize; ++i) {
@@ -272,14 +315,16 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
             }
         }
 
-        // Set each job up with an animator to process and set dependencies
+        std::vector<Qt3DCore::QAspectJobPtr> dependencies;
+        if (hasLoadAnimationClipJob)
+            dependencies.push_back(m_loadAnimationClipJob);
+        if (hasBuildBlendTreesJob)
+            dependencies.push_back(m_buildBlendTreesJob);
+
+        // Set each job up with a batch of animators to process and set dependencies
         for (int i = 0; i < newSize; ++i) {
-            m_evaluateBlendClipAnimatorJobs[i]->setBlendClipAnimator(m_runningBlendedClipAnimators[i]);
-            Qt3DCore::QAspectJobPrivate::get(m_evaluateBlendClipAnimatorJobs[i].data())->clearDependencies();
-            if (hasLoadAnimationClipJob)
-                m_evaluateBlendClipAnimatorJobs[i]->addDependency(m_loadAnimationClipJob);
-            if (hasBuildBlendTreesJob)
-                m_evaluateBlendClipAnimatorJobs[i]->addDependency(m_buildBlendTreesJob);
+            m_evaluateBlendClipAnimatorJobs[i]->setBlendClipAnimators(batchOf(m_runningBlendedClipAnimators, i, newSize));
+            setBatchDependencies(m_evaluateBlendClipAnimatorJobs[i].data(), dependencies);
             jobs.push_back(m_evaluateBlendClipAnimatorJobs[i]);
         }
     }
@@ -80,6 +80,7 @@ class ChannelMapper;
 class ChannelMapperManager;
 class ClipBlendNodeManager;
 class SkeletonManager;
+class PoseCache;
 
 class FindRunningClipAnimatorsJob;
 class LoadAnimationClipJob;
@@ -121,6 +122,7 @@ public:
     ChannelMapperManager *channelMapperManager() const noexcept { return m_channelMapperManager.data(); }
     ClipBlendNodeManager *clipBlendNodeManager() const noexcept { return m_clipBlendNodeManager.data(); }
     SkeletonManager *skeletonManager() const noexcept { return m_skeletonManager.data(); }
+    PoseCache *poseCache() const noexcept { return m_poseCache.data(); }
 
     std::vector<Qt3DCore::QAspectJobPtr> jobsToExecute(qint64 time);
 
@@ -138,6 +140,7 @@ private:
     QScopedPointer<ChannelMapperManager> m_channelMapperManager;
     QScopedPointer<ClipBlendNodeManager> m_clipBlendNodeManager;
     QScopedPointer<SkeletonManager> m_skeletonManager;
+    QScopedPointer<PoseCache> m_poseCache;
 
     QVector<HAnimationClip> m_dirtyAnimationClips;
     QVector<HClipAnimator> m_dirtyClipAnimators;
@@ -40,6 +40,7 @@
 #include "lerpclipblend_p.h"
 #include <Qt3DAnimation/qlerpclipblend.h>
 #include <Qt3DAnimation/private/qlerpclipblend_p.h>
+#include <Qt3DAnimation/private/animationsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -72,16 +73,22 @@ void LerpClipBlend::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool first
 }
 
 ClipResults LerpClipBlend::doBlend(const QList<ClipResults> &blendData) const
+{
+    ClipResults blendResults;
+    doBlendInto(blendData, blendResults);
+    return blendResults;
+}
+
+void LerpClipBlend::doBlendInto(const QList<ClipResults> &blendData, ClipResults &results) const
 {
     Q_ASSERT(blendData.size() == 2);
     Q_ASSERT(blendData[0].size() == blendData[1].size());
     const int elementCount = blendData.first().size();
-    ClipResults blendResults(elementCount);
-
-    for (int i = 0; i < elementCount; ++i)
-        blendResults[i] = (1.0f - m_blendFactor) * blendData[0][i] + (m_blendFactor * blendData[1][i]);
+    results.resize(elementCount);
 
-    return blendResults;
+    weightedSum(blendData[0].constData(), 1.0f - m_blendFactor,
+                blendData[1].constData(), m_blendFactor,
+                results.data(), elementCount);
 }
 
 double LerpClipBlend::duration() const
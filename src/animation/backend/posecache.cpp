@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "posecache_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DAnimation {
+namespace Animation {
+
+PoseCache::PoseCache()
+{
+}
+
+/*!
+    \internal
+
+    Returns the results of evaluating \a clip at \a phase. The clip is only
+    evaluated if no results were stored for the same clip and phase since the
+    last call to clear(). Can be called concurrently.
+ */
+ClipResults PoseCache::evaluateClipAtPhase(AnimationClip *clip, float phase)
+{
+    const auto key = qMakePair(clip, phase);
+    {
+        QMutexLocker lock(&m_mutex);
+        const auto it = m_poses.constFind(key);
+        if (it != m_poses.cend())
+            return it.value();
+    }
+
+    // Evaluate without holding the lock, at worst two jobs evaluate the same
+    // pose and the first one wins
+    const ClipResults results = Animation::evaluateClipAtPhase(clip, phase);
+    QMutexLocker lock(&m_mutex);
+    auto it = m_poses.find(key);
+    if (it == m_poses.end())
+        it = m_poses.insert(key, results);
+    return it.value();
+}
+
+// Called once per frame before the evaluation jobs run, as clips may be
+// reloaded or destroyed in between
+void PoseCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_poses.clear();
+}
+
+int PoseCache::size() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_poses.size();
+}
+
+} // namespace Animation
+} // namespace Qt3DAnimation
+
+QT_END_NAMESPACE
@@ -108,6 +108,7 @@ QChannelMappingPrivate::QChannelMappingPrivate()
     , m_target(nullptr)
     , m_property()
     , m_propertyName(nullptr)
+    , m_propertyIndex(-1)
     , m_type(static_cast<int>(QMetaType::UnknownType))
     , m_componentCount(0)
 {
@@ -124,6 +125,9 @@ void QChannelMappingPrivate::updatePropertyNameTypeAndComponentCount()
     int type;
     int componentCount = 0;
     const char *propertyName = nullptr;
+    // Only set when the results can be written straight to the property
+    // with a value of type, saving the backend from going through QVariant
+    int metaPropertyIndex = -1;
 
     if (!m_target || m_property.isNull()) {
          type = QMetaType::UnknownType;
@@ -134,6 +138,8 @@ void QChannelMappingPrivate::updatePropertyNameTypeAndComponentCount()
         propertyName = mp.name();
         type = mp.userType();
         const QVariant currentValue = m_target->property(mp.name());
+        if (type != QMetaType::QVariant)
+            metaPropertyIndex = propertyIndex;
         if (type == QMetaType::QVariant) {
             if (currentValue.isValid()) {
                 type = currentValue.userType();
@@ -159,6 +165,11 @@ void QChannelMappingPrivate::updatePropertyNameTypeAndComponentCount()
         m_propertyName = propertyName;
         update();
     }
+
+    if (m_propertyIndex != metaPropertyIndex) {
+        m_propertyIndex = metaPropertyIndex;
+        update();
+    }
 }
 
 /*!
@@ -72,6 +72,7 @@ public:
     Qt3DCore::QNode *m_target;
     QString m_property;
     const char *m_propertyName;
+    int m_propertyIndex;
     int m_type;
     int m_componentCount;
 };
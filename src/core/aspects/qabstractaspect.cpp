@@ -89,6 +89,7 @@ void QAbstractAspectPrivate::onEngineAboutToShutdown()
 void QAbstractAspectPrivate::unregisterBackendType(const QMetaObject &mo)
 {
     m_backendCreatorFunctors.remove(&mo);
+    m_mapperCache.clear();
 }
 
 /*!
@@ -175,12 +176,14 @@ void QAbstractAspect::registerBackendType(const QMetaObject &obj, const QBackend
 {
     Q_D(QAbstractAspect);
     d->m_backendCreatorFunctors.insert(&obj, functor);
+    d->m_mapperCache.clear();
 }
 
 void QAbstractAspect::unregisterBackendType(const QMetaObject &obj)
 {
     Q_D(QAbstractAspect);
     d->m_backendCreatorFunctors.remove(&obj);
+    d->m_mapperCache.clear();
 }
 
 QVariant QAbstractAspect::executeCommand(const QStringList &args)
@@ -198,12 +201,19 @@ std::vector<QAspectJobPtr> QAbstractAspect::jobsToExecute(qint64 time)
 QBackendNodeMapperPtr QAbstractAspectPrivate::mapperForNode(const QMetaObject *metaObj) const
 {
     Q_ASSERT(metaObj);
-    QBackendNodeMapperPtr mapper;
+    // Walking up the meta object chain for every dirty node is costly,
+    // remember the outcome for each type, including when there is no mapper
+    const auto it = m_mapperCache.constFind(metaObj);
+    if (it != m_mapperCache.cend())
+        return it.value();
 
-    while (metaObj != nullptr && mapper.isNull()) {
-        mapper = m_backendCreatorFunctors.value(metaObj);
-        metaObj = metaObj->superClass();
+    QBackendNodeMapperPtr mapper;
+    const QMetaObject *mo = metaObj;
+    while (mo != nullptr && mapper.isNull()) {
+        mapper = m_backendCreatorFunctors.value(mo);
+        mo = mo->superClass();
     }
+    m_mapperCache.insert(metaObj, mapper);
     return mapper;
 }
 
@@ -151,6 +151,8 @@ public:
     QAbstractAspectJobManager *m_jobManager;
     QChangeArbiter *m_arbiter;
     QHash<const QMetaObject*, QBackendNodeMapperPtr> m_backendCreatorFunctors;
+    // Resolved mapper (possibly null) for each concrete frontend type seen so far
+    mutable QHash<const QMetaObject*, QBackendNodeMapperPtr> m_mapperCache;
     QMutex m_singleShotMutex;
     std::vector<QAspectJobPtr> m_singleShotJobs;
 
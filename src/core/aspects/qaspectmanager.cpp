@@ -546,13 +546,15 @@ void QAspectManager::processFrame()
             }
         }
 
-        // Sync node / subnode relationship changes
+        // Sync node / subnode relationship changes and property updates.
+        // This has to stay on the main thread, one aspect after the other:
+        // syncing may call back into the frontend (e.g. texture status
+        // updates or QNodePrivate::update()), which is not thread safe
         const auto dirtySubNodes = m_changeArbiter->takeDirtyEntityComponentNodes();
         if (dirtySubNodes.size())
             for (QAbstractAspect *aspect : qAsConst(m_aspects))
                 QAbstractAspectPrivate::get(aspect)->syncDirtyEntityComponentNodes(dirtySubNodes);
 
-        // Sync property updates
         const auto dirtyFrontEndNodes = m_changeArbiter->takeDirtyFrontEndNodes();
         if (dirtyFrontEndNodes.size())
             for (QAbstractAspect *aspect : qAsConst(m_aspects))
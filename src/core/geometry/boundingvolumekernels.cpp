@@ -0,0 +1,415 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "boundingvolumekernels_p.h"
+
+#include <Qt3DCore/private/qt3dcore-config_p.h>
+#include <private/qsimd_p.h>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace BoundingVolumeKernels {
+
+#if QT_CONFIG(qt3d_simd_sse2) && (defined(__AVX2__) || defined(__SSE2__)) && defined(QT_COMPILER_SUPPORTS_SSE2)
+
+namespace {
+
+// Four positions in structure of arrays form. The ordinals keep track of the
+// traversal order, so that ties are resolved like the scalar visitors do
+// (the last visited point wins)
+struct Batch
+{
+    __m128 x;
+    __m128 y;
+    __m128 z;
+    __m128i ordinals;
+};
+
+Q_ALWAYS_INLINE __m128 select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+Q_ALWAYS_INLINE __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+Q_ALWAYS_INLINE __m128 loadPosition(const float *p, const float *end)
+{
+    // Only the last position(s) of a buffer can't be read with a 4 wide load
+    return p + 4 <= end ? _mm_loadu_ps(p) : _mm_setr_ps(p[0], p[1], p[2], 0.0f);
+}
+
+// Gathers up to 4 arbitrary positions, incomplete batches are padded by
+// repeating the last position
+Q_ALWAYS_INLINE Batch loadBatch(const float * const *points, int count, const float *end, int firstOrdinal)
+{
+    __m128 r0 = loadPosition(points[0], end);
+    __m128 r1 = count > 1 ? loadPosition(points[1], end) : r0;
+    __m128 r2 = count > 2 ? loadPosition(points[2], end) : r1;
+    __m128 r3 = count > 3 ? loadPosition(points[3], end) : r2;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    const int last = firstOrdinal + count - 1;
+    return { r0, r1, r2, _mm_setr_epi32(firstOrdinal,
+                                        qMin(firstOrdinal + 1, last),
+                                        qMin(firstOrdinal + 2, last),
+                                        qMin(firstOrdinal + 3, last)) };
+}
+
+// 4 tightly packed float3 positions, x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+Q_ALWAYS_INLINE Batch loadPackedBatch(const float *p, int firstOrdinal)
+{
+    const __m128 a = _mm_loadu_ps(p);
+    const __m128 b = _mm_loadu_ps(p + 4);
+    const __m128 c = _mm_loadu_ps(p + 8);
+
+    const __m128 xt = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 x = _mm_shuffle_ps(a, xt, _MM_SHUFFLE(2, 0, 3, 0));
+    const __m128 yt0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m128 yt1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    const __m128 y = _mm_shuffle_ps(yt0, yt1, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 zt = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 z = _mm_shuffle_ps(zt, c, _MM_SHUFFLE(3, 0, 2, 0));
+
+    return { x, y, z, _mm_add_epi32(_mm_set1_epi32(firstOrdinal), _mm_setr_epi32(0, 1, 2, 3)) };
+}
+
+template <typename Kernel>
+void visitPositions(const BoundingVolumeKernelInput &input, uint stride, Kernel &kernel)
+{
+    const float *points[4];
+    uint i = 0;
+
+    if (stride == 3) {
+        for (; i + 4 <= input.count; i += 4)
+            kernel(loadPackedBatch(input.vertices + 3 * i, int(i)));
+    }
+
+    while (i < input.count) {
+        const uint first = i;
+        int count = 0;
+        while (count < 4 && i < input.count)
+            points[count++] = input.vertices + stride * i++;
+        kernel(loadBatch(points, count, input.verticesEnd, int(first)));
+    }
+}
+
+template <typename Index, typename Kernel>
+void visitIndexedPositions(const BoundingVolumeKernelInput &input, uint stride, Kernel &kernel)
+{
+    const Index *indices = static_cast<const Index *>(input.indices);
+    const float *points[4];
+    int count = 0;
+    int ordinal = 0;
+
+    for (uint i = 0; i < input.count; ++i) {
+        const Index index = indices[i];
+        if (input.primitiveRestartEnabled && static_cast<int>(index) == input.primitiveRestartIndex)
+            continue;
+        points[count++] = input.vertices + stride * index;
+        if (count == 4) {
+            kernel(loadBatch(points, 4, input.verticesEnd, ordinal));
+            ordinal += 4;
+            count = 0;
+        }
+    }
+    if (count)
+        kernel(loadBatch(points, count, input.verticesEnd, ordinal));
+}
+
+template <typename Kernel>
+void visit(const BoundingVolumeKernelInput &input, uint stride, Kernel &kernel)
+{
+    if (!input.indices) {
+        visitPositions(input, stride, kernel);
+        return;
+    }
+
+    switch (input.indexType) {
+    case QAttribute::UnsignedByte:
+        visitIndexedPositions<quint8>(input, stride, kernel);
+        break;
+    case QAttribute::UnsignedShort:
+        visitIndexedPositions<quint16>(input, stride, kernel);
+        break;
+    case QAttribute::UnsignedInt:
+        visitIndexedPositions<quint32>(input, stride, kernel);
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+struct ExtentsKernel
+{
+    explicit ExtentsKernel(const QVector3D &initial)
+        : minX(_mm_set1_ps(initial.x()))
+        , minY(_mm_set1_ps(initial.y()))
+        , minZ(_mm_set1_ps(initial.z()))
+        , maxX(minX)
+        , maxY(minY)
+        , maxZ(minZ)
+    {
+    }
+
+    // The accumulator is the second operand so that NaNs never replace it,
+    // like the comparisons of FindExtremePoints
+    Q_ALWAYS_INLINE void operator()(const Batch &batch)
+    {
+        minX = _mm_min_ps(batch.x, minX);
+        minY = _mm_min_ps(batch.y, minY);
+        minZ = _mm_min_ps(batch.z, minZ);
+        maxX = _mm_max_ps(batch.x, maxX);
+        maxY = _mm_max_ps(batch.y, maxY);
+        maxZ = _mm_max_ps(batch.z, maxZ);
+    }
+
+    static float horizontalMin(__m128 v)
+    {
+        alignas(16) float values[4];
+        _mm_store_ps(values, v);
+        return qMin(qMin(values[0], values[1]), qMin(values[2], values[3]));
+    }
+
+    static float horizontalMax(__m128 v)
+    {
+        alignas(16) float values[4];
+        _mm_store_ps(values, v);
+        return qMax(qMax(values[0], values[1]), qMax(values[2], values[3]));
+    }
+
+    QVector3D min() const { return QVector3D(horizontalMin(minX), horizontalMin(minY), horizontalMin(minZ)); }
+    QVector3D max() const { return QVector3D(horizontalMax(maxX), horizontalMax(maxY), horizontalMax(maxZ)); }
+
+    __m128 minX, minY, minZ;
+    __m128 maxX, maxY, maxZ;
+};
+
+struct FarthestPointKernel
+{
+    explicit FarthestPointKernel(const QVector3D &reference)
+        : refX(_mm_set1_ps(reference.x()))
+        , refY(_mm_set1_ps(reference.y()))
+        , refZ(_mm_set1_ps(reference.z()))
+        , bestDistance(_mm_setzero_ps())
+        , bestX(_mm_setzero_ps())
+        , bestY(_mm_setzero_ps())
+        , bestZ(_mm_setzero_ps())
+        , bestOrdinal(_mm_set1_epi32(-1))
+    {
+    }
+
+    Q_ALWAYS_INLINE void operator()(const Batch &batch)
+    {
+        const __m128 dx = _mm_sub_ps(batch.x, refX);
+        const __m128 dy = _mm_sub_ps(batch.y, refY);
+        const __m128 dz = _mm_sub_ps(batch.z, refZ);
+        const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                           _mm_mul_ps(dz, dz));
+        // >= so that the last of equally distant points is kept
+        const __m128 farther = _mm_cmpge_ps(distance, bestDistance);
+        bestDistance = select(farther, distance, bestDistance);
+        bestX = select(farther, batch.x, bestX);
+        bestY = select(farther, batch.y, bestY);
+        bestZ = select(farther, batch.z, bestZ);
+        bestOrdinal = select(_mm_castps_si128(farther), batch.ordinals, bestOrdinal);
+    }
+
+    QVector3D point() const
+    {
+        alignas(16) float distances[4];
+        alignas(16) float xs[4];
+        alignas(16) float ys[4];
+        alignas(16) float zs[4];
+        alignas(16) int ordinals[4];
+        _mm_store_ps(distances, bestDistance);
+        _mm_store_ps(xs, bestX);
+        _mm_store_ps(ys, bestY);
+        _mm_store_ps(zs, bestZ);
+        _mm_store_si128(reinterpret_cast<__m128i *>(ordinals), bestOrdinal);
+
+        int best = -1;
+        for (int lane = 0; lane < 4; ++lane) {
+            if (ordinals[lane] < 0)
+                continue;
+            if (best < 0 || distances[lane] > distances[best]
+                    || (distances[lane] == distances[best] && ordinals[lane] > ordinals[best]))
+                best = lane;
+        }
+        if (best < 0)
+            return QVector3D();
+        return QVector3D(xs[best], ys[best], zs[best]);
+    }
+
+    __m128 refX, refY, refZ;
+    __m128 bestDistance;
+    __m128 bestX, bestY, bestZ;
+    __m128i bestOrdinal;
+};
+
+// The extents and the first farthest point search only depend on the input,
+// they are computed in a single pass over the positions
+struct ExtentsAndFarthestPointKernel
+{
+    ExtentsAndFarthestPointKernel(const QVector3D &initialExtents, const QVector3D &reference)
+        : extents(initialExtents)
+        , farthest(reference)
+    {
+    }
+
+    Q_ALWAYS_INLINE void operator()(const Batch &batch)
+    {
+        extents(batch);
+        farthest(batch);
+    }
+
+    ExtentsKernel extents;
+    FarthestPointKernel farthest;
+};
+
+QVector3D positionAt(const BoundingVolumeKernelInput &input, uint stride, uint vertex)
+{
+    const float *p = input.vertices + stride * vertex;
+    return QVector3D(p[0], p[1], p[2]);
+}
+
+uint indexAt(const BoundingVolumeKernelInput &input, uint i)
+{
+    switch (input.indexType) {
+    case QAttribute::UnsignedByte:
+        return static_cast<const quint8 *>(input.indices)[i];
+    case QAttribute::UnsignedShort:
+        return static_cast<const quint16 *>(input.indices)[i];
+    default:
+        return static_cast<const quint32 *>(input.indices)[i];
+    }
+}
+
+bool isRestart(const BoundingVolumeKernelInput &input, uint index)
+{
+    return input.primitiveRestartEnabled && static_cast<int>(index) == input.primitiveRestartIndex;
+}
+
+} // anonymous
+
+bool isAvailable()
+{
+    return true;
+}
+
+bool compute(const BoundingVolumeKernelInput &input, BoundingVolumeKernelResult &result)
+{
+    if (!input.vertices || !input.verticesEnd || input.count == 0)
+        return false;
+
+    if (input.indices
+            && input.indexType != QAttribute::UnsignedByte
+            && input.indexType != QAttribute::UnsignedShort
+            && input.indexType != QAttribute::UnsignedInt)
+        return false;
+
+    const uint stride = input.byteStride ? input.byteStride / sizeof(float) : 3;
+
+    // FindExtremePoints starts from the point visited with index 0, or from
+    // the origin if that one is a primitive restart
+    bool hasPoints = false;
+    QVector3D firstPoint;
+    QVector3D initialExtents;
+    if (!input.indices) {
+        firstPoint = initialExtents = positionAt(input, stride, 0);
+        hasPoints = true;
+    } else {
+        for (uint i = 0; i < input.count && !hasPoints; ++i) {
+            const uint index = indexAt(input, i);
+            if (isRestart(input, index))
+                continue;
+            firstPoint = positionAt(input, stride, index);
+            if (i == 0)
+                initialExtents = firstPoint;
+            hasPoints = true;
+        }
+    }
+    if (!hasPoints)
+        return false;
+
+    ExtentsAndFarthestPointKernel firstPass(initialExtents, firstPoint);
+    visit(input, stride, firstPass);
+    const QVector3D y = firstPass.farthest.point();
+
+    FarthestPointKernel farthestFromY(y);
+    visit(input, stride, farthestFromY);
+    const QVector3D z = farthestFromY.point();
+
+    const QVector3D center = (y + z) * .5f;
+    FarthestPointKernel farthestFromCenter(center);
+    visit(input, stride, farthestFromCenter);
+
+    result.min = firstPass.extents.min();
+    result.max = firstPass.extents.max();
+    result.center = center;
+    result.radius = (center - farthestFromCenter.point()).length();
+    return true;
+}
+
+#else
+
+bool isAvailable()
+{
+    return false;
+}
+
+bool compute(const BoundingVolumeKernelInput &input, BoundingVolumeKernelResult &result)
+{
+    Q_UNUSED(input);
+    Q_UNUSED(result);
+    return false;
+}
+
+#endif
+
+} // namespace BoundingVolumeKernels
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_BOUNDINGVOLUMEKERNELS_P_H
+#define QT3DCORE_BOUNDINGVOLUMEKERNELS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtGui/qvector3d.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+// Raw description of the float positions (and optional indices) a bounding
+// volume is computed from. The layout rules are the ones of BufferVisitor: a
+// null byte stride means tightly packed float3 positions.
+struct BoundingVolumeKernelInput
+{
+    void setVertexData(const QByteArray &data, uint byteOffset, uint stride)
+    {
+        vertices = reinterpret_cast<const float *>(data.constData() + byteOffset);
+        verticesEnd = reinterpret_cast<const float *>(data.constData() + data.size());
+        byteStride = stride;
+    }
+
+    void setIndexData(const QByteArray &data, uint byteOffset, QAttribute::VertexBaseType type)
+    {
+        indices = data.constData() + byteOffset;
+        indexType = type;
+    }
+
+    const float *vertices = nullptr;
+    const float *verticesEnd = nullptr;
+    uint byteStride = 0;
+    const void *indices = nullptr;
+    QAttribute::VertexBaseType indexType = QAttribute::UnsignedInt;
+    uint count = 0;
+    bool primitiveRestartEnabled = false;
+    int primitiveRestartIndex = -1;
+};
+
+struct BoundingVolumeKernelResult
+{
+    QVector3D min;
+    QVector3D max;
+    QVector3D center;
+    float radius = -1.f;
+};
+
+namespace BoundingVolumeKernels {
+
+// Vectorized equivalent of the FindExtremePoints / FindMaxDistantPoint
+// visitor passes of BoundingVolumeCalculator. Returns false when the input
+// cannot be handled (no SIMD support, unsupported index type or no point to
+// visit), in which case callers fall back to the visitors.
+Q_3DCORE_PRIVATE_EXPORT bool isAvailable();
+Q_3DCORE_PRIVATE_EXPORT bool compute(const BoundingVolumeKernelInput &input, BoundingVolumeKernelResult &result);
+
+} // namespace BoundingVolumeKernels
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_BOUNDINGVOLUMEKERNELS_P_H
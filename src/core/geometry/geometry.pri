@@ -14,7 +14,8 @@ HEADERS += \
     $$PWD/qgeometryview_p.h \
     $$PWD/qgeometryview.h \
     $$PWD/bufferutils_p.h \
-    $$PWD/buffervisitor_p.h
+    $$PWD/buffervisitor_p.h \
+    $$PWD/boundingvolumekernels_p.h
 
 SOURCES += \
     $$PWD/qabstractfunctor.cpp \
@@ -22,5 +23,6 @@ SOURCES += \
     $$PWD/qboundingvolume.cpp \
     $$PWD/qbuffer.cpp \
     $$PWD/qgeometry.cpp \
-    $$PWD/qgeometryview.cpp
+    $$PWD/qgeometryview.cpp \
+    $$PWD/boundingvolumekernels.cpp
 
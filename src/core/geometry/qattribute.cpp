@@ -62,8 +62,10 @@ QAttributePrivate::QAttributePrivate()
 
 void QAttributePrivate::update()
 {
-    if (!m_blockNotifications)
+    if (!m_blockNotifications) {
         m_dirty = true;
+        markDirty(QScene::BoundingVolumeDirty);
+    }
     QNodePrivate::update();
 }
 
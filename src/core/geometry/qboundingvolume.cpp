@@ -41,6 +41,7 @@
 #include "qboundingvolume_p.h"
 #include <Qt3DCore/private/corelogging_p.h>
 #include <Qt3DCore/private/calcboundingvolumejob_p.h>
+#include <Qt3DCore/private/qscene_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -57,9 +58,26 @@ QBoundingVolumePrivate::QBoundingVolumePrivate()
     , m_implicitPointsValid(false)
     , m_explicitPointsValid(false)
     , m_primaryProvider(true)
+    , m_dirty(false)
 {
 }
 
+void QBoundingVolumePrivate::setScene(QScene *scene)
+{
+    Q_Q(QBoundingVolume);
+
+    if (m_scene == scene)
+        return;
+
+    if (m_scene)
+        m_scene->removeBoundingVolumeProvider(q);
+    QComponentPrivate::setScene(scene);
+    if (m_scene) {
+        m_dirty = true;
+        m_scene->addBoundingVolumeProvider(q);
+    }
+}
+
 void QBoundingVolumePrivate::setImplicitBounds(const QVector3D &minPoint, const QVector3D &maxPoint,
                                                const QVector3D &center, float radius)
 {
@@ -107,6 +125,9 @@ void QBoundingVolumePrivate::setView(QGeometryView *view)
     if (m_view)
         registerDestructionHelper(m_view, &QBoundingVolume::setView, m_view);
 
+    m_dirty = true;
+    markDirty(QScene::BoundingVolumeDirty);
+
     emit q->viewChanged(view);
 }
 
@@ -68,6 +68,7 @@ public:
 
     QBoundingVolumePrivate();
 
+    void setScene(QScene *scene) override;
     void setImplicitBounds(const QVector3D &minPoint, const QVector3D &maxPoint, const QVector3D &center, float radius);
     virtual void setView(QGeometryView *view);
 
@@ -83,6 +84,7 @@ public:
     bool m_implicitPointsValid;
     bool m_explicitPointsValid;
     bool m_primaryProvider;
+    bool m_dirty;
 };
 
 } // namespace Qt3DCore
@@ -41,6 +41,7 @@
 #include "qgeometryview_p.h"
 #include "qgeometry_p.h"
 #include "buffervisitor_p.h"
+#include "boundingvolumekernels_p.h"
 
 #include <Qt3DCore/QAttribute>
 #include <Qt3DCore/QBuffer>
@@ -141,6 +142,43 @@ bool BoundingVolumeCalculator::apply(QAttribute *positionAttribute,
 {
     m_radius = -1.f;
 
+    if (BoundingVolumeKernels::isAvailable()
+            && positionAttribute->vertexBaseType() == QAttribute::Float
+            && positionAttribute->vertexSize() >= 3) {
+        // Keep the buffer contents alive while the kernels read them
+        const QByteArray vertexData = positionAttribute->buffer()->data();
+        const QByteArray indexData = indexAttribute ? indexAttribute->buffer()->data() : QByteArray();
+
+        BoundingVolumeKernelInput input;
+        input.setVertexData(vertexData, positionAttribute->byteOffset(), positionAttribute->byteStride());
+        if (indexAttribute)
+            input.setIndexData(indexData, indexAttribute->byteOffset(), indexAttribute->vertexBaseType());
+        input.count = uint(drawVertexCount);
+        input.primitiveRestartEnabled = primitiveRestartEnabled;
+        input.primitiveRestartIndex = primitiveRestartIndex;
+
+        BoundingVolumeKernelResult result;
+        if (BoundingVolumeKernels::compute(input, result)) {
+            m_min = result.min;
+            m_max = result.max;
+            m_center = result.center;
+            m_radius = result.radius;
+            return true;
+        }
+    }
+
+    return applyScalar(positionAttribute, indexAttribute, drawVertexCount,
+                       primitiveRestartEnabled, primitiveRestartIndex);
+}
+
+bool BoundingVolumeCalculator::applyScalar(QAttribute *positionAttribute,
+                                           QAttribute *indexAttribute,
+                                           int drawVertexCount,
+                                           bool primitiveRestartEnabled,
+                                           int primitiveRestartIndex)
+{
+    m_radius = -1.f;
+
     FindExtremePoints findExtremePoints;
     if (!findExtremePoints.apply(positionAttribute, indexAttribute, drawVertexCount,
                                  primitiveRestartEnabled, primitiveRestartIndex)) {
@@ -218,8 +256,10 @@ QGeometryViewPrivate *QGeometryViewPrivate::get(QGeometryView *q)
 
 void QGeometryViewPrivate::update()
 {
-    if (!m_blockNotifications)
+    if (!m_blockNotifications) {
         m_dirty = true;
+        markDirty(QScene::BoundingVolumeDirty);
+    }
     QNodePrivate::update();
 }
 
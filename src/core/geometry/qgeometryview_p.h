@@ -89,7 +89,7 @@ public:
     bool m_dirty;
 };
 
-class BoundingVolumeCalculator
+class Q_3DCORE_PRIVATE_EXPORT BoundingVolumeCalculator
 {
 public:
     BoundingVolumeCalculator() = default;
@@ -105,6 +105,13 @@ public:
                int drawVertexCount,
                bool primitiveRestartEnabled,
                int primitiveRestartIndex);
+    // Visitor based implementation, used for the layouts the vectorized
+    // kernels do not handle
+    bool applyScalar(QAttribute *positionAttribute,
+                     QAttribute *indexAttribute,
+                     int drawVertexCount,
+                     bool primitiveRestartEnabled,
+                     int primitiveRestartIndex);
 
 private:
     QVector3D m_min;
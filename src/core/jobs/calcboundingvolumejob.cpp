@@ -55,6 +55,7 @@
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DCore/private/qgeometryview_p.h>
 #include <Qt3DCore/private/qnodevisitor_p.h>
+#include <Qt3DCore/private/qscene_p.h>
 #include <Qt3DCore/private/qthreadpooler_p.h>
 
 #include <QtCore/qmath.h>
@@ -241,11 +242,7 @@ void CalculateBoundingVolumeJob::run()
     m_results.clear();
 
     QHash<QEntity *, BoundingVolumeComputeData> dirtyEntities;
-    QNodeVisitor visitor;
-    visitor.traverse(m_root, [](QNode *) {}, [&dirtyEntities, this](QEntity *entity) {
-        if (!isTreeEnabled(entity))
-            return;
-
+    const auto gatherDirtyEntity = [&dirtyEntities, this](QEntity *entity) {
         const auto bvProviders = entity->componentsOfType<QBoundingVolume>();
         if (bvProviders.isEmpty())
             return;
@@ -288,7 +285,8 @@ void CalculateBoundingVolumeJob::run()
                 continue;
             }
 
-            bool dirty = QEntityPrivate::get(entity)->m_dirty;
+            bool dirty = dbv->m_dirty;
+            dirty |= QEntityPrivate::get(entity)->m_dirty;
             dirty |= QGeometryViewPrivate::get(bv->view())->m_dirty;
             dirty |= QGeometryPrivate::get(bv->view()->geometry())->m_dirty;
             dirty |= QAttributePrivate::get(bvdata.positionAttribute)->m_dirty;
@@ -307,7 +305,31 @@ void CalculateBoundingVolumeJob::run()
                 foundBV = true;
             }
         }
-    });
+    };
+
+    QScene *scene = m_root ? QNodePrivate::get(m_root)->scene() : nullptr;
+    if (scene) {
+        // Only look at the entities referencing the providers registered
+        // with the scene, rather than walking the whole frontend tree
+        const QList<QBoundingVolume *> providers = scene->boundingVolumeProviders();
+        QSet<QEntity *> visitedEntities;
+        for (QBoundingVolume *bv : providers) {
+            const auto entities = bv->entities();
+            for (QEntity *entity : entities) {
+                if (visitedEntities.contains(entity) || !isTreeEnabled(entity))
+                    continue;
+                visitedEntities.insert(entity);
+                gatherDirtyEntity(entity);
+            }
+        }
+    } else {
+        QNodeVisitor visitor;
+        visitor.traverse(m_root, [](QNode *) {}, [&gatherDirtyEntity](QEntity *entity) {
+            if (!isTreeEnabled(entity))
+                return;
+            gatherDirtyEntity(entity);
+        });
+    }
 
 #if QT_CONFIG(concurrent)
     if (dirtyEntities.size() > 1 && QAspectJobManager::idealThreadCount() > 1) {
@@ -343,6 +365,7 @@ void CalculateBoundingVolumeJob::postFrame(QAspectEngine *aspectEngine)
         QBoundingVolumePrivate::get(result.provider)->setImplicitBounds(result.m_min, result.m_max, result.m_center, result.m_radius);
 
         // reset dirty flags
+        QBoundingVolumePrivate::get(result.provider)->m_dirty = false;
         QEntityPrivate::get(result.entity)->m_dirty = false;
         QGeometryViewPrivate::get(result.provider->view())->m_dirty = false;
         QGeometryPrivate::get(result.provider->view()->geometry())->m_dirty = false;
@@ -1,20 +1,24 @@
 
 SOURCES += \
     $$PWD/qaspectjob.cpp \
+    $$PWD/qaspectjobgraph.cpp \
     $$PWD/qaspectjobmanager.cpp \
     $$PWD/qabstractaspectjobmanager.cpp \
     $$PWD/qthreadpooler.cpp \
     $$PWD/task.cpp \
+    $$PWD/qworkstealingexecutor.cpp \
     $$PWD/calcboundingvolumejob.cpp
 
 HEADERS += \
     $$PWD/qaspectjob.h \
     $$PWD/qaspectjob_p.h \
+    $$PWD/qaspectjobgraph_p.h \
     $$PWD/qaspectjobproviderinterface_p.h \
     $$PWD/qaspectjobmanager_p.h \
     $$PWD/qabstractaspectjobmanager_p.h \
     $$PWD/task_p.h \
     $$PWD/qthreadpooler_p.h \
+    $$PWD/qworkstealingexecutor_p.h \
     $$PWD/calcboundingvolumejob_p.h \
     $$PWD/job_common_p.h
 
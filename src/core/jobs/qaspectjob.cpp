@@ -45,6 +45,9 @@
 
 #include <QtCore/QByteArray>
 
+#include <algorithm>
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
@@ -56,11 +59,19 @@ bool isDependencyNull(const QWeakPointer<QAspectJob> &dep)
     return dep.isNull();
 }
 
+std::atomic<quint64> dependenciesRevisionCounter(0);
+
 } // anonymous
 
 QAspectJobPrivate::QAspectJobPrivate()
-    : m_jobName(QLatin1String("UnknowJob"))
+    : m_dependenciesRevision(nextDependenciesRevision())
+    , m_jobName(QLatin1String("UnknowJob"))
+{
+}
+
+quint64 QAspectJobPrivate::nextDependenciesRevision()
 {
+    return dependenciesRevisionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 QAspectJobPrivate::~QAspectJobPrivate() = default;
@@ -111,12 +122,16 @@ QAspectJob::~QAspectJob()
 }
 
 /*!
- * Adds \a dependency to the aspect job.
+ * Adds \a dependency to the aspect job. Adding a dependency the job already
+ * has does nothing.
  */
 void QAspectJob::addDependency(QWeakPointer<QAspectJob> dependency)
 {
     Q_D(QAspectJob);
+    if (std::find(d->m_dependencies.cbegin(), d->m_dependencies.cend(), dependency) != d->m_dependencies.cend())
+        return;
     d->m_dependencies.push_back(dependency);
+    d->m_dependenciesRevision = QAspectJobPrivate::nextDependenciesRevision();
 #ifdef QT3DCORE_ASPECT_JOB_DEBUG
     static int threshold = qMax(1, qgetenv("QT3DCORE_ASPECT_JOB_DEPENDENCY_THRESHOLD").toInt());
     if (d->m_dependencies.count() > threshold)
@@ -130,6 +145,7 @@ void QAspectJob::addDependency(QWeakPointer<QAspectJob> dependency)
 void QAspectJob::removeDependency(QWeakPointer<QAspectJob> dependency)
 {
     Q_D(QAspectJob);
+    const size_t dependencyCount = d->m_dependencies.size();
     if (!dependency.isNull()) {
         d->m_dependencies.erase(std::remove(d->m_dependencies.begin(),
                                             d->m_dependencies.end(),
@@ -141,6 +157,8 @@ void QAspectJob::removeDependency(QWeakPointer<QAspectJob> dependency)
                                                isDependencyNull),
                                 d->m_dependencies.end());
     }
+    if (d->m_dependencies.size() != dependencyCount)
+        d->m_dependenciesRevision = QAspectJobPrivate::nextDependenciesRevision();
 }
 
 /*!
@@ -75,9 +75,16 @@ public:
     virtual bool isRequired() const;
     virtual void postFrame(QAspectManager *aspectManager);
 
-    void clearDependencies() { m_dependencies.clear(); }
+    static quint64 nextDependenciesRevision();
+
+    void clearDependencies() { m_dependencies.clear(); m_dependenciesRevision = nextDependenciesRevision(); }
 
     std::vector<QWeakPointer<QAspectJob> > m_dependencies;
+    // Renewed whenever m_dependencies changes, lets the job manager know
+    // when the job graph it compiled is out of date. Revisions are drawn from
+    // a single counter so that they are never shared between two jobs, even
+    // when a job is allocated at the address of a deleted one.
+    quint64 m_dependenciesRevision;
     JobId m_jobId;
     QString m_jobName;
 };
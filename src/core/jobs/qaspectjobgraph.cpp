@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qaspectjobgraph_p.h"
+
+#include <Qt3DCore/private/corelogging_p.h>
+#include <Qt3DCore/private/qaspectjob_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+QAspectJobGraph::UpdateResult QAspectJobGraph::update(const std::vector<QAspectJobPtr> &jobQueue)
+{
+    const size_t jobCount = jobQueue.size();
+    bool membershipChanged = jobCount != m_nodes.size();
+    bool dependenciesChanged = false;
+
+    // Same jobs at the same position, only patch the nodes whose
+    // dependencies were modified since they were last compiled
+    for (size_t i = 0; !membershipChanged && i < jobCount; ++i) {
+        const QAspectJobPtr &job = jobQueue[i];
+        Node &node = m_nodes[i];
+        if (!isNodeOf(node, job)) {
+            membershipChanged = true;
+        } else if (node.dependenciesRevision != QAspectJobPrivate::get(job.data())->m_dependenciesRevision) {
+            snapshotDependencies(node, job);
+            resolveDependencies(node);
+            dependenciesChanged = true;
+        }
+    }
+
+    if (membershipChanged) {
+        std::vector<Node> previousNodes;
+        previousNodes.swap(m_nodes);
+        QHash<QAspectJob *, int> previousIndices;
+        previousIndices.swap(m_nodeIndices);
+
+        m_nodes.resize(jobCount);
+        m_nodeIndices.reserve(int(jobCount));
+        for (size_t i = 0; i < jobCount; ++i) {
+            const QAspectJobPtr &job = jobQueue[i];
+            m_nodeIndices.insert(job.data(), int(i));
+
+            // Jobs that were already there keep their dependency snapshot. The
+            // previous index is found by address, which may have been reused
+            // by a new job since, hence checking the node against the job.
+            const int previousIndex = previousIndices.value(job.data(), -1);
+            if (previousIndex >= 0
+                    && isNodeOf(previousNodes[previousIndex], job)
+                    && previousNodes[previousIndex].dependenciesRevision == QAspectJobPrivate::get(job.data())->m_dependenciesRevision) {
+                m_nodes[i] = std::move(previousNodes[previousIndex]);
+                previousNodes[previousIndex].job.clear();
+            } else {
+                snapshotDependencies(m_nodes[i], job);
+            }
+        }
+
+        for (Node &node : m_nodes)
+            resolveDependencies(node);
+
+        compile();
+        ++m_statistics.rebuilt;
+        return Rebuilt;
+    }
+
+    if (dependenciesChanged) {
+        compile();
+        ++m_statistics.patched;
+        return Patched;
+    }
+
+    ++m_statistics.reused;
+    return Reused;
+}
+
+bool QAspectJobGraph::isNodeOf(const Node &node, const QAspectJobPtr &job)
+{
+    // A node whose job was deleted can't match, whatever the address of job
+    return node.job.toStrongRef() == job;
+}
+
+void QAspectJobGraph::snapshotDependencies(Node &node, const QAspectJobPtr &job)
+{
+    const std::vector<QWeakPointer<QAspectJob>> &dependencies = job->dependencies();
+    node.job = job;
+    node.dependenciesRevision = QAspectJobPrivate::get(job.data())->m_dependenciesRevision;
+    node.dependencies = dependencies;
+    node.dependencyJobs.clear();
+    node.dependencyJobs.reserve(dependencies.size());
+    for (const QWeakPointer<QAspectJob> &dependency : dependencies)
+        node.dependencyJobs.push_back(dependency.toStrongRef().data());
+}
+
+void QAspectJobGraph::resolveDependencies(Node &node) const
+{
+    node.resolvedDependencies.clear();
+    for (size_t i = 0, m = node.dependencies.size(); i < m; ++i) {
+        // A dead dependency can't be in the queue, even if a queued job
+        // happens to have been allocated at the same address
+        if (node.dependencies[i].isNull())
+            continue;
+        // The dependencies here are not hard requirements, i.e., the dependencies
+        // not in the jobQueue should already have their data ready.
+        const int index = m_nodeIndices.value(node.dependencyJobs[i], -1);
+        if (index >= 0)
+            node.resolvedDependencies.push_back(index);
+    }
+}
+
+// Flattens the per node dependencies into indegrees and a compressed
+// depender adjacency list, and computes a topological order
+void QAspectJobGraph::compile()
+{
+    const int nodeCount = int(m_nodes.size());
+
+    m_indegrees.assign(nodeCount, 0);
+    m_adjacencyOffsets.assign(nodeCount + 1, 0);
+    for (int i = 0; i < nodeCount; ++i) {
+        const std::vector<int> &dependencies = m_nodes[i].resolvedDependencies;
+        m_indegrees[i] = int(dependencies.size());
+        for (const int dependency : dependencies)
+            ++m_adjacencyOffsets[dependency + 1];
+    }
+    for (int i = 0; i < nodeCount; ++i)
+        m_adjacencyOffsets[i + 1] += m_adjacencyOffsets[i];
+
+    m_adjacency.resize(m_adjacencyOffsets[nodeCount]);
+    std::vector<int> cursors(m_adjacencyOffsets.begin(), m_adjacencyOffsets.end() - 1);
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const int dependency : m_nodes[i].resolvedDependencies)
+            m_adjacency[cursors[dependency]++] = i;
+    }
+
+    // Kahn's algorithm, reusing the cursors as remaining indegrees
+    m_topologicalOrder.clear();
+    m_topologicalOrder.reserve(nodeCount);
+    cursors.assign(m_indegrees.begin(), m_indegrees.end());
+    for (int i = 0; i < nodeCount; ++i) {
+        if (cursors[i] == 0)
+            m_topologicalOrder.push_back(i);
+    }
+    for (size_t head = 0; head < m_topologicalOrder.size(); ++head) {
+        const int node = m_topologicalOrder[head];
+        for (const int *depender = dependersBegin(node), *end = dependersEnd(node); depender != end; ++depender) {
+            if (--cursors[*depender] == 0)
+                m_topologicalOrder.push_back(*depender);
+        }
+    }
+
+    if (int(m_topologicalOrder.size()) != nodeCount)
+        qCWarning(Aspects) << "Cyclic dependency found between aspect jobs, some jobs will never run";
+}
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
@@ -0,0 +1,130 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_QASPECTJOBGRAPH_P_H
+#define QT3DCORE_QASPECTJOBGRAPH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+
+#include <QtCore/QHash>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+// Dependency graph of the jobs of a frame, compiled to flat arrays.
+// Nodes are numbered after the position of their job in the queue. As the
+// queue is mostly identical from one frame to the next, the graph is only
+// patched for the jobs whose dependencies were modified and only rebuilt
+// when jobs were added, removed or reordered.
+class Q_3DCORE_PRIVATE_EXPORT QAspectJobGraph
+{
+public:
+    enum UpdateResult {
+        Reused,
+        Patched,
+        Rebuilt
+    };
+
+    struct Statistics
+    {
+        quint64 reused = 0;
+        quint64 patched = 0;
+        quint64 rebuilt = 0;
+    };
+
+    UpdateResult update(const std::vector<QAspectJobPtr> &jobQueue);
+
+    int nodeCount() const { return int(m_nodes.size()); }
+    int indegree(int node) const { return m_indegrees[node]; }
+    const int *dependersBegin(int node) const { return m_adjacency.data() + m_adjacencyOffsets[node]; }
+    const int *dependersEnd(int node) const { return m_adjacency.data() + m_adjacencyOffsets[node + 1]; }
+    const std::vector<int> &topologicalOrder() const { return m_topologicalOrder; }
+
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    struct Node
+    {
+        // Only ever compared through the weak pointer, a job allocated at
+        // the address of a deleted one must not inherit its node
+        QWeakPointer<QAspectJob> job;
+        quint64 dependenciesRevision = 0;
+        // Snapshot of the job dependencies, only taken when they change
+        std::vector<QWeakPointer<QAspectJob>> dependencies;
+        std::vector<QAspectJob *> dependencyJobs;
+        // Node indices of the dependencies that are part of the graph
+        std::vector<int> resolvedDependencies;
+    };
+
+    static bool isNodeOf(const Node &node, const QAspectJobPtr &job);
+    static void snapshotDependencies(Node &node, const QAspectJobPtr &job);
+    void resolveDependencies(Node &node) const;
+    void compile();
+
+    std::vector<Node> m_nodes;
+    QHash<QAspectJob *, int> m_nodeIndices;
+
+    std::vector<int> m_indegrees;
+    std::vector<int> m_adjacencyOffsets;
+    std::vector<int> m_adjacency;
+    std::vector<int> m_topologicalOrder;
+
+    Statistics m_statistics;
+};
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_QASPECTJOBGRAPH_P_H
@@ -43,9 +43,9 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QThread>
-#include <QtCore/QFuture>
+#include <QtCore/QThreadPool>
 #include <Qt3DCore/private/qaspectmanager_p.h>
-#include <Qt3DCore/private/qthreadpooler_p.h>
+#include <Qt3DCore/private/qworkstealingexecutor_p.h>
 #include <Qt3DCore/private/task_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -54,19 +54,40 @@ namespace Qt3DCore {
 
 QAspectJobManager::QAspectJobManager(QAspectManager *parent)
     : QAbstractAspectJobManager(parent)
-    , m_threadPooler(new QThreadPooler(this))
     , m_aspectManager(parent)
+    , m_usedTaskCount(0)
 {
+    // Jobs relying on QtConcurrent should honor QT3D_MAX_THREAD_COUNT too and,
+    // like the executor workers which only ever sleep between frames, should
+    // never have their threads recycled
+    QThreadPool::globalInstance()->setMaxThreadCount(QAspectJobManager::idealThreadCount());
+    QThreadPool::globalInstance()->setExpiryTimeout(-1);
 }
 
 QAspectJobManager::~QAspectJobManager()
 {
+    // Destroying the executor waits for any pending job and stops the workers
+    m_executor.reset();
 }
 
 void QAspectJobManager::initialize()
 {
 }
 
+// Workers are only spawned once there is actually something to run
+QWorkStealingExecutor *QAspectJobManager::executor()
+{
+    if (!m_executor)
+        m_executor = std::make_unique<QWorkStealingExecutor>(QAspectJobManager::idealThreadCount());
+    return m_executor.get();
+}
+
+void QAspectJobManager::reserveTasks(size_t count)
+{
+    while (m_tasks.size() < count)
+        m_tasks.push_back(std::make_unique<AspectJobTask>());
+}
+
 // Adds all Aspect Jobs to be processed for a frame
 void QAspectJobManager::enqueueJobs(const std::vector<QAspectJobPtr> &jobQueue)
 {
@@ -74,58 +95,132 @@ void QAspectJobManager::enqueueJobs(const std::vector<QAspectJobPtr> &jobQueue)
     if (systemService)
         systemService->writePreviousFrameTraces();
 
-    // Convert QJobs to Tasks
-    QHash<QAspectJob *, AspectTaskRunnable *> tasksMap;
-    QList<RunnableInterface *> taskList;
-    taskList.reserve(jobQueue.size());
-    for (const QAspectJobPtr &job : jobQueue) {
-        AspectTaskRunnable *task = new AspectTaskRunnable(systemService);
-        task->m_job = job;
-        tasksMap.insert(job.data(), task);
+    // The first batch of a frame is expected to be the same set of jobs
+    // as in the previous frame and goes through the compiled job graph
+    if (m_usedTaskCount == 0)
+        enqueueCompiledJobs(jobQueue, systemService);
+    else
+        enqueueAdditionalJobs(jobQueue, systemService);
 
-        taskList << task;
+    executor()->submit(m_submittedTasks.data(), m_submittedTasks.size());
+}
+
+void QAspectJobManager::enqueueCompiledJobs(const std::vector<QAspectJobPtr> &jobQueue,
+                                            QSystemInformationService *systemService)
+{
+    const QAspectJobGraph::UpdateResult result = m_jobGraph.update(jobQueue);
+    const size_t jobCount = jobQueue.size();
+    reserveTasks(jobCount);
+
+    // Only rewire the tasks when the graph has changed
+    if (result != QAspectJobGraph::Reused) {
+        for (size_t i = 0; i < jobCount; ++i) {
+            AspectJobTask *task = m_tasks[i].get();
+            task->m_dependers.clear();
+            for (const int *depender = m_jobGraph.dependersBegin(int(i)),
+                 *end = m_jobGraph.dependersEnd(int(i)); depender != end; ++depender)
+                task->m_dependers.push_back(m_tasks[*depender].get());
+            task->m_dependencyCount = m_jobGraph.indegree(int(i));
+        }
+    }
+
+    m_submittedTasks.clear();
+    m_submittedTasks.reserve(jobCount);
+    for (size_t i = 0; i < jobCount; ++i) {
+        AspectJobTask *task = m_tasks[i].get();
+        task->m_job = jobQueue[i];
+        task->m_service = systemService;
+        m_submittedTasks.push_back(task);
+    }
+    m_usedTaskCount = jobCount;
+}
+
+// Jobs enqueued on top of the frame jobs are wired on the fly, using tasks
+// past the ones reserved for the compiled graph
+void QAspectJobManager::enqueueAdditionalJobs(const std::vector<QAspectJobPtr> &jobQueue,
+                                              QSystemInformationService *systemService)
+{
+    const size_t firstTask = qMax(m_usedTaskCount, size_t(m_jobGraph.nodeCount()));
+    reserveTasks(firstTask + jobQueue.size());
+
+    m_tasksMap.clear();
+    m_submittedTasks.clear();
+    m_submittedTasks.reserve(jobQueue.size());
+    for (size_t i = 0, m = jobQueue.size(); i < m; ++i) {
+        AspectJobTask *task = m_tasks[firstTask + i].get();
+        task->m_job = jobQueue[i];
+        task->m_service = systemService;
+        task->m_dependers.clear();
+        task->m_dependencyCount = 0;
+        m_tasksMap.insert(task->m_job.data(), task);
+        m_submittedTasks.push_back(task);
     }
 
     for (const QAspectJobPtr &job : jobQueue) {
         const std::vector<QWeakPointer<QAspectJob> > &deps = job->dependencies();
-        AspectTaskRunnable *taskDepender = tasksMap.value(job.data());
+        AspectJobTask *taskDepender = m_tasksMap.value(job.data());
 
-        int dependerCount = 0;
         for (const QWeakPointer<QAspectJob> &dep : deps) {
-            AspectTaskRunnable *taskDependee = tasksMap.value(dep.toStrongRef().data());
+            AspectJobTask *taskDependee = m_tasksMap.value(dep.toStrongRef().data());
             // The dependencies here are not hard requirements, i.e., the dependencies
             // not in the jobQueue should already have their data ready.
             if (taskDependee) {
-                taskDependee->m_dependers.append(taskDepender);
-                ++dependerCount;
+                taskDependee->m_dependers.push_back(taskDepender);
+                ++taskDepender->m_dependencyCount;
             }
         }
-
-        taskDepender->m_dependerCount += dependerCount;
     }
-
-    m_threadPooler->mapDependables(taskList);
+    m_usedTaskCount = firstTask + jobQueue.size();
 }
 
 // Wait for all aspects jobs to be completed
 int QAspectJobManager::waitForAllJobs()
 {
-    return m_threadPooler->waitForAllJobs();
+    const int totalRunJobs = m_executor ? m_executor->waitForAll() : 0;
+
+    // No worker can be holding a sync task anymore
+    m_syncBatches.clear();
+
+    // Release the jobs but keep the tasks and their wiring for the next frame
+    for (size_t i = 0; i < m_usedTaskCount; ++i)
+        m_tasks[i]->m_job.reset();
+    m_usedTaskCount = 0;
+
+    return totalRunJobs;
 }
 
-void QAspectJobManager::waitForPerThreadFunction(JobFunction func, void *arg)
+QAspectJobGraph::Statistics QAspectJobManager::jobGraphStatistics() const
 {
-    const int threadCount = QAspectJobManager::idealThreadCount();
-    QAtomicInt atomicCount(threadCount);
+    return m_jobGraph.statistics();
+}
 
-    QList<RunnableInterface *> taskList;
-    for (int i = 0; i < threadCount; ++i) {
-        SyncTaskRunnable *syncTask = new SyncTaskRunnable(func, arg, &atomicCount);
-        taskList << syncTask;
+void QAspectJobManager::waitForPerThreadFunction(JobFunction func, void *arg)
+{
+    QWorkStealingExecutor *executor = this->executor();
+    const int threadCount = executor->threadCount();
+
+    m_syncBatches.push_back(std::make_unique<SyncJobBatch>(threadCount));
+    SyncJobBatch *batch = m_syncBatches.back().get();
+    SyncJobBarrier *barrier = &batch->barrier;
+    barrier->pendingCount = threadCount;
+    barrier->runningCount = threadCount;
+
+    std::vector<QExecutorTask *> taskList;
+    taskList.reserve(threadCount);
+    for (SyncJobTask &task : batch->tasks) {
+        task.m_func = func;
+        task.m_arg = arg;
+        task.m_barrier = barrier;
+        taskList.push_back(&task);
     }
 
-    QFuture<void> future = m_threadPooler->mapDependables(taskList);
-    future.waitForFinished();
+    // Only wait for our own tasks, waiting on the executor would also wait
+    // for and reset the count of the frame jobs currently in flight
+    executor->submit(taskList.data(), taskList.size());
+
+    const QMutexLocker lock(&barrier->mutex);
+    while (barrier->runningCount > 0)
+        barrier->condition.wait(&barrier->mutex);
 }
 
 
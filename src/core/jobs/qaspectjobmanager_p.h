@@ -54,15 +54,24 @@
 #include <Qt3DCore/qaspectjob.h>
 
 #include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
+#include <Qt3DCore/private/qaspectjobgraph_p.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
 
+#include <QtCore/QHash>
+
+#include <memory>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
 
-class QThreadPooler;
-class DependencyHandler;
+class QWorkStealingExecutor;
+class AspectJobTask;
+struct SyncJobBatch;
+class QExecutorTask;
 class QAspectManager;
+class QSystemInformationService;
 
 class Q_3DCORE_PRIVATE_EXPORT QAspectJobManager : public QAbstractAspectJobManager
 {
@@ -80,9 +89,33 @@ public:
     void waitForPerThreadFunction(JobFunction func, void *arg) override;
     static int idealThreadCount();
 
+    QAspectJobGraph::Statistics jobGraphStatistics() const;
+
 private:
-    QThreadPooler *m_threadPooler;
+    QWorkStealingExecutor *executor();
+    void reserveTasks(size_t count);
+    void enqueueCompiledJobs(const std::vector<QAspectJobPtr> &jobQueue,
+                             QSystemInformationService *systemService);
+    void enqueueAdditionalJobs(const std::vector<QAspectJobPtr> &jobQueue,
+                               QSystemInformationService *systemService);
+
+    std::unique_ptr<QWorkStealingExecutor> m_executor;
     QAspectManager *m_aspectManager;
+
+    // Tasks are recycled across frames, only the ones in
+    // [0, m_usedTaskCount) are in flight for the current frame. The first
+    // m_jobGraph.nodeCount() tasks are wired after the compiled job graph
+    // and keep their wiring for as long as the graph is reused.
+    QAspectJobGraph m_jobGraph;
+    std::vector<std::unique_ptr<AspectJobTask>> m_tasks;
+    size_t m_usedTaskCount;
+    std::vector<QExecutorTask *> m_submittedTasks;
+    QHash<QAspectJob *, AspectJobTask *> m_tasksMap;
+
+    // One batch per waitForPerThreadFunction() call, released by the next
+    // waitForAllJobs() since a worker may still be returning from a task
+    // after the caller has been released
+    std::vector<std::unique_ptr<SyncJobBatch>> m_syncBatches;
 };
 
 } // namespace Qt3DCore
@@ -0,0 +1,275 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qworkstealingexecutor_p.h"
+
+#include <QtCore/QThread>
+
+#include <deque>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace {
+
+// Number of times an idle worker polls the queues before going to sleep
+const int IdleSpinCount = 64;
+
+} // anonymous
+
+QExecutorTask::~QExecutorTask()
+{
+}
+
+// Each worker owns a queue. The owner pushes and pops at the back so that
+// released dependers run hot in cache, idle workers steal from the front.
+// The lock is only ever contended when a thief and the owner meet.
+struct alignas(64) QWorkStealingExecutor::WorkQueue
+{
+    QMutex mutex;
+    std::deque<QExecutorTask *> tasks;
+};
+
+class QWorkStealingExecutor::WorkerThread : public QThread
+{
+public:
+    WorkerThread(QWorkStealingExecutor *executor, int index)
+        : m_executor(executor)
+        , m_index(index)
+    {
+        setObjectName(QStringLiteral("Qt3D Worker %1").arg(index));
+    }
+
+    static thread_local WorkerThread *current;
+
+    QWorkStealingExecutor *m_executor;
+    int m_index;
+
+protected:
+    void run() override
+    {
+        current = this;
+        m_executor->workerLoop(m_index);
+        current = nullptr;
+    }
+};
+
+thread_local QWorkStealingExecutor::WorkerThread *QWorkStealingExecutor::WorkerThread::current = nullptr;
+
+QWorkStealingExecutor::QWorkStealingExecutor(int threadCount)
+    : m_queuedTasks(0)
+    , m_sleepingWorkers(0)
+    , m_outstandingTasks(0)
+    , m_executedTasks(0)
+    , m_nextQueue(0)
+    , m_quit(false)
+{
+    threadCount = qMax(1, threadCount);
+    m_queues.reserve(threadCount);
+    m_workers.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i)
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    for (int i = 0; i < threadCount; ++i) {
+        m_workers.push_back(std::make_unique<WorkerThread>(this, i));
+        m_workers.back()->start();
+    }
+}
+
+QWorkStealingExecutor::~QWorkStealingExecutor()
+{
+    waitForAll();
+    {
+        const QMutexLocker lock(&m_sleepMutex);
+        m_quit = true;
+        m_wakeCondition.wakeAll();
+    }
+    for (const auto &worker : m_workers)
+        worker->wait();
+}
+
+int QWorkStealingExecutor::threadCount() const
+{
+    return int(m_workers.size());
+}
+
+// Submits a batch of tasks whose dependencies are all contained in the batch.
+// Tasks without dependencies are scheduled right away, the others are released
+// by the last of their dependencies to complete. The tasks must outlive the
+// next call to waitForAll().
+void QWorkStealingExecutor::submit(QExecutorTask *const *tasks, size_t count)
+{
+    if (count == 0)
+        return;
+
+    m_outstandingTasks.fetch_add(int(count));
+
+    // All counters have to be armed before the first task can complete,
+    // pushing to a queue publishes them to the workers
+    for (size_t i = 0; i < count; ++i)
+        tasks[i]->m_pendingDependencies.store(tasks[i]->m_dependencyCount, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (tasks[i]->m_dependencyCount == 0)
+            schedule(tasks[i]);
+    }
+}
+
+// Blocks until all submitted tasks have completed and returns the number of
+// tasks that were actually run since the previous call
+int QWorkStealingExecutor::waitForAll()
+{
+    {
+        QMutexLocker lock(&m_doneMutex);
+        while (m_outstandingTasks.load() > 0)
+            m_doneCondition.wait(&m_doneMutex);
+    }
+    return m_executedTasks.exchange(0);
+}
+
+void QWorkStealingExecutor::schedule(QExecutorTask *task)
+{
+    // Tasks released from a worker go to that worker's own queue, tasks
+    // submitted from the outside are spread over all queues
+    const WorkerThread *worker = WorkerThread::current;
+    const size_t queueIndex = (worker != nullptr && worker->m_executor == this)
+            ? size_t(worker->m_index)
+            : size_t(m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size());
+
+    // Counted before being pushed so that m_queuedTasks never underflows and
+    // a worker about to sleep is guaranteed to either see the task or be woken
+    m_queuedTasks.fetch_add(1);
+    {
+        WorkQueue *queue = m_queues[queueIndex].get();
+        const QMutexLocker lock(&queue->mutex);
+        queue->tasks.push_back(task);
+    }
+
+    if (m_sleepingWorkers.load() > 0) {
+        const QMutexLocker lock(&m_sleepMutex);
+        m_wakeCondition.wakeOne();
+    }
+}
+
+QExecutorTask *QWorkStealingExecutor::take(int workerIndex)
+{
+    QExecutorTask *task = nullptr;
+
+    {
+        WorkQueue *own = m_queues[workerIndex].get();
+        const QMutexLocker lock(&own->mutex);
+        if (!own->tasks.empty()) {
+            task = own->tasks.back();
+            own->tasks.pop_back();
+        }
+    }
+
+    const int queueCount = int(m_queues.size());
+    for (int i = 1; task == nullptr && i < queueCount; ++i) {
+        WorkQueue *victim = m_queues[(workerIndex + i) % queueCount].get();
+        // Don't wait on a busy victim, another one is likely to have work
+        if (!victim->mutex.tryLock())
+            continue;
+        if (!victim->tasks.empty()) {
+            task = victim->tasks.front();
+            victim->tasks.pop_front();
+        }
+        victim->mutex.unlock();
+    }
+
+    if (task != nullptr)
+        m_queuedTasks.fetch_sub(1);
+    return task;
+}
+
+void QWorkStealingExecutor::execute(QExecutorTask *task)
+{
+    if (task->isRequired()) {
+        task->run();
+        if (task->isCounted())
+            m_executedTasks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Release dependers without taking any lock, the last dependency to
+    // complete schedules the depender on the current worker
+    for (QExecutorTask *depender : task->m_dependers) {
+        if (depender->m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            schedule(depender);
+    }
+
+    if (m_outstandingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        const QMutexLocker lock(&m_doneMutex);
+        m_doneCondition.wakeAll();
+    }
+}
+
+void QWorkStealingExecutor::workerLoop(int workerIndex)
+{
+    int idleSpins = 0;
+    while (true) {
+        QExecutorTask *task = take(workerIndex);
+        if (task != nullptr) {
+            execute(task);
+            idleSpins = 0;
+            continue;
+        }
+
+        // A task may just be in the process of being pushed, or another worker
+        // may be about to release dependers. Poll a bit before sleeping.
+        if (m_queuedTasks.load() > 0 || ++idleSpins < IdleSpinCount) {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+        idleSpins = 0;
+
+        QMutexLocker lock(&m_sleepMutex);
+        if (m_quit)
+            return;
+        m_sleepingWorkers.fetch_add(1);
+        if (m_queuedTasks.load() == 0)
+            m_wakeCondition.wait(&m_sleepMutex);
+        m_sleepingWorkers.fetch_sub(1);
+        if (m_quit)
+            return;
+    }
+}
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_QWORKSTEALINGEXECUTOR_P_H
+#define QT3DCORE_QWORKSTEALINGEXECUTOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+class QWorkStealingExecutor;
+
+class Q_3DCORE_PRIVATE_EXPORT QExecutorTask
+{
+public:
+    virtual ~QExecutorTask();
+
+    virtual bool isRequired() const { return true; }
+    // Whether running the task is reported by QWorkStealingExecutor::waitForAll()
+    virtual bool isCounted() const { return true; }
+    virtual void run() = 0;
+
+    // Tasks to release once this task completes and the number of tasks
+    // that have to complete before this task can be scheduled. Both are
+    // expected to be set up before the task is submitted.
+    std::vector<QExecutorTask *> m_dependers;
+    int m_dependencyCount = 0;
+
+private:
+    friend class QWorkStealingExecutor;
+    std::atomic<int> m_pendingDependencies { 0 };
+};
+
+class Q_3DCORE_PRIVATE_EXPORT QWorkStealingExecutor
+{
+    Q_DISABLE_COPY(QWorkStealingExecutor)
+public:
+    explicit QWorkStealingExecutor(int threadCount);
+    ~QWorkStealingExecutor();
+
+    int threadCount() const;
+
+    void submit(QExecutorTask *const *tasks, size_t count);
+    int waitForAll();
+
+private:
+    class WorkerThread;
+    struct WorkQueue;
+
+    void schedule(QExecutorTask *task);
+    QExecutorTask *take(int workerIndex);
+    void execute(QExecutorTask *task);
+    void workerLoop(int workerIndex);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::unique_ptr<WorkerThread>> m_workers;
+
+    std::atomic<int> m_queuedTasks;
+    std::atomic<int> m_sleepingWorkers;
+    std::atomic<int> m_outstandingTasks;
+    std::atomic<int> m_executedTasks;
+    std::atomic<uint> m_nextQueue;
+    bool m_quit;
+
+    QMutex m_sleepMutex;
+    QWaitCondition m_wakeCondition;
+    QMutex m_doneMutex;
+    QWaitCondition m_doneCondition;
+};
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_QWORKSTEALINGEXECUTOR_P_H
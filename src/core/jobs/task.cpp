@@ -88,42 +88,36 @@ void AspectTaskRunnable::run()
         m_pooler->taskFinished(this);
 }
 
-// Synchronized task
+// Aspect job task
 
-SyncTaskRunnable::SyncTaskRunnable(QAbstractAspectJobManager::JobFunction func,
-                                   void *arg, QAtomicInt *atomicCount)
-    : m_func(func)
-    , m_arg(arg)
-    , m_atomicCount(atomicCount)
-    , m_pooler(nullptr)
-    , m_reserved(false)
-    , m_id(0)
+bool AspectJobTask::isRequired() const
 {
+    return m_job ? QAspectJobPrivate::get(m_job.data())->isRequired() : false;
 }
 
-SyncTaskRunnable::~SyncTaskRunnable()
+void AspectJobTask::run()
 {
+    QAspectJobPrivate *jobD = QAspectJobPrivate::get(m_job.data());
+    QTaskLogger logger(m_service, jobD->m_jobId, QTaskLogger::AspectJob);
+    m_job->run();
 }
 
-bool SyncTaskRunnable::isRequired() const
-{
-    return true;
-}
+// Synchronized job task
 
-void SyncTaskRunnable::run()
+void SyncJobTask::run()
 {
-    // Call the function
     m_func(m_arg);
 
-    // Decrement the atomic counter to let others know we've done our bit
-    m_atomicCount->deref();
-
-    // Wait for the other worker threads to be done
-    while (m_atomicCount->loadRelaxed() > 0)
-        QThread::currentThread()->yieldCurrentThread();
+    // Hold this worker until every other worker has run the function, which
+    // guarantees each of them is called exactly once
+    const QMutexLocker lock(&m_barrier->mutex);
+    if (--m_barrier->pendingCount == 0)
+        m_barrier->condition.wakeAll();
+    while (m_barrier->pendingCount > 0)
+        m_barrier->condition.wait(&m_barrier->mutex);
 
-    if (m_pooler)
-        m_pooler->taskFinished(this);
+    if (--m_barrier->runningCount == 0)
+        m_barrier->condition.wakeAll();
 }
 
 } // namespace Qt3DCore {
@@ -51,12 +51,18 @@
 // We mean it.
 //
 
+#include <QtCore/QMutex>
 #include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThread>
 #include <QtCore/QtGlobal>
+#include <QtCore/QWaitCondition>
 
 #include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qworkstealingexecutor_p.h>
+
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -122,35 +128,49 @@ private:
     bool m_reserved;
 };
 
-class SyncTaskRunnable : public RunnableInterface
+// Tasks run by the QWorkStealingExecutor. Unlike the runnables above they are
+// owned by the QAspectJobManager and recycled from one frame to the next.
+
+class AspectJobTask : public QExecutorTask
 {
 public:
-    explicit SyncTaskRunnable(QAbstractAspectJobManager::JobFunction func, void *arg,
-                              QAtomicInt *atomicCount);
-    ~SyncTaskRunnable();
-
     bool isRequired() const override;
     void run() override;
 
-    void setPooler(QThreadPooler *pooler) override { m_pooler = pooler; }
-
-    void setReserved(bool reserved) override { m_reserved = reserved; }
-    bool reserved() override { return m_reserved; }
+    QSharedPointer<QAspectJob> m_job;
+    QSystemInformationService *m_service = nullptr;
+};
 
-    int id() override { return m_id; }
-    void setId(int id) override { m_id = id; }
+// Where the SyncJobTasks of a QAspectJobManager::waitForPerThreadFunction()
+// call wait for each other, and the caller for all of them
+struct SyncJobBarrier
+{
+    QMutex mutex;
+    QWaitCondition condition;
+    int pendingCount = 0; // Workers yet to run the function
+    int runningCount = 0; // Workers yet to leave the barrier
+};
 
-    RunnableType type() const override { return RunnableType::SyncTask; }
+class SyncJobTask : public QExecutorTask
+{
+public:
+    bool isCounted() const override { return false; }
+    void run() override;
 
-private:
-    QAbstractAspectJobManager::JobFunction m_func;
-    void *m_arg;
-    QAtomicInt *m_atomicCount;
+    QAbstractAspectJobManager::JobFunction m_func = nullptr;
+    void *m_arg = nullptr;
+    SyncJobBarrier *m_barrier = nullptr;
+};
 
-    QThreadPooler *m_pooler;
-    bool m_reserved;
+// The tasks and the barrier of one waitForPerThreadFunction() call. The
+// executor still accesses a task once it has run, so the batch is only
+// released once the executor is known to be idle.
+struct SyncJobBatch
+{
+    explicit SyncJobBatch(int threadCount) : tasks(size_t(threadCount)) { }
 
-    int m_id;
+    SyncJobBarrier barrier;
+    std::vector<SyncJobTask> tasks;
 };
 
 } // namespace Qt3DCore
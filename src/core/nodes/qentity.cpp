@@ -154,6 +154,7 @@ void QEntityPrivate::removeDestroyedComponent(QComponent *comp)
     updateComponentRelationShip(comp, ComponentRelationshipChange::Removed);
     m_components.removeOne(comp);
     m_dirty = true;
+    markDirty(QScene::BoundingVolumeDirty);
 
     // Remove bookkeeping connection
     unregisterDestructionHelper(comp);
@@ -228,6 +229,7 @@ void QEntity::addComponent(QComponent *comp)
 
     d->m_components.append(comp);
     d->m_dirty = true;
+    d->markDirty(QScene::BoundingVolumeDirty);
 
     // Ensures proper bookkeeping
     d->registerPrivateDestructionHelper(comp, &QEntityPrivate::removeDestroyedComponent);
@@ -251,6 +253,7 @@ void QEntity::removeComponent(QComponent *comp)
 
     d->m_components.removeOne(comp);
     d->m_dirty = true;
+    d->markDirty(QScene::BoundingVolumeDirty);
 
     // Remove bookkeeping connection
     d->unregisterDestructionHelper(comp);
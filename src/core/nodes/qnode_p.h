@@ -101,6 +101,7 @@ public:
     QScene *m_scene;
     mutable QNodeId m_id;
     QNodeId m_parentId; // Store this so we have it even in parent's QObject dtor
+    int m_dirtyFrontEndNodeIndex; // Position in the arbiter's dirty node list, see QChangeArbiter
     bool m_blockNotifications;
     bool m_hasBackendNode;
     bool m_enabled;
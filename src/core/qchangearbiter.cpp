@@ -48,6 +48,7 @@
 
 #include <Qt3DCore/private/corelogging_p.h>
 #include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
+#include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/private/qscene_p.h>
 #include <Qt3DCore/private/vector_helper_p.h>
 
@@ -57,6 +58,18 @@ QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
 
+namespace {
+
+// Nodes remember where they sit in the dirty node list so that marking a node
+// dirty is O(1). The index is only trusted if the list agrees with it, as the
+// list can be taken or cleared without the nodes being told.
+bool isDirtyFrontEndNode(const QList<QNode *> &dirtyNodes, QNode *node, int index)
+{
+    return index >= 0 && index < dirtyNodes.size() && dirtyNodes.at(index) == node;
+}
+
+} // anonymous
+
 QChangeArbiter::QChangeArbiter(QObject *parent)
     : QObject(parent)
     , m_scene(nullptr)
@@ -79,8 +92,10 @@ QScene *QChangeArbiter::scene() const
 
 void QChangeArbiter::addDirtyFrontEndNode(QNode *node)
 {
-    if (!m_dirtyFrontEndNodes.contains(node)) {
-        m_dirtyFrontEndNodes += node;
+    QNodePrivate *d = QNodePrivate::get(node);
+    if (!isDirtyFrontEndNode(m_dirtyFrontEndNodes, node, d->m_dirtyFrontEndNodeIndex)) {
+        d->m_dirtyFrontEndNodeIndex = int(m_dirtyFrontEndNodes.size());
+        m_dirtyFrontEndNodes.push_back(node);
         emit receivedChange();
     }
 }
@@ -94,7 +109,13 @@ void QChangeArbiter::addDirtyEntityComponentNodes(QEntity *entity, QComponent *c
 
 void QChangeArbiter::removeDirtyFrontEndNode(QNode *node)
 {
-    m_dirtyFrontEndNodes.removeOne(node);
+    // Leave a hole rather than shifting the entries behind it, holes are
+    // dropped when the list is taken
+    QNodePrivate *d = QNodePrivate::get(node);
+    if (isDirtyFrontEndNode(m_dirtyFrontEndNodes, node, d->m_dirtyFrontEndNodeIndex)) {
+        m_dirtyFrontEndNodes[d->m_dirtyFrontEndNodeIndex] = nullptr;
+        d->m_dirtyFrontEndNodeIndex = -1;
+    }
     m_dirtyEntityComponentNodeChanges.erase(std::remove_if(m_dirtyEntityComponentNodeChanges.begin(), m_dirtyEntityComponentNodeChanges.end(), [node](const ComponentRelationshipChange &elt) {
                                     return elt.node == node || elt.subNode == node;
                                 }), m_dirtyEntityComponentNodeChanges.end());
@@ -102,7 +123,9 @@ void QChangeArbiter::removeDirtyFrontEndNode(QNode *node)
 
 QList<QNode *> QChangeArbiter::takeDirtyFrontEndNodes()
 {
-    return Qt3DCore::moveAndClear(m_dirtyFrontEndNodes);
+    QList<QNode *> dirtyNodes = Qt3DCore::moveAndClear(m_dirtyFrontEndNodes);
+    dirtyNodes.removeAll(nullptr);
+    return dirtyNodes;
 }
 
 QList<ComponentRelationshipChange> QChangeArbiter::takeDirtyEntityComponentNodes()
@@ -40,8 +40,10 @@
 #include "qscene_p.h"
 
 #include <Qt3DCore/qnode.h>
+#include <Qt3DCore/qboundingvolume.h>
 #include <QtCore/QHash>
 #include <QtCore/QReadLocker>
+#include <QtCore/QSet>
 
 #include <Qt3DCore/private/qnode_p.h>
 
@@ -69,6 +71,10 @@ public:
     mutable QReadWriteLock m_nodePropertyTrackModeLock;
     QNode *m_rootNode;
     QScene::DirtyNodeSet m_dirtyBits;
+
+    // Providers are stored as QNode * so that nodes going away can be looked
+    // up without casting partially destroyed objects
+    QSet<QNode *> m_boundingVolumeProviders;
 };
 
 
@@ -108,6 +114,7 @@ void QScene::removeObservable(QNode *observable)
         const QNodeId nodeUuid = observable->id();
         d->m_nodeLookupTable.remove(nodeUuid);
         observable->d_func()->setArbiter(nullptr);
+        d->m_boundingVolumeProviders.remove(observable);
     }
 }
 
@@ -205,6 +212,32 @@ void QScene::markDirty(QScene::DirtyNodeSet changes)
     d->m_dirtyBits |= changes;
 }
 
+// Called by main thread
+void QScene::addBoundingVolumeProvider(QBoundingVolume *provider)
+{
+    Q_D(QScene);
+    d->m_boundingVolumeProviders.insert(provider);
+    d->m_dirtyBits |= BoundingVolumeDirty;
+}
+
+// Called by main thread
+void QScene::removeBoundingVolumeProvider(QBoundingVolume *provider)
+{
+    Q_D(QScene);
+    d->m_boundingVolumeProviders.remove(provider);
+}
+
+// Called by the bounding volume job, while the frontend is not being modified
+QList<QBoundingVolume *> QScene::boundingVolumeProviders() const
+{
+    Q_D(const QScene);
+    QList<QBoundingVolume *> providers;
+    providers.reserve(d->m_boundingVolumeProviders.size());
+    for (QNode *provider : qAsConst(d->m_boundingVolumeProviders))
+        providers.push_back(static_cast<QBoundingVolume *>(provider));
+    return providers;
+}
+
 void QScene::setRootNode(QNode *root)
 {
     Q_D(QScene);
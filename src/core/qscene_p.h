@@ -66,6 +66,7 @@ class QScenePrivate;
 class QAspectEngine;
 class NodePostConstructorInit;
 class QChangeArbiter;
+class QBoundingVolume;
 
 class Q_3DCORE_PRIVATE_EXPORT QScene : public QAbstractFrontEndNodeManager
 {
@@ -76,6 +77,7 @@ public:
         GeometryDirty       = 1 << 1,
         EntityEnabledDirty  = 1 << 2,
         BuffersDirty        = 1 << 3,
+        BoundingVolumeDirty = 1 << 4,
         AllDirty            = 0xffffff
     };
     Q_DECLARE_FLAGS(DirtyNodeSet, DirtyNodeFlag)
@@ -108,6 +110,11 @@ public:
     DirtyNodeSet dirtyBits();
     void clearDirtyBits();
 
+    // Bounding volume providers
+    void addBoundingVolumeProvider(QBoundingVolume *provider);
+    void removeBoundingVolumeProvider(QBoundingVolume *provider);
+    QList<QBoundingVolume *> boundingVolumeProviders() const;
+
 private:
     Q_DECLARE_PRIVATE(QScene)
     QScopedPointer<QScenePrivate> d_ptr;
@@ -54,6 +54,7 @@
 #include <QtCore/QDebug>
 #include <QtCore/qhashfunctions.h>
 #include <private/qglobal_p.h>
+#include <atomic>
 
 QT_BEGIN_NAMESPACE
 
@@ -64,10 +65,16 @@ class QHandle
 {
 public:
     struct Data {
-        union {
-            quintptr counter;
-            Data *nextFree;
-        };
+        // Allocation counter while the slot is in use, next free slot once it
+        // has been released. Counters keep their lowest bit set so that they
+        // never match a pointer. Handles are validated against it without
+        // holding the manager lock, while the allocator, serialized by the
+        // manager write lock, may be releasing or reusing the slot. Hence a
+        // single atomic word rather than a union of the two.
+        std::atomic<quintptr> counter;
+
+        Data *nextFree() const { return reinterpret_cast<Data *>(counter.load(std::memory_order_relaxed)); }
+        void setNextFree(Data *next) { counter.store(reinterpret_cast<quintptr>(next), std::memory_order_release); }
     };
     QHandle()
         : d(nullptr),
@@ -75,7 +82,12 @@ public:
     {}
     QHandle(Data *d)
         : d(d),
-          counter(d->counter)
+          counter(d->counter.load(std::memory_order_acquire))
+    {
+    }
+    QHandle(Data *d, quintptr counter)
+        : d(d),
+          counter(counter)
     {
     }
     QHandle(const QHandle &other)
@@ -97,6 +109,7 @@ public:
     bool isNull() const { return !d; }
 
     Data *data_ptr() const { return d; }
+    quintptr counter_value() const { return counter; }
 
     bool operator==(const QHandle &other) const { return d == other.d && counter == other.counter; }
     bool operator!=(const QHandle &other) const { return !operator==(other); }
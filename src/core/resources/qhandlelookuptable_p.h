@@ -0,0 +1,385 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_QHANDLELOOKUPTABLE_P_H
+#define QT3DCORE_QHANDLELOOKUPTABLE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QHash>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qglobal.h>
+#include <QtCore/QThread>
+#include <Qt3DCore/private/qhandle_p.h>
+
+#if defined(Q_PROCESSOR_X86)
+#include <immintrin.h>
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+template <typename KeyType>
+struct QHandleLookupTableTraits
+{
+    static constexpr bool isLockFree = std::is_trivially_copyable<KeyType>::value
+            && std::is_default_constructible<KeyType>::value;
+};
+
+// Maps keys to handles. Lookups (value() and contains()) can be performed
+// from any thread without taking a lock, concurrently with a writer.
+// Writers (insert(), take(), clear()) must be serialized by the caller.
+//
+// The table uses open addressing with linear probing and backward shift
+// deletion, so there are no tombstones. All slot reads are validated
+// against a sequence counter that writers bump around every modification,
+// readers simply retry if a write overlapped with their lookup. When the
+// table grows, the previous slot arrays are kept alive until destruction
+// since a reader might still be probing them; they are bounded by the
+// size of the current array.
+template <typename KeyType, typename Handle,
+          bool LockFree = QHandleLookupTableTraits<KeyType>::isLockFree>
+class QHandleLookupTable
+{
+public:
+    static constexpr bool isLockFree = true;
+
+    QHandleLookupTable()
+    {
+        m_table.store(new Table(InitialBits), std::memory_order_relaxed);
+    }
+
+    ~QHandleLookupTable()
+    {
+        delete m_table.load(std::memory_order_relaxed);
+    }
+
+    Handle value(const KeyType &key) const
+    {
+        int spins = 0;
+        while (true) {
+            const quint32 version = m_version.load(std::memory_order_acquire);
+            if (version & 1) {
+                backOff(spins);
+                continue;
+            }
+
+            const Table *table = m_table.load(std::memory_order_acquire);
+            Handle handle;
+            size_t i = table->bucket(key);
+            for (size_t probes = 0; probes <= table->mask; ++probes, i = (i + 1) & table->mask) {
+                const Slot &slot = table->slots[i];
+                typename Handle::Data *d = slot.d.load(std::memory_order_relaxed);
+                if (!d)
+                    break;
+                if (slot.loadKey() == key) {
+                    handle = Handle(d, slot.counter.load(std::memory_order_relaxed));
+                    break;
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_version.load(std::memory_order_relaxed) == version)
+                return handle;
+            backOff(spins);
+        }
+    }
+
+    bool contains(const KeyType &key) const
+    {
+        return !value(key).isNull();
+    }
+
+    // Writer side
+
+    void insert(const KeyType &key, const Handle &handle)
+    {
+        Q_ASSERT(!handle.isNull());
+        Table *table = m_table.load(std::memory_order_relaxed);
+        size_t i = table->find(key);
+        if (table->slots[i].d.load(std::memory_order_relaxed) == nullptr
+                && (m_size + 1) * 4 > (table->mask + 1) * 3) {
+            grow();
+            table = m_table.load(std::memory_order_relaxed);
+            i = table->find(key);
+        }
+
+        Slot &slot = table->slots[i];
+        const bool isNew = slot.d.load(std::memory_order_relaxed) == nullptr;
+        const quint32 version = beginWrite();
+        if (isNew)
+            slot.storeKey(key);
+        slot.counter.store(handle.counter_value(), std::memory_order_relaxed);
+        slot.d.store(handle.data_ptr(), std::memory_order_relaxed);
+        endWrite(version);
+        if (isNew)
+            ++m_size;
+    }
+
+    Handle take(const KeyType &key)
+    {
+        Table *table = m_table.load(std::memory_order_relaxed);
+        size_t hole = table->find(key);
+        Slot *slot = &table->slots[hole];
+        typename Handle::Data *d = slot->d.load(std::memory_order_relaxed);
+        if (!d)
+            return Handle();
+        const Handle handle(d, slot->counter.load(std::memory_order_relaxed));
+
+        const quint32 version = beginWrite();
+        // Shift back the entries of the cluster that would no longer be
+        // reachable from their home bucket once the hole is emptied
+        for (size_t i = (hole + 1) & table->mask;; i = (i + 1) & table->mask) {
+            Slot &candidate = table->slots[i];
+            typename Handle::Data *candidateD = candidate.d.load(std::memory_order_relaxed);
+            if (!candidateD)
+                break;
+            const size_t home = table->bucket(candidate.loadKey());
+            if (((i - home) & table->mask) < ((i - hole) & table->mask))
+                continue;
+            Slot &target = table->slots[hole];
+            target.copyKey(candidate);
+            target.counter.store(candidate.counter.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            target.d.store(candidateD, std::memory_order_relaxed);
+            hole = i;
+        }
+        table->slots[hole].d.store(nullptr, std::memory_order_relaxed);
+        endWrite(version);
+        --m_size;
+        return handle;
+    }
+
+    void clear()
+    {
+        Table *table = m_table.load(std::memory_order_relaxed);
+        const quint32 version = beginWrite();
+        for (size_t i = 0; i <= table->mask; ++i)
+            table->slots[i].d.store(nullptr, std::memory_order_relaxed);
+        endWrite(version);
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+
+    // Must not run concurrently with a writer
+    template <typename F>
+    void forEach(F &&f) const
+    {
+        const Table *table = m_table.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= table->mask; ++i) {
+            const Slot &slot = table->slots[i];
+            typename Handle::Data *d = slot.d.load(std::memory_order_relaxed);
+            if (d)
+                f(slot.loadKey(), Handle(d, slot.counter.load(std::memory_order_relaxed)));
+        }
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QHandleLookupTable)
+
+    enum { InitialBits = 4, SpinCount = 16 };
+
+    // Waits for a concurrent write to complete: pause the CPU for a few
+    // rounds first, then give up the time slice so that a preempted writer
+    // gets a chance to finish
+    static void backOff(int &spins)
+    {
+        if (spins < SpinCount) {
+            ++spins;
+#if defined(Q_PROCESSOR_X86)
+            _mm_pause();
+#endif
+        } else {
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    struct Slot
+    {
+        // The key is stored as machine words so that it can be read
+        // atomically (though possibly torn) by concurrent readers
+        static constexpr size_t KeyWords = (sizeof(KeyType) + sizeof(quintptr) - 1) / sizeof(quintptr);
+
+        std::atomic<quintptr> key[KeyWords];
+        std::atomic<quintptr> counter;
+        std::atomic<typename Handle::Data *> d;
+
+        KeyType loadKey() const
+        {
+            quintptr words[KeyWords];
+            for (size_t i = 0; i < KeyWords; ++i)
+                words[i] = key[i].load(std::memory_order_relaxed);
+            KeyType k;
+            std::memcpy(&k, words, sizeof(KeyType));
+            return k;
+        }
+
+        void storeKey(const KeyType &k)
+        {
+            quintptr words[KeyWords] = {};
+            std::memcpy(words, &k, sizeof(KeyType));
+            for (size_t i = 0; i < KeyWords; ++i)
+                key[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        void copyKey(const Slot &other)
+        {
+            for (size_t i = 0; i < KeyWords; ++i)
+                key[i].store(other.key[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    };
+
+    struct Table
+    {
+        explicit Table(uint bits)
+            : mask((size_t(1) << bits) - 1)
+            , shift(64 - bits)
+            , slots(new Slot[mask + 1])
+        {
+            for (size_t i = 0; i <= mask; ++i)
+                slots[i].d.store(nullptr, std::memory_order_relaxed);
+        }
+
+        size_t bucket(const KeyType &key) const
+        {
+            using QT_PREPEND_NAMESPACE(qHash);
+            // Fibonacci hashing spreads sequential ids over the whole table
+            return size_t((quint64(qHash(key, size_t(0))) * Q_UINT64_C(0x9E3779B97F4A7C15)) >> shift);
+        }
+
+        // Returns the slot holding key or the empty slot where it would go
+        size_t find(const KeyType &key) const
+        {
+            size_t i = bucket(key);
+            while (slots[i].d.load(std::memory_order_relaxed) && !(slots[i].loadKey() == key))
+                i = (i + 1) & mask;
+            return i;
+        }
+
+        const size_t mask;
+        const uint shift;
+        std::unique_ptr<Slot[]> slots;
+        std::unique_ptr<Table> retired;
+    };
+
+    quint32 beginWrite()
+    {
+        const quint32 version = m_version.load(std::memory_order_relaxed);
+        m_version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return version;
+    }
+
+    void endWrite(quint32 version)
+    {
+        m_version.store(version + 2, std::memory_order_release);
+    }
+
+    void grow()
+    {
+        Table *table = m_table.load(std::memory_order_relaxed);
+        Table *newTable = new Table(64 - table->shift + 1);
+        for (size_t i = 0; i <= table->mask; ++i) {
+            const Slot &slot = table->slots[i];
+            typename Handle::Data *d = slot.d.load(std::memory_order_relaxed);
+            if (!d)
+                continue;
+            Slot &target = newTable->slots[newTable->find(slot.loadKey())];
+            target.copyKey(slot);
+            target.counter.store(slot.counter.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            target.d.store(d, std::memory_order_relaxed);
+        }
+        // Readers may still be probing the old array
+        newTable->retired.reset(table);
+        m_table.store(newTable, std::memory_order_release);
+    }
+
+    std::atomic<Table *> m_table;
+    std::atomic<quint32> m_version = { 0 };
+    size_t m_size = 0;
+};
+
+// Fallback for keys that can't be copied word by word: a plain QHash,
+// lookups have to be serialized with writers by the caller.
+template <typename KeyType, typename Handle>
+class QHandleLookupTable<KeyType, Handle, false>
+{
+public:
+    static constexpr bool isLockFree = false;
+
+    Handle value(const KeyType &key) const { return m_hash.value(key); }
+    bool contains(const KeyType &key) const { return m_hash.contains(key); }
+    void insert(const KeyType &key, const Handle &handle) { m_hash.insert(key, handle); }
+    Handle take(const KeyType &key) { return m_hash.take(key); }
+    void clear() { m_hash.clear(); }
+    size_t size() const { return size_t(m_hash.size()); }
+
+    template <typename F>
+    void forEach(F &&f) const
+    {
+        const auto end = m_hash.cend();
+        for (auto it = m_hash.cbegin(); it != end; ++it)
+            f(it.key(), it.value());
+    }
+
+private:
+    QHash<KeyType, Handle> m_hash;
+};
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_QHANDLELOOKUPTABLE_P_H
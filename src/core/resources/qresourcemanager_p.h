@@ -59,6 +59,7 @@
 #include <limits>
 
 #include <Qt3DCore/private/qhandle_p.h>
+#include <Qt3DCore/private/qhandlelookuptable_p.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
 
 // Silence complaints about unreferenced local variables in
@@ -208,9 +209,9 @@ public:
 };
 
 template<typename T>
-inline T *QHandle<T>::operator->() const { return (d && counter == d->counter) ? &static_cast<QHandleData<T> *>(d)->data : nullptr; }
+inline T *QHandle<T>::operator->() const { return (d && counter == d->counter.load(std::memory_order_acquire)) ? &static_cast<QHandleData<T> *>(d)->data : nullptr; }
 template<typename T>
-inline T *QHandle<T>::data() const { return (d && counter == d->counter) ? &static_cast<QHandleData<T> *>(d)->data : nullptr; }
+inline T *QHandle<T>::data() const { return (d && counter == d->counter.load(std::memory_order_acquire)) ? &static_cast<QHandleData<T> *>(d)->data : nullptr; }
 
 
 class Q_3DCORE_PRIVATE_EXPORT AlignedAllocator
@@ -241,8 +242,8 @@ public:
         if (!freeList)
             allocateBucket();
         typename Handle::Data *d = freeList;
-        freeList = freeList->nextFree;
-        d->counter = allocCounter;
+        freeList = freeList->nextFree();
+        d->counter.store(allocCounter, std::memory_order_release);
         allocCounter += 2; // ensure this will never clash with a pointer in nextFree by keeping the lowest bit set
         Handle handle(d);
         m_activeHandles.push_back(handle);
@@ -253,7 +254,7 @@ public:
     {
         m_activeHandles.erase(std::remove(m_activeHandles.begin(), m_activeHandles.end(), handle), m_activeHandles.end());
         typename Handle::Data *d = handle.data_ptr();
-        d->nextFree = freeList;
+        d->setNextFree(freeList);
         freeList = d;
         performCleanup(&static_cast<QHandleData<T> *>(d)->data, std::integral_constant<bool, QResourceInfo<T>::needsCleanup>{});
     }
@@ -310,9 +311,9 @@ private:
         b->header.next = firstBucket;
         firstBucket = b;
         for (int i = 0; i < Bucket::NumEntries - 1; ++i) {
-            b->data[i].nextFree = &b->data[i + 1];
+            b->data[i].setNextFree(&b->data[i + 1]);
         }
-        b->data[Bucket::NumEntries - 1].nextFree = nullptr;
+        b->data[Bucket::NumEntries - 1].setNextFree(nullptr);
         freeList = &b->data[0];
     }
 
@@ -390,45 +391,37 @@ public:
         Allocator::releaseResource(handle);
     }
 
+    // Lookups by key don't take the lock when the key can be stored in a
+    // QHandleLookupTable, which allows jobs to resolve ids concurrently
     bool contains(const KeyType &id) const
     {
-        typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
-        return m_keyToHandleMap.contains(id);
+        return !lookupHandleImpl(id).isNull();
     }
 
     Handle getOrAcquireHandle(const KeyType &id)
     {
-        typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
-        Handle handle = m_keyToHandleMap.value(id);
+        Handle handle = lookupHandleImpl(id);
         if (handle.isNull()) {
-            lock.unlock();
             typename LockingPolicy<QResourceManager>::WriteLocker writeLock(this);
-            // Test that the handle hasn't been set (in the meantime between the read unlock and the write lock)
-            Handle &handleToSet = m_keyToHandleMap[id];
-            if (handleToSet.isNull()) {
-                handleToSet = Allocator::allocateResource();
+            // Test that the handle hasn't been set (in the meantime between the lookup and the write lock)
+            handle = m_keyToHandleMap.value(id);
+            if (handle.isNull()) {
+                handle = Allocator::allocateResource();
+                m_keyToHandleMap.insert(id, handle);
             }
-            return handleToSet;
         }
         return handle;
     }
 
     Handle lookupHandle(const KeyType &id)
     {
-        typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
-        return m_keyToHandleMap.value(id);
+        return lookupHandleImpl(id);
     }
 
     ValueType *lookupResource(const KeyType &id)
     {
-        ValueType* ret = nullptr;
-        {
-            typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
-            Handle handle = m_keyToHandleMap.value(id);
-            if (!handle.isNull())
-                ret = Allocator::data(handle);
-        }
-        return ret;
+        const Handle handle = lookupHandleImpl(id);
+        return handle.isNull() ? nullptr : Allocator::data(handle);
     }
 
     ValueType *getOrCreateResource(const KeyType &id)
@@ -459,9 +452,19 @@ public:
     }
 
 protected:
-    QHash<KeyType, Handle > m_keyToHandleMap;
+    QHandleLookupTable<KeyType, Handle> m_keyToHandleMap;
 
 private:
+    Handle lookupHandleImpl(const KeyType &id) const
+    {
+        if constexpr (QHandleLookupTable<KeyType, Handle>::isLockFree) {
+            return m_keyToHandleMap.value(id);
+        } else {
+            typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
+            return m_keyToHandleMap.value(id);
+        }
+    }
+
     friend QDebug operator<< <>(QDebug dbg, const QResourceManager<ValueType, KeyType, LockingPolicy> &manager);
 };
 
@@ -475,9 +478,9 @@ QDebug operator<<(QDebug dbg, const QResourceManager<ValueType, KeyType, Locking
     dbg << "Contains" << manager.count() << "items" << Qt::endl;
 
     dbg << "Key to Handle Map:" << Qt::endl;
-    const auto end = manager.m_keyToHandleMap.cend();
-    for (auto it = manager.m_keyToHandleMap.cbegin(); it != end; ++it)
-        dbg << "QNodeId =" << it.key() << "Handle =" << it.value() << Qt::endl;
+    manager.m_keyToHandleMap.forEach([&dbg] (const KeyType &key, const typename QResourceManager<ValueType, KeyType, LockingPolicy>::Handle &handle) {
+        dbg << "QNodeId =" << key << "Handle =" << handle << Qt::endl;
+    });
 
 //    dbg << "Resources:" << Qt::endl;
 //    dbg << manager.m_handleManager;
@@ -1,7 +1,8 @@
 HEADERS += \
     $$PWD/qloadgltf_p.h \
     $$PWD/qresourcemanager_p.h \
-    $$PWD/qhandle_p.h
+    $$PWD/qhandle_p.h \
+    $$PWD/qhandlelookuptable_p.h
 
 SOURCES += \
     $$PWD/qresourcemanager.cpp
@@ -232,6 +232,8 @@ bool GLShader::hasUniform(int nameId) const noexcept
 void GLShader::prepareUniforms(ShaderParameterPack &pack)
 {
     const PackUniformHash &values = pack.uniforms();
+    // Recomputed from the current uniforms, the capacity is kept
+    pack.clearSubmissionUniformIndices();
 
     auto it = values.keys.cbegin();
     const auto end = values.keys.cend();
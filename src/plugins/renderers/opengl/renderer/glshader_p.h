@@ -59,6 +59,7 @@
 
 #ifdef QT_BUILD_INTERNAL
     class tst_BenchShaderParameterPack;
+    class tst_ShaderParameterPack;
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -171,6 +172,7 @@ private:
     friend class GraphicsContext;
 #ifdef QT_BUILD_INTERNAL
     friend class ::tst_BenchShaderParameterPack;
+    friend class ::tst_ShaderParameterPack;
 #endif
 
     mutable QMutex m_mutex;
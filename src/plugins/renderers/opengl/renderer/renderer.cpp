@@ -1712,7 +1712,9 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const std::vector
 
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
-    Q_UNUSED(node);
+    // Only the materials depending on those need to be gathered again
+    if ((changes & AbstractRenderer::MaterialDirty) && node != nullptr)
+        m_dirtyMaterialNodes.push_back(node->peerId());
     m_dirtyBits.marked |= changes;
 }
 
@@ -1842,8 +1844,19 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     const bool lightsDirty = dirtyBitsForFrame & AbstractRenderer::LightsDirty;
     const bool computeableDirty = dirtyBitsForFrame & AbstractRenderer::ComputeDirty;
     const bool renderableDirty = dirtyBitsForFrame & AbstractRenderer::GeometryDirty;
-    const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || frameGraphDirty;
+    // Technique compatibility is only evaluated once the renderer is ready
+    const bool techniquesDirty = (dirtyBitsForFrame & AbstractRenderer::TechniquesDirty)
+            && isRunning() && m_submissionContext->isInitialized();
+    // Filters and Techniques decide which passes every material uses
+    const bool materialCacheNeedsFullRebuild = frameGraphDirty || techniquesDirty;
+    const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || materialCacheNeedsFullRebuild;
     const bool renderCommandsDirty = materialCacheNeedsToBeRebuilt || renderableDirty || computeableDirty;
+    // Values the uniforms of cached commands are computed from
+    const bool commandUniformsDirty = dirtyBitsForFrame & (AbstractRenderer::ParameterDirty |
+                                                           AbstractRenderer::BuffersDirty |
+                                                           AbstractRenderer::TexturesDirty |
+                                                           AbstractRenderer::ShadersDirty |
+                                                           AbstractRenderer::LightsDirty);
 
     if (renderableDirty)
         renderBinJobs.push_back(m_renderableEntityFilterJob);
@@ -1871,6 +1884,11 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
             if (!Qt3DCore::contains(m_frameGraphLeaves, leafNode))
                 m_cache.leafNodeCache.remove(leafNode);
         }
+        const QList<FrameGraphNode *> builderLeaves = m_renderViewBuilders.keys();
+        for (FrameGraphNode *leafNode : builderLeaves) {
+            if (!Qt3DCore::contains(m_frameGraphLeaves, leafNode))
+                m_renderViewBuilders.remove(leafNode);
+        }
 
         // Handle single shot subtree enablers
         const auto subtreeEnablers = visitor.takeEnablersToDisable();
@@ -1878,6 +1896,14 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
             m_updatedDisableSubtreeEnablers.push_back(node->peerId());
     }
 
+    // Materials depending on these nodes are gathered again. RenderViews are
+    // always built here, so MaterialDirty and these nodes are consumed
+    // together, as the RHI renderer does when it builds its RenderViews.
+    std::vector<Qt3DCore::QNodeId> dirtyMaterialNodes = Qt3DCore::moveAndClear(m_dirtyMaterialNodes);
+    std::sort(dirtyMaterialNodes.begin(), dirtyMaterialNodes.end());
+    dirtyMaterialNodes.erase(std::unique(dirtyMaterialNodes.begin(), dirtyMaterialNodes.end()),
+                             dirtyMaterialNodes.end());
+
     int idealThreadCount = QAspectJobManager::idealThreadCount();
 
     const size_t fgBranchCount = m_frameGraphLeaves.size();
@@ -1893,15 +1919,21 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
 
     for (size_t i = 0; i < fgBranchCount; ++i) {
         FrameGraphNode *leaf = m_frameGraphLeaves[i];
-        RenderViewBuilder builder(leaf, int(i), this);
+        QSharedPointer<RenderViewBuilder> &builderPtr = m_renderViewBuilders[leaf];
+        if (!builderPtr || builderPtr->renderViewIndex() != int(i))
+            builderPtr.reset(new RenderViewBuilder(leaf, int(i), this));
+        RenderViewBuilder &builder = *builderPtr;
         builder.setOptimalJobCount(leaf->nodeType() == FrameGraphNode::NoDraw ? 1 : idealThreadCount);
 
         // If we have a new RV (wasn't in the cache before, then it contains no cached data)
         const bool isNewRV = !m_cache.leafNodeCache.contains(leaf);
         builder.setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
         builder.setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt || isNewRV);
+        builder.setMaterialGathererCacheNeedsFullRebuild(materialCacheNeedsFullRebuild || isNewRV);
+        builder.setDirtyMaterialNodes(dirtyMaterialNodes);
         builder.setRenderCommandCacheNeedsToBeRebuilt(renderCommandsDirty || isNewRV);
         builder.setLightCacheNeedsToBeRebuilt(lightsDirty);
+        builder.setRenderCommandUniformsNeedUpdate(commandUniformsDirty);
 
         // Insert leaf into cache
         if (isNewRV) {
@@ -2132,10 +2164,10 @@ bool Renderer::executeCommandsSubmission(RenderView *rv)
 
             {
                 Profiling::GLTimeRecorder recorder(Profiling::StateUpdate, activeProfiler());
-                // Merge the RenderCommand state with the globalState of the RenderView
-                // Or restore the globalState if no stateSet for the RenderCommand
+                // The RenderCommand state was merged with the globalState of the
+                // RenderView when built and is shared with other commands.
+                // Restore the globalState if no stateSet for the RenderCommand
                 if (localState != nullptr) {
-                    command.m_stateSet->merge(globalState);
                     m_submissionContext->setCurrentStateSet(localState);
                 } else {
                     m_submissionContext->setCurrentStateSet(globalState);
@@ -162,6 +162,7 @@ class RenderCommand;
 class GLShader;
 class GLResourceManagers;
 class RenderView;
+class RenderViewBuilder;
 
 class Q_AUTOTEST_EXPORT Renderer : public AbstractRenderer
 {
@@ -341,6 +342,8 @@ private:
         BackendNodeDirtySet remaining; // remaining dirty after jobs have finished
     };
     DirtyBits m_dirtyBits;
+    // Nodes marked MaterialDirty since last job build
+    std::vector<Qt3DCore::QNodeId> m_dirtyMaterialNodes;
 
     QAtomicInt m_lastFrameCorrect;
     QOpenGLContext *m_glContext;
@@ -416,6 +419,8 @@ private:
     RenderDriver m_driver = RenderDriver::Qt3D;
 
     std::vector<FrameGraphNode *> m_frameGraphLeaves;
+    // Builders are kept per leaf so that their jobs are reused across frames
+    QHash<FrameGraphNode *, QSharedPointer<RenderViewBuilder>> m_renderViewBuilders;
     QScreen *m_screen = nullptr;
     QSharedPointer<ResourceAccessor> m_scene2DResourceAccessor;
 
@@ -72,6 +72,7 @@
 #include <Qt3DRender/private/clearbuffers_p.h>
 #include <Qt3DRender/private/rendertargetselectornode_p.h>
 #include <Qt3DRender/private/sortpolicy_p.h>
+#include <Qt3DRender/private/radixsort_p.h>
 #include <Qt3DRender/private/techniquefilternode_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/shaderdata_p.h>
@@ -93,6 +94,7 @@
 #include <glresourcemanagers_p.h>
 #include <Qt3DCore/qentity.h>
 #include <QtGui/qsurface.h>
+#include <QtCore/qvarlengtharray.h>
 #include <algorithm>
 #include <atomic>
 #include <gllights_p.h>
@@ -166,43 +168,85 @@ static Matrix4x4 getProjectionMatrix(const CameraLens *lens)
     return lens ? lens->projection() : Matrix4x4();
 }
 
+int RenderView::standardUniformDependencies(RenderView::StandardUniform standardUniformType)
+{
+    switch (standardUniformType) {
+    case ModelMatrix:
+    case InverseModelMatrix:
+    case ModelNormalMatrix:
+        return DependsOnEntity;
+    case ModelViewMatrix:
+    case ModelViewProjectionMatrix:
+    case InverseModelViewMatrix:
+    case InverseModelViewProjectionMatrix:
+    case ModelViewNormalMatrix:
+        return DependsOnEntity | DependsOnCamera;
+    case SkinningPalette:
+        return DependsOnEntity | DependsOnFrame;
+    case Time:
+        return DependsOnFrame;
+    default:
+        return DependsOnCamera;
+    }
+}
+
 UniformValue RenderView::standardUniformValue(RenderView::StandardUniform standardUniformType,
                                               const Entity *entity) const
 {
+    if (!(standardUniformDependencies(standardUniformType) & DependsOnEntity))
+        return m_viewUniformValues[standardUniformType];
+
     const Matrix4x4 &model = *(entity->worldTransform());
 
     switch (standardUniformType) {
     case ModelMatrix:
         return UniformValue(model);
-    case ViewMatrix:
-        return UniformValue(m_viewMatrix);
-    case ProjectionMatrix:
-        return UniformValue(getProjectionMatrix(m_renderCameraLens));
     case ModelViewMatrix:
         return UniformValue(m_viewMatrix * model);
-    case ViewProjectionMatrix:
-        return UniformValue(getProjectionMatrix(m_renderCameraLens) * m_viewMatrix);
     case ModelViewProjectionMatrix:
         return UniformValue(m_viewProjectionMatrix * model);
     case InverseModelMatrix:
         return UniformValue(model.inverted());
+    case InverseModelViewMatrix:
+        return UniformValue((m_viewMatrix * model).inverted());
+    case InverseModelViewProjectionMatrix:
+        return UniformValue((m_viewProjectionMatrix * model).inverted());
+    case ModelNormalMatrix:
+        return UniformValue(convertToQMatrix4x4(model).normalMatrix());
+    case ModelViewNormalMatrix:
+        return UniformValue(convertToQMatrix4x4(m_viewMatrix * model).normalMatrix());
+    case SkinningPalette: {
+        const Armature *armature = entity->renderComponent<Armature>();
+        if (!armature) {
+            qCWarning(Jobs, "Requesting skinningPalette uniform but no armature set on entity");
+            return UniformValue();
+        }
+        return armature->skinningPaletteUniform();
+    }
+    default:
+        Q_UNREACHABLE();
+        return UniformValue();
+    }
+}
+
+UniformValue RenderView::viewUniformValue(RenderView::StandardUniform standardUniformType) const
+{
+    switch (standardUniformType) {
+    case ViewMatrix:
+        return UniformValue(m_viewMatrix);
+    case ProjectionMatrix:
+        return UniformValue(getProjectionMatrix(m_renderCameraLens));
+    case ViewProjectionMatrix:
+        return UniformValue(getProjectionMatrix(m_renderCameraLens) * m_viewMatrix);
     case InverseViewMatrix:
         return UniformValue(m_viewMatrix.inverted());
     case InverseProjectionMatrix: {
         return UniformValue(getProjectionMatrix(m_renderCameraLens).inverted());
     }
-    case InverseModelViewMatrix:
-        return UniformValue((m_viewMatrix * model).inverted());
     case InverseViewProjectionMatrix: {
         const Matrix4x4 viewProjectionMatrix = getProjectionMatrix(m_renderCameraLens) * m_viewMatrix;
         return UniformValue(viewProjectionMatrix.inverted());
     }
-    case InverseModelViewProjectionMatrix:
-        return UniformValue((m_viewProjectionMatrix * model).inverted());
-    case ModelNormalMatrix:
-        return UniformValue(convertToQMatrix4x4(model).normalMatrix());
-    case ModelViewNormalMatrix:
-        return UniformValue(convertToQMatrix4x4(m_viewMatrix * model).normalMatrix());
     case ViewportMatrix: {
         QMatrix4x4 viewportMatrix;
         // TO DO: Implement on Matrix4x4
@@ -225,14 +269,6 @@ UniformValue RenderView::standardUniformValue(RenderView::StandardUniform standa
         return UniformValue(float(m_renderer->time() / 1000000000.0f));
     case EyePosition:
         return UniformValue(m_eyePos);
-    case SkinningPalette: {
-        const Armature *armature = entity->renderComponent<Armature>();
-        if (!armature) {
-            qCWarning(Jobs, "Requesting skinningPalette uniform but no armature set on entity");
-            return UniformValue();
-        }
-        return armature->skinningPaletteUniform();
-    }
     case YUpInNDC:
         return UniformValue(0.0f);
     case YUpInFBO:
@@ -772,7 +808,13 @@ void RenderView::sort()
     assert(m_renderCommandDataView);
     // Compares the bitsetKey of the RenderCommands
     // Key[Depth | StateCost | Shader]
-    sortCommandRange(m_renderCommandDataView.data(), 0, int(m_renderCommandDataView->size()), 0, m_sortingTypes);
+    std::vector<quint64> sortKeys;
+    const auto shaderOf = [] (const RenderCommand &command) -> const GLShader * { return command.m_glShader; };
+    if (buildRadixSortKeys(m_renderCommandDataView->data.commands, m_renderCommandDataView->indices,
+                           m_sortingTypes, shaderOf, sortKeys))
+        radixSort(sortKeys, m_renderCommandDataView->indices);
+    else
+        sortCommandRange(m_renderCommandDataView.data(), 0, int(m_renderCommandDataView->size()), 0, m_sortingTypes);
 
     // For RenderCommand with the same shader
     // We compute the adjacent change cost
@@ -787,6 +829,9 @@ void RenderView::sort()
     const std::vector<size_t> &indices = m_renderCommandDataView->indices;
     const size_t commandSize = indices.size();
 
+    // Reused by all the shader groups so that its storage only grows
+    PackUniformHash cachedUniforms;
+
     while (i < commandSize) {
         size_t j = i;
 
@@ -796,7 +841,7 @@ void RenderView::sort()
             ++i;
 
         if (i - j > 0) { // Several commands have the same shader, so we minimize uniform changes
-            PackUniformHash cachedUniforms = commands[indices[j++]].m_parameterPack.uniforms();
+            cachedUniforms = commands[indices[j++]].m_parameterPack.uniforms();
 
             while (j < i) {
                 // We need the reference here as we are modifying the original container
@@ -812,15 +857,18 @@ void RenderView::sort()
                     // where two uniforms, referencing the same texture eventually have 2 different
                     // texture unit values
                     const int uniformNameId = uniforms.keys.at(u);
-                    const UniformValue &refValue = cachedUniforms.value(uniformNameId);
+                    const int refIdx = cachedUniforms.indexForKey(uniformNameId);
                     const UniformValue &newValue = uniforms.values.at(u);
-                    if (newValue == refValue) {
+                    if (refIdx != -1 && newValue == cachedUniforms.values[refIdx]) {
                         uniforms.erase(int(u));
                     } else {
                         // Record updated value so that subsequent comparison
                         // for the next command will be made againts latest
                         // uniform value
-                        cachedUniforms.insert(uniformNameId, newValue);
+                        if (refIdx != -1)
+                            cachedUniforms.values[refIdx] = newValue;
+                        else
+                            cachedUniforms.insert(uniformNameId, newValue);
                         ++u;
                     }
                 }
@@ -918,11 +966,10 @@ EntityRenderCommandData RenderView::buildDrawRenderCommands(const Entity **entit
                 // StateSet in the FrameGraph
                 RenderPass *pass = passData.pass;
                 if (pass->hasRenderStates()) {
-                    command.m_stateSet = RenderStateSetPtr::create();
-                    addStatesToRenderStateSet(command.m_stateSet.data(), pass->renderStates(), m_manager->renderStateManager());
-                    if (m_stateSet)
-                        command.m_stateSet->merge(m_stateSet.data());
-                    command.m_changeCost = m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
+                    const auto it = m_renderPassStateSets.constFind(pass->peerId());
+                    Q_ASSERT(it != m_renderPassStateSets.cend());
+                    command.m_stateSet = it->stateSet;
+                    command.m_changeCost = it->changeCost;
                 }
                 command.m_shaderId = pass->shaderProgram();
 
@@ -1046,14 +1093,10 @@ EntityRenderCommandData RenderView::buildComputeRenderCommands(const Entity **en
                 RenderPass *pass = passData.pass;
 
                 if (pass->hasRenderStates()) {
-                    command.m_stateSet = RenderStateSetPtr::create();
-                    addStatesToRenderStateSet(command.m_stateSet.data(), pass->renderStates(), m_manager->renderStateManager());
-
-                    // Merge per pass stateset with global stateset
-                    // so that the local stateset only overrides
-                    if (m_stateSet != nullptr)
-                        command.m_stateSet->merge(m_stateSet.data());
-                    command.m_changeCost = m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
+                    const auto it = m_renderPassStateSets.constFind(pass->peerId());
+                    Q_ASSERT(it != m_renderPassStateSets.cend());
+                    command.m_stateSet = it->stateSet;
+                    command.m_changeCost = it->changeCost;
                 }
                 command.m_shaderId = pass->shaderProgram();
                 command.m_glShader = glShaderManager->lookupResource(command.m_shaderId);
@@ -1081,18 +1124,31 @@ EntityRenderCommandData RenderView::buildComputeRenderCommands(const Entity **en
 
 void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subView)
 {
-    subView.forEach([this] (const Entity *entity,
-                            const RenderPassParameterData &passData,
-                            RenderCommand &command) {
+    // Uniform minimization removes from the packs the values a command shares
+    // with the previous one, so they have to be set again every frame
+    const bool alwaysFullUpdate = m_sortingTypes.contains(QSortPolicy::Uniform);
+
+    subView.forEachUpdate([this, alwaysFullUpdate] (const Entity *entity,
+                                                    const RenderPassParameterData &passData,
+                                                    RenderCommand &command,
+                                                    RenderCommandUpdate update) {
+        // Commands only become valid once updated with a loaded shader
+        if (alwaysFullUpdate ||
+                command.m_type == RenderCommand::Compute ||
+                !command.m_isValid)
+            update = RenderCommandUpdate::Full;
+
         if (command.m_type == RenderCommand::Draw) {
-            // Project the camera-to-object-center vector onto the camera
-            // view vector. This gives a depth value suitable as the key
-            // for BackToFront sorting.
-            command.m_depth = Vector3D::dotProduct(entity->worldBoundingVolume()->center() - m_eyePos, m_eyeViewDir);
-
-            auto geometryRenderer = m_manager->geometryRendererManager()->data(command.m_geometryRenderer);
-            if (geometryRenderer && !qFuzzyCompare(geometryRenderer->sortIndex(), -1.f))
-                command.m_depth = geometryRenderer->sortIndex();
+            if (update != RenderCommandUpdate::Frame) {
+                // Project the camera-to-object-center vector onto the camera
+                // view vector. This gives a depth value suitable as the key
+                // for BackToFront sorting.
+                command.m_depth = Vector3D::dotProduct(entity->worldBoundingVolume()->center() - m_eyePos, m_eyeViewDir);
+
+                auto geometryRenderer = m_manager->geometryRendererManager()->data(command.m_geometryRenderer);
+                if (geometryRenderer && !qFuzzyCompare(geometryRenderer->sortIndex(), -1.f))
+                    command.m_depth = geometryRenderer->sortIndex();
+            }
         } else { // Compute
             // Note: if frameCount has reached 0 in the previous frame, isEnabled
             // would be false
@@ -1101,11 +1157,21 @@ void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subVi
                 computeJob->updateFrameCount();
         }
 
-        // setShaderAndUniforms can initialize a localData
-        // make sure this is cleared before we leave this function
-        setShaderAndUniforms(&command,
-                             passData.parameterInfo,
-                             entity);
+        switch (update) {
+        case RenderCommandUpdate::Full:
+            // setShaderAndUniforms can initialize a localData
+            // make sure this is cleared before we leave this function
+            setShaderAndUniforms(&command,
+                                 passData.parameterInfo,
+                                 entity);
+            break;
+        case RenderCommandUpdate::Camera:
+            updateStandardUniforms(&command, entity, DependsOnCamera | DependsOnFrame);
+            break;
+        case RenderCommandUpdate::Frame:
+            updateStandardUniforms(&command, entity, DependsOnFrame);
+            break;
+        }
     });
 }
 
@@ -1130,6 +1196,15 @@ void RenderView::updateMatrices()
     }
 }
 
+void RenderView::updateViewUniforms()
+{
+    for (int i = 0; i <= YUpInFBO; ++i) {
+        const StandardUniform standardUniformType = StandardUniform(i);
+        if (!(standardUniformDependencies(standardUniformType) & DependsOnEntity))
+            m_viewUniformValues[i] = viewUniformValue(standardUniformType);
+    }
+}
+
 void RenderView::setUniformValue(ShaderParameterPack &uniformPack, int nameId, const UniformValue &value) const
 {
     // At this point a uniform value can only be a scalar type
@@ -1354,6 +1429,27 @@ void RenderView::setShaderAndUniforms(RenderCommand *command,
         shader->prepareUniforms(command->m_parameterPack);
 }
 
+// Only refreshes the standard uniforms that have one of the dependencies,
+// the other values of the pack are left as they were last set
+void RenderView::updateStandardUniforms(RenderCommand *command,
+                                        const Entity *entity,
+                                        int dependencies) const
+{
+    GLShader *shader = command->m_glShader;
+    if (shader == nullptr || !shader->isLoaded() || !shader->hasActiveVariables())
+        return;
+
+    const size_t previousUniformCount = command->m_parameterPack.uniforms().size();
+    const std::vector<int> &standardUniformNamesIds = shader->standardUniformNameIds();
+    for (const int uniformNameId : standardUniformNamesIds) {
+        if (standardUniformDependencies(ms_standardUniformSetters.value(uniformNameId)) & dependencies)
+            setStandardUniformValue(command->m_parameterPack, uniformNameId, entity);
+    }
+
+    if (previousUniformCount != command->m_parameterPack.uniforms().size())
+        shader->prepareUniforms(command->m_parameterPack);
+}
+
 void RenderView::updateLightUniforms(RenderCommand *command, const Entity *entity) const
 {
     GLShader *shader = command->m_glShader;
@@ -1362,24 +1458,25 @@ void RenderView::updateLightUniforms(RenderCommand *command, const Entity *entit
         // Pick which lights to take in to account.
         // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
         // Replace with more sophisticated mechanisms later.
-        // Copy vector so that we can sort it concurrently and we only want to sort the one for the current command
-        std::vector<LightSource> lightSources = m_lightSources;
-
-        if (lightSources.size() > 1) {
-            const Vector3D entityCenter = entity->worldBoundingVolume()->center();
-            std::sort(lightSources.begin(), lightSources.end(),
-                      [&] (const LightSource &a, const LightSource &b) {
-                const float distA = entityCenter.distanceToPoint(a.entity->worldBoundingVolume()->center());
-                const float distB = entityCenter.distanceToPoint(b.entity->worldBoundingVolume()->center());
-                return distA < distB;
-            });
-            m_lightSources = {lightSources.begin(), lightSources.begin() + std::min(lightSources.size(), size_t(MAX_LIGHTS)) };
+        // Sort pointers to the light sources so that commands can be updated
+        // concurrently, they stay on the stack for usual light counts
+        QVarLengthArray<std::pair<float, const LightSource *>, 16> lightSources;
+        lightSources.reserve(qsizetype(m_lightSources.size()));
+        const Vector3D entityCenter = entity->worldBoundingVolume()->center();
+        for (const LightSource &lightSource : m_lightSources) {
+            const float distance = entityCenter.distanceToPoint(lightSource.entity->worldBoundingVolume()->center());
+            lightSources.push_back({ distance, &lightSource });
         }
+        std::sort(lightSources.begin(), lightSources.end(),
+                  [] (const std::pair<float, const LightSource *> &a, const std::pair<float, const LightSource *> &b) {
+            return a.first < b.first;
+        });
 
         int lightIdx = 0;
-        for (const LightSource &lightSource : m_lightSources) {
+        for (const auto &sortedLightSource : qAsConst(lightSources)) {
             if (lightIdx == MAX_LIGHTS)
                 break;
+            const LightSource &lightSource = *sortedLightSource.second;
             const Entity *lightEntity = lightSource.entity;
             const Matrix4x4 lightWorldTransform = *(lightEntity->worldTransform());
             const Vector3D worldPos = lightWorldTransform * Vector3D(0.0f, 0.0f, 0.0f);
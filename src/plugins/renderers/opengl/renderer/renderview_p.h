@@ -204,6 +204,7 @@ public:
     void setShowDebugOverlay(bool showDebugOverlay) noexcept { m_showDebugOverlay = showDebugOverlay; }
 
     inline void setMaterialParameterTable(const MaterialParameterGathererData &parameters) noexcept { m_parameters = parameters; }
+    inline void setRenderPassStateSets(const RenderPassStateSets &stateSets) noexcept { m_renderPassStateSets = stateSets; }
 
     // TODO: Get rid of this overly complex memory management by splitting out the
     // InnerData as a RenderViewConfig struct. This can be created by setRenderViewConfigFromFrameGraphLeafNode
@@ -250,6 +251,7 @@ public:
     void setEnvironmentLight(EnvironmentLight *environmentLight) noexcept { m_environmentLight = environmentLight; }
 
     void updateMatrices();
+    void updateViewUniforms();
 
     inline void setRenderCaptureNodeId(const Qt3DCore::QNodeId nodeId) noexcept { m_renderCaptureNodeId = nodeId; }
     inline const Qt3DCore::QNodeId renderCaptureNodeId() const noexcept { return m_renderCaptureNodeId; }
@@ -296,6 +298,10 @@ private:
     void updateLightUniforms(RenderCommand *command,
                              const Entity *entity) const;
 
+    void updateStandardUniforms(RenderCommand *command,
+                                const Entity *entity,
+                                int dependencies) const;
+
     Renderer *m_renderer = nullptr;
     NodeManagers *m_manager = nullptr;
     EntityRenderCommandDataViewPtr m_renderCommandDataView;
@@ -343,7 +349,8 @@ private:
     Vector3D m_eyeViewDir;
 
     MaterialParameterGathererData m_parameters;
-    mutable std::vector<LightSource> m_lightSources;
+    RenderPassStateSets m_renderPassStateSets;
+    std::vector<LightSource> m_lightSources;
     EnvironmentLight *m_environmentLight = nullptr;
 
     enum StandardUniform
@@ -374,12 +381,26 @@ private:
         YUpInFBO,
     };
 
+    // What the value of a standard uniform is computed from
+    enum StandardUniformDependency
+    {
+        DependsOnEntity = 1 << 0,
+        DependsOnCamera = 1 << 1,
+        DependsOnFrame = 1 << 2
+    };
+
     typedef QHash<int, StandardUniform> StandardUniformsNameToTypeHash;
     static StandardUniformsNameToTypeHash ms_standardUniformSetters;
     static StandardUniformsNameToTypeHash initializeStandardUniformSetters();
+    static int standardUniformDependencies(StandardUniform standardUniformType);
+
+    // Values of the standard uniforms that don't depend on the entity,
+    // computed once by updateViewUniforms
+    UniformValue m_viewUniformValues[YUpInFBO + 1];
 
     UniformValue standardUniformValue(StandardUniform standardUniformType,
                                       const Entity *entity) const;
+    UniformValue viewUniformValue(StandardUniform standardUniformType) const;
 
     void setUniformValue(ShaderParameterPack &uniformPack, int nameId, const UniformValue &value) const;
     void setStandardUniformValue(ShaderParameterPack &uniformPack,
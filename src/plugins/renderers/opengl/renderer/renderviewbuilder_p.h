@@ -78,6 +78,8 @@ class Renderer;
 using SynchronizerJobPtr = GenericLambdaJobPtr<std::function<void()>>;
 #define CreateSynchronizerJobPtr(lambda, type, instance) \
     SynchronizerJobPtr::create(lambda, type, #type, instance)
+#define UpdateSynchronizerJobPtr(job, lambda, type, instance) \
+    (job ? job->setCallable(lambda) : void(job = CreateSynchronizerJobPtr(lambda, type, instance)))
 
 using RenderViewCommandBuilderJobPtr = Render::RenderViewCommandBuilderJobPtr<RenderView, RenderCommand>;
 using RenderViewCommandUpdaterJobPtr = Render::RenderViewCommandUpdaterJobPtr<RenderView, RenderCommand>;
@@ -114,10 +116,15 @@ public:
     bool layerCacheNeedsToBeRebuilt() const;
     void setMaterialGathererCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool materialGathererCacheNeedsToBeRebuilt() const;
+    void setMaterialGathererCacheNeedsFullRebuild(bool needsFullRebuild);
+    bool materialGathererCacheNeedsFullRebuild() const;
+    void setDirtyMaterialNodes(const std::vector<Qt3DCore::QNodeId> &dirtyNodes);
     void setRenderCommandCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool renderCommandCacheNeedsToBeRebuilt() const;
     void setLightCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool lightCacheNeedsToBeRebuilt() const;
+    void setRenderCommandUniformsNeedUpdate(bool needsUpdate);
+    bool renderCommandUniformsNeedUpdate() const;
 
     int optimalJobCount() const;
     void setOptimalJobCount(int v);
@@ -127,6 +134,7 @@ private:
     const int m_renderViewIndex;
     Renderer *m_renderer;
     RebuildFlagSet m_rebuildFlags;
+    std::vector<Qt3DCore::QNodeId> m_dirtyMaterialNodes;
 
     RenderViewInitializerJobPtr m_renderViewJob;
     FilterLayerEntityJobPtr m_filterEntityByLayerJob;
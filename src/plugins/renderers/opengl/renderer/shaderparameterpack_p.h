@@ -189,6 +189,7 @@ public:
     void setUniformBuffer(BlockToUBO blockToUBO);
     void setShaderStorageBuffer(BlockToSSBO blockToSSBO);
     void setSubmissionUniformIndex(const int shaderUniformIndex);
+    inline void clearSubmissionUniformIndices() noexcept { m_submissionUniformIndices.clear(); }
 
     inline PackUniformHash &uniforms() { return m_uniforms; }
     inline const PackUniformHash &uniforms() const { return m_uniforms; }
@@ -1016,10 +1016,10 @@ void Renderer::buildGraphicsPipelines(RHIGraphicsPipeline *graphicsPipeline,
         RenderStateSet *globalState =
                 (rv->stateSet() != nullptr) ? rv->stateSet() : m_defaultRenderStateSet;
 
-        // Merge global state into local state
+        // The local state already includes the global state, it was merged
+        // in when the shared state set of the RenderPass was built
         RenderStateSet *localState = cmd.m_stateSet.data();
         if (localState != nullptr) {
-            localState->merge(globalState);
             renderState = localState;
         } else {
             renderState = globalState;
@@ -2160,7 +2160,9 @@ Renderer::submitRenderViews(const std::vector<RHIPassInfo> &rhiPassesInfo)
 
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
-    Q_UNUSED(node);
+    // Only the materials depending on those need to be gathered again
+    if ((changes & AbstractRenderer::MaterialDirty) && node != nullptr)
+        m_dirtyMaterialNodes.push_back(node->peerId());
     m_dirtyBits.marked |= changes;
 }
 
@@ -2280,9 +2282,20 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     const bool lightsDirty = dirtyBitsForFrame & AbstractRenderer::LightsDirty;
     const bool computeableDirty = dirtyBitsForFrame & AbstractRenderer::ComputeDirty;
     const bool renderableDirty = dirtyBitsForFrame & AbstractRenderer::GeometryDirty;
-    const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || frameGraphDirty;
+    // Technique compatibility is only evaluated once the renderer is ready
+    const bool techniquesDirty = (dirtyBitsForFrame & AbstractRenderer::TechniquesDirty)
+            && isRunning() && m_submissionContext->isInitialized();
+    // Filters and Techniques decide which passes every material uses
+    const bool materialCacheNeedsFullRebuild = frameGraphDirty || techniquesDirty;
+    const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || materialCacheNeedsFullRebuild;
     const bool renderCommandsDirty =
             materialCacheNeedsToBeRebuilt || renderableDirty || computeableDirty;
+    // Values the uniforms of cached commands are computed from
+    const bool commandUniformsDirty = dirtyBitsForFrame & (AbstractRenderer::ParameterDirty |
+                                                           AbstractRenderer::BuffersDirty |
+                                                           AbstractRenderer::TexturesDirty |
+                                                           AbstractRenderer::ShadersDirty |
+                                                           AbstractRenderer::LightsDirty);
 
     // Rebuild Entity Layers list if layers are dirty
 
@@ -2313,6 +2326,13 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
                               leafNode) == m_frameGraphLeaves.end())
                     m_cache.leafNodeCache.remove(leafNode);
             }
+            const QList<FrameGraphNode *> builderLeaves = m_renderViewBuilders.keys();
+            for (FrameGraphNode *leafNode : builderLeaves) {
+                if (std::find(m_frameGraphLeaves.begin(),
+                              m_frameGraphLeaves.end(),
+                              leafNode) == m_frameGraphLeaves.end())
+                    m_renderViewBuilders.remove(leafNode);
+            }
 
             // Handle single shot subtree enablers
             const auto subtreeEnablers = visitor.takeEnablersToDisable();
@@ -2320,6 +2340,12 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
                 m_updatedDisableSubtreeEnablers.push_back(node->peerId());
         }
 
+        // Materials depending on these nodes are gathered again
+        std::vector<Qt3DCore::QNodeId> dirtyMaterialNodes = Qt3DCore::moveAndClear(m_dirtyMaterialNodes);
+        std::sort(dirtyMaterialNodes.begin(), dirtyMaterialNodes.end());
+        dirtyMaterialNodes.erase(std::unique(dirtyMaterialNodes.begin(), dirtyMaterialNodes.end()),
+                                 dirtyMaterialNodes.end());
+
         int idealThreadCount = QAspectJobManager::idealThreadCount();
 
         const size_t fgBranchCount = m_frameGraphLeaves.size();
@@ -2335,7 +2361,10 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
 
         for (size_t i = 0; i < fgBranchCount; ++i) {
             FrameGraphNode *leaf = m_frameGraphLeaves.at(i);
-            RenderViewBuilder builder(leaf, int(i), this);
+            QSharedPointer<RenderViewBuilder> &builderPtr = m_renderViewBuilders[leaf];
+            if (!builderPtr || builderPtr->renderViewIndex() != int(i))
+                builderPtr.reset(new RenderViewBuilder(leaf, int(i), this));
+            RenderViewBuilder &builder = *builderPtr;
             builder.setOptimalJobCount(leaf->nodeType() == FrameGraphNode::NoDraw ? 1 : idealThreadCount);
 
             // If we have a new RV (wasn't in the cache before, then it contains no cached data)
@@ -2343,8 +2372,11 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
             builder.setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
             builder.setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt
                                                              || isNewRV);
+            builder.setMaterialGathererCacheNeedsFullRebuild(materialCacheNeedsFullRebuild || isNewRV);
+            builder.setDirtyMaterialNodes(dirtyMaterialNodes);
             builder.setRenderCommandCacheNeedsToBeRebuilt(renderCommandsDirty || isNewRV);
             builder.setLightCacheNeedsToBeRebuilt(lightsDirty);
+            builder.setRenderCommandUniformsNeedUpdate(commandUniformsDirty);
 
             // Insert leaf into cache
             if (isNewRV) {
@@ -2363,6 +2395,13 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
         notCleared |= AbstractRenderer::EntityEnabledDirty;
         notCleared |= AbstractRenderer::FrameGraphDirty;
         notCleared |= AbstractRenderer::LayersDirty;
+        // So are the MaterialParameterGathererJobs, m_dirtyMaterialNodes is kept until then
+        notCleared |= AbstractRenderer::MaterialDirty;
+        // Cached commands only get their uniforms updated once RenderViews are built again
+        notCleared |= AbstractRenderer::ParameterDirty;
+        notCleared |= AbstractRenderer::BuffersDirty;
+        notCleared |= AbstractRenderer::TexturesDirty;
+        notCleared |= AbstractRenderer::LightsDirty;
     }
 
     if (isRunning() && m_submissionContext->isInitialized()) {
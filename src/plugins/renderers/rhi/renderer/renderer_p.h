@@ -157,6 +157,7 @@ struct RHIRenderTarget;
 class RHIShader;
 class RHIResourceManagers;
 class RenderView;
+class RenderViewBuilder;
 class RHIGraphicsPipeline;
 class RHIComputePipeline;
 class PipelineUBOSet;
@@ -343,6 +344,8 @@ private:
         BackendNodeDirtySet remaining; // remaining dirty after jobs have finished
     };
     DirtyBits m_dirtyBits;
+    // Nodes marked MaterialDirty since last job build
+    std::vector<Qt3DCore::QNodeId> m_dirtyMaterialNodes;
 
     QAtomicInt m_lastFrameCorrect;
     QOpenGLContext *m_glContext;
@@ -400,6 +403,8 @@ private:
     bool m_shouldSwapBuffers;
 
     std::vector<FrameGraphNode *> m_frameGraphLeaves;
+    // Builders are kept per leaf so that their jobs are reused across frames
+    QHash<FrameGraphNode *, QSharedPointer<RenderViewBuilder>> m_renderViewBuilders;
     QScreen *m_screen = nullptr;
     QSharedPointer<ResourceAccessor> m_scene2DResourceAccessor;
     QHash<RenderView *, std::vector<RHIGraphicsPipeline *>> m_rvToGraphicsPipelines;
@@ -71,6 +71,7 @@
 #include <Qt3DRender/private/clearbuffers_p.h>
 #include <Qt3DRender/private/rendertargetselectornode_p.h>
 #include <Qt3DRender/private/sortpolicy_p.h>
+#include <Qt3DRender/private/radixsort_p.h>
 #include <Qt3DRender/private/techniquefilternode_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/shaderdata_p.h>
@@ -95,6 +96,7 @@
 #include <QDebug>
 #if defined(QT3D_RENDER_VIEW_JOB_TIMINGS)
 #include <QElapsedTimer>
+#include <QVarLengthArray>
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -700,7 +702,13 @@ void RenderView::sort()
     assert(m_renderCommandDataView);
     // Compares the bitsetKey of the RenderCommands
     // Key[Depth | StateCost | Shader]
-    sortCommandRange(m_renderCommandDataView.data(), 0, int(m_renderCommandDataView->size()), 0, m_sortingTypes);
+    std::vector<quint64> sortKeys;
+    const auto shaderOf = [] (const RenderCommand &command) -> const RHIShader * { return command.m_rhiShader; };
+    if (buildRadixSortKeys(m_renderCommandDataView->data.commands, m_renderCommandDataView->indices,
+                           m_sortingTypes, shaderOf, sortKeys))
+        radixSort(sortKeys, m_renderCommandDataView->indices);
+    else
+        sortCommandRange(m_renderCommandDataView.data(), 0, int(m_renderCommandDataView->size()), 0, m_sortingTypes);
 
     // For RenderCommand with the same shader
     // We compute the adjacent change cost
@@ -715,6 +723,9 @@ void RenderView::sort()
     const std::vector<size_t> &indices = m_renderCommandDataView->indices;
     const size_t commandSize = indices.size();
 
+    // Reused by all the shader groups so that its storage only grows
+    PackUniformHash cachedUniforms;
+
     while (i < commandSize) {
         size_t j = i;
 
@@ -724,7 +735,7 @@ void RenderView::sort()
             ++i;
 
         if (i - j > 0) { // Several commands have the same shader, so we minimize uniform changes
-            PackUniformHash cachedUniforms = commands[indices[j++]].m_parameterPack.uniforms();
+            cachedUniforms = commands[indices[j++]].m_parameterPack.uniforms();
 
             while (j < i) {
                 // We need the reference here as we are modifying the original container
@@ -740,15 +751,18 @@ void RenderView::sort()
                     // where two uniforms, referencing the same texture eventually have 2 different
                     // texture unit values
                     const int uniformNameId = uniforms.keys.at(u);
-                    const UniformValue &refValue = cachedUniforms.value(uniformNameId);
+                    const int refIdx = cachedUniforms.indexForKey(uniformNameId);
                     const UniformValue &newValue = uniforms.values.at(u);
-                    if (newValue == refValue) {
+                    if (refIdx != -1 && newValue == cachedUniforms.values[refIdx]) {
                         uniforms.erase(int(u));
                     } else {
                         // Record updated value so that subsequent comparison
                         // for the next command will be made againts latest
                         // uniform value
-                        cachedUniforms.insert(uniformNameId, newValue);
+                        if (refIdx != -1)
+                            cachedUniforms.values[refIdx] = newValue;
+                        else
+                            cachedUniforms.insert(uniformNameId, newValue);
                         ++u;
                     }
                 }
@@ -852,13 +866,10 @@ EntityRenderCommandData RenderView::buildDrawRenderCommands(const Entity **entit
                 // StateSet in the FrameGraph
                 RenderPass *pass = passData.pass;
                 if (pass->hasRenderStates()) {
-                    command.m_stateSet = RenderStateSetPtr::create();
-                    addStatesToRenderStateSet(command.m_stateSet.data(), pass->renderStates(),
-                                              m_manager->renderStateManager());
-                    if (m_stateSet != nullptr)
-                        command.m_stateSet->merge(m_stateSet.get());
-                    command.m_changeCost =
-                            m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
+                    const auto it = m_renderPassStateSets.constFind(pass->peerId());
+                    Q_ASSERT(it != m_renderPassStateSets.cend());
+                    command.m_stateSet = it->stateSet;
+                    command.m_changeCost = it->changeCost;
                 }
                 command.m_shaderId = pass->shaderProgram();
 
@@ -1013,16 +1024,10 @@ EntityRenderCommandData RenderView::buildComputeRenderCommands(const Entity **en
                 RenderPass *pass = passData.pass;
 
                 if (pass->hasRenderStates()) {
-                    command.m_stateSet = RenderStateSetPtr::create();
-                    addStatesToRenderStateSet(command.m_stateSet.data(), pass->renderStates(),
-                                              m_manager->renderStateManager());
-
-                    // Merge per pass stateset with global stateset
-                    // so that the local stateset only overrides
-                    if (m_stateSet != nullptr)
-                        command.m_stateSet->merge(m_stateSet.get());
-                    command.m_changeCost =
-                            m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
+                    const auto it = m_renderPassStateSets.constFind(pass->peerId());
+                    Q_ASSERT(it != m_renderPassStateSets.cend());
+                    command.m_stateSet = it->stateSet;
+                    command.m_changeCost = it->changeCost;
                 }
                 command.m_shaderId = pass->shaderProgram();
 
@@ -1072,7 +1077,7 @@ void copyNormalMatrix(float(&destination)[12], const float* src) noexcept {
 }
 }
 
-void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subView)
+void RenderView::updateViewUniforms()
 {
     // Update RenderViewUBO (Qt3D standard uniforms)
     const bool yIsUp = m_renderer->submissionContext()->rhi()->isYUpInNDC();
@@ -1123,18 +1128,33 @@ void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subVi
         memcpy(&m_renderViewUBO.yUpInNDC, &yUpNDC, sizeof(float));
         memcpy(&m_renderViewUBO.yUpInFBO, &yUpFBO, sizeof(float));
     }
+}
 
-    subView.forEach([&] (const Entity *entity,
-                         const RenderPassParameterData &passData,
-                         RenderCommand &command) {
+void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subView)
+{
+    const Matrix4x4 clipCorrectionMatrix = Matrix4x4(m_renderer->submissionContext()->rhi()->clipSpaceCorrMatrix());
+    const Matrix4x4 projectionMatrix = clipCorrectionMatrix * getProjectionMatrix(m_renderCameraLens);
 
-        // Pick which lights to take in to account.
-        // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
-        // Replace with more sophisticated mechanisms later.
-        // Copy vector so that we can sort it concurrently and we only want to sort the one for the
-        // current command
-        std::vector<LightSource> lightSources;
-        EnvironmentLight *environmentLight = nullptr;
+    // Uniform minimization removes from the packs the values a command shares
+    // with the previous one, so they have to be set again every frame
+    const bool alwaysFullUpdate = Qt3DCore::contains(m_sortingTypes, QSortPolicy::Uniform);
+
+    subView.forEachUpdate([&] (const Entity *entity,
+                               const RenderPassParameterData &passData,
+                               RenderCommand &command,
+                               RenderCommandUpdate update) {
+        // Commands only become valid once updated with a loaded shader
+        if (alwaysFullUpdate ||
+                command.m_type == RenderCommand::Compute ||
+                !command.m_isValid)
+            update = RenderCommandUpdate::Full;
+
+        // Values that change every frame are all in the RenderViewUBO
+        if (update == RenderCommandUpdate::Frame)
+            return;
+
+        // Only draw commands are lit
+        bool useLights = false;
 
         if (command.m_type == RenderCommand::Draw) {
             // Project the camera-to-object-center vector onto the camera
@@ -1147,21 +1167,7 @@ void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subVi
             if (geometryRenderer && !qFuzzyCompare(geometryRenderer->sortIndex(), -1.f))
                 command.m_depth = geometryRenderer->sortIndex();
 
-            environmentLight = m_environmentLight;
-            lightSources = m_lightSources;
-
-            if (lightSources.size() > 1) {
-                const Vector3D entityCenter = entity->worldBoundingVolume()->center();
-                std::sort(lightSources.begin(), lightSources.end(),
-                          [&](const LightSource &a, const LightSource &b) {
-                              const float distA = entityCenter.distanceToPoint(
-                                      a.entity->worldBoundingVolume()->center());
-                              const float distB = entityCenter.distanceToPoint(
-                                      b.entity->worldBoundingVolume()->center());
-                              return distA < distB;
-                          });
-                m_lightSources = {lightSources.begin(), lightSources.begin() + std::min(lightSources.size(), size_t(MAX_LIGHTS)) };
-            }
+            useLights = update == RenderCommandUpdate::Full;
         } else { // Compute
             // Note: if frameCount has reached 0 in the previous frame, isEnabled
             // would be false
@@ -1171,27 +1177,31 @@ void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subVi
                 computeJob->updateFrameCount();
         }
 
-        ParameterInfoList globalParameters = passData.parameterInfo;
-        // setShaderAndUniforms can initialize a localData
-        // make sure this is cleared before we leave this function
-
-        setShaderAndUniforms(&command, globalParameters, entity, lightSources, environmentLight);
+        if (update == RenderCommandUpdate::Full) {
+            ParameterInfoList globalParameters = passData.parameterInfo;
+            // setShaderAndUniforms can initialize a localData
+            // make sure this is cleared before we leave this function
+            setShaderAndUniforms(&command, globalParameters, entity, useLights);
+        }
 
         // Update CommandUBO (Qt3D standard uniforms)
         const Matrix4x4 worldTransform = *(entity->worldTransform());
-        const Matrix4x4 inverseWorldTransform = worldTransform.inverted();
-        const QMatrix3x3 modelNormalMatrix = convertToQMatrix4x4(worldTransform).normalMatrix();
+        if (update == RenderCommandUpdate::Full) {
+            // These only depend on the entity
+            const Matrix4x4 inverseWorldTransform = worldTransform.inverted();
+            const QMatrix3x3 modelNormalMatrix = convertToQMatrix4x4(worldTransform).normalMatrix();
+            memcpy(&command.m_commandUBO.modelMatrix, &worldTransform, sizeof(Matrix4x4));
+            memcpy(&command.m_commandUBO.inverseModelMatrix, &inverseWorldTransform,
+                   sizeof(Matrix4x4));
+            copyNormalMatrix(command.m_commandUBO.modelNormalMatrix, modelNormalMatrix.constData());
+        }
         const Matrix4x4 modelViewMatrix = m_viewMatrix * worldTransform;
         const QMatrix3x3 modelViewNormalMatrix = convertToQMatrix4x4(modelViewMatrix).normalMatrix();
         const Matrix4x4 inverseModelViewMatrix = modelViewMatrix.inverted();
         const Matrix4x4 mvp = projectionMatrix * modelViewMatrix;
         const Matrix4x4 inverseModelViewProjection = mvp.inverted();
         {
-            memcpy(&command.m_commandUBO.modelMatrix, &worldTransform, sizeof(Matrix4x4));
-            memcpy(&command.m_commandUBO.inverseModelMatrix, &inverseWorldTransform,
-                   sizeof(Matrix4x4));
             memcpy(&command.m_commandUBO.modelViewMatrix, &modelViewMatrix, sizeof(Matrix4x4));
-            copyNormalMatrix(command.m_commandUBO.modelNormalMatrix, modelNormalMatrix.constData());
             memcpy(&command.m_commandUBO.inverseModelViewMatrix, &inverseModelViewMatrix,
                    sizeof(Matrix4x4));
             memcpy(&command.m_commandUBO.mvp, &mvp, sizeof(Matrix4x4));
@@ -1385,12 +1395,8 @@ void RenderView::applyParameter(const Parameter *param, RenderCommand *command,
 }
 
 void RenderView::setShaderAndUniforms(RenderCommand *command, ParameterInfoList &parameters,
-                                      const Entity *entity,
-                                      const std::vector<LightSource> &activeLightSources,
-                                      EnvironmentLight *environmentLight) const
+                                      const Entity *entity, bool useLights) const
 {
-    Q_UNUSED(entity);
-
     // The VAO Handle is set directly in the renderer thread so as to avoid having to use a mutex
     // here Set shader, technique, and effect by basically doing :
     // ShaderProgramManager[MaterialManager[frontentEntity->id()]->Effect->Techniques[TechniqueFilter->name]->RenderPasses[RenderPassFilter->name]];
@@ -1459,111 +1465,140 @@ void RenderView::setShaderAndUniforms(RenderCommand *command, ParameterInfoList
         }
 
         // Lights
-        int lightIdx = 0;
-        for (const LightSource &lightSource : activeLightSources) {
-            if (lightIdx == MAX_LIGHTS)
-                break;
-            const Entity *lightEntity = lightSource.entity;
-            const Matrix4x4 lightWorldTransform = *(lightEntity->worldTransform());
-            const Vector3D worldPos = lightWorldTransform * Vector3D(0.0f, 0.0f, 0.0f);
-            for (Light *light : lightSource.lights) {
-                if (!light->isEnabled())
-                    continue;
+        updateLightUniforms(command, entity, useLights);
+    }
+}
 
-                ShaderData *shaderData =
-                        m_manager->shaderDataManager()->lookupResource(light->shaderData());
-                if (!shaderData)
-                    continue;
+void RenderView::updateLightUniforms(RenderCommand *command, const Entity *entity, bool useLights) const
+{
+    RHIShader *shader = command->m_rhiShader;
 
-                if (lightIdx == MAX_LIGHTS)
-                    break;
-
-                // Note: implicit conversion of values to UniformValue
-                setUniformValue(command->m_parameterPack, LIGHT_POSITION_NAMES[lightIdx],
-                                worldPos);
-                setUniformValue(command->m_parameterPack, LIGHT_TYPE_NAMES[lightIdx],
-                                int(QAbstractLight::PointLight));
-                setUniformValue(command->m_parameterPack, LIGHT_COLOR_NAMES[lightIdx],
-                                Vector3D(1.0f, 1.0f, 1.0f));
-                setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_NAMES[lightIdx],
-                                0.5f);
-                // Unrolled
-                setUniformValue(command->m_parameterPack, LIGHT_POSITION_UNROLL_NAMES[lightIdx],
-                                worldPos);
-                setUniformValue(command->m_parameterPack, LIGHT_TYPE_UNROLL_NAMES[lightIdx],
-                                int(QAbstractLight::PointLight));
-                setUniformValue(command->m_parameterPack, LIGHT_COLOR_UNROLL_NAMES[lightIdx],
-                                Vector3D(1.0f, 1.0f, 1.0f));
-                setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_UNROLL_NAMES[lightIdx], 0.5f);
-
-                // There is no risk in doing that even if multithreaded
-                // since we are sure that a shaderData is unique for a given light
-                // and won't ever be referenced as a Component either
-                const Matrix4x4 *worldTransform = lightEntity->worldTransform();
-                if (worldTransform)
-                    shaderData->updateWorldTransform(*worldTransform);
-
-                setDefaultUniformBlockShaderDataValue(command->m_parameterPack, shader,
-                                                      shaderData, LIGHT_STRUCT_NAMES[lightIdx]);
-                ++lightIdx;
-            }
+    // Pick which lights to take in to account.
+    // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
+    // Replace with more sophisticated mechanisms later.
+    // Sort pointers to the light sources so that commands can be updated
+    // concurrently, they stay on the stack for usual light counts
+    QVarLengthArray<std::pair<float, const LightSource *>, 16> lightSources;
+    EnvironmentLight *environmentLight = nullptr;
+    if (useLights) {
+        environmentLight = m_environmentLight;
+        lightSources.reserve(qsizetype(m_lightSources.size()));
+        const Vector3D entityCenter = entity->worldBoundingVolume()->center();
+        for (const LightSource &lightSource : m_lightSources) {
+            const float distance = entityCenter.distanceToPoint(lightSource.entity->worldBoundingVolume()->center());
+            lightSources.push_back({ distance, &lightSource });
         }
+        std::sort(lightSources.begin(), lightSources.end(),
+                  [] (const std::pair<float, const LightSource *> &a, const std::pair<float, const LightSource *> &b) {
+            return a.first < b.first;
+        });
+    }
 
-        if (shader->hasUniform(LIGHT_COUNT_NAME_ID))
-            setUniformValue(command->m_parameterPack, LIGHT_COUNT_NAME_ID,
-                            UniformValue(qMax((environmentLight ? 0 : 1), lightIdx)));
+    int lightIdx = 0;
+    for (const auto &sortedLightSource : qAsConst(lightSources)) {
+        if (lightIdx == MAX_LIGHTS)
+            break;
+        const LightSource &lightSource = *sortedLightSource.second;
+        const Entity *lightEntity = lightSource.entity;
+        const Matrix4x4 lightWorldTransform = *(lightEntity->worldTransform());
+        const Vector3D worldPos = lightWorldTransform * Vector3D(0.0f, 0.0f, 0.0f);
+        for (Light *light : lightSource.lights) {
+            if (!light->isEnabled())
+                continue;
+
+            ShaderData *shaderData =
+                    m_manager->shaderDataManager()->lookupResource(light->shaderData());
+            if (!shaderData)
+                continue;
+
+            if (lightIdx == MAX_LIGHTS)
+                break;
 
-        // If no active light sources and no environment light, add a default light
-        if (activeLightSources.empty() && !environmentLight) {
             // Note: implicit conversion of values to UniformValue
-            setUniformValue(command->m_parameterPack, LIGHT_POSITION_NAMES[0],
-                    Vector3D(10.0f, 10.0f, 0.0f));
-            setUniformValue(command->m_parameterPack, LIGHT_TYPE_NAMES[0],
-                    int(QAbstractLight::PointLight));
-            setUniformValue(command->m_parameterPack, LIGHT_COLOR_NAMES[0],
-                    Vector3D(1.0f, 1.0f, 1.0f));
-            setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_NAMES[0], 0.5f);
+            setUniformValue(command->m_parameterPack, LIGHT_POSITION_NAMES[lightIdx],
+                            worldPos);
+            setUniformValue(command->m_parameterPack, LIGHT_TYPE_NAMES[lightIdx],
+                            int(QAbstractLight::PointLight));
+            setUniformValue(command->m_parameterPack, LIGHT_COLOR_NAMES[lightIdx],
+                            Vector3D(1.0f, 1.0f, 1.0f));
+            setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_NAMES[lightIdx],
+                            0.5f);
             // Unrolled
-            setUniformValue(command->m_parameterPack, LIGHT_POSITION_UNROLL_NAMES[0],
-                    Vector3D(10.0f, 10.0f, 0.0f));
-            setUniformValue(command->m_parameterPack, LIGHT_TYPE_UNROLL_NAMES[0],
-                    int(QAbstractLight::PointLight));
-            setUniformValue(command->m_parameterPack, LIGHT_COLOR_UNROLL_NAMES[0],
-                    Vector3D(1.0f, 1.0f, 1.0f));
-            setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_UNROLL_NAMES[0], 0.5f);
+            setUniformValue(command->m_parameterPack, LIGHT_POSITION_UNROLL_NAMES[lightIdx],
+                            worldPos);
+            setUniformValue(command->m_parameterPack, LIGHT_TYPE_UNROLL_NAMES[lightIdx],
+                            int(QAbstractLight::PointLight));
+            setUniformValue(command->m_parameterPack, LIGHT_COLOR_UNROLL_NAMES[lightIdx],
+                            Vector3D(1.0f, 1.0f, 1.0f));
+            setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_UNROLL_NAMES[lightIdx], 0.5f);
+
+            // There is no risk in doing that even if multithreaded
+            // since we are sure that a shaderData is unique for a given light
+            // and won't ever be referenced as a Component either
+            const Matrix4x4 *worldTransform = lightEntity->worldTransform();
+            if (worldTransform)
+                shaderData->updateWorldTransform(*worldTransform);
+
+            setDefaultUniformBlockShaderDataValue(command->m_parameterPack, shader,
+                                                  shaderData, LIGHT_STRUCT_NAMES[lightIdx]);
+            ++lightIdx;
         }
+    }
 
-        // Environment Light
-        int envLightCount = 0;
-        if (environmentLight && environmentLight->isEnabled()) {
-            static const int irradianceStructId =
-                    StringToInt::lookupId(QLatin1String("envLight_irradiance"));
-            static const int specularStructId =
-                    StringToInt::lookupId(QLatin1String("envLight_specular"));
-            static const int irradianceId =
-                    StringToInt::lookupId(QLatin1String("envLightIrradiance"));
-            static const int specularId =
-                    StringToInt::lookupId(QLatin1String("envLightSpecular"));
-            ShaderData *shaderData = m_manager->shaderDataManager()->lookupResource(
-                        environmentLight->shaderData());
-            if (shaderData) {
-                envLightCount = 1;
-
-                // ("specularSize", "irradiance", "irradianceSize", "specular")
-                auto irr =
-                        shaderData->properties()["irradiance"].value.value<Qt3DCore::QNodeId>();
-                auto spec =
-                        shaderData->properties()["specular"].value.value<Qt3DCore::QNodeId>();
-
-                setUniformValue(command->m_parameterPack, irradianceId, irr);
-                setUniformValue(command->m_parameterPack, irradianceStructId, irr);
-                setUniformValue(command->m_parameterPack, specularId, spec);
-                setUniformValue(command->m_parameterPack, specularStructId, spec);
-            }
+    if (shader->hasUniform(LIGHT_COUNT_NAME_ID))
+        setUniformValue(command->m_parameterPack, LIGHT_COUNT_NAME_ID,
+                        UniformValue(qMax((environmentLight ? 0 : 1), lightIdx)));
+
+    // If no active light sources and no environment light, add a default light
+    if (lightSources.empty() && !environmentLight) {
+        // Note: implicit conversion of values to UniformValue
+        setUniformValue(command->m_parameterPack, LIGHT_POSITION_NAMES[0],
+                Vector3D(10.0f, 10.0f, 0.0f));
+        setUniformValue(command->m_parameterPack, LIGHT_TYPE_NAMES[0],
+                int(QAbstractLight::PointLight));
+        setUniformValue(command->m_parameterPack, LIGHT_COLOR_NAMES[0],
+                Vector3D(1.0f, 1.0f, 1.0f));
+        setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_NAMES[0], 0.5f);
+        // Unrolled
+        setUniformValue(command->m_parameterPack, LIGHT_POSITION_UNROLL_NAMES[0],
+                Vector3D(10.0f, 10.0f, 0.0f));
+        setUniformValue(command->m_parameterPack, LIGHT_TYPE_UNROLL_NAMES[0],
+                int(QAbstractLight::PointLight));
+        setUniformValue(command->m_parameterPack, LIGHT_COLOR_UNROLL_NAMES[0],
+                Vector3D(1.0f, 1.0f, 1.0f));
+        setUniformValue(command->m_parameterPack, LIGHT_INTENSITY_UNROLL_NAMES[0], 0.5f);
+    }
+
+    // Environment Light
+    int envLightCount = 0;
+    if (environmentLight && environmentLight->isEnabled()) {
+        static const int irradianceStructId =
+                StringToInt::lookupId(QLatin1String("envLight_irradiance"));
+        static const int specularStructId =
+                StringToInt::lookupId(QLatin1String("envLight_specular"));
+        static const int irradianceId =
+                StringToInt::lookupId(QLatin1String("envLightIrradiance"));
+        static const int specularId =
+                StringToInt::lookupId(QLatin1String("envLightSpecular"));
+        ShaderData *shaderData = m_manager->shaderDataManager()->lookupResource(
+                    environmentLight->shaderData());
+        if (shaderData) {
+            envLightCount = 1;
+
+            // ("specularSize", "irradiance", "irradianceSize", "specular")
+            auto irr =
+                    shaderData->properties()["irradiance"].value.value<Qt3DCore::QNodeId>();
+            auto spec =
+                    shaderData->properties()["specular"].value.value<Qt3DCore::QNodeId>();
+
+            setUniformValue(command->m_parameterPack, irradianceId, irr);
+            setUniformValue(command->m_parameterPack, irradianceStructId, irr);
+            setUniformValue(command->m_parameterPack, specularId, spec);
+            setUniformValue(command->m_parameterPack, specularStructId, spec);
         }
-        setUniformValue(command->m_parameterPack,
-                        StringToInt::lookupId(QStringLiteral("envLightCount")), envLightCount);
     }
+    setUniformValue(command->m_parameterPack,
+                    StringToInt::lookupId(QStringLiteral("envLightCount")), envLightCount);
 }
 
 bool RenderView::hasBlitFramebufferInfo() const
@@ -220,6 +220,7 @@ public:
     void setShowDebugOverlay(bool showDebugOverlay) noexcept { m_showDebugOverlay = showDebugOverlay; }
 
     inline void setMaterialParameterTable(const MaterialParameterGathererData &parameters) noexcept { m_parameters = parameters; }
+    inline void setRenderPassStateSets(const RenderPassStateSets &stateSets) noexcept { m_renderPassStateSets = stateSets; }
 
     // TODO: Get rid of this overly complex memory management by splitting out the
     // InnerData as a RenderViewConfig struct. This can be created by setRenderViewConfigFromFrameGraphLeafNode
@@ -263,6 +264,7 @@ public:
     void setEnvironmentLight(EnvironmentLight *environmentLight) noexcept { m_environmentLight = environmentLight; }
 
     void updateMatrices();
+    void updateViewUniforms();
 
     inline void setRenderCaptureNodeId(const Qt3DCore::QNodeId nodeId) noexcept { m_renderCaptureNodeId = nodeId; }
     inline const Qt3DCore::QNodeId renderCaptureNodeId() const noexcept { return m_renderCaptureNodeId; }
@@ -303,8 +305,8 @@ public:
 
 private:
     void setShaderAndUniforms(RenderCommand *command, ParameterInfoList &parameters, const Entity *entity,
-                              const std::vector<LightSource> &activeLightSources,
-                              EnvironmentLight *environmentLight) const;
+                              bool useLights) const;
+    void updateLightUniforms(RenderCommand *command, const Entity *entity, bool useLights) const;
 
     Renderer *m_renderer = nullptr;
     NodeManagers *m_manager = nullptr;
@@ -351,7 +353,8 @@ private:
     Vector3D m_eyeViewDir;
 
     MaterialParameterGathererData m_parameters;
-    mutable std::vector<LightSource> m_lightSources;
+    RenderPassStateSets m_renderPassStateSets;
+    std::vector<LightSource> m_lightSources;
     EnvironmentLight *m_environmentLight = nullptr;
 
     RenderViewUBO m_renderViewUBO;
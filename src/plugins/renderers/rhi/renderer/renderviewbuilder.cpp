@@ -140,7 +140,20 @@ void RenderViewBuilder::prepareJobs()
 {
     // Init what we can here
     m_filterProximityJob->setManager(m_renderer->nodeManagers());
+    m_filterProximityJob->setSceneBVH(QRenderAspectPrivate::get(m_renderer->aspect())->m_expandBoundingVolumeJob->sceneBVH());
     m_frustumCullingJob->setRoot(m_renderer->sceneRoot());
+    m_frustumCullingJob->setManagers(m_renderer->nodeManagers());
+    m_frustumCullingJob->setBoundingSpheres(QRenderAspectPrivate::get(m_renderer->aspect())->m_expandBoundingVolumeJob->boundingSpheres());
+
+    // Jobs only needed when a cache is rebuilt are created for the frame that
+    // needs them. The other jobs are kept for as long as the builder, so that
+    // the job graph compiled by the job manager can be reused across frames.
+    m_renderViewCommandBuilderJobs.clear();
+    m_syncRenderViewPreCommandBuildingJob.reset();
+    m_materialGathererJobs.clear();
+    m_syncMaterialGathererJob.reset();
+    m_filterEntityByLayerJob.reset();
+    m_syncFilterEntityByLayerJob.reset();
 
     const bool commandsNeedRebuild = m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild);
     if (commandsNeedRebuild) {
@@ -162,16 +175,34 @@ void RenderViewBuilder::prepareJobs()
 
     // RenderCommand building is the most consuming task -> split it
     // Estimate the number of jobs to create based on the number of entities
-    m_renderViewCommandUpdaterJobs.reserve(m_optimalParallelJobCount);
-    for (auto i = 0; i < m_optimalParallelJobCount; ++i) {
-        auto renderViewCommandUpdater = RenderViewCommandUpdaterJobPtr::create();
-        m_renderViewCommandUpdaterJobs.push_back(renderViewCommandUpdater);
+    if (m_renderViewCommandUpdaterJobs.size() != size_t(m_optimalParallelJobCount)) {
+        m_renderViewCommandUpdaterJobs.clear();
+        m_renderViewCommandUpdaterJobs.reserve(m_optimalParallelJobCount);
+        for (auto i = 0; i < m_optimalParallelJobCount; ++i) {
+            auto renderViewCommandUpdater = RenderViewCommandUpdaterJobPtr::create();
+            m_renderViewCommandUpdaterJobs.push_back(renderViewCommandUpdater);
+        }
     }
 
     const bool materialCacheNeedsRebuild = m_rebuildFlags.testFlag(RebuildFlag::MaterialCacheRebuild);
     if (materialCacheNeedsRebuild) {
+        MaterialManager *materialManager = m_renderer->nodeManagers()->materialManager();
+        const bool materialCacheNeedsFullRebuild = m_rebuildFlags.testFlag(RebuildFlag::MaterialCacheFullRebuild);
+        std::vector<HMaterial> materialHandles;
+        std::vector<Qt3DCore::QNodeId> removedMaterials;
+        if (materialCacheNeedsFullRebuild) {
+            materialHandles = materialManager->activeHandles();
+        } else {
+            // Only gather the materials affected by what changed since last time
+            auto *cache = m_renderer->cache();
+            QMutexLocker lock(cache->mutex());
+            materialHandles = MaterialParameterGathererJob::findMaterialsToGather(materialManager,
+                                                                                  cache->leafNodeCache[m_leafNode].materialParameterGathererDependencies,
+                                                                                  m_dirtyMaterialNodes,
+                                                                                  removedMaterials);
+        }
+
         // Since Material gathering is an heavy task, we split it
-        const std::vector<HMaterial> &materialHandles = m_renderer->nodeManagers()->materialManager()->activeHandles();
         const size_t handlesCount = materialHandles.size();
         if (handlesCount) {
             m_materialGathererJobs.reserve(m_optimalParallelJobCount);
@@ -190,7 +221,9 @@ void RenderViewBuilder::prepareJobs()
         }
         m_syncMaterialGathererJob = CreateSynchronizerJobPtr(SyncMaterialParameterGatherer(m_materialGathererJobs,
                                                                                            m_renderer,
-                                                                                           m_leafNode),
+                                                                                           m_leafNode,
+                                                                                           materialCacheNeedsFullRebuild,
+                                                                                           std::move(removedMaterials)),
                                                              JobTypes::SyncMaterialGatherer);
     }
 
@@ -204,30 +237,30 @@ void RenderViewBuilder::prepareJobs()
                                                                   JobTypes::SyncFilterEntityByLayer);
     }
 
-    m_syncRenderViewPreCommandUpdateJob = CreateSynchronizerJobPtr(SyncRenderViewPreCommandUpdate(m_renderViewJob,
-                                                                                                  m_frustumCullingJob,
-                                                                                                  m_filterProximityJob,
-                                                                                                  m_materialGathererJobs,
-                                                                                                  m_renderViewCommandUpdaterJobs,
-                                                                                                  m_renderViewCommandBuilderJobs,
-                                                                                                  m_renderer,
-                                                                                                  m_leafNode,
-                                                                                                  m_rebuildFlags),
-                                                                   JobTypes::SyncRenderViewPreCommandUpdate);
-
-    m_syncRenderViewPostCommandUpdateJob = CreateSynchronizerJobPtr(SyncRenderViewPostCommandUpdate(m_renderViewJob,
-                                                                                                    m_renderViewCommandUpdaterJobs,
-                                                                                                    m_renderer),
-                                                                    JobTypes::SyncRenderViewPostCommandUpdate);
-
-    m_syncRenderViewPostInitializationJob = CreateSynchronizerJobPtr(SyncRenderViewPostInitialization(m_renderViewJob,
-                                                                                                      m_frustumCullingJob,
-                                                                                                      m_filterEntityByLayerJob,
-                                                                                                      m_filterProximityJob,
-                                                                                                      m_materialGathererJobs,
-                                                                                                      m_renderViewCommandUpdaterJobs,
-                                                                                                      m_renderViewCommandBuilderJobs),
-                                                                     JobTypes::SyncRenderViewInitialization);
+    UpdateSynchronizerJobPtr(m_syncRenderViewPreCommandUpdateJob, SyncRenderViewPreCommandUpdate(m_renderViewJob,
+                                                                                                 m_frustumCullingJob,
+                                                                                                 m_filterProximityJob,
+                                                                                                 m_materialGathererJobs,
+                                                                                                 m_renderViewCommandUpdaterJobs,
+                                                                                                 m_renderViewCommandBuilderJobs,
+                                                                                                 m_renderer,
+                                                                                                 m_leafNode,
+                                                                                                 m_rebuildFlags),
+                                                                  JobTypes::SyncRenderViewPreCommandUpdate);
+
+    UpdateSynchronizerJobPtr(m_syncRenderViewPostCommandUpdateJob, SyncRenderViewPostCommandUpdate(m_renderViewJob,
+                                                                                                   m_renderViewCommandUpdaterJobs,
+                                                                                                   m_renderer),
+                                                                   JobTypes::SyncRenderViewPostCommandUpdate);
+
+    UpdateSynchronizerJobPtr(m_syncRenderViewPostInitializationJob, SyncRenderViewPostInitialization(m_renderViewJob,
+                                                                                                     m_frustumCullingJob,
+                                                                                                     m_filterEntityByLayerJob,
+                                                                                                     m_filterProximityJob,
+                                                                                                     m_materialGathererJobs,
+                                                                                                     m_renderViewCommandUpdaterJobs,
+                                                                                                     m_renderViewCommandBuilderJobs),
+                                                                    JobTypes::SyncRenderViewInitialization);
 }
 
 std::vector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy() const
@@ -240,7 +273,14 @@ std::vector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy() const
     auto updateSkinningPaletteJob = daspect->m_updateSkinningPaletteJob;
     auto updateEntityLayersJob = daspect->m_updateEntityLayersJob;
 
-    jobs.reserve(m_materialGathererJobs.size() + m_renderViewCommandUpdaterJobs.size() + 11);
+    jobs.reserve(m_materialGathererJobs.size() + m_renderViewCommandUpdaterJobs.size()
+                 + m_frustumCullingJob->chunkJobs().size() + 11);
+
+    // The jobs below are kept across frames, drop their dependencies upon the
+    // jobs of previous frames that were since released. The dependencies that
+    // are still valid are not added again.
+    m_syncRenderViewPreCommandUpdateJob->removeDependency(QWeakPointer<Qt3DCore::QAspectJob>());
+    m_syncRenderViewPostCommandUpdateJob->removeDependency(QWeakPointer<Qt3DCore::QAspectJob>());
 
     // Set dependencies
 
@@ -255,6 +295,14 @@ std::vector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy() const
     m_frustumCullingJob->addDependency(expandBVJob);
     m_frustumCullingJob->addDependency(m_syncPreFrustumCullingJob);
 
+    // The culling job gathers the results of its chunk jobs, the first of
+    // which prepares the culling
+    const std::vector<Qt3DCore::QAspectJobPtr> &frustumCullingChunkJobs = m_frustumCullingJob->chunkJobs();
+    if (!frustumCullingChunkJobs.empty()) {
+        frustumCullingChunkJobs.front()->addDependency(expandBVJob);
+        frustumCullingChunkJobs.front()->addDependency(m_syncPreFrustumCullingJob);
+    }
+
     m_syncRenderViewPostInitializationJob->addDependency(m_renderViewJob);
 
     m_filterProximityJob->addDependency(expandBVJob);
@@ -331,6 +379,7 @@ std::vector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy() const
         jobs.push_back(m_syncMaterialGathererJob); // Step 3
     }
 
+    jobs.insert(jobs.end(), frustumCullingChunkJobs.begin(), frustumCullingChunkJobs.end()); // Step 4
     jobs.push_back(m_frustumCullingJob); // Step 4
     jobs.push_back(m_syncRenderViewPreCommandUpdateJob); // Step 5
 
@@ -373,6 +422,21 @@ bool RenderViewBuilder::materialGathererCacheNeedsToBeRebuilt() const
     return m_rebuildFlags.testFlag(RebuildFlag::MaterialCacheRebuild);
 }
 
+void RenderViewBuilder::setMaterialGathererCacheNeedsFullRebuild(bool needsFullRebuild)
+{
+    m_rebuildFlags.setFlag(RebuildFlag::MaterialCacheFullRebuild, needsFullRebuild);
+}
+
+bool RenderViewBuilder::materialGathererCacheNeedsFullRebuild() const
+{
+    return m_rebuildFlags.testFlag(RebuildFlag::MaterialCacheFullRebuild);
+}
+
+void RenderViewBuilder::setDirtyMaterialNodes(const std::vector<Qt3DCore::QNodeId> &dirtyNodes)
+{
+    m_dirtyMaterialNodes = dirtyNodes;
+}
+
 void RenderViewBuilder::setRenderCommandCacheNeedsToBeRebuilt(bool needsToBeRebuilt)
 {
     m_rebuildFlags.setFlag(RebuildFlag::FullCommandRebuild, needsToBeRebuilt);
@@ -393,6 +457,16 @@ bool RenderViewBuilder::lightCacheNeedsToBeRebuilt() const
     return m_rebuildFlags.testFlag(RebuildFlag::LightCacheRebuild);
 }
 
+void RenderViewBuilder::setRenderCommandUniformsNeedUpdate(bool needsUpdate)
+{
+    m_rebuildFlags.setFlag(RebuildFlag::CommandUniformsUpdate, needsUpdate);
+}
+
+bool RenderViewBuilder::renderCommandUniformsNeedUpdate() const
+{
+    return m_rebuildFlags.testFlag(RebuildFlag::CommandUniformsUpdate);
+}
+
 int RenderViewBuilder::optimalJobCount() const
 {
     return m_optimalParallelJobCount;
@@ -104,7 +104,9 @@ Entity::Entity()
     : BackendNode(*new EntityPrivate)
     , m_nodeManagers(nullptr)
     , m_boundingDirty(false)
+    , m_worldTransformDirty(true)
     , m_treeEnabled(true)
+    , m_worldTransformRevision(0)
 {
 }
 
@@ -120,6 +122,7 @@ void Entity::cleanup()
         qCDebug(Render::RenderNodes) << Q_FUNC_INFO;
 
         removeFromParentChildHandles();
+        m_nodeManagers->renderNodesManager()->markHierarchyChanged();
 
         for (auto &childHandle : qAsConst(m_childrenHandles)) {
             auto child = m_nodeManagers->renderNodesManager()->data(childHandle);
@@ -146,6 +149,7 @@ void Entity::cleanup()
     m_armatureComponent = QNodeId();
     m_childrenHandles.clear();
     m_layerComponents.clear();
+    m_layerMask.clear();
     m_levelOfDetailComponents.clear();
     m_rayCasterComponents.clear();
     m_shaderDataComponents.clear();
@@ -156,6 +160,9 @@ void Entity::cleanup()
     m_worldBoundingVolumeWithChildren.reset();
     m_parentHandle = {};
     m_boundingDirty = false;
+    m_worldTransformDirty = true;
+    // Not reset, commands cached for the previous use of this Entity must see a change
+    ++m_worldTransformRevision;
     QBackendNode::setEnabled(false);
 
     // Ensure we rebuild caches when an Entity gets cleaned up
@@ -171,6 +178,8 @@ void Entity::setParentHandle(HEntity parentHandle)
         return;
 
     removeFromParentChildHandles();
+    m_worldTransformDirty = true;
+    m_nodeManagers->renderNodesManager()->markHierarchyChanged();
 
     m_parentHandle = parentHandle;
     auto parent = m_nodeManagers->renderNodesManager()->data(parentHandle);
@@ -195,6 +204,8 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         return;
 
     if (this->isEnabled() != node->isEnabled()) {
+        // Disabled subtrees are not kept up to date
+        m_worldTransformDirty = true;
         markDirty(AbstractRenderer::EntityEnabledDirty);
         // We let QBackendNode::syncFromFrontEnd change the enabled property
     }
@@ -215,6 +226,8 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
 
     if (firstTime) {
         m_worldTransform = m_nodeManagers->worldMatrixManager()->getOrAcquireHandle(peerId());
+        m_worldTransformDirty = true;
+        m_nodeManagers->renderNodesManager()->markHierarchyChanged();
 
         // TODO: Suboptimal -> Maybe have a Hash<QComponent, QEntityList> instead
         m_transformComponent = QNodeId();
@@ -281,24 +294,9 @@ QList<Entity *> Entity::children() const
     return childrenVector;
 }
 
-void Entity::traverse(const std::function<void(Entity *)> &operation)
+Entity *Entity::entityFromHandle(const HEntity &handle) const
 {
-    operation(this);
-    for (const HEntity &handle : qAsConst(m_childrenHandles)) {
-        Entity *child = m_nodeManagers->renderNodesManager()->data(handle);
-        if (child != nullptr)
-            child->traverse(operation);
-    }
-}
-
-void Entity::traverse(const std::function<void(const Entity *)> &operation) const
-{
-    operation(this);
-    for (const HEntity &handle : m_childrenHandles) {
-        const Entity *child = m_nodeManagers->renderNodesManager()->data(handle);
-        if (child != nullptr)
-            child->traverse(operation);
-    }
+    return m_nodeManagers->renderNodesManager()->data(handle);
 }
 
 Matrix4x4 *Entity::worldTransform()
@@ -320,6 +318,7 @@ void Entity::addComponent(Qt3DCore::QNodeIdTypePair idAndType)
     qCDebug(Render::RenderNodes) << Q_FUNC_INFO << "id =" << id << type->className();
     if (type->inherits(&Qt3DCore::QTransform::staticMetaObject)) {
         m_transformComponent = id;
+        m_worldTransformDirty = true;
     } else if (type->inherits(&QCameraLens::staticMetaObject)) {
         m_cameraComponent = id;
     } else if (type->inherits(&QLayer::staticMetaObject)) {
@@ -359,6 +358,7 @@ void Entity::removeComponent(Qt3DCore::QNodeId nodeId)
 {
     if (m_transformComponent == nodeId) {
         m_transformComponent = QNodeId();
+        m_worldTransformDirty = true;
     } else if (m_cameraComponent == nodeId) {
         m_cameraComponent = QNodeId();
     } else if (m_layerComponents.contains(nodeId)) {
@@ -55,6 +55,7 @@
 #include <Qt3DRender/private/backendnode_p.h>
 #include <Qt3DRender/private/abstractrenderer_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
+#include <Qt3DRender/private/layermask_p.h>
 #include <Qt3DCore/private/qentity_p.h>
 #include <Qt3DCore/private/qhandle_p.h>
 #include <QList>
@@ -104,8 +105,29 @@ public:
     const QList<HEntity> &childrenHandles() const { return m_childrenHandles; }
     QList<Entity *> children() const;
     bool hasChildren() const { return !m_childrenHandles.empty(); }
-    void traverse(const std::function<void(Entity *)> &operation);
-    void traverse(const std::function<void(const Entity *)> &operation) const;
+
+    // Calls operation on this entity and its descendants, parents first.
+    // Templated so that the operation can be inlined and nothing gets
+    // allocated, unlike going through a std::function
+    template<typename F>
+    void traverse(F &&operation)
+    {
+        operation(this);
+        for (const HEntity &handle : qAsConst(m_childrenHandles)) {
+            if (Entity *child = entityFromHandle(handle))
+                child->traverse(operation);
+        }
+    }
+
+    template<typename F>
+    void traverse(F &&operation) const
+    {
+        operation(this);
+        for (const HEntity &handle : m_childrenHandles) {
+            if (const Entity *child = entityFromHandle(handle))
+                child->traverse(operation);
+        }
+    }
 
     Matrix4x4 *worldTransform();
     const Matrix4x4 *worldTransform() const;
@@ -119,6 +141,17 @@ public:
     bool isBoundingVolumeDirty() const;
     void unsetBoundingVolumeDirty();
 
+    // Set when the world transform has to be recomputed regardless of
+    // whether the parent world transform or the Transform component changed
+    bool isWorldTransformDirty() const { return m_worldTransformDirty; }
+    void markWorldTransformDirty() { m_worldTransformDirty = true; }
+    void unsetWorldTransformDirty() { m_worldTransformDirty = false; }
+
+    // Incremented every time the world transform actually changes, lets
+    // caches tell whether what they derived from it is still valid
+    uint worldTransformRevision() const { return m_worldTransformRevision; }
+    void markWorldTransformChanged() { ++m_worldTransformRevision; }
+
     void setTreeEnabled(bool enabled) { m_treeEnabled = enabled; }
     bool isTreeEnabled() const { return m_treeEnabled; }
 
@@ -127,6 +160,10 @@ public:
     void removeRecursiveLayerId(const Qt3DCore::QNodeId layerId);
     void clearRecursiveLayerIds() { m_recursiveLayerComponents.clear(); }
 
+    // All the layers of layerIds(), kept up to date by UpdateEntityLayersJob
+    const LayerMask &layerMask() const { return m_layerMask; }
+    void setLayerMask(const LayerMask &layerMask) { m_layerMask = layerMask; }
+
     template<class Backend>
     Qt3DCore::QHandle<Backend> componentHandle() const
     {
@@ -182,6 +219,8 @@ protected:
     Q_DECLARE_PRIVATE(Entity)
 
 private:
+    Entity *entityFromHandle(const HEntity &handle) const;
+
     NodeManagers *m_nodeManagers;
     HEntity m_handle;
     HEntity m_parentHandle;
@@ -211,11 +250,14 @@ private:
 
     // Includes recursive layers
     Qt3DCore::QNodeIdVector m_recursiveLayerComponents;
+    LayerMask m_layerMask;
 
     QString m_objectName;
     bool m_boundingDirty;
+    bool m_worldTransformDirty;
     // true only if this and all parent nodes are enabled
     bool m_treeEnabled;
+    uint m_worldTransformRevision;
 };
 
 #define ENTITY_COMPONENT_TEMPLATE_SPECIALIZATION(Type, Handle) \
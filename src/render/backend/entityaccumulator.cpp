@@ -38,36 +38,10 @@
 ****************************************************************************/
 
 #include "entityaccumulator_p.h"
-#include "entityvisitor_p.h"
 
 QT_USE_NAMESPACE
 using namespace Qt3DRender::Render;
 
-namespace {
-
-class Accumulator : public EntityVisitor
-{
-public:
-    Accumulator(std::function<bool(Entity *)> predicate, NodeManagers *manager)
-        : EntityVisitor(manager)
-        , m_predicate(predicate)
-    {
-    }
-
-    EntityVisitor::Operation visit(Entity *entity) override {
-        if (m_predicate(entity))
-            m_entities << entity;
-        return Continue;
-    }
-
-    QList<Entity *> m_entities;
-
-private:
-    std::function<bool(Entity *)> m_predicate;
-};
-
-}
-
 EntityAccumulator::EntityAccumulator(NodeManagers *manager)
     : m_manager(manager)
     , m_predicate([](Entity*) { return true; })
@@ -93,7 +67,12 @@ EntityAccumulator::EntityAccumulator(std::function<bool (Entity *)> predicate, N
  */
 QList<Entity *> EntityAccumulator::apply(Entity *root) const
 {
-    Accumulator a(m_predicate, m_manager);
-    a.apply(root);
-    return a.m_entities;
+    QList<Entity *> entities;
+    if (root) {
+        root->traverse([this, &entities] (Entity *entity) {
+            if (m_predicate(entity))
+                entities.push_back(entity);
+        });
+    }
+    return entities;
 }
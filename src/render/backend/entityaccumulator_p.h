@@ -54,6 +54,7 @@
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
 #include <QList>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -40,6 +40,7 @@
 #include "entityvisitor_p.h"
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/flatentityhierarchy_p.h>
 
 QT_USE_NAMESPACE
 using namespace Qt3DRender::Render;
@@ -47,6 +48,7 @@ using namespace Qt3DRender::Render;
 EntityVisitor::EntityVisitor(NodeManagers *manager)
     : m_manager(manager)
     , m_pruneDisabled(false)
+    , m_useFlatHierarchy(false)
 {
 
 }
@@ -84,6 +86,26 @@ void EntityVisitor::setPruneDisabled(bool pruneDisabled)
     m_pruneDisabled = pruneDisabled;
 }
 
+/*!
+ * \internal
+ *
+ * If true and the flat entity hierarchy of the EntityManager is up to date
+ * and rooted at the entity passed to apply(), the traversal iterates over it
+ * rather than recursing through the children handles.
+ *
+ * Only enable it from jobs that run after the ones updating the flat
+ * hierarchy, as it is rebuilt in place.
+ */
+bool EntityVisitor::useFlatHierarchy() const
+{
+    return m_useFlatHierarchy;
+}
+
+void EntityVisitor::setUseFlatHierarchy(bool useFlatHierarchy)
+{
+    m_useFlatHierarchy = useFlatHierarchy;
+}
+
 /*!
  * \internal
  *
@@ -93,21 +115,48 @@ void EntityVisitor::setPruneDisabled(bool pruneDisabled)
 bool EntityVisitor::apply(Entity *root) {
     if (!root)
         return false;
-    if (m_pruneDisabled && !root->isEnabled())
+
+    if (m_useFlatHierarchy) {
+        EntityManager *entityManager = m_manager->renderNodesManager();
+        const FlatEntityHierarchy *hierarchy = entityManager->flatHierarchy();
+        if (hierarchy->root() == root && hierarchy->isUpToDate(entityManager->hierarchyRevision()))
+            return applyFlat(*hierarchy);
+    }
+
+    return applyRecursively(root);
+}
+
+bool EntityVisitor::applyRecursively(Entity *entity)
+{
+    if (m_pruneDisabled && !entity->isEnabled())
         return true;
 
-    const auto op = visit(root);
+    const auto op = visit(entity);
     if (op == Stop)
         return false;
     if (op == Prune)
         return true;
 
-    const auto &childrenHandles = root->childrenHandles();
+    const auto &childrenHandles = entity->childrenHandles();
     for (const HEntity &handle : childrenHandles) {
         Entity *child = m_manager->renderNodesManager()->data(handle);
-        if (child != nullptr && !apply(child))
+        if (child != nullptr && !applyRecursively(child))
             return false;
     }
 
     return true;
 }
+
+bool EntityVisitor::applyFlat(const FlatEntityHierarchy &hierarchy)
+{
+    static_assert(int(Continue) == int(FlatEntityHierarchy::Continue)
+                  && int(Prune) == int(FlatEntityHierarchy::Prune)
+                  && int(Stop) == int(FlatEntityHierarchy::Stop),
+                  "EntityVisitor and FlatEntityHierarchy operations must match");
+
+    return hierarchy.traverse(0, [this] (Entity *entity, uint) {
+        if (m_pruneDisabled && !entity->isEnabled())
+            return FlatEntityHierarchy::Prune;
+        return FlatEntityHierarchy::Operation(visit(entity));
+    });
+}
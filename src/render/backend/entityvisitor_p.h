@@ -59,6 +59,7 @@ namespace Qt3DRender {
 namespace Render {
 
 class Entity;
+class FlatEntityHierarchy;
 class NodeManagers;
 
 class Q_AUTOTEST_EXPORT EntityVisitor
@@ -78,13 +79,20 @@ public:
     bool pruneDisabled() const;
     void setPruneDisabled(bool pruneDisabled);
 
+    bool useFlatHierarchy() const;
+    void setUseFlatHierarchy(bool useFlatHierarchy);
+
     bool apply(Entity *root);
 
 protected:
     NodeManagers *m_manager;
 
 private:
+    bool applyRecursively(Entity *entity);
+    bool applyFlat(const FlatEntityHierarchy &hierarchy);
+
     bool m_pruneDisabled;
+    bool m_useFlatHierarchy;
 };
 
 } // namespace Render
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "flatentityhierarchy_p.h"
+#include <Qt3DRender/private/entity_p.h>
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+FlatEntityHierarchy::FlatEntityHierarchy()
+    : m_root(nullptr)
+    , m_hierarchyRevision(0)
+{
+}
+
+bool FlatEntityHierarchy::update(Entity *root, uint hierarchyRevision)
+{
+    if (root == m_root && hierarchyRevision == m_hierarchyRevision)
+        return false;
+
+    clear();
+    m_root = root;
+    m_hierarchyRevision = hierarchyRevision;
+    if (!root)
+        return true;
+
+    // Iterative pre-order traversal, deep hierarchies would exhaust the stack
+    struct Pending {
+        Entity *entity;
+        int parentIndex;
+    };
+    std::vector<Pending> pending = { { root, -1 } };
+    while (!pending.empty()) {
+        const Pending p = pending.back();
+        pending.pop_back();
+        append(p.entity, p.parentIndex);
+
+        const auto children = p.entity->children();
+        const int index = int(m_entities.size()) - 1;
+        for (auto it = children.crbegin(), end = children.crend(); it != end; ++it)
+            pending.push_back({ *it, index });
+    }
+
+    // Children come after their parent, so a reverse pass is enough to
+    // propagate the end of each subtree up to its root
+    for (size_t i = m_entities.size(); i-- > 1; ) {
+        const uint parent = uint(m_parentIndices[i]);
+        m_subtreeEnd[parent] = std::max(m_subtreeEnd[parent], m_subtreeEnd[i]);
+    }
+    return true;
+}
+
+void FlatEntityHierarchy::append(Entity *e, int parentIndex)
+{
+    m_entities.push_back(e);
+    m_parentIndices.push_back(parentIndex);
+    m_subtreeEnd.push_back(uint(m_entities.size()));
+    m_boundsChanged.push_back(true);
+}
+
+void FlatEntityHierarchy::clear()
+{
+    m_entities.clear();
+    m_parentIndices.clear();
+    m_subtreeEnd.clear();
+    m_boundsChanged.clear();
+    m_root = nullptr;
+}
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
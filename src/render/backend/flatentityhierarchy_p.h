@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_FLATENTITYHIERARCHY_P_H
+#define QT3DRENDER_RENDER_FLATENTITYHIERARCHY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <QtCore/qglobal.h>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+class Entity;
+
+// Structure of arrays view of the Entity tree. Entities are stored in depth
+// first order so that each subtree is a contiguous range and every parent
+// comes before its children, allowing the jobs computing world transforms
+// and bounding volumes to stream over the scene rather than chasing handles.
+// Only the topology is stored here, the Entities own the transforms and
+// bounding volumes.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT FlatEntityHierarchy
+{
+public:
+    // Same meaning as EntityVisitor::Operation
+    enum Operation {
+        Continue,   //! continue traversal
+        Prune,      //! skip the subtree of the current entity
+        Stop        //! abort traversal
+    };
+
+    FlatEntityHierarchy();
+
+    // Collects the entities under root (disabled ones included) if root or
+    // the hierarchy revision changed since the last call. Returns true if
+    // the arrays were rebuilt.
+    bool update(Entity *root, uint hierarchyRevision);
+    inline bool isUpToDate(uint hierarchyRevision) const noexcept { return m_root != nullptr && m_hierarchyRevision == hierarchyRevision; }
+    void clear();
+
+    inline uint hierarchyRevision() const noexcept { return m_hierarchyRevision; }
+    inline Entity *root() const noexcept { return m_root; }
+    inline size_t size() const noexcept { return m_entities.size(); }
+    inline Entity *entity(uint index) const noexcept { return m_entities[index]; }
+    // -1 for the root
+    inline int parentIndex(uint index) const noexcept { return m_parentIndices[index]; }
+    // One past the last index of the subtree rooted at index
+    inline uint subtreeEnd(uint index) const noexcept { return m_subtreeEnd[index]; }
+
+    // Visits the subtree rooted at index in depth first order without
+    // recursion, operation(Entity *, uint index) returns an Operation.
+    // Pruning jumps straight to the end of the pruned subtree. Returns false
+    // if the traversal was stopped.
+    template<typename F>
+    bool traverse(uint index, F &&operation) const
+    {
+        for (uint i = index, end = m_subtreeEnd[index]; i < end; ) {
+            switch (operation(m_entities[i], i)) {
+            case Continue:
+                ++i;
+                break;
+            case Prune:
+                i = m_subtreeEnd[i];
+                break;
+            case Stop:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Set when the world bounding volume of an entity actually changed, or
+    // when the volumes its parent is expanded with may have. Consumed by
+    // ExpandBoundingVolumeJob to only refit the entities that moved.
+    inline bool isBoundsChanged(uint index) const noexcept { return m_boundsChanged[index]; }
+    inline void markBoundsChanged(uint index) noexcept { m_boundsChanged[index] = true; }
+    inline void unsetBoundsChanged(uint index) noexcept { m_boundsChanged[index] = false; }
+
+private:
+    void append(Entity *e, int parentIndex);
+
+    std::vector<Entity *> m_entities;
+    std::vector<int> m_parentIndices;
+    std::vector<uint> m_subtreeEnd;
+    std::vector<quint8> m_boundsChanged;
+    Entity *m_root;
+    uint m_hierarchyRevision;
+};
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_FLATENTITYHIERARCHY_P_H
@@ -53,6 +53,7 @@ namespace Render {
 Layer::Layer()
     : BackendNode()
     , m_recursive(false)
+    , m_layerIndex(-1)
 {
 }
 
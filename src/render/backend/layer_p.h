@@ -76,10 +76,16 @@ public:
     bool recursive() const;
     void setRecursive(bool recursive);
 
+    // Bit of this Layer in the Entity LayerMasks, -1 until assigned by
+    // UpdateEntityLayersJob
+    inline int layerIndex() const noexcept { return m_layerIndex; }
+    inline void setLayerIndex(int layerIndex) noexcept { m_layerIndex = layerIndex; }
+
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) override;
 
 private:
     bool m_recursive;
+    int m_layerIndex;
 };
 
 } // namespace Render
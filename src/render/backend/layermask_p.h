@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_LAYERMASK_P_H
+#define QT3DRENDER_RENDER_LAYERMASK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <QtCore/qvarlengtharray.h>
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// Set of Layers, bit n is set when the Layer of index n belongs to the set.
+// Layer indices are assigned by UpdateEntityLayersJob. The first 63 Layers
+// fit in the inline storage.
+class LayerMask
+{
+public:
+    static constexpr int BitsPerWord = 64;
+    // Never set on Entities, stands for Layers without an index when filtering
+    static constexpr int UnknownLayerIndex = 0;
+
+    inline int wordCount() const noexcept { return int(m_words.size()); }
+    inline quint64 word(int i) const noexcept { return i < m_words.size() ? m_words[i] : 0; }
+
+    inline void clear() noexcept { m_words.clear(); }
+
+    inline void setBit(int index)
+    {
+        const int w = index / BitsPerWord;
+        const int oldWordCount = wordCount();
+        if (w >= oldWordCount) {
+            m_words.resize(w + 1);
+            std::fill(m_words.begin() + oldWordCount, m_words.end(), quint64(0));
+        }
+        m_words[w] |= quint64(1) << (index % BitsPerWord);
+    }
+
+    inline bool testBit(int index) const noexcept
+    {
+        return (word(index / BitsPerWord) >> (index % BitsPerWord)) & 1;
+    }
+
+    inline bool isEmpty() const noexcept
+    {
+        for (quint64 w : m_words) {
+            if (w)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    QVarLengthArray<quint64, 1> m_words;
+};
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_LAYERMASK_P_H
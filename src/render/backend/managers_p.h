@@ -58,6 +58,7 @@
 #include <Qt3DRender/private/filterkey_p.h>
 #include <Qt3DRender/private/effect_p.h>
 #include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/flatentityhierarchy_p.h>
 #include <Qt3DRender/private/layer_p.h>
 #include <Qt3DRender/private/levelofdetail_p.h>
 #include <Qt3DRender/private/material_p.h>
@@ -144,6 +145,19 @@ public:
                 e->setNodeManagers(nullptr);
         });
     }
+
+    // Bumped whenever an Entity is created, destroyed or reparented so that
+    // jobs caching flattened views of the scene know when to rebuild them
+    uint hierarchyRevision() const noexcept { return m_hierarchyRevision; }
+    void markHierarchyChanged() noexcept { ++m_hierarchyRevision; }
+
+    // Depth first arrays of world transforms and bounding volumes, brought
+    // up to date by the first job of the frame that streams over them
+    FlatEntityHierarchy *flatHierarchy() noexcept { return &m_flatHierarchy; }
+
+private:
+    uint m_hierarchyRevision = 0;
+    FlatEntityHierarchy m_flatHierarchy;
 };
 
 class FrameGraphNode;
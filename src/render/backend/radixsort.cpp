@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "radixsort_p.h"
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+const int DigitBits = 8;
+const int DigitCount = 64 / DigitBits;
+const int BucketCount = 1 << DigitBits;
+
+inline uint digitOf(quint64 key, int digit)
+{
+    return uint(key >> (digit * DigitBits)) & (BucketCount - 1);
+}
+
+} // anonymous
+
+// Runs serially in the calling job, each RenderView being sorted by a job of
+// its own
+void radixSort(std::vector<quint64> &keys, std::vector<size_t> &values)
+{
+    Q_ASSERT(keys.size() == values.size());
+    const size_t count = keys.size();
+    if (count < 2)
+        return;
+
+    quint64 setBits = 0;
+    quint64 commonBits = ~quint64(0);
+    for (const quint64 key : keys) {
+        setBits |= key;
+        commonBits &= key;
+    }
+    const quint64 varyingBits = setBits ^ commonBits;
+    if (varyingBits == 0)
+        return;
+
+    std::vector<quint64> sortedKeys(count);
+    std::vector<size_t> sortedValues(count);
+    std::array<size_t, BucketCount> offsets;
+
+    for (int digit = 0; digit < DigitCount; ++digit) {
+        if (digitOf(varyingBits, digit) == 0)
+            continue;
+
+        offsets.fill(0);
+        for (const quint64 key : keys)
+            ++offsets[digitOf(key, digit)];
+
+        size_t offset = 0;
+        for (size_t &bucketOffset : offsets) {
+            const size_t bucketSize = bucketOffset;
+            bucketOffset = offset;
+            offset += bucketSize;
+        }
+
+        // Keys are scattered in order, which keeps the sort stable
+        for (size_t i = 0; i < count; ++i) {
+            const size_t dst = offsets[digitOf(keys[i], digit)]++;
+            sortedKeys[dst] = keys[i];
+            sortedValues[dst] = values[i];
+        }
+
+        keys.swap(sortedKeys);
+        values.swap(sortedValues);
+    }
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_RADIXSORT_P_H
+#define QT3DRENDER_RENDER_RADIXSORT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/qsortpolicy.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// Stable sort of values by their 64 bit keys, keys[i] being the key of
+// values[i]. LSD radix sort on 8 bit digits, the digits which are the same
+// for all the keys are skipped.
+Q_3DRENDERSHARED_PRIVATE_EXPORT void radixSort(std::vector<quint64> &keys, std::vector<size_t> &values);
+
+namespace RadixSortKeys {
+
+inline int bitsFor(quint64 maxValue)
+{
+    int bits = 0;
+    while (bits < 64 && (maxValue >> bits))
+        ++bits;
+    return bits;
+}
+
+// Maps a float to an integer sorting the same way, -0 and +0 compare equal
+inline quint32 orderedDepthBits(float depth)
+{
+    if (depth == 0.0f)
+        depth = 0.0f;
+    quint32 bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Assigns a dense rank to each distinct value, ordered by lessThan
+template<typename T, typename LessThan>
+QHash<T, quint64> rankValues(const std::vector<T> &values, LessThan lessThan)
+{
+    QHash<T, quint64> ranks;
+    for (const T &v : values)
+        ranks.insert(v, 0);
+    std::vector<T> uniqueValues;
+    uniqueValues.reserve(ranks.size());
+    for (auto it = ranks.cbegin(), end = ranks.cend(); it != end; ++it)
+        uniqueValues.push_back(it.key());
+    std::sort(uniqueValues.begin(), uniqueValues.end(), lessThan);
+    for (size_t i = 0, m = uniqueValues.size(); i < m; ++i)
+        ranks[uniqueValues[i]] = i;
+    return ranks;
+}
+
+} // namespace RadixSortKeys
+
+// Packs the sort criteria of the commands at indices into a single 64 bit
+// key each, the first sort type taking the most significant bits, so that a
+// single radixSort gives the same order as sorting each level in turn.
+// shaderOf(command) returns the shader of a command. Returns false when the
+// criteria can't be packed (Texture sorting or too many bits), the commands
+// then have to be sorted level by level.
+template<typename Command, typename ShaderOf>
+bool buildRadixSortKeys(const std::vector<Command> &commands,
+                        const std::vector<size_t> &indices,
+                        const QList<QSortPolicy::SortType> &sortingTypes,
+                        ShaderOf shaderOf,
+                        std::vector<quint64> &keys)
+{
+    using namespace RadixSortKeys;
+    using Shader = decltype(shaderOf(std::declval<const Command &>()));
+    const size_t commandCount = indices.size();
+
+    if (sortingTypes.contains(QSortPolicy::Texture))
+        return false;
+    if (commandCount == 0)
+        return true;
+
+    keys.assign(commandCount, 0);
+    int usedBits = 0;
+    const auto appendField = [&] (int bits, auto fieldValue) {
+        usedBits += bits;
+        if (bits == 0 || usedBits > 64)
+            return;
+        for (size_t i = 0; i < commandCount; ++i)
+            keys[i] = (bits < 64 ? keys[i] << bits : 0) | fieldValue(commands[indices[i]]);
+    };
+
+    QHash<Shader, quint64> shaderRanks;
+    bool sortsByMaterial = false;
+    for (const QSortPolicy::SortType type : sortingTypes) {
+        switch (type) {
+        case QSortPolicy::StateChangeCost: {
+            int minCost = std::numeric_limits<int>::max();
+            int maxCost = std::numeric_limits<int>::min();
+            for (const size_t idx : indices) {
+                minCost = std::min(minCost, commands[idx].m_changeCost);
+                maxCost = std::max(maxCost, commands[idx].m_changeCost);
+            }
+            // Highest cost first
+            appendField(bitsFor(quint64(qint64(maxCost) - qint64(minCost))), [maxCost] (const Command &c) {
+                return quint64(qint64(maxCost) - qint64(c.m_changeCost));
+            });
+            break;
+        }
+        case QSortPolicy::BackToFront:
+            appendField(32, [] (const Command &c) {
+                return quint64(~orderedDepthBits(c.m_depth));
+            });
+            break;
+        case QSortPolicy::FrontToBack:
+            appendField(32, [] (const Command &c) {
+                return quint64(orderedDepthBits(c.m_depth));
+            });
+            break;
+        case QSortPolicy::Material: {
+            // Groups all same shader DNA together
+            if (shaderRanks.isEmpty()) {
+                std::vector<Shader> shaders;
+                shaders.reserve(commandCount);
+                for (const size_t idx : indices)
+                    shaders.push_back(shaderOf(commands[idx]));
+                shaderRanks = rankValues(shaders, std::greater<Shader>());
+            }
+            appendField(bitsFor(quint64(shaderRanks.size() - 1)), [&shaderRanks, &shaderOf] (const Command &c) {
+                return shaderRanks.value(shaderOf(c));
+            });
+            sortsByMaterial = true;
+            break;
+        }
+        case QSortPolicy::Uniform:
+            break;
+        default:
+            Q_UNREACHABLE();
+        }
+    }
+
+    // Commands sharing a shader are grouped by material (same parameters
+    // most likely) once all the other criteria have been applied
+    if (sortsByMaterial) {
+        std::vector<quintptr> materials;
+        materials.reserve(commandCount);
+        for (const size_t idx : indices)
+            materials.push_back(commands[idx].m_material.handle());
+        const QHash<quintptr, quint64> materialRanks = rankValues(materials, std::less<quintptr>());
+        appendField(bitsFor(quint64(materialRanks.size() - 1)), [&materialRanks] (const Command &c) {
+            return materialRanks.value(c.m_material.handle());
+        });
+    }
+
+    return usedBits <= 64;
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_RADIXSORT_P_H
@@ -12,7 +12,9 @@ HEADERS += \
     $$PWD/entity_p_p.h \
     $$PWD/entityvisitor_p.h \
     $$PWD/entityaccumulator_p.h \
+    $$PWD/flatentityhierarchy_p.h \
     $$PWD/layer_p.h \
+    $$PWD/layermask_p.h \
     $$PWD/levelofdetail_p.h \
     $$PWD/nodefunctor_p.h \
     $$PWD/transform_p.h \
@@ -34,6 +36,7 @@ HEADERS += \
     $$PWD/visitorutils_p.h \
     $$PWD/segmentsvisitor_p.h \
     $$PWD/pointsvisitor_p.h \
+    $$PWD/radixsort_p.h \
     $$PWD/apishadermanager_p.h
 
 SOURCES += \
@@ -45,6 +48,7 @@ SOURCES += \
     $$PWD/entity.cpp \
     $$PWD/entityvisitor.cpp \
     $$PWD/entityaccumulator.cpp \
+    $$PWD/flatentityhierarchy.cpp \
     $$PWD/layer.cpp \
     $$PWD/levelofdetail.cpp \
     $$PWD/transform.cpp \
@@ -62,4 +66,5 @@ SOURCES += \
     $$PWD/offscreensurfacehelper.cpp \
     $$PWD/resourceaccessor.cpp \
     $$PWD/segmentsvisitor.cpp \
-    $$PWD/pointsvisitor.cpp
+    $$PWD/pointsvisitor.cpp \
+    $$PWD/radixsort.cpp
@@ -55,6 +55,7 @@ Transform::Transform()
     , m_rotation()
     , m_scale(1.0f, 1.0f, 1.0f)
     , m_translation()
+    , m_transformDirty(true)
 {
 }
 
@@ -64,6 +65,7 @@ void Transform::cleanup()
     m_scale = QVector3D();
     m_translation = QVector3D();
     m_transformMatrix = Matrix4x4();
+    m_transformDirty = true;
     QBackendNode::setEnabled(false);
 }
 
@@ -102,11 +104,14 @@ void Transform::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
 
     if (dirty || firstTime) {
         updateMatrix();
+        m_transformDirty = true;
         markDirty(AbstractRenderer::TransformDirty);
     }
 
-    if (transform->isEnabled() != isEnabled())
+    if (transform->isEnabled() != isEnabled()) {
+        m_transformDirty = true;
         markDirty(AbstractRenderer::TransformDirty);
+    }
 
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
 }
@@ -76,6 +76,11 @@ public:
     QQuaternion rotation() const;
     QVector3D translation() const;
 
+    // Set when the matrix or enabled state changed since the world
+    // transforms depending on this transform were last updated
+    bool isTransformDirty() const { return m_transformDirty; }
+    void unsetTransformDirty() { m_transformDirty = false; }
+
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) final;
 
 private:
@@ -84,6 +89,7 @@ private:
     QQuaternion m_rotation;
     QVector3D m_scale;
     QVector3D m_translation;
+    bool m_transformDirty;
 };
 
 } // namespace Render
@@ -63,6 +63,8 @@
 #include <QColor>
 
 #include <QDebug>
+#include <algorithm>
+#include <utility>
 #include <string.h>
 
 QT_BEGIN_NAMESPACE
@@ -230,9 +232,95 @@ public:
         return !(*this == other);
     }
 private:
-    // Allocate 16 floats on stack
-    // For larger elements, heap allocation will be used
-    QVarLengthArray<float, 16> m_data;
+    // Inline storage for values up to a mat4, only arrays use the heap.
+    // Copies only touch the floats in use and assignments reuse the heap
+    // buffer of the destination when it is large enough.
+    class Storage
+    {
+    public:
+        static constexpr qsizetype InlineCapacity = 16;
+
+        Storage() noexcept = default;
+        explicit Storage(qsizetype size) { resize(size); }
+        Storage(const Storage &other) { assign(other); }
+        Storage(Storage &&other) noexcept { take(other); }
+        ~Storage() { delete [] m_heap; }
+
+        Storage &operator=(const Storage &other)
+        {
+            if (this != &other)
+                assign(other);
+            return *this;
+        }
+
+        // Keeps the heap buffer when other is stored inline
+        Storage &operator=(Storage &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+            if (other.m_heap) {
+                delete [] m_heap;
+                take(other);
+            } else {
+                m_size = 0;
+                resize(other.m_size);
+                memcpy(data(), other.m_inline, m_size * sizeof(float));
+            }
+            return *this;
+        }
+
+        qsizetype size() const noexcept { return m_size; }
+        float *data() noexcept { return m_heap ? m_heap : m_inline; }
+        const float *data() const noexcept { return constData(); }
+        const float *constData() const noexcept { return m_heap ? m_heap : m_inline; }
+        float &operator[](qsizetype i) noexcept { return data()[i]; }
+        const float &operator[](qsizetype i) const noexcept { return constData()[i]; }
+
+        // Existing values are kept, new ones are left uninitialized
+        void resize(qsizetype size)
+        {
+            if (size > capacity()) {
+                float *heap = new float[size];
+                memcpy(heap, constData(), m_size * sizeof(float));
+                delete [] m_heap;
+                m_heap = heap;
+                m_heapCapacity = size;
+            }
+            m_size = size;
+        }
+
+        bool operator==(const Storage &other) const noexcept
+        {
+            return m_size == other.m_size
+                    && std::equal(constData(), constData() + m_size, other.constData());
+        }
+
+    private:
+        qsizetype capacity() const noexcept { return m_heap ? m_heapCapacity : InlineCapacity; }
+
+        void assign(const Storage &other)
+        {
+            m_size = 0;
+            resize(other.m_size);
+            memcpy(data(), other.constData(), m_size * sizeof(float));
+        }
+
+        void take(Storage &other) noexcept
+        {
+            m_heap = std::exchange(other.m_heap, nullptr);
+            m_heapCapacity = std::exchange(other.m_heapCapacity, 0);
+            m_size = other.m_size;
+            if (!m_heap)
+                memcpy(m_inline, other.m_inline, m_size * sizeof(float));
+        }
+
+        float *m_heap = nullptr;
+        qsizetype m_heapCapacity = 0;
+        qsizetype m_size = 0;
+        alignas(16) float m_inline[InlineCapacity];
+    };
+
+    Storage m_data;
 
     ValueType m_valueType = ScalarValue;
 
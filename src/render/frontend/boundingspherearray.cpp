@@ -0,0 +1,341 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "boundingspherearray_p.h"
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/flatentityhierarchy_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DCore/private/qt3dcore-config_p.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qvarlengtharray.h>
+#include <private/qsimd_p.h>
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+// Leaf runs shorter than this are tested one sphere at a time
+const uint MinLeafBatch = 4;
+
+// Pushes the indices matching the bits of visibleMask, lowest bit first
+inline void appendVisible(uint visibleMask, uint firstIndex, std::vector<uint> &visibleIndices)
+{
+    while (visibleMask) {
+        visibleIndices.push_back(firstIndex + qCountTrailingZeroBits(visibleMask));
+        visibleMask &= visibleMask - 1;
+    }
+}
+
+} // anonymous
+
+BoundingSphereArray::BoundingSphereArray()
+    : m_root(nullptr)
+    , m_hierarchyRevision(0)
+{
+}
+
+void BoundingSphereArray::rebuild(Entity *root, uint hierarchyRevision)
+{
+    m_entities.clear();
+    m_subtreeEnd.clear();
+    m_root = root;
+    m_hierarchyRevision = hierarchyRevision;
+
+    if (root)
+        collect(root);
+
+    resizeArrays();
+}
+
+void BoundingSphereArray::rebuild(const FlatEntityHierarchy &hierarchy)
+{
+    const size_t count = hierarchy.size();
+    m_root = hierarchy.root();
+    m_hierarchyRevision = hierarchy.hierarchyRevision();
+    m_entities.resize(count);
+    m_subtreeEnd.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_entities[i] = hierarchy.entity(uint(i));
+        m_subtreeEnd[i] = hierarchy.subtreeEnd(uint(i));
+    }
+
+    resizeArrays();
+}
+
+void BoundingSphereArray::resizeArrays()
+{
+    const size_t count = m_entities.size();
+    m_addressOrder.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        m_addressOrder[i] = uint(i);
+    std::sort(m_addressOrder.begin(), m_addressOrder.end(), [this] (uint a, uint b) {
+        return m_entities[a] < m_entities[b];
+    });
+
+    m_centerX.resize(count);
+    m_centerY.resize(count);
+    m_centerZ.resize(count);
+    m_radius.resize(count);
+}
+
+void BoundingSphereArray::collect(Entity *e)
+{
+    const size_t index = m_entities.size();
+    m_entities.push_back(e);
+    m_subtreeEnd.push_back(0);
+    const auto children = e->children();
+    for (Entity *child : children)
+        collect(child);
+    m_subtreeEnd[index] = uint(m_entities.size());
+}
+
+void BoundingSphereArray::update()
+{
+    const size_t count = m_entities.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Sphere *s = m_entities[i]->worldBoundingVolumeWithChildren();
+        const Vector3D &center = s->center();
+        m_centerX[i] = center.x();
+        m_centerY[i] = center.y();
+        m_centerZ[i] = center.z();
+        m_radius[i] = s->radius();
+    }
+}
+
+void BoundingSphereArray::clear()
+{
+    m_entities.clear();
+    m_subtreeEnd.clear();
+    m_addressOrder.clear();
+    m_centerX.clear();
+    m_centerY.clear();
+    m_centerZ.clear();
+    m_radius.clear();
+    m_root = nullptr;
+}
+
+bool BoundingSphereArray::cullNode(uint index, const Vector4D *planes, uint &planeMask,
+                                   quint8 *lastRejectingPlanes, std::vector<uint> &visibleIndices) const
+{
+    const float x = m_centerX[index];
+    const float y = m_centerY[index];
+    const float z = m_centerZ[index];
+    const float r = m_radius[index];
+
+    // Start with the plane which rejected this sphere last time, as it is
+    // likely to still reject it if the camera only moved a little
+    const uint firstPlane = lastRejectingPlanes[index];
+    uint remainingPlanes = planeMask;
+    bool outside = false;
+    for (uint n = 0; n < 6; ++n) {
+        const uint p = (firstPlane + n) % 6;
+        if (!(planeMask & (1U << p)))
+            continue;
+        const float dist = planes[p].x() * x + planes[p].y() * y + planes[p].z() * z + planes[p].w();
+        if (dist < -r) {
+            lastRejectingPlanes[index] = quint8(p);
+            outside = true;
+            break;
+        }
+        if (dist >= r)
+            remainingPlanes &= ~(1U << p);
+    }
+
+    // A null sphere tells nothing about the children, test them as usual
+    if (r < 0.0f) {
+        if (!outside)
+            visibleIndices.push_back(index);
+        return true;
+    }
+
+    if (outside)
+        return false;
+
+    // Fully inside of all the planes, so is the whole subtree
+    if (remainingPlanes == 0) {
+        for (uint i = index, end = m_subtreeEnd[index]; i < end; ++i)
+            visibleIndices.push_back(i);
+        return false;
+    }
+
+    visibleIndices.push_back(index);
+    planeMask = remainingPlanes;
+    return true;
+}
+
+void BoundingSphereArray::cullSubtrees(uint begin, uint end, const Vector4D *planes, uint planeMask,
+                                       quint8 *lastRejectingPlanes, std::vector<uint> &visibleIndices) const
+{
+    struct Level {
+        uint end;
+        uint planeMask;
+    };
+    QVarLengthArray<Level, 64> levels;
+    levels.push_back({ end, planeMask });
+
+    uint i = begin;
+    while (!levels.empty()) {
+        const Level level = levels.back();
+        if (i >= level.end) {
+            levels.pop_back();
+            continue;
+        }
+
+        // Siblings without children are tested in batches
+        if (m_subtreeEnd[i] == i + 1) {
+            uint leafEnd = i + 1;
+            while (leafEnd < level.end && m_subtreeEnd[leafEnd] == leafEnd + 1)
+                ++leafEnd;
+            if (leafEnd - i >= MinLeafBatch) {
+                cullRange(i, leafEnd, planes, level.planeMask, visibleIndices);
+                i = leafEnd;
+                continue;
+            }
+        }
+
+        uint childPlaneMask = level.planeMask;
+        const uint subtreeEnd = m_subtreeEnd[i];
+        if (cullNode(i, planes, childPlaneMask, lastRejectingPlanes, visibleIndices) && subtreeEnd > i + 1) {
+            levels.push_back({ subtreeEnd, childPlaneMask });
+            ++i;
+        } else {
+            i = subtreeEnd;
+        }
+    }
+}
+
+void BoundingSphereArray::cullRange(uint begin, uint end, const Vector4D *planes, uint planeMask,
+                                    std::vector<uint> &visibleIndices) const
+{
+    Q_ASSERT(end <= m_entities.size());
+
+    Vector4D activePlanes[6];
+    int planeCount = 0;
+    for (int p = 0; p < 6; ++p) {
+        if (planeMask & (1U << p))
+            activePlanes[planeCount++] = planes[p];
+    }
+
+    const float *cx = m_centerX.data();
+    const float *cy = m_centerY.data();
+    const float *cz = m_centerZ.data();
+    const float *r = m_radius.data();
+    uint i = begin;
+
+    // A sphere is rejected as soon as it lies entirely on the negative side
+    // of one plane, the comparisons are arranged so that NaNs are kept visible
+#if QT_CONFIG(qt3d_simd_avx2) && defined(__AVX2__) && defined(QT_COMPILER_SUPPORTS_AVX2)
+    {
+        __m256 nx[6], ny[6], nz[6], d[6];
+        for (int p = 0; p < planeCount; ++p) {
+            nx[p] = _mm256_set1_ps(activePlanes[p].x());
+            ny[p] = _mm256_set1_ps(activePlanes[p].y());
+            nz[p] = _mm256_set1_ps(activePlanes[p].z());
+            d[p] = _mm256_set1_ps(activePlanes[p].w());
+        }
+        const __m256 zero = _mm256_setzero_ps();
+
+        for (; i + 8 <= end; i += 8) {
+            const __m256 x = _mm256_loadu_ps(cx + i);
+            const __m256 y = _mm256_loadu_ps(cy + i);
+            const __m256 z = _mm256_loadu_ps(cz + i);
+            const __m256 negRadius = _mm256_sub_ps(zero, _mm256_loadu_ps(r + i));
+            __m256 outside = zero;
+            for (int p = 0; p < planeCount; ++p) {
+                const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx[p], x),
+                                                                              _mm256_mul_ps(ny[p], y)),
+                                                                _mm256_mul_ps(nz[p], z)),
+                                                  d[p]);
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, negRadius, _CMP_LT_OQ));
+            }
+            appendVisible(~uint(_mm256_movemask_ps(outside)) & 0xffU, i, visibleIndices);
+        }
+    }
+#elif QT_CONFIG(qt3d_simd_sse2) && defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+    {
+        __m128 nx[6], ny[6], nz[6], d[6];
+        for (int p = 0; p < planeCount; ++p) {
+            nx[p] = _mm_set1_ps(activePlanes[p].x());
+            ny[p] = _mm_set1_ps(activePlanes[p].y());
+            nz[p] = _mm_set1_ps(activePlanes[p].z());
+            d[p] = _mm_set1_ps(activePlanes[p].w());
+        }
+        const __m128 zero = _mm_setzero_ps();
+
+        for (; i + 4 <= end; i += 4) {
+            const __m128 x = _mm_loadu_ps(cx + i);
+            const __m128 y = _mm_loadu_ps(cy + i);
+            const __m128 z = _mm_loadu_ps(cz + i);
+            const __m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(r + i));
+            __m128 outside = zero;
+            for (int p = 0; p < planeCount; ++p) {
+                const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], x),
+                                                                     _mm_mul_ps(ny[p], y)),
+                                                          _mm_mul_ps(nz[p], z)),
+                                               d[p]);
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, negRadius));
+            }
+            appendVisible(~uint(_mm_movemask_ps(outside)) & 0xfU, i, visibleIndices);
+        }
+    }
+#endif
+
+    // Scalar path for the remaining spheres
+    for (; i < end; ++i) {
+        bool outside = false;
+        for (int p = 0; p < planeCount && !outside; ++p) {
+            const Vector4D &plane = activePlanes[p];
+            const float dist = plane.x() * cx[i] + plane.y() * cy[i] + plane.z() * cz[i] + plane.w();
+            outside = dist < -r[i];
+        }
+        if (!outside)
+            visibleIndices.push_back(i);
+    }
+}
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_BOUNDINGSPHEREARRAY_P_H
+#define QT3DRENDER_RENDER_BOUNDINGSPHEREARRAY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/vector4d_p.h>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+class Entity;
+class FlatEntityHierarchy;
+
+// Structure of arrays copy of the worldBoundingVolumeWithChildren spheres of
+// all the Entities of a scene. Entities are stored in depth first order so
+// that each subtree is a contiguous range which can be rejected or accepted
+// as a whole. A second index sorted by Entity address allows producing the
+// sorted visible set expected by the RenderViewBuilder.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT BoundingSphereArray
+{
+public:
+    enum {
+        AllPlanes = 0x3f
+    };
+
+    BoundingSphereArray();
+
+    // Collects all entities under root (disabled ones included)
+    void rebuild(Entity *root, uint hierarchyRevision);
+    // Same as above, reusing the depth first order of an up to date hierarchy
+    void rebuild(const FlatEntityHierarchy &hierarchy);
+    // Copies the current world bounding volumes of the collected entities
+    void update();
+    void clear();
+
+    inline uint hierarchyRevision() const noexcept { return m_hierarchyRevision; }
+    inline Entity *root() const noexcept { return m_root; }
+    inline size_t size() const noexcept { return m_entities.size(); }
+    inline Entity *entity(uint index) const noexcept { return m_entities[index]; }
+    // One past the last index of the subtree rooted at index
+    inline uint subtreeEnd(uint index) const noexcept { return m_subtreeEnd[index]; }
+    // Indices of the entities sorted by Entity address
+    inline const std::vector<uint> &addressOrder() const noexcept { return m_addressOrder; }
+
+    // In the functions below, each of the 6 planes is given as a normalized
+    // normal in xyz and its distance to origin in w. planeMask selects the
+    // planes that still need testing, the others being known to fully contain
+    // the spheres. lastRejectingPlanes holds, per index, the plane which last
+    // rejected that sphere, it is tested first on the next call.
+
+    // Tests the sphere at index. Appends index, or its whole subtree if it is
+    // fully inside, to visibleIndices. Returns true if the children still need
+    // testing against the planes left in planeMask.
+    bool cullNode(uint index, const Vector4D *planes, uint &planeMask,
+                  quint8 *lastRejectingPlanes, std::vector<uint> &visibleIndices) const;
+    // Hierarchically culls the sibling subtrees found in [begin, end)
+    void cullSubtrees(uint begin, uint end, const Vector4D *planes, uint planeMask,
+                      quint8 *lastRejectingPlanes, std::vector<uint> &visibleIndices) const;
+    // Tests each of the spheres in [begin, end) individually, 4 or 8 at a time
+    void cullRange(uint begin, uint end, const Vector4D *planes, uint planeMask,
+                   std::vector<uint> &visibleIndices) const;
+
+private:
+    void collect(Entity *e);
+    void resizeArrays();
+
+    std::vector<Entity *> m_entities;
+    std::vector<uint> m_subtreeEnd;
+    std::vector<uint> m_addressOrder;
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_radius;
+    Entity *m_root;
+    uint m_hierarchyRevision;
+};
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_BOUNDINGSPHEREARRAY_P_H
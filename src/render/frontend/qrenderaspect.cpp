@@ -377,7 +377,9 @@ void QRenderAspectPrivate::createNodeManagers()
     m_updateLevelOfDetailJob->setManagers(m_nodeManagers);
     m_updateEntityLayersJob->setManager(m_nodeManagers);
     m_pickBoundingVolumeJob->setManagers(m_nodeManagers);
+    m_pickBoundingVolumeJob->setSceneBVH(m_expandBoundingVolumeJob->sceneBVH());
     m_rayCastingJob->setManagers(m_nodeManagers);
+    m_rayCastingJob->setSceneBVH(m_expandBoundingVolumeJob->sceneBVH());
 
     m_calculateBoundingVolumeJob->setFrontEndNodeManager(m_aspectManager);
 }
@@ -392,7 +394,6 @@ void QRenderAspectPrivate::onEngineStartup()
     m_expandBoundingVolumeJob->setRoot(rootEntity);
     m_calculateBoundingVolumeJob->setRoot(rootEntity);
     m_updateLevelOfDetailJob->setRoot(rootEntity);
-    m_updateSkinningPaletteJob->setRoot(rootEntity);
     m_updateTreeEnabledJob->setRoot(rootEntity);
     m_pickBoundingVolumeJob->setRoot(rootEntity);
     m_rayCastingJob->setRoot(rootEntity);
@@ -729,6 +730,8 @@ std::vector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
         if (entitiesEnabledDirty ||
             dirtyBitsForFrame & AbstractRenderer::TransformDirty) {
             jobs.push_back(d->m_worldTransformJob);
+            const std::vector<QAspectJobPtr> &subtreeJobs = d->m_worldTransformJob->subtreeJobs();
+            jobs.insert(jobs.end(), subtreeJobs.begin(), subtreeJobs.end());
             jobs.push_back(d->m_updateWorldBoundingVolumeJob);
         }
 
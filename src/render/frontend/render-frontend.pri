@@ -12,6 +12,8 @@ HEADERS += \
     $$PWD/qrendertarget.h \
     $$PWD/qrendertarget_p.h \
     $$PWD/sphere_p.h \
+    $$PWD/boundingspherearray_p.h \
+    $$PWD/scenebvh_p.h \
     $$PWD/qcamera_p.h \
     $$PWD/qcamera.h \
     $$PWD/qcameralens.h \
@@ -35,6 +37,8 @@ HEADERS += \
 SOURCES += \
     $$PWD/qrenderaspect.cpp \
     $$PWD/sphere.cpp \
+    $$PWD/boundingspherearray.cpp \
+    $$PWD/scenebvh.cpp \
     $$PWD/qlayer.cpp \
     $$PWD/qlevelofdetail.cpp \
     $$PWD/qlevelofdetailswitch.cpp \
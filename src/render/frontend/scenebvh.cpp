@@ -0,0 +1,375 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "scenebvh_p.h"
+#include <Qt3DRender/private/boundingspherearray_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/qray3d_p.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+const uint MaxLeafSize = 4;
+const uint NoParent = std::numeric_limits<uint>::max();
+// Relative padding of the bounds, so that rounding never rejects an Entity
+const float BoundsEpsilon = 1.0e-5f;
+
+// Refitting keeps the topology, which degrades as entities move around
+const double MaxSurfaceAreaGrowth = 1.5;
+
+inline float padding(float value)
+{
+    return BoundsEpsilon * (1.0f + std::abs(value));
+}
+
+template<typename Node>
+inline double surfaceArea(const Node &node)
+{
+    const double x = double(node.max[0]) - double(node.min[0]);
+    const double y = double(node.max[1]) - double(node.min[1]);
+    const double z = double(node.max[2]) - double(node.min[2]);
+    return 2.0 * (x * y + y * z + z * x);
+}
+
+} // anonymous
+
+SceneBVH::SceneBVH()
+    : m_root(nullptr)
+    , m_hierarchyRevision(0)
+    , m_surfaceArea(0.0)
+    , m_builtSurfaceArea(0.0)
+    , m_buildCount(0)
+{
+}
+
+void SceneBVH::rebuild(const BoundingSphereArray &spheres)
+{
+    const size_t count = spheres.size();
+    m_root = spheres.root();
+    m_hierarchyRevision = spheres.hierarchyRevision();
+    m_entities.resize(count);
+    m_subtreeEnd.resize(count);
+    m_bounds.resize(6 * count);
+    for (size_t i = 0; i < count; ++i) {
+        m_entities[i] = spheres.entity(uint(i));
+        m_subtreeEnd[i] = spheres.subtreeEnd(uint(i));
+        updateBounds(uint(i));
+    }
+    build();
+}
+
+void SceneBVH::refit(const std::vector<uint> &indices)
+{
+    bool moved = false;
+    for (const uint i : indices) {
+        if (!updateBounds(i))
+            continue;
+        moved = true;
+
+        // Walk up until a node isn't changed by its children anymore
+        const uint leaf = m_leafOfEntity[i];
+        refitNode(leaf);
+        for (uint nodeIndex = m_parents[leaf]; nodeIndex != NoParent; nodeIndex = m_parents[nodeIndex]) {
+            const Node previous = m_nodes[nodeIndex];
+            refitNode(nodeIndex);
+            const Node &node = m_nodes[nodeIndex];
+            if (std::equal(node.min, node.min + 3, previous.min) && std::equal(node.max, node.max + 3, previous.max))
+                break;
+        }
+    }
+
+    if (moved && m_surfaceArea > MaxSurfaceAreaGrowth * m_builtSurfaceArea)
+        build();
+}
+
+void SceneBVH::clear()
+{
+    m_entities.clear();
+    m_subtreeEnd.clear();
+    m_bounds.clear();
+    m_nodes.clear();
+    m_parents.clear();
+    m_slots.clear();
+    m_leafOfEntity.clear();
+    m_root = nullptr;
+    m_surfaceArea = 0.0;
+    m_builtSurfaceArea = 0.0;
+}
+
+bool SceneBVH::updateBounds(uint index)
+{
+    const Entity *entity = m_entities[index];
+    const Sphere *volume = entity->worldBoundingVolume();
+    const Vector3D &childrenCenter = entity->worldBoundingVolumeWithChildren()->center();
+
+    float bounds[6];
+    for (int axis = 0; axis < 3; ++axis)
+        bounds[axis] = bounds[axis + 3] = childrenCenter[axis];
+    if (!volume->isNull()) {
+        const Vector3D &center = volume->center();
+        // The ray test squares the radius, so must the bounds
+        const float radius = std::abs(volume->radius());
+        for (int axis = 0; axis < 3; ++axis) {
+            bounds[axis] = std::min(bounds[axis], center[axis] - radius);
+            bounds[axis + 3] = std::max(bounds[axis + 3], center[axis] + radius);
+        }
+    }
+
+    float *stored = m_bounds.data() + 6 * size_t(index);
+    if (std::equal(bounds, bounds + 6, stored))
+        return false;
+    std::copy(bounds, bounds + 6, stored);
+    return true;
+}
+
+void SceneBVH::fitNode(uint nodeIndex)
+{
+    Node &node = m_nodes[nodeIndex];
+    if (node.count > 0) {
+        for (int axis = 0; axis < 3; ++axis) {
+            node.min[axis] = std::numeric_limits<float>::max();
+            node.max[axis] = std::numeric_limits<float>::lowest();
+        }
+        for (uint slot = node.first, last = node.first + node.count; slot < last; ++slot) {
+            const float *b = m_bounds.data() + 6 * size_t(m_slots[slot]);
+            for (int axis = 0; axis < 3; ++axis) {
+                node.min[axis] = std::min(node.min[axis], b[axis]);
+                node.max[axis] = std::max(node.max[axis], b[axis + 3]);
+            }
+        }
+    } else {
+        const Node &left = m_nodes[nodeIndex + 1];
+        const Node &right = m_nodes[node.first];
+        for (int axis = 0; axis < 3; ++axis) {
+            node.min[axis] = std::min(left.min[axis], right.min[axis]);
+            node.max[axis] = std::max(left.max[axis], right.max[axis]);
+        }
+    }
+}
+
+void SceneBVH::refitNode(uint nodeIndex)
+{
+    m_surfaceArea -= surfaceArea(m_nodes[nodeIndex]);
+    fitNode(nodeIndex);
+    m_surfaceArea += surfaceArea(m_nodes[nodeIndex]);
+}
+
+void SceneBVH::build()
+{
+    const uint count = uint(m_entities.size());
+    m_nodes.clear();
+    m_parents.clear();
+    m_slots.resize(count);
+    m_leafOfEntity.resize(count);
+    std::iota(m_slots.begin(), m_slots.end(), 0U);
+    m_surfaceArea = 0.0;
+    ++m_buildCount;
+
+    if (count > 0) {
+        m_nodes.reserve(2 * (count / MaxLeafSize + 1));
+        m_parents.reserve(m_nodes.capacity());
+        buildNode(0, count, NoParent);
+        for (const Node &node : m_nodes)
+            m_surfaceArea += surfaceArea(node);
+    }
+    m_builtSurfaceArea = m_surfaceArea;
+}
+
+uint SceneBVH::buildNode(uint begin, uint end, uint parent)
+{
+    const uint nodeIndex = uint(m_nodes.size());
+    m_nodes.emplace_back();
+    m_parents.push_back(parent);
+
+    if (end - begin <= MaxLeafSize) {
+        Node &node = m_nodes[nodeIndex];
+        node.first = begin;
+        node.count = end - begin;
+        for (uint slot = begin; slot < end; ++slot)
+            m_leafOfEntity[m_slots[slot]] = nodeIndex;
+        fitNode(nodeIndex);
+        return nodeIndex;
+    }
+
+    // Median split along the axis where the centers are the most spread
+    float centerMin[3];
+    float centerMax[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        centerMin[axis] = std::numeric_limits<float>::max();
+        centerMax[axis] = std::numeric_limits<float>::lowest();
+    }
+    for (uint slot = begin; slot < end; ++slot) {
+        const float *b = m_bounds.data() + 6 * size_t(m_slots[slot]);
+        for (int axis = 0; axis < 3; ++axis) {
+            const float center = b[axis] + b[axis + 3];
+            centerMin[axis] = std::min(centerMin[axis], center);
+            centerMax[axis] = std::max(centerMax[axis], center);
+        }
+    }
+    int splitAxis = 0;
+    for (int axis = 1; axis < 3; ++axis) {
+        if (centerMax[axis] - centerMin[axis] > centerMax[splitAxis] - centerMin[splitAxis])
+            splitAxis = axis;
+    }
+    const uint middle = begin + (end - begin) / 2;
+    const float *bounds = m_bounds.data();
+    std::nth_element(m_slots.begin() + begin, m_slots.begin() + middle, m_slots.begin() + end,
+                     [bounds, splitAxis] (uint a, uint b) {
+        return bounds[6 * size_t(a) + splitAxis] + bounds[6 * size_t(a) + splitAxis + 3]
+                < bounds[6 * size_t(b) + splitAxis] + bounds[6 * size_t(b) + splitAxis + 3];
+    });
+
+    buildNode(begin, middle, nodeIndex);
+    const uint right = buildNode(middle, end, nodeIndex);
+    Node &node = m_nodes[nodeIndex];
+    node.first = right;
+    node.count = 0;
+    fitNode(nodeIndex);
+    return nodeIndex;
+}
+
+void SceneBVH::intersect(const RayCasting::QRay3D &ray, std::vector<uint> &indices) const
+{
+    indices.clear();
+    if (m_nodes.empty())
+        return;
+
+    // Sphere hits are computed along the ray regardless of its length
+    const Vector3D &origin = ray.origin();
+    const Vector3D &direction = ray.direction();
+    const float o[3] = { origin.x(), origin.y(), origin.z() };
+    const float d[3] = { direction.x(), direction.y(), direction.z() };
+
+    const auto crossesNode = [&] (const Node &node) {
+        float tMin = 0.0f;
+        float tMax = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; ++axis) {
+            const float lo = node.min[axis] - padding(node.min[axis]);
+            const float hi = node.max[axis] + padding(node.max[axis]);
+            if (std::abs(d[axis]) < std::numeric_limits<float>::min()) {
+                if (o[axis] < lo || o[axis] > hi)
+                    return false;
+                continue;
+            }
+            const float invD = 1.0f / d[axis];
+            float t0 = (lo - o[axis]) * invD;
+            float t1 = (hi - o[axis]) * invD;
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if (tMin > tMax)
+                return false;
+        }
+        return true;
+    };
+
+    QVarLengthArray<uint, 64> stack;
+    stack.push_back(0);
+    while (!stack.isEmpty()) {
+        const uint nodeIndex = stack.takeLast();
+        const Node &node = m_nodes[nodeIndex];
+        if (!crossesNode(node))
+            continue;
+        if (node.count > 0) {
+            for (uint slot = node.first, last = node.first + node.count; slot < last; ++slot)
+                indices.push_back(m_slots[slot]);
+        } else {
+            stack.push_back(node.first);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+    std::sort(indices.begin(), indices.end());
+}
+
+void SceneBVH::gatherNear(const Vector3D &center, float distance, std::vector<uint> &indices) const
+{
+    indices.clear();
+    if (m_nodes.empty())
+        return;
+
+    const float c[3] = { center.x(), center.y(), center.z() };
+    const float maxDistanceSquared = distance * distance;
+
+    const auto nearNode = [&] (const Node &node) {
+        float distanceSquared = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float lo = node.min[axis] - padding(node.min[axis]);
+            const float hi = node.max[axis] + padding(node.max[axis]);
+            const float delta = c[axis] < lo ? lo - c[axis] : (c[axis] > hi ? c[axis] - hi : 0.0f);
+            distanceSquared += delta * delta;
+        }
+        return distanceSquared <= maxDistanceSquared;
+    };
+
+    QVarLengthArray<uint, 64> stack;
+    stack.push_back(0);
+    while (!stack.isEmpty()) {
+        const uint nodeIndex = stack.takeLast();
+        const Node &node = m_nodes[nodeIndex];
+        if (!nearNode(node))
+            continue;
+        if (node.count > 0) {
+            for (uint slot = node.first, last = node.first + node.count; slot < last; ++slot)
+                indices.push_back(m_slots[slot]);
+        } else {
+            stack.push_back(node.first);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+    std::sort(indices.begin(), indices.end());
+}
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
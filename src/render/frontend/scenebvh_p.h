@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_SCENEBVH_P_H
+#define QT3DRENDER_RENDER_SCENEBVH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace RayCasting {
+class QRay3D;
+}
+
+namespace Render {
+
+class Entity;
+class BoundingSphereArray;
+
+// Bounding volume hierarchy over the Entities of a scene. The bounds of an
+// Entity enclose its worldBoundingVolume and the center of its
+// worldBoundingVolumeWithChildren, so that both ray casting and proximity
+// queries only visit the Entities they can possibly select. The hierarchy is
+// refit in place as Entities move and only rebuilt once refitting has made its
+// nodes noticeably larger.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT SceneBVH
+{
+public:
+    SceneBVH();
+
+    // Builds the hierarchy over the entities collected by spheres
+    void rebuild(const BoundingSphereArray &spheres);
+    // Updates the bounds of the entities at indices, the ones whose volumes
+    // may have changed since the last call
+    void refit(const std::vector<uint> &indices);
+    void clear();
+
+    inline uint hierarchyRevision() const noexcept { return m_hierarchyRevision; }
+    inline Entity *root() const noexcept { return m_root; }
+    inline size_t size() const noexcept { return m_entities.size(); }
+    inline size_t nodeCount() const noexcept { return m_nodes.size(); }
+    inline Entity *entity(uint index) const noexcept { return m_entities[index]; }
+    // Entities are indexed in depth first order, one past the last index of
+    // the subtree rooted at index
+    inline uint subtreeEnd(uint index) const noexcept { return m_subtreeEnd[index]; }
+    inline quint64 buildCount() const noexcept { return m_buildCount; }
+
+    // Collects, in increasing order, the indices of the entities whose
+    // worldBoundingVolume may be hit by the ray
+    void intersect(const RayCasting::QRay3D &ray, std::vector<uint> &indices) const;
+    // Collects, in increasing order, the indices of the entities whose
+    // worldBoundingVolumeWithChildren center may be within distance of center
+    void gatherNear(const Vector3D &center, float distance, std::vector<uint> &indices) const;
+
+private:
+    struct Node
+    {
+        float min[3];
+        float max[3];
+        // Leaves reference count slots from first, inner nodes have their
+        // left child right after them and their right child at first
+        uint first;
+        uint count;
+    };
+
+    void build();
+    uint buildNode(uint begin, uint end, uint parent);
+    bool updateBounds(uint index);
+    void fitNode(uint nodeIndex);
+    void refitNode(uint nodeIndex);
+
+    std::vector<Entity *> m_entities;
+    std::vector<uint> m_subtreeEnd;
+    // Bounds of each entity, as min xyz followed by max xyz
+    std::vector<float> m_bounds;
+    std::vector<Node> m_nodes;
+    std::vector<uint> m_parents;
+    std::vector<uint> m_slots;
+    std::vector<uint> m_leafOfEntity;
+    Entity *m_root;
+    uint m_hierarchyRevision;
+    // Sum of the surface areas of the nodes, which the cost of a query
+    // is roughly proportional to
+    double m_surfaceArea;
+    double m_builtSurfaceArea;
+    quint64 m_buildCount;
+};
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_SCENEBVH_P_H
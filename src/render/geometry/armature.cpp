@@ -53,6 +53,7 @@ namespace Render {
 
 Armature::Armature()
     : BackendNode(Qt3DCore::QBackendNode::ReadOnly)
+    , m_skinningPaletteRevision(0)
 {
 }
 
@@ -63,12 +64,18 @@ void Armature::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (!node)
         return;
 
-    m_skeletonId = node->skeleton() ? node->skeleton()->id() : QNodeId{};
+    const QNodeId skeletonId = node->skeleton() ? node->skeleton()->id() : QNodeId{};
+    if (skeletonId != m_skeletonId) {
+        m_skeletonId = skeletonId;
+        // Revisions of different skeletons can't be compared
+        m_skinningPaletteRevision = 0;
+    }
 }
 
 void Armature::cleanup()
 {
     m_skeletonId = Qt3DCore::QNodeId();
+    m_skinningPaletteRevision = 0;
     setEnabled(false);
 }
 
@@ -74,10 +74,14 @@ public:
     // Called from jobs
     UniformValue &skinningPaletteUniform() { return m_skinningPaletteUniform; }
     const UniformValue &skinningPaletteUniform() const { return m_skinningPaletteUniform; }
+    // Revision of the skeleton skinning palette held by the uniform
+    uint skinningPaletteRevision() const { return m_skinningPaletteRevision; }
+    void setSkinningPaletteRevision(uint revision) { m_skinningPaletteRevision = revision; }
 
 private:
     Qt3DCore::QNodeId m_skeletonId;
     UniformValue m_skinningPaletteUniform;
+    uint m_skinningPaletteRevision;
 };
 
 } // namespace Render
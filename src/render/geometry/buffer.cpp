@@ -50,6 +50,7 @@ Buffer::Buffer()
     : BackendNode(QBackendNode::ReadWrite)
     , m_usage(Qt3DCore::QBuffer::StaticDraw)
     , m_bufferDirty(false)
+    , m_dataRevision(0)
     , m_access(Qt3DCore::QBuffer::Write)
     , m_manager(nullptr)
 {
@@ -67,6 +68,7 @@ void Buffer::cleanup()
     m_data.clear();
     m_bufferUpdates.clear();
     m_bufferDirty = false;
+    ++m_dataRevision;
     m_access = Qt3DCore::QBuffer::Write;
 }
 
@@ -82,6 +84,7 @@ void Buffer::updateDataFromGPUToCPU(QByteArray data)
     // Note: when this is called, data is what's currently in GPU memory
     // so m_data shouldn't be reuploaded
     m_data = data;
+    ++m_dataRevision;
 }
 
 void Buffer::forceDataUpload()
@@ -121,6 +124,8 @@ void Buffer::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
             const bool dirty = m_data != newData;
             m_bufferDirty |= dirty;
             m_data = newData;
+            if (dirty)
+                ++m_dataRevision;
 
             // Since frontend applies partial updates to its m_data
             // if we enter this code block, there's no problem in actually
@@ -138,6 +143,7 @@ void Buffer::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
                 m_data.replace(updateData.offset, updateData.data.size(), updateData.data);
                 m_bufferUpdates.push_back(updateData);
                 m_bufferDirty = true;
+                ++m_dataRevision;
             }
 
             const_cast<Qt3DCore::QBuffer *>(node)->setProperty(Qt3DCore::QBufferPrivate::UpdateDataPropertyName, {});
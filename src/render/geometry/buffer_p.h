@@ -81,6 +81,8 @@ public:
     inline QByteArray data() const { return m_data; }
     inline std::vector<Qt3DCore::QBufferUpdate> &pendingBufferUpdates() { return m_bufferUpdates; }
     inline bool isDirty() const { return m_bufferDirty; }
+    // Incremented each time the content of the buffer changes
+    inline uint dataRevision() const { return m_dataRevision; }
     inline Qt3DCore::QBuffer::AccessType access() const { return m_access; }
     void unsetDirty();
 
@@ -91,6 +93,7 @@ private:
     QByteArray m_data;
     std::vector<Qt3DCore::QBufferUpdate> m_bufferUpdates;
     bool m_bufferDirty;
+    uint m_dataRevision;
     Qt3DCore::QBuffer::AccessType m_access;
     BufferManager *m_manager;
 };
@@ -11,6 +11,7 @@ HEADERS += \
     $$PWD/qgeometryrenderer_p.h \
     $$PWD/qmesh.h \
     $$PWD/qmesh_p.h \
+    $$PWD/meshcache_p.h \
     $$PWD/armature_p.h \
     $$PWD/skeleton_p.h \
     $$PWD/gltfskeletonloader_p.h \
@@ -29,6 +30,7 @@ SOURCES += \
     $$PWD/geometryrenderermanager.cpp \
     $$PWD/qgeometryrenderer.cpp \
     $$PWD/qmesh.cpp \
+    $$PWD/meshcache.cpp \
     $$PWD/armature.cpp \
     $$PWD/skeleton.cpp \
     $$PWD/gltfskeletonloader.cpp \
@@ -39,6 +39,9 @@
 
 #include "geometryrenderer_p.h"
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/abstractrenderer_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/meshbvh_p.h>
 #include <Qt3DRender/private/qboundingvolume_p.h>
 #include <Qt3DRender/private/qgeometryrenderer_p.h>
 #include <Qt3DRender/private/qmesh_p.h>
@@ -237,6 +240,8 @@ Qt3DCore::QBackendNode *GeometryRendererFunctor::get(Qt3DCore::QNodeId id) const
 
 void GeometryRendererFunctor::destroy(Qt3DCore::QNodeId id) const
 {
+    if (m_renderer != nullptr && m_renderer->nodeManagers() != nullptr)
+        m_renderer->nodeManagers()->meshBVHCache()->release(id);
     m_manager->releaseResource(id);
 }
 
@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "meshcache_p.h"
+
+#include <Qt3DCore/qgeometry.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace {
+
+// Default budget in MB, kept small as the cache is process wide and holds on
+// to the data of meshes which may no longer be used. Can be overridden with
+// QT3D_MESH_CACHE_SIZE (0 disables the cache)
+const int defaultMaximumSizeMB = 32;
+
+qsizetype maximumSizeFromEnvironment()
+{
+    bool ok = false;
+    const int sizeMB = qEnvironmentVariableIntValue("QT3D_MESH_CACHE_SIZE", &ok);
+    return qsizetype(ok ? std::max(sizeMB, 0) : defaultMaximumSizeMB) * 1024 * 1024;
+}
+
+} // anonymous
+
+Q_GLOBAL_STATIC(MeshCache, meshCache)
+
+/*!
+    \internal
+    \class Qt3DRender::MeshCache
+
+    Keeps the geometry of the meshes loaded by MeshLoaderFunctor so that the
+    same file (or downloaded content) with the same mesh name is only parsed
+    once. Every lookup returns a new QGeometry whose buffers share their data
+    with the cached one, the data itself is never copied.
+
+    Entries are evicted in least recently used order once the total size of
+    their buffers exceeds maximumSize().
+ */
+MeshCache::MeshCache()
+{
+    m_entries.setMaxCost(maximumSizeFromEnvironment());
+}
+
+MeshCache *MeshCache::instance()
+{
+    return meshCache();
+}
+
+/*!
+    \internal
+    Returns a geometry for \a key, calling \a load to parse it if it isn't
+    cached yet. Concurrent requests for the same key wait for the first one
+    to complete rather than parsing the content again. The caller takes
+    ownership of the returned geometry.
+ */
+Qt3DCore::QGeometry *MeshCache::geometry(const MeshCacheKey &key,
+                                         const std::function<Qt3DCore::QGeometry *()> &load)
+{
+    QSharedPointer<QMutex> keyMutex;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (const Entry *entry = m_entries.object(key))
+            return createGeometry(*entry);
+        if (m_entries.maxCost() <= 0)
+            return load();
+        QSharedPointer<QMutex> &loadingMutex = m_loadingKeys[key];
+        if (loadingMutex.isNull())
+            loadingMutex.reset(new QMutex);
+        keyMutex = loadingMutex;
+    }
+
+    QMutexLocker keyLock(keyMutex.data());
+    {
+        // Another thread may have loaded it while we were waiting
+        QMutexLocker lock(&m_mutex);
+        if (const Entry *entry = m_entries.object(key))
+            return createGeometry(*entry);
+    }
+
+    Qt3DCore::QGeometry *geometry = load();
+
+    QMutexLocker lock(&m_mutex);
+    if (geometry != nullptr) {
+        Entry *entry = createEntry(geometry);
+        // QCache takes ownership and discards entries larger than the budget
+        m_entries.insert(key, entry, std::max<qsizetype>(entry->byteSize, 1));
+    }
+    if (m_loadingKeys.value(key) == keyMutex)
+        m_loadingKeys.remove(key);
+    return geometry;
+}
+
+void MeshCache::setMaximumSize(qsizetype bytes)
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.setMaxCost(std::max<qsizetype>(bytes, 0));
+}
+
+qsizetype MeshCache::maximumSize() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_entries.maxCost();
+}
+
+qsizetype MeshCache::size() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_entries.totalCost();
+}
+
+int MeshCache::count() const
+{
+    QMutexLocker lock(&m_mutex);
+    return int(m_entries.count());
+}
+
+void MeshCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.clear();
+}
+
+MeshCache::Entry *MeshCache::createEntry(const Qt3DCore::QGeometry *geometry)
+{
+    Entry *entry = new Entry;
+    QList<Qt3DCore::QBuffer *> buffers;
+    const auto attributes = geometry->attributes();
+    entry->attributes.reserve(attributes.size());
+
+    for (const Qt3DCore::QAttribute *attribute : attributes) {
+        Qt3DCore::QBuffer *buffer = attribute->buffer();
+        int bufferIndex = -1;
+        if (buffer != nullptr) {
+            bufferIndex = int(buffers.indexOf(buffer));
+            if (bufferIndex < 0) {
+                bufferIndex = int(buffers.size());
+                buffers.push_back(buffer);
+                const QByteArray data = buffer->data();
+                entry->buffers.push_back({ data, buffer->usage(), buffer->accessType() });
+                entry->byteSize += data.size();
+            }
+        }
+
+        if (attribute == geometry->boundingVolumePositionAttribute())
+            entry->boundingVolumePositionAttribute = int(entry->attributes.size());
+
+        entry->attributes.push_back({ attribute->name(),
+                                      attribute->attributeType(),
+                                      attribute->vertexBaseType(),
+                                      attribute->vertexSize(),
+                                      attribute->count(),
+                                      attribute->byteStride(),
+                                      attribute->byteOffset(),
+                                      attribute->divisor(),
+                                      bufferIndex });
+    }
+    return entry;
+}
+
+Qt3DCore::QGeometry *MeshCache::createGeometry(const Entry &entry)
+{
+    Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry;
+
+    QList<Qt3DCore::QBuffer *> buffers;
+    buffers.reserve(entry.buffers.size());
+    for (const BufferData &bufferData : entry.buffers) {
+        Qt3DCore::QBuffer *buffer = new Qt3DCore::QBuffer(geometry);
+        buffer->setUsage(bufferData.usage);
+        buffer->setAccessType(bufferData.accessType);
+        buffer->setData(bufferData.data);
+        buffers.push_back(buffer);
+    }
+
+    for (int i = 0, m = int(entry.attributes.size()); i < m; ++i) {
+        const AttributeData &attributeData = entry.attributes.at(i);
+        Qt3DCore::QAttribute *attribute = new Qt3DCore::QAttribute(geometry);
+        attribute->setName(attributeData.name);
+        attribute->setAttributeType(attributeData.attributeType);
+        attribute->setVertexBaseType(attributeData.vertexBaseType);
+        attribute->setVertexSize(attributeData.vertexSize);
+        attribute->setCount(attributeData.count);
+        attribute->setByteStride(attributeData.byteStride);
+        attribute->setByteOffset(attributeData.byteOffset);
+        attribute->setDivisor(attributeData.divisor);
+        if (attributeData.bufferIndex >= 0)
+            attribute->setBuffer(buffers.at(attributeData.bufferIndex));
+        geometry->addAttribute(attribute);
+
+        if (i == entry.boundingVolumePositionAttribute)
+            geometry->setBoundingVolumePositionAttribute(attribute);
+    }
+
+    return geometry;
+}
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_MESHCACHE_P_H
+#define QT3DRENDER_MESHCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsharedpointer.h>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+class QGeometry;
+}
+
+namespace Qt3DRender {
+
+// Identifies the content a mesh is loaded from
+struct MeshCacheKey
+{
+    QString source;     // Canonical file path or url
+    QString meshName;
+    QByteArray version; // File modification time and size or hash of the downloaded data
+};
+
+inline bool operator==(const MeshCacheKey &a, const MeshCacheKey &b) noexcept
+{
+    return a.source == b.source && a.meshName == b.meshName && a.version == b.version;
+}
+
+inline size_t qHash(const MeshCacheKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.source, key.meshName, key.version);
+}
+
+class Q_AUTOTEST_EXPORT MeshCache
+{
+public:
+    MeshCache();
+
+    static MeshCache *instance();
+
+    Qt3DCore::QGeometry *geometry(const MeshCacheKey &key,
+                                  const std::function<Qt3DCore::QGeometry *()> &load);
+
+    void setMaximumSize(qsizetype bytes);
+    qsizetype maximumSize() const;
+    qsizetype size() const;
+    int count() const;
+    void clear();
+
+private:
+    struct BufferData {
+        QByteArray data;
+        Qt3DCore::QBuffer::UsageType usage;
+        Qt3DCore::QBuffer::AccessType accessType;
+    };
+
+    struct AttributeData {
+        QString name;
+        Qt3DCore::QAttribute::AttributeType attributeType;
+        Qt3DCore::QAttribute::VertexBaseType vertexBaseType;
+        uint vertexSize;
+        uint count;
+        uint byteStride;
+        uint byteOffset;
+        uint divisor;
+        int bufferIndex;
+    };
+
+    // The buffers data is implicitly shared with every geometry created from it
+    struct Entry {
+        QList<BufferData> buffers;
+        QList<AttributeData> attributes;
+        int boundingVolumePositionAttribute = -1;
+        qsizetype byteSize = 0;
+    };
+
+    static Entry *createEntry(const Qt3DCore::QGeometry *geometry);
+    static Qt3DCore::QGeometry *createGeometry(const Entry &entry);
+
+    mutable QMutex m_mutex;
+    QCache<MeshCacheKey, Entry> m_entries;
+    // Held while a key is being loaded so that concurrent loads of the same
+    // content wait for the first one instead of parsing it again
+    QHash<MeshCacheKey, QSharedPointer<QMutex>> m_loadingKeys;
+};
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_MESHCACHE_P_H
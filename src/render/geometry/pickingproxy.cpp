@@ -39,6 +39,9 @@
 
 #include "pickingproxy_p.h"
 #include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/abstractrenderer_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/meshbvh_p.h>
 #include <Qt3DRender/private/qpickingproxy_p.h>
 #include <Qt3DCore/private/qgeometryview_p.h>
 #include <Qt3DCore/private/qnode_p.h>
@@ -169,6 +172,8 @@ Qt3DCore::QBackendNode *PickingProxyFunctor::get(Qt3DCore::QNodeId id) const
 
 void PickingProxyFunctor::destroy(Qt3DCore::QNodeId id) const
 {
+    if (m_renderer != nullptr && m_renderer->nodeManagers() != nullptr)
+        m_renderer->nodeManagers()->meshBVHCache()->release(id);
     m_manager->releaseResource(id);
 }
 
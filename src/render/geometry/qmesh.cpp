@@ -48,6 +48,8 @@
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
 #include <Qt3DRender/QRenderAspect>
 #include <Qt3DCore/QAspectEngine>
 #include <Qt3DCore/private/qscene_p.h>
@@ -59,6 +61,7 @@
 #include <Qt3DRender/private/renderlogging_p.h>
 #include <Qt3DRender/private/qgeometryloaderfactory_p.h>
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/meshcache_p.h>
 
 #include <algorithm>
 
@@ -339,6 +342,33 @@ Qt3DCore::QGeometry *MeshLoaderFunctor::operator()()
             ext << finfo.suffix();
     }
 
+    Qt3DCore::QGeometry *geometry = MeshCache::instance()->geometry(cacheKey(), [this, &ext] {
+        return loadGeometry(ext);
+    });
+    if (geometry != nullptr)
+        m_status = QMesh::Ready;
+    return geometry;
+}
+
+MeshCacheKey MeshLoaderFunctor::cacheKey() const
+{
+    MeshCacheKey key;
+    key.meshName = m_meshName;
+    if (m_sourceData.isEmpty()) {
+        const QFileInfo finfo(Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(m_sourcePath));
+        const QString canonicalPath = finfo.canonicalFilePath();
+        key.source = canonicalPath.isEmpty() ? finfo.filePath() : canonicalPath;
+        key.version = QByteArray::number(finfo.lastModified().toMSecsSinceEpoch())
+                + '/' + QByteArray::number(finfo.size());
+    } else {
+        key.source = m_sourcePath.toString();
+        key.version = QCryptographicHash::hash(m_sourceData, QCryptographicHash::Sha1);
+    }
+    return key;
+}
+
+Qt3DCore::QGeometry *MeshLoaderFunctor::loadGeometry(const QStringList &ext)
+{
     QScopedPointer<QGeometryLoaderInterface> loader;
     for (const QString &e: qAsConst(ext)) {
         loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), e));
@@ -69,6 +69,8 @@ namespace Render {
 class NodeManagers;
 }
 
+struct MeshCacheKey;
+
 class Q_3DRENDERSHARED_PRIVATE_EXPORT QMeshPrivate : public QGeometryRendererPrivate
 {
 public:
@@ -123,6 +125,9 @@ public :
     QT3D_FUNCTOR(MeshLoaderFunctor)
 
 private:
+    MeshCacheKey cacheKey() const;
+    Qt3DCore::QGeometry *loadGeometry(const QStringList &ext);
+
     Qt3DCore::QNodeId m_mesh;
     QUrl m_sourcePath;
     QString m_meshName;
@@ -63,6 +63,8 @@ Skeleton::Skeleton()
     : BackendNode(Qt3DCore::QBackendNode::ReadWrite)
     , m_status(Qt3DCore::QSkeletonLoader::NotReady)
     , m_createJoints(false)
+    , m_skinningPaletteRevision(0)
+    , m_skinningPaletteDirty(true)
     , m_dataType(Unknown)
     , m_skeletonManager(nullptr)
     , m_jointManager(nullptr)
@@ -140,7 +142,10 @@ void Skeleton::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     }
 
     auto d = Qt3DCore::QAbstractSkeletonPrivate::get(node);
-    m_skeletonData.localPoses = d->m_localPoses;
+    if (m_skeletonData.localPoses != d->m_localPoses) {
+        m_skeletonData.localPoses = d->m_localPoses;
+        m_skinningPaletteDirty = true;
+    }
 }
 
 void Skeleton::setStatus(QSkeletonLoader::Status status)
@@ -156,12 +161,24 @@ void Skeleton::clearData()
     m_skeletonData.localPoses.clear();
     m_skeletonData.jointNames.clear();
     m_skeletonData.jointIndices.clear();
+    m_inverseBindPoses.clear();
+    m_globalPoses.clear();
+    m_skinningPalette = UniformValue(0, UniformValue::ScalarValue);
+    m_skinningPaletteDirty = true;
 }
 
 void Skeleton::setSkeletonData(const SkeletonData &data)
 {
     m_skeletonData = data;
-    m_skinningPalette.resize(m_skeletonData.joints.size());
+
+    const size_t jointCount = size_t(m_skeletonData.joints.size());
+    m_inverseBindPoses.clear();
+    m_inverseBindPoses.reserve(jointCount);
+    for (const JointInfo &joint : qAsConst(m_skeletonData.joints))
+        m_inverseBindPoses.push_back(Matrix4x4(joint.inverseBindPose));
+    m_globalPoses.resize(jointCount);
+    m_skinningPalette = UniformValue(int(jointCount * 16 * sizeof(float)), UniformValue::ScalarValue);
+    m_skinningPaletteDirty = true;
 }
 
 // Called from UpdateSkinningPaletteJob
@@ -172,25 +189,61 @@ void Skeleton::setLocalPose(HJoint jointHandle, const Qt3DCore::Sqt &localPose)
     const int jointIndex = m_skeletonData.jointIndices.value(jointHandle, -1);
     Q_ASSERT(jointIndex != -1);
     m_skeletonData.localPoses[jointIndex] = localPose;
+    m_skinningPaletteDirty = true;
+}
+
+namespace {
+
+// Same as Sqt::toMatrix but without going through QMatrix4x4 and the
+// successive translate, rotate and scale multiplications
+Matrix4x4 sqtToMatrix(const Sqt &sqt)
+{
+    const float x = sqt.rotation.x();
+    const float y = sqt.rotation.y();
+    const float z = sqt.rotation.z();
+    const float w = sqt.rotation.scalar();
+    const float xx = x * x;
+    const float yy = y * y;
+    const float zz = z * z;
+    const float xy = x * y;
+    const float xz = x * z;
+    const float yz = y * z;
+    const float xw = x * w;
+    const float yw = y * w;
+    const float zw = z * w;
+    const QVector3D &s = sqt.scale;
+    const QVector3D &t = sqt.translation;
+
+    return Matrix4x4((1.0f - 2.0f * (yy + zz)) * s.x(), 2.0f * (xy - zw) * s.y(), 2.0f * (xz + yw) * s.z(), t.x(),
+                     2.0f * (xy + zw) * s.x(), (1.0f - 2.0f * (xx + zz)) * s.y(), 2.0f * (yz - xw) * s.z(), t.y(),
+                     2.0f * (xz - yw) * s.x(), 2.0f * (yz + xw) * s.y(), (1.0f - 2.0f * (xx + yy)) * s.z(), t.z(),
+                     0.0f, 0.0f, 0.0f, 1.0f);
 }
 
-QVector<QMatrix4x4> Skeleton::calculateSkinningMatrixPalette()
+} // anonymous
+
+// Called from UpdateSkinningPaletteJob
+void Skeleton::updateSkinningPalette()
 {
     const QVector<Sqt> &localPoses = m_skeletonData.localPoses;
-    QVector<JointInfo> &joints = m_skeletonData.joints;
-    for (int i = 0; i < m_skeletonData.joints.size(); ++i) {
-        // Calculate the global pose of this joint
-        JointInfo &joint = joints[i];
-        if (joint.parentIndex == -1) {
-            joint.globalPose = localPoses[i].toMatrix();
-        } else {
-            JointInfo &parentJoint = joints[joint.parentIndex];
-            joint.globalPose = parentJoint.globalPose * localPoses[i].toMatrix();
-        }
+    const QVector<JointInfo> &joints = m_skeletonData.joints;
+    float *palette = m_skinningPalette.data<float>();
+
+    // Parents come before their children in the joints
+    for (int i = 0, m = joints.size(); i < m; ++i) {
+        const int parentIndex = joints[i].parentIndex;
+        if (parentIndex == -1)
+            m_globalPoses[i] = sqtToMatrix(localPoses[i]);
+        else
+            m_globalPoses[i] = m_globalPoses[parentIndex] * sqtToMatrix(localPoses[i]);
 
-        m_skinningPalette[i] = joint.globalPose * joint.inverseBindPose;
+        // All the Matrix4x4 flavors start with their 16 floats in column major order
+        const Matrix4x4 skinningMatrix = m_globalPoses[i] * m_inverseBindPoses[i];
+        memcpy(palette + 16 * i, &skinningMatrix, 16 * sizeof(float));
     }
-    return m_skinningPalette;
+
+    ++m_skinningPaletteRevision;
+    m_skinningPaletteDirty = false;
 }
 
 
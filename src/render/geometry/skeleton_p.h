@@ -54,7 +54,9 @@
 #include <Qt3DRender/private/backendnode_p.h>
 #include <Qt3DRender/private/skeletondata_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
+#include <Qt3DRender/private/uniform_p.h>
 #include <Qt3DCore/qskeletonloader.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
 
 #include <QtGui/qmatrix4x4.h>
 #include <QDebug>
@@ -113,7 +115,12 @@ public:
 
     // Called from jobs
     void setLocalPose(HJoint jointHandle, const Qt3DCore::Sqt &localPose);
-    QVector<QMatrix4x4> calculateSkinningMatrixPalette();
+    bool isSkinningPaletteDirty() const { return m_skinningPaletteDirty; }
+    void updateSkinningPalette();
+    // Packed array of column major mat4, shared by the armatures using the skeleton
+    const UniformValue &skinningPalette() const { return m_skinningPalette; }
+    // Incremented each time the skinning palette is recomputed
+    uint skinningPaletteRevision() const { return m_skinningPaletteRevision; }
 
     void clearData();
     void setSkeletonData(const SkeletonData &data);
@@ -127,7 +134,11 @@ public:
 #endif
 
 private:
-    QVector<QMatrix4x4> m_skinningPalette;
+    std::vector<Matrix4x4> m_inverseBindPoses;
+    std::vector<Matrix4x4> m_globalPoses;
+    UniformValue m_skinningPalette;
+    uint m_skinningPaletteRevision;
+    bool m_skinningPaletteDirty;
 
     // QSkeletonLoader Properties
     QUrl m_source;
@@ -79,7 +79,6 @@ struct Q_AUTOTEST_EXPORT JointInfo
     }
 
     QMatrix4x4 inverseBindPose;
-    QMatrix4x4 globalPose;
     int parentIndex;
 };
 
@@ -62,6 +62,7 @@ AbstractPickingJob::AbstractPickingJob()
     , m_node(nullptr)
     , m_frameGraphRoot(nullptr)
     , m_renderSettings(nullptr)
+    , m_sceneBVH(nullptr)
     , m_oneEnabledAtLeast(false)
 {
 }
@@ -72,6 +73,7 @@ AbstractPickingJob::AbstractPickingJob(Qt3DCore::QAspectJobPrivate &dd)
     , m_node(nullptr)
     , m_frameGraphRoot(nullptr)
     , m_renderSettings(nullptr)
+    , m_sceneBVH(nullptr)
     , m_oneEnabledAtLeast(false)
 {
 
@@ -97,6 +99,11 @@ void AbstractPickingJob::setManagers(NodeManagers *manager)
     m_manager = manager;
 }
 
+void AbstractPickingJob::setSceneBVH(const SceneBVH *sceneBVH)
+{
+    m_sceneBVH = sceneBVH;
+}
+
 void AbstractPickingJob::run()
 {
     Q_ASSERT(m_frameGraphRoot && m_renderSettings && m_node && m_manager);
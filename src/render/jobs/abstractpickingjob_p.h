@@ -72,6 +72,7 @@ class Entity;
 class Renderer;
 class NodeManagers;
 class RenderSettings;
+class SceneBVH;
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT AbstractPickingJob : public Qt3DCore::QAspectJob
 {
@@ -82,6 +83,7 @@ public:
     void setFrameGraphRoot(FrameGraphNode *frameGraphRoot);
     void setRenderSettings(RenderSettings *settings);
     void setManagers(NodeManagers *manager);
+    void setSceneBVH(const SceneBVH *sceneBVH);
 
     // public for unit tests
     virtual bool runHelper() = 0;
@@ -99,6 +101,7 @@ protected:
     Entity *m_node;
     FrameGraphNode *m_frameGraphRoot;
     RenderSettings *m_renderSettings;
+    const SceneBVH *m_sceneBVH;
 
     bool m_oneEnabledAtLeast;
 
@@ -42,6 +42,7 @@
 
 #include <Qt3DCore/qboundingvolume.h>
 #include <Qt3DCore/private/qabstractfrontendnodemanager_p.h>
+#include <Qt3DCore/private/boundingvolumekernels_p.h>
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DCore/private/qaspectjobmanager_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
@@ -88,6 +89,31 @@ public:
                bool primitiveRestartEnabled,
                int primitiveRestartIndex)
     {
+        if (Qt3DCore::BoundingVolumeKernels::isAvailable()
+                && positionAttribute->vertexBaseType() == QAttribute::Float
+                && positionAttribute->vertexSize() >= 3) {
+            const QByteArray vertexData = m_manager->lookupResource<Buffer, BufferManager>(positionAttribute->bufferId())->data();
+            const QByteArray indexData = indexAttribute
+                    ? m_manager->lookupResource<Buffer, BufferManager>(indexAttribute->bufferId())->data()
+                    : QByteArray();
+
+            Qt3DCore::BoundingVolumeKernelInput input;
+            input.setVertexData(vertexData, positionAttribute->byteOffset(), positionAttribute->byteStride());
+            if (indexAttribute)
+                input.setIndexData(indexData, indexAttribute->byteOffset(), indexAttribute->vertexBaseType());
+            input.count = uint(drawVertexCount);
+            input.primitiveRestartEnabled = primitiveRestartEnabled;
+            input.primitiveRestartIndex = primitiveRestartIndex;
+
+            Qt3DCore::BoundingVolumeKernelResult result;
+            if (Qt3DCore::BoundingVolumeKernels::compute(input, result)) {
+                m_min = result.min;
+                m_max = result.max;
+                m_volume = Qt3DRender::Render::Sphere(Vector3D(result.center), result.radius);
+                return !m_volume.isNull();
+            }
+        }
+
         FindExtremePoints findExtremePoints(m_manager);
         if (!findExtremePoints.apply(positionAttribute, indexAttribute, drawVertexCount,
                                      primitiveRestartEnabled, primitiveRestartIndex))
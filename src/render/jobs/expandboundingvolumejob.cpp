@@ -53,32 +53,6 @@ QT_BEGIN_NAMESPACE
 namespace Qt3DRender {
 namespace Render {
 
-namespace {
-
-void expandWorldBoundingVolume(NodeManagers *manager, Entity *node)
-{
-    // Go to the nodes that have the most depth
-    const auto &childrenHandles = node->childrenHandles();
-    for (const HEntity &handle : childrenHandles) {
-        Entity *c = manager->renderNodesManager()->data(handle);
-        if (c && c->isEnabled())
-            expandWorldBoundingVolume(manager, c);
-    }
-
-    // Then traverse back from leaf to root
-    // Initialize parent bounding volume to be equal to that of the first child
-    if (!childrenHandles.empty()) {
-        Qt3DRender::Render::Sphere *parentBoundingVolume = node->worldBoundingVolumeWithChildren();
-        for (const HEntity &handle : childrenHandles) {
-            Entity *c = manager->renderNodesManager()->data(handle);
-            if (c && c->isEnabled())
-                parentBoundingVolume->expandToContain(*c->worldBoundingVolumeWithChildren());
-        }
-    }
-}
-
-}
-
 ExpandBoundingVolumeJob::ExpandBoundingVolumeJob()
     : m_node(nullptr)
     , m_manager(nullptr)
@@ -101,9 +75,56 @@ void ExpandBoundingVolumeJob::run()
     // Expand worldBoundingVolumeWithChildren of each node that has children by the
     // bounding volumes of the children.
 
-    // TODO: Implement this using a parallel_for
     qCDebug(Jobs) << "Entering" << Q_FUNC_INFO << QThread::currentThread();
-    expandWorldBoundingVolume(m_manager, m_node);
+    EntityManager *entityManager = m_manager->renderNodesManager();
+    FlatEntityHierarchy *hierarchy = entityManager->flatHierarchy();
+    const uint hierarchyRevision = entityManager->hierarchyRevision();
+    hierarchy->update(m_node, hierarchyRevision);
+
+    // An entity is expanded into its parent if it and all its ancestors,
+    // the root aside, are enabled. Parents come first in the arrays.
+    const uint count = uint(hierarchy->size());
+    m_reachable.resize(count);
+    for (uint i = 0; i < count; ++i) {
+        const int parent = hierarchy->parentIndex(i);
+        const quint8 reachable = parent < 0 || (m_reachable[parent] && hierarchy->entity(i)->isEnabled());
+        // Whether its volume is expanded into its parent changed
+        if (reachable != m_reachable[i])
+            hierarchy->markBoundsChanged(i);
+        m_reachable[i] = reachable;
+    }
+
+    // Children come after their parent, walking backwards guarantees their
+    // volumes are final by the time the parent is expanded
+    m_changedIndices.clear();
+    for (uint i = count; i-- > 0; ) {
+        const uint end = hierarchy->subtreeEnd(i);
+        if (m_reachable[i] && end != i + 1) {
+            Sphere *parentBoundingVolume = hierarchy->entity(i)->worldBoundingVolumeWithChildren();
+            for (uint child = i + 1; child < end; child = hierarchy->subtreeEnd(child)) {
+                if (m_reachable[child])
+                    parentBoundingVolume->expandToContain(*hierarchy->entity(child)->worldBoundingVolumeWithChildren());
+            }
+        }
+
+        // The volume of the parent may have changed along with this one
+        if (hierarchy->isBoundsChanged(i)) {
+            m_changedIndices.push_back(i);
+            const int parent = hierarchy->parentIndex(i);
+            if (parent >= 0)
+                hierarchy->markBoundsChanged(uint(parent));
+            hierarchy->unsetBoundsChanged(i);
+        }
+    }
+
+    // Only collect the entities again if the scene hierarchy has changed
+    if (m_boundingSpheres.root() != m_node || m_boundingSpheres.hierarchyRevision() != hierarchyRevision) {
+        m_boundingSpheres.rebuild(*hierarchy);
+        m_sceneBVH.rebuild(m_boundingSpheres);
+    } else {
+        m_sceneBVH.refit(m_changedIndices);
+    }
+    m_boundingSpheres.update();
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
 
@@ -53,6 +53,8 @@
 
 #include <Qt3DCore/qaspectjob.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/private/boundingspherearray_p.h>
+#include <Qt3DRender/private/scenebvh_p.h>
 
 #include <QSharedPointer>
 
@@ -73,9 +75,18 @@ public:
     void setManagers(NodeManagers *manager);
     void run() override;
 
+    // Flat copy of the expanded volumes, refreshed each time the job runs
+    const BoundingSphereArray *boundingSpheres() const { return &m_boundingSpheres; }
+    // Hierarchy over the volumes of all entities, refit each time the job runs
+    const SceneBVH *sceneBVH() const { return &m_sceneBVH; }
+
 private:
     Entity *m_node;
     NodeManagers *m_manager;
+    BoundingSphereArray m_boundingSpheres;
+    SceneBVH m_sceneBVH;
+    std::vector<quint8> m_reachable;
+    std::vector<uint> m_changedIndices;
 };
 
 typedef QSharedPointer<ExpandBoundingVolumeJob> ExpandBoundingVolumeJobPtr;
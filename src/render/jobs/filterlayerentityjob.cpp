@@ -43,6 +43,10 @@
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DRender/private/layerfilternode_p.h>
+#include <Qt3DCore/private/qt3dcore-config_p.h>
+#include <QtCore/qvarlengtharray.h>
+#include <private/qsimd_p.h>
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -75,105 +79,118 @@ void FilterLayerEntityJob::run()
     std::sort(m_filteredEntities.begin(), m_filteredEntities.end());
 }
 
+// Filtering against a set of Layers for a single entity, mostly used for picking
 void FilterLayerEntityJob::filterEntityAgainstLayers(Entity *entity,
                                                      const Qt3DCore::QNodeIdVector &layerIds,
                                                      const QLayerFilter::FilterMode filterMode)
 {
-    // Perform filtering
-    switch (filterMode) {
-    case QLayerFilter::AcceptAnyMatchingLayers: {
-        filterAcceptAnyMatchingLayers(entity, layerIds);
-        break;
-    }
-    case QLayerFilter::AcceptAllMatchingLayers: {
-        filterAcceptAllMatchingLayers(entity, layerIds);
-        break;
-    }
-    case QLayerFilter::DiscardAnyMatchingLayers: {
-        filterDiscardAnyMatchingLayers(entity, layerIds);
-        break;
-    }
-    case QLayerFilter::DiscardAllMatchingLayers: {
-        filterDiscardAllMatchingLayers(entity, layerIds);
-        break;
-    }
-    default:
-        Q_UNREACHABLE();
-    }
+    if (matchesLayers(entity->layerMask(), layerMask(layerIds, false), filterMode))
+        m_filteredEntities.push_back(entity);
 }
 
-// We accept the entity if it contains any of the layers that are in the layer filter
-void FilterLayerEntityJob::filterAcceptAnyMatchingLayers(Entity *entity,
-                                                         const Qt3DCore::QNodeIdVector &layerIds)
+// Layers which are unknown to the backend or which haven't been assigned an
+// index yet can't belong to any entity, they are mapped to UnknownLayerIndex
+LayerMask FilterLayerEntityJob::layerMask(const Qt3DCore::QNodeIdVector &layerIds,
+                                          bool enabledLayersOnly) const
 {
-    const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
+    LayerManager *layerManager = m_manager->layerManager();
+    LayerMask mask;
+
+    for (const Qt3DCore::QNodeId &layerId : layerIds) {
+        const Layer *backendLayer = layerManager->lookupResource(layerId);
+        if (enabledLayersOnly && (backendLayer == nullptr || !backendLayer->isEnabled()))
+            continue;
+        if (backendLayer == nullptr || backendLayer->layerIndex() < 0)
+            mask.setBit(LayerMask::UnknownLayerIndex);
+        else
+            mask.setBit(backendLayer->layerIndex());
+    }
+    return mask;
+}
 
-    for (const Qt3DCore::QNodeId &id : entityLayers) {
-        const bool layerAccepted = layerIds.contains(id);
+namespace {
 
-        if (layerAccepted) {
-            m_filteredEntities.push_back(entity);
-            break;
-        }
-    }
+// AcceptAny/DiscardAny test whether any of the filter layers is set on the
+// entity, AcceptAll/DiscardAll whether all of them are. The Discard modes
+// select the entities failing the test.
+inline bool testsAllLayers(QLayerFilter::FilterMode filterMode)
+{
+    return filterMode == QLayerFilter::AcceptAllMatchingLayers
+            || filterMode == QLayerFilter::DiscardAllMatchingLayers;
 }
 
-// We accept the entity if it contains all the layers that are in the layer
-// filter
-void FilterLayerEntityJob::filterAcceptAllMatchingLayers(Entity *entity,
-                                                         const Qt3DCore::QNodeIdVector &layerIds)
+inline bool discardsMatches(QLayerFilter::FilterMode filterMode)
 {
-    const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
-    int layersAccepted = 0;
+    return filterMode == QLayerFilter::DiscardAnyMatchingLayers
+            || filterMode == QLayerFilter::DiscardAllMatchingLayers;
+}
 
-    for (const Qt3DCore::QNodeId &id : entityLayers) {
-        if (layerIds.contains(id))
-            ++layersAccepted;
+inline bool layerTest(const quint64 *entityWords, const quint64 *filterWords, int wordCount, bool allLayers)
+{
+    quint64 result = 0;
+    if (allLayers) {
+        // Filter layers missing from the entity
+        for (int w = 0; w < wordCount; ++w)
+            result |= filterWords[w] & ~entityWords[w];
+        return result == 0;
     }
-
-    if (layersAccepted == layerIds.size())
-        m_filteredEntities.push_back(entity);
+    for (int w = 0; w < wordCount; ++w)
+        result |= filterWords[w] & entityWords[w];
+    return result != 0;
 }
 
-// We discard the entity if it contains any of the layers that are in the layer
-// filter
-// In other words that means we select an entity if one of its layers is not on
-// the layer filter
-void FilterLayerEntityJob::filterDiscardAnyMatchingLayers(Entity *entity,
-                                                          const Qt3DCore::QNodeIdVector &layerIds)
+// Writes 1 to accepted[i] when the layer mask i of entityWords matches
+void filterLayerMasks(const quint64 *entityWords, size_t entityCount, int wordsPerEntity,
+                      const quint64 *filterWords, QLayerFilter::FilterMode filterMode,
+                      quint8 *accepted)
 {
-    const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
-    bool entityCanBeDiscarded = false;
-
-    for (const Qt3DCore::QNodeId &id : entityLayers) {
-        if (layerIds.contains(id)) {
-            entityCanBeDiscarded =  true;
-            break;
+    const bool allLayers = testsAllLayers(filterMode);
+    const quint8 discard = discardsMatches(filterMode) ? 1 : 0;
+    size_t i = 0;
+
+    if (wordsPerEntity == 1) {
+        const quint64 filter = filterWords[0];
+#if QT_CONFIG(qt3d_simd_sse2) && (defined(__AVX2__) || defined(__SSE2__)) && defined(QT_COMPILER_SUPPORTS_SSE2)
+        // Two entities at a time, a 64 bit lane is zero when all its bytes are
+        const __m128i filters = _mm_set1_epi64x(qint64(filter));
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 2 <= entityCount; i += 2) {
+            const __m128i entities = _mm_loadu_si128(reinterpret_cast<const __m128i *>(entityWords + i));
+            const __m128i tested = allLayers ? _mm_andnot_si128(entities, filters)
+                                             : _mm_and_si128(entities, filters);
+            const int zeroBytes = _mm_movemask_epi8(_mm_cmpeq_epi8(tested, zero));
+            const quint8 lane0Zero = (zeroBytes & 0xff) == 0xff;
+            const quint8 lane1Zero = (zeroBytes & 0xff00) == 0xff00;
+            accepted[i] = (allLayers ? lane0Zero : !lane0Zero) ^ discard;
+            accepted[i + 1] = (allLayers ? lane1Zero : !lane1Zero) ^ discard;
+        }
+#endif
+        for (; i < entityCount; ++i) {
+            const quint64 tested = allLayers ? (filter & ~entityWords[i]) : (filter & entityWords[i]);
+            accepted[i] = (allLayers ? tested == 0 : tested != 0) ^ discard;
         }
+        return;
     }
 
-    if (!entityCanBeDiscarded)
-        m_filteredEntities.push_back(entity);
+    for (; i < entityCount; ++i)
+        accepted[i] = layerTest(entityWords + i * wordsPerEntity, filterWords, wordsPerEntity, allLayers) ^ discard;
 }
 
-// We discard the entity if it contains all of the layers that are in the layer
-// filter
-// In other words that means we select an entity if none of its layers are on
-// the layer filter
-void FilterLayerEntityJob::filterDiscardAllMatchingLayers(Entity *entity,
-                                                          const Qt3DCore::QNodeIdVector &layerIds)
-{
-    const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
-
-    int containedLayers = 0;
+} // anonymous
 
-    for (const Qt3DCore::QNodeId &id : layerIds) {
-        if (entityLayers.contains(id))
-            ++containedLayers;
+bool FilterLayerEntityJob::matchesLayers(const LayerMask &entityLayers,
+                                         const LayerMask &layers,
+                                         const QLayerFilter::FilterMode filterMode)
+{
+    const int wordCount = layers.wordCount();
+    QVarLengthArray<quint64, 4> entityWords(wordCount);
+    QVarLengthArray<quint64, 4> filterWords(wordCount);
+    for (int w = 0; w < wordCount; ++w) {
+        entityWords[w] = entityLayers.word(w);
+        filterWords[w] = layers.word(w);
     }
-
-    if (containedLayers != layerIds.size())
-        m_filteredEntities.push_back(entity);
+    return layerTest(entityWords.constData(), filterWords.constData(), wordCount, testsAllLayers(filterMode))
+            != discardsMatches(filterMode);
 }
 
 void FilterLayerEntityJob::filterLayerAndEntity()
@@ -192,28 +209,54 @@ void FilterLayerEntityJob::filterLayerAndEntity()
     }
 
     FrameGraphManager *frameGraphManager = m_manager->frameGraphManager();
-    LayerManager *layerManager = m_manager->layerManager();
+
+    // Only disabled layers are removed from the filters
+    std::vector<LayerMask> filterMasks;
+    std::vector<QLayerFilter::FilterMode> filterModes;
+    filterMasks.reserve(m_layerFilterIds.size());
+    filterModes.reserve(m_layerFilterIds.size());
+    int wordsPerEntity = 1;
 
     for (const Qt3DCore::QNodeId &layerFilterId : qAsConst(m_layerFilterIds)) {
         LayerFilterNode *layerFilter = static_cast<LayerFilterNode *>(frameGraphManager->lookupNode(layerFilterId));
-        Qt3DCore::QNodeIdVector layerIds = layerFilter->layerIds();
-
-        // Remove layerIds which are not active/enabled
-        for (int i = layerIds.size() - 1; i >= 0; --i) {
-            Layer *backendLayer = layerManager->lookupResource(layerIds.at(i));
-            if (backendLayer == nullptr || !backendLayer->isEnabled())
-                layerIds.removeAt(i);
-        }
-
-        const QLayerFilter::FilterMode filterMode = layerFilter->filterMode();
+        filterMasks.push_back(layerMask(layerFilter->layerIds(), true));
+        filterModes.push_back(layerFilter->filterMode());
+        wordsPerEntity = std::max(wordsPerEntity, filterMasks.back().wordCount());
+    }
 
-        // Perform filtering
-        for (Entity *entity : entitiesToFilter)
-            filterEntityAgainstLayers(entity, layerIds, filterMode);
+    // Flat copy of the entity masks, bits beyond the filter masks don't matter
+    const size_t entityCount = entitiesToFilter.size();
+    m_entityLayerMasks.resize(entityCount * wordsPerEntity);
+    for (size_t i = 0; i < entityCount; ++i) {
+        const LayerMask &entityLayers = entitiesToFilter[i]->layerMask();
+        for (int w = 0; w < wordsPerEntity; ++w)
+            m_entityLayerMasks[i * wordsPerEntity + w] = entityLayers.word(w);
+    }
 
-        // Entities to filter for the next frame are the filtered result of the
-        // current LayerFilter
-        entitiesToFilter = std::move(m_filteredEntities);
+    QVarLengthArray<quint64, 4> filterWords(wordsPerEntity);
+    for (size_t f = 0, m = filterMasks.size(); f < m; ++f) {
+        for (int w = 0; w < wordsPerEntity; ++w)
+            filterWords[w] = filterMasks[f].word(w);
+
+        const size_t count = entitiesToFilter.size();
+        m_accepted.resize(count);
+        filterLayerMasks(m_entityLayerMasks.data(), count, wordsPerEntity,
+                         filterWords.constData(), filterModes[f], m_accepted.data());
+
+        // Entities to filter for the next LayerFilter are the entities
+        // accepted by the current one
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!m_accepted[i])
+                continue;
+            if (kept != i) {
+                entitiesToFilter[kept] = entitiesToFilter[i];
+                std::copy_n(m_entityLayerMasks.begin() + i * wordsPerEntity, wordsPerEntity,
+                            m_entityLayerMasks.begin() + kept * wordsPerEntity);
+            }
+            ++kept;
+        }
+        entitiesToFilter.resize(kept);
     }
     m_filteredEntities = std::move(entitiesToFilter);
 }
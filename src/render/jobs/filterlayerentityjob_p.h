@@ -54,6 +54,7 @@
 #include <Qt3DCore/qaspectjob.h>
 #include <Qt3DCore/qnodeid.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/private/layermask_p.h>
 #include <Qt3DRender/qlayerfilter.h>
 
 QT_BEGIN_NAMESPACE
@@ -81,10 +82,9 @@ public:
     void run() final;
 
     void filterEntityAgainstLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds, const QLayerFilter::FilterMode filterMode);
-    void filterAcceptAnyMatchingLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds);
-    void filterAcceptAllMatchingLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds);
-    void filterDiscardAnyMatchingLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds);
-    void filterDiscardAllMatchingLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds);
+
+    LayerMask layerMask(const Qt3DCore::QNodeIdVector &layerIds, bool enabledLayersOnly) const;
+    static bool matchesLayers(const LayerMask &entityLayers, const LayerMask &layers, const QLayerFilter::FilterMode filterMode);
 
 private:
     void filterLayerAndEntity();
@@ -93,6 +93,10 @@ private:
     NodeManagers *m_manager;
     Qt3DCore::QNodeIdVector m_layerFilterIds;
     std::vector<Entity *> m_filteredEntities;
+
+    // Layer masks of the entities being filtered, wordsPerEntity words each
+    std::vector<quint64> m_entityLayerMasks;
+    std::vector<quint8> m_accepted;
 };
 
 typedef QSharedPointer<FilterLayerEntityJob> FilterLayerEntityJobPtr;
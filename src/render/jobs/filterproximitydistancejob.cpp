@@ -44,6 +44,7 @@
 #include <Qt3DRender/private/proximityfilter_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/scenebvh_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -58,6 +59,7 @@ int instanceCounter = 0;
 
 FilterProximityDistanceJob::FilterProximityDistanceJob()
     : m_manager(nullptr)
+    , m_sceneBVH(nullptr)
     , m_targetEntity(nullptr)
     , m_distanceThresholdSquared(0.)
 {
@@ -84,10 +86,13 @@ void FilterProximityDistanceJob::run()
     // otherwise it will be used as the base list of entities to filter
 
     if (hasProximityFilter()) {
-        selectAllEntities();
+        const bool gatherFromSceneBVH = canGatherFromSceneBVH();
+        if (!gatherFromSceneBVH)
+            selectAllEntities();
         std::vector<Entity *> entitiesToFilter = std::move(m_filteredEntities);
         FrameGraphManager *frameGraphManager = m_manager->frameGraphManager();
         EntityManager *entityManager = m_manager->renderNodesManager();
+        bool firstFilter = true;
 
         for (const Qt3DCore::QNodeId &proximityFilterId : qAsConst(m_proximityFilterIds)) {
             ProximityFilter *proximityFilter = static_cast<ProximityFilter *>(frameGraphManager->lookupNode(proximityFilterId));
@@ -100,6 +105,18 @@ void FilterProximityDistanceJob::run()
                 m_filteredEntities.clear();
                 return;
             }
+
+            // Only the entities close enough to the first target need testing
+            if (gatherFromSceneBVH && firstFilter) {
+                std::vector<uint> candidates;
+                m_sceneBVH->gatherNear(m_targetEntity->worldBoundingVolumeWithChildren()->center(),
+                                       proximityFilter->distanceThreshold(), candidates);
+                entitiesToFilter.reserve(candidates.size());
+                for (const uint index : candidates)
+                    entitiesToFilter.push_back(m_sceneBVH->entity(index));
+            }
+            firstFilter = false;
+
             // Otherwise we filter
             filterEntities(entitiesToFilter);
 
@@ -114,6 +131,15 @@ void FilterProximityDistanceJob::run()
     std::sort(m_filteredEntities.begin(), m_filteredEntities.end());
 }
 
+bool FilterProximityDistanceJob::canGatherFromSceneBVH() const
+{
+    // The hierarchy must be up to date and cover all the entities
+    const EntityManager *entityManager = m_manager->renderNodesManager();
+    return m_sceneBVH != nullptr
+            && m_sceneBVH->hierarchyRevision() == entityManager->hierarchyRevision()
+            && m_sceneBVH->size() == entityManager->activeHandles().size();
+}
+
 void FilterProximityDistanceJob::selectAllEntities()
 {
     EntityManager *entityManager = m_manager->renderNodesManager();
@@ -63,6 +63,7 @@ namespace Render {
 
 class Entity;
 class NodeManagers;
+class SceneBVH;
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT FilterProximityDistanceJob : public Qt3DCore::QAspectJob
 {
@@ -71,6 +72,8 @@ public:
     ~FilterProximityDistanceJob();
 
     inline void setManager(NodeManagers *manager) { m_manager = manager; }
+    // When set, only the entities near the first target are filtered
+    inline void setSceneBVH(const SceneBVH *sceneBVH) { m_sceneBVH = sceneBVH; }
     inline void setProximityFilterIds(const Qt3DCore::QNodeIdVector &proximityFilterIds) { m_proximityFilterIds = proximityFilterIds; }
     inline bool hasProximityFilter() const { return !m_proximityFilterIds.empty(); }
 
@@ -86,10 +89,12 @@ public:
 #endif
 
 private:
+    bool canGatherFromSceneBVH() const;
     void selectAllEntities();
     void filterEntities(const std::vector<Entity *> &entitiesToFilter);
 
     NodeManagers *m_manager;
+    const SceneBVH *m_sceneBVH;
     Qt3DCore::QNodeIdVector m_proximityFilterIds;
     Entity *m_targetEntity;
     float m_distanceThresholdSquared;
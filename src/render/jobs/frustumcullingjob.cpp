@@ -44,6 +44,11 @@
 #include <Qt3DRender/private/sphere_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/boundingspherearray_p.h>
+#include <Qt3DRender/private/genericlambdajob_p.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -53,15 +58,44 @@ namespace Render {
 
 namespace {
 int instanceCounter = 0;
+
+// Below that, splitting the culling across threads costs more than it saves
+const uint MinSpheresPerThread = 4096;
 } // anonymous
 
 FrustumCullingJob::FrustumCullingJob()
     : Qt3DCore::QAspectJob()
     , m_root(nullptr)
     , m_manager(nullptr)
+    , m_boundingSpheres(nullptr)
+    , m_lastRejectingPlanesRevision(0)
     , m_active(false)
+    , m_prepared(false)
+    , m_cullBoundingSpheres(false)
 {
-    SET_JOB_RUN_STAT_TYPE(this, JobTypes::FrustumCulling, instanceCounter++)
+    const int instance = instanceCounter++;
+    SET_JOB_RUN_STAT_TYPE(this, JobTypes::FrustumCulling, instance)
+
+    // Large flat arrays are culled by chunk jobs, this job gathers their
+    // results once they are all done
+    const int chunkCount = Qt3DCore::QAspectJobManager::idealThreadCount();
+    if (chunkCount > 1) {
+        using ChunkJobPtr = GenericLambdaJobPtr<std::function<void ()>>;
+        const ChunkJobPtr prepareJob = ChunkJobPtr::create([this] {
+            if (m_active)
+                prepare();
+        }, JobTypes::PrepareFrustumCulling, "PrepareFrustumCulling", instance);
+        m_chunkJobs.push_back(prepareJob);
+        for (int i = 0; i < chunkCount; ++i) {
+            const ChunkJobPtr chunkJob = ChunkJobPtr::create([this, i] {
+                if (m_prepared)
+                    cullChunk(size_t(i));
+            }, JobTypes::FrustumCullingChunk, "FrustumCullingChunk", instance);
+            chunkJob->addDependency(prepareJob);
+            addDependency(chunkJob);
+            m_chunkJobs.push_back(chunkJob);
+        }
+    }
 }
 
 FrustumCullingJob::~FrustumCullingJob()
@@ -75,21 +109,174 @@ void FrustumCullingJob::run()
     if (!m_active)
         return;
 
+    // Without the chunk jobs, e.g. when run on its own, everything is
+    // culled here
+    if (!m_prepared) {
+        prepare();
+        for (size_t i = 0, m = chunkCount(); i < m; ++i)
+            cullChunk(i);
+    }
+    m_prepared = false;
+
+    if (m_cullBoundingSpheres) {
+        gatherVisibleEntities();
+    } else {
+        const Plane planes[6] = {
+            Plane(m_planeEquations[0]), Plane(m_planeEquations[1]), Plane(m_planeEquations[2]),
+            Plane(m_planeEquations[3]), Plane(m_planeEquations[4]), Plane(m_planeEquations[5]),
+        };
+        cullScene(m_root, planes);
+
+        // sort needed for set_intersection in RenderViewBuilder
+        std::sort(m_visibleEntities.begin(), m_visibleEntities.end());
+    }
+}
+
+bool FrustumCullingJob::canCullBoundingSpheres() const
+{
+    // The flat array is only valid if no entity was added, removed or
+    // reparented since the ExpandBoundingVolumeJob last refreshed it
+    return m_boundingSpheres != nullptr && m_manager != nullptr
+            && m_boundingSpheres->root() == m_root
+            && m_boundingSpheres->hierarchyRevision() == m_manager->renderNodesManager()->hierarchyRevision();
+}
+
+size_t FrustumCullingJob::chunkCount() const
+{
+    return m_chunkJobs.empty() ? 1 : m_chunkJobs.size() - 1;
+}
+
+// Computes the frustum planes and, when the flat bounding sphere array can
+// be used, splits it into the ranges culled by the chunks
+void FrustumCullingJob::prepare()
+{
     m_visibleEntities.clear();
+    m_visibleIndices.clear();
+    m_ranges.clear();
+
+    m_planeEquations[0] = m_viewProjection.row(3) + m_viewProjection.row(0); // Left
+    m_planeEquations[1] = m_viewProjection.row(3) - m_viewProjection.row(0); // Right
+    m_planeEquations[2] = m_viewProjection.row(3) + m_viewProjection.row(1); // Top
+    m_planeEquations[3] = m_viewProjection.row(3) - m_viewProjection.row(1); // Bottom
+    m_planeEquations[4] = m_viewProjection.row(3) + m_viewProjection.row(2); // Front
+    m_planeEquations[5] = m_viewProjection.row(3) - m_viewProjection.row(2); // Back
+
+    m_cullBoundingSpheres = canCullBoundingSpheres();
+    m_prepared = true;
+    if (!m_cullBoundingSpheres)
+        return;
+
+    // The culling kernels expect normalized plane equations
+    for (Vector4D &planeEquation : m_planeEquations) {
+        const Plane plane(planeEquation);
+        planeEquation = Vector4D(plane.normal, plane.d);
+    }
+
+    const BoundingSphereArray *spheres = m_boundingSpheres;
+    const uint sphereCount = uint(spheres->size());
+    if (sphereCount == 0)
+        return;
+
+    // Plane coherency cache, indexed like the sphere array
+    if (m_lastRejectingPlanes.size() != sphereCount
+            || m_lastRejectingPlanesRevision != spheres->hierarchyRevision()) {
+        m_lastRejectingPlanes.assign(sphereCount, 0);
+        m_lastRejectingPlanesRevision = spheres->hierarchyRevision();
+    }
+    quint8 *lastRejectingPlanes = m_lastRejectingPlanes.data();
+
+    const uint threadCount = uint(chunkCount());
+    if (threadCount == 1 || sphereCount < 2 * MinSpheresPerThread) {
+        m_ranges.push_back({ 0, sphereCount, BoundingSphereArray::AllPlanes, {} });
+        return;
+    }
+
+    // Open the top of the hierarchy until it is split in ranges of about
+    // grainSize spheres. Each range holds whole subtrees so that they can
+    // still be rejected or accepted at once.
+    const uint grainSize = std::max(MinSpheresPerThread, sphereCount / (threadCount * 4));
+    std::vector<SubtreeRange> pending;
+    pending.push_back({ 0, sphereCount, BoundingSphereArray::AllPlanes, {} });
+    while (!pending.empty()) {
+        SubtreeRange range = std::move(pending.back());
+        pending.pop_back();
 
-    const Plane planes[6] = {
-        Plane(m_viewProjection.row(3) + m_viewProjection.row(0)), // Left
-        Plane(m_viewProjection.row(3) - m_viewProjection.row(0)), // Right
-        Plane(m_viewProjection.row(3) + m_viewProjection.row(1)), // Top
-        Plane(m_viewProjection.row(3) - m_viewProjection.row(1)), // Bottom
-        Plane(m_viewProjection.row(3) + m_viewProjection.row(2)), // Front
-        Plane(m_viewProjection.row(3) - m_viewProjection.row(2)), // Back
-    };
+        if (range.end - range.begin <= grainSize) {
+            m_ranges.push_back(std::move(range));
+            continue;
+        }
+
+        if (spheres->subtreeEnd(range.begin) == range.end) {
+            // Single large subtree, test its root and open it
+            uint planeMask = range.planeMask;
+            if (spheres->cullNode(range.begin, m_planeEquations, planeMask,
+                                  lastRejectingPlanes, m_visibleIndices))
+                pending.push_back({ range.begin + 1, range.end, planeMask, {} });
+            continue;
+        }
+
+        // Group siblings, only subtrees too large by themselves get opened
+        uint groupBegin = range.begin;
+        for (uint child = range.begin; child < range.end; ) {
+            const uint next = spheres->subtreeEnd(child);
+            if (next - groupBegin >= grainSize || next == range.end) {
+                const bool singleSubtree = (child == groupBegin);
+                if (singleSubtree && next - groupBegin > grainSize)
+                    pending.push_back({ groupBegin, next, range.planeMask, {} });
+                else
+                    m_ranges.push_back({ groupBegin, next, range.planeMask, {} });
+                groupBegin = next;
+            }
+            child = next;
+        }
+    }
+}
+
+// Culls every chunkCount()th range, starting at the range at chunkIndex
+void FrustumCullingJob::cullChunk(size_t chunkIndex)
+{
+    const size_t stride = chunkCount();
+    for (size_t i = chunkIndex, m = m_ranges.size(); i < m; i += stride) {
+        SubtreeRange &range = m_ranges[i];
+        range.visibleIndices.clear();
+        m_boundingSpheres->cullSubtrees(range.begin, range.end, m_planeEquations, range.planeMask,
+                                        m_lastRejectingPlanes.data(), range.visibleIndices);
+    }
+}
+
+void FrustumCullingJob::gatherVisibleEntities()
+{
+    const BoundingSphereArray *spheres = m_boundingSpheres;
+    const uint sphereCount = uint(spheres->size());
 
-    cullScene(m_root, planes);
+    size_t visibleCount = m_visibleIndices.size();
+    for (const SubtreeRange &range : m_ranges)
+        visibleCount += range.visibleIndices.size();
+    m_visibleEntities.reserve(visibleCount);
 
-    // sort needed for set_intersection in RenderViewBuilder
-    std::sort(m_visibleEntities.begin(), m_visibleEntities.end());
+    if (visibleCount < sphereCount / 8) {
+        // Few visible entities, sorting them is cheaper than a full pass
+        for (uint index : m_visibleIndices)
+            m_visibleEntities.push_back(spheres->entity(index));
+        for (const SubtreeRange &range : m_ranges) {
+            for (uint index : range.visibleIndices)
+                m_visibleEntities.push_back(spheres->entity(index));
+        }
+        std::sort(m_visibleEntities.begin(), m_visibleEntities.end());
+    } else {
+        // Otherwise gather them following the address order of the array
+        m_visibleFlags.assign(sphereCount, 0);
+        for (uint index : m_visibleIndices)
+            m_visibleFlags[index] = 1;
+        for (const SubtreeRange &range : m_ranges) {
+            for (uint index : range.visibleIndices)
+                m_visibleFlags[index] = 1;
+        }
+        for (uint index : spheres->addressOrder()) {
+            if (m_visibleFlags[index])
+                m_visibleEntities.push_back(spheres->entity(index));
+        }
+    }
 }
 
 void FrustumCullingJob::cullScene(Entity *e, const Plane *planes)
@@ -67,6 +67,7 @@ namespace Render {
 class Entity;
 class EntityManager;
 class NodeManagers;
+class BoundingSphereArray;
 struct Plane;
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT FrustumCullingJob : public Qt3DCore::QAspectJob
@@ -79,6 +80,7 @@ public:
 
     inline void setRoot(Entity *root) noexcept { m_root = root; }
     inline void setManagers(NodeManagers *manager) noexcept { m_manager = manager; }
+    inline void setBoundingSpheres(const BoundingSphereArray *spheres) noexcept { m_boundingSpheres = spheres; }
     inline void setActive(bool active) noexcept { m_active = active; }
     inline bool isActive() const noexcept { return m_active; }
     inline void setViewProjection(const Matrix4x4 &viewProjection) noexcept { m_viewProjection = viewProjection; }
@@ -87,6 +89,11 @@ public:
 
     const std::vector<Entity *> &visibleEntities() const noexcept { return m_visibleEntities; }
 
+    // Jobs culling the bounding spheres in parallel, to be scheduled along
+    // with this job which depends on them. The first one prepares the
+    // culling and has to run after the jobs this job depends upon.
+    const std::vector<Qt3DCore::QAspectJobPtr> &chunkJobs() const noexcept { return m_chunkJobs; }
+
     void run() final;
 
 private:
@@ -103,12 +110,36 @@ private:
         const float d;
     };
 
+    // Range of sibling subtrees culled as a single unit of work
+    struct SubtreeRange
+    {
+        uint begin;
+        uint end;
+        uint planeMask;
+        std::vector<uint> visibleIndices;
+    };
+
     void cullScene(Entity *e, const Plane *planes);
+    bool canCullBoundingSpheres() const;
+    size_t chunkCount() const;
+    void prepare();
+    void cullChunk(size_t chunkIndex);
+    void gatherVisibleEntities();
     Matrix4x4 m_viewProjection;
+    Vector4D m_planeEquations[6];
     Entity *m_root;
     NodeManagers *m_manager;
+    const BoundingSphereArray *m_boundingSpheres;
+    std::vector<quint8> m_lastRejectingPlanes;
+    uint m_lastRejectingPlanesRevision;
+    std::vector<uint> m_visibleIndices;
+    std::vector<quint8> m_visibleFlags;
+    std::vector<SubtreeRange> m_ranges;
     std::vector<Entity *> m_visibleEntities;
+    std::vector<Qt3DCore::QAspectJobPtr> m_chunkJobs;
     bool m_active;
+    bool m_prepared;
+    bool m_cullBoundingSpheres;
 };
 
 typedef QSharedPointer<FrustumCullingJob> FrustumCullingJobPtr;
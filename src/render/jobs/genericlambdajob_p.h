@@ -71,6 +71,12 @@ public:
         SET_JOB_RUN_STAT_TYPE_AND_NAME(this, type, name, instance)
     }
 
+    // Lets a job be reused from one frame to the next with new state
+    void setCallable(T callable)
+    {
+        m_callable = std::move(callable);
+    }
+
     // QAspectJob interface
     void run() final
     {
@@ -111,7 +111,11 @@ namespace JobTypes {
         SendSetFenceHandlesToFrontend,
         SendDisablesToFrontend,
         RenderViewCommandBuilder,
-        SyncRenderViewPreCommandBuilding
+        SyncRenderViewPreCommandBuilding,
+        PrepareUpdateTransform,
+        UpdateTransformBatch,
+        PrepareFrustumCulling,
+        FrustumCullingChunk
     };
 
 } // JobTypes
@@ -19,6 +19,7 @@ HEADERS += \
     $$PWD/updateshaderdatatransformjob_p.h \
     $$PWD/updatelevelofdetailjob_p.h \
     $$PWD/pickboundingvolumeutils_p.h \
+    $$PWD/meshbvh_p.h \
     $$PWD/updatetreeenabledjob_p.h \
     $$PWD/sendbuffercapturejob_p.h \
     $$PWD/loadskeletonjob_p.h \
@@ -54,6 +55,7 @@ SOURCES += \
     $$PWD/updateshaderdatatransformjob.cpp \
     $$PWD/updatelevelofdetailjob.cpp \
     $$PWD/pickboundingvolumeutils.cpp \
+    $$PWD/meshbvh.cpp \
     $$PWD/updatetreeenabledjob.cpp \
     $$PWD/sendbuffercapturejob.cpp \
     $$PWD/loadskeletonjob.cpp \
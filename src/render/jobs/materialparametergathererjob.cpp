@@ -43,6 +43,8 @@
 #include <Qt3DRender/private/renderpassfilternode_p.h>
 #include <Qt3DRender/private/techniquefilternode_p.h>
 #include <Qt3DRender/private/job_common_p.h>
+#include <Qt3DCore/private/vector_helper_p.h>
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -94,9 +96,12 @@ MaterialParameterGathererJob::MaterialParameterGathererJob()
 
 // Parameters from Material/Effect/Technique
 
-// Note: we could maybe improve that by having a smart update when we detect
-// that a parameter value has changed. That might require way more book keeping
-// which might make this solution a bit too complex
+// Only the materials referencing nodes which changed since the last run are
+// handed to the job, see findMaterialsToGather. The dependencies recorded for
+// each material allow finding them on the next run. They include all the
+// passes of the selected Technique, not only the ones matching the filter.
+// Changes to the filters or to the Techniques require gathering all the
+// materials again.
 
 // The fact that this can now be performed in parallel should already provide a big
 // improvement
@@ -105,13 +110,34 @@ void MaterialParameterGathererJob::run()
     for (const HMaterial &materialHandle : qAsConst(m_handles)) {
         Material *material = m_manager->materialManager()->data(materialHandle);
 
+        // Recorded even if nothing gets gathered so that the material isn't
+        // considered as new on the next run
+        std::vector<Qt3DCore::QNodeId> &dependencies = m_dependencies[material->peerId()];
+
         if (Q_UNLIKELY(!material->isEnabled()))
             continue;
 
+        dependencies.push_back(material->effect());
         Effect *effect = m_manager->effectManager()->lookupResource(material->effect());
         Technique *technique = findTechniqueForEffect(m_manager, m_techniqueFilter, effect);
 
         if (Q_LIKELY(technique != nullptr)) {
+            // Passes filtered out now may match once their filter keys change,
+            // which only marks the pass itself dirty
+            Qt3DCore::append(dependencies, technique->renderPasses());
+            for (const Qt3DCore::QNodeId &passId : technique->renderPasses()) {
+                if (RenderPass *renderPass = m_manager->renderPassManager()->lookupResource(passId))
+                    Qt3DCore::append(dependencies, renderPass->filterKeys());
+            }
+            if (m_renderPassFilter) {
+                dependencies.push_back(m_renderPassFilter->peerId());
+                Qt3DCore::append(dependencies, m_renderPassFilter->parameters());
+            }
+            if (m_techniqueFilter) {
+                dependencies.push_back(m_techniqueFilter->peerId());
+                Qt3DCore::append(dependencies, m_techniqueFilter->parameters());
+            }
+
             RenderPassList passes = findRenderPassesForTechnique(m_manager, m_renderPassFilter, technique);
             if (Q_LIKELY(passes.size() > 0)) {
                 // Order set:
@@ -137,10 +163,14 @@ void MaterialParameterGathererJob::run()
                                                      m_techniqueFilter);
                 // Get the parameters for our selected rendering setup (override what was defined in the technique/pass filter)
                 parametersFromMaterialEffectTechnique(&parameters, m_manager->parameterManager(), material, effect, technique);
+                Qt3DCore::append(dependencies, material->parameters());
+                Qt3DCore::append(dependencies, effect->parameters());
+                Qt3DCore::append(dependencies, technique->parameters());
 
                 for (RenderPass *renderPass : passes) {
                     ParameterInfoList globalParameters = parameters;
                     parametersFromParametersProvider(&globalParameters, m_manager->parameterManager(), renderPass);
+                    Qt3DCore::append(dependencies, renderPass->parameters());
                     auto it = m_parameters.find(material->peerId());
                     if (it != m_parameters.end())
                         it->push_back({renderPass, globalParameters});
@@ -152,6 +182,43 @@ void MaterialParameterGathererJob::run()
     }
 }
 
+std::vector<HMaterial> MaterialParameterGathererJob::findMaterialsToGather(MaterialManager *manager,
+                                                                           const MaterialParameterGathererDependencies &dependencies,
+                                                                           const std::vector<Qt3DCore::QNodeId> &dirtyNodes,
+                                                                           std::vector<Qt3DCore::QNodeId> &removedMaterials)
+{
+    const auto isDirty = [&dirtyNodes] (Qt3DCore::QNodeId id) {
+        return std::binary_search(dirtyNodes.begin(), dirtyNodes.end(), id);
+    };
+
+    std::vector<HMaterial> materialsToGather;
+    qsizetype knownMaterialCount = 0;
+    const std::vector<HMaterial> &handles = manager->activeHandles();
+    for (const HMaterial &handle : handles) {
+        const Material *material = manager->data(handle);
+        const auto it = dependencies.constFind(material->peerId());
+        if (it == dependencies.cend()) {
+            materialsToGather.push_back(handle);
+            continue;
+        }
+        ++knownMaterialCount;
+        if (dirtyNodes.empty())
+            continue;
+        if (isDirty(material->peerId()) || std::any_of(it->cbegin(), it->cend(), isDirty))
+            materialsToGather.push_back(handle);
+    }
+
+    // Some of the materials we know about were destroyed
+    if (knownMaterialCount != dependencies.size()) {
+        for (auto it = dependencies.cbegin(), end = dependencies.cend(); it != end; ++it) {
+            if (!manager->contains(it.key()))
+                removedMaterials.push_back(it.key());
+        }
+    }
+
+    return materialsToGather;
+}
+
 } // Render
 
 } // Qt3DRender
@@ -64,6 +64,7 @@ namespace Qt3DRender {
 namespace Render {
 
 class NodeManagers;
+class MaterialManager;
 class TechniqueFilter;
 class RenderPassFilter;
 
@@ -79,6 +80,7 @@ public:
     inline void setTechniqueFilter(TechniqueFilter *techniqueFilter) noexcept { m_techniqueFilter = techniqueFilter; }
     inline void setRenderPassFilter(RenderPassFilter *renderPassFilter) noexcept { m_renderPassFilter = renderPassFilter; }
     inline const MaterialParameterGathererData &materialToPassAndParameter() noexcept { return m_parameters; }
+    inline const MaterialParameterGathererDependencies &materialDependencies() const noexcept { return m_dependencies; }
     inline void setHandles(std::vector<HMaterial> &&handles) noexcept { m_handles = std::move(handles); }
     inline void setHandles(const std::vector<HMaterial> &handles) noexcept { m_handles = handles; }
 
@@ -87,6 +89,15 @@ public:
 
     void run() final;
 
+    // Returns the materials which have to be gathered again given the
+    // sorted ids of the nodes which changed since the previous gathering.
+    // Materials which were gathered but no longer exist are appended to
+    // removedMaterials.
+    static std::vector<HMaterial> findMaterialsToGather(MaterialManager *manager,
+                                                        const MaterialParameterGathererDependencies &dependencies,
+                                                        const std::vector<Qt3DCore::QNodeId> &dirtyNodes,
+                                                        std::vector<Qt3DCore::QNodeId> &removedMaterials);
+
 private:
     NodeManagers *m_manager;
     TechniqueFilter *m_techniqueFilter;
@@ -94,6 +105,7 @@ private:
 
     // Material id to array of RenderPasse with parameters
     MaterialParameterGathererData m_parameters;
+    MaterialParameterGathererDependencies m_dependencies;
     std::vector<HMaterial> m_handles;
 
     Q_DECLARE_PRIVATE(MaterialParameterGathererJob)
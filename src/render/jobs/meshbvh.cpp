@@ -0,0 +1,448 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "meshbvh_p.h"
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/buffermanager_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/pickingproxy_p.h>
+#include <Qt3DRender/private/geometry_p.h>
+#include <Qt3DRender/private/attribute_p.h>
+#include <Qt3DRender/private/buffer_p.h>
+#include <Qt3DRender/private/trianglesvisitor_p.h>
+#include <Qt3DRender/private/segmentsvisitor_p.h>
+#include <Qt3DRender/private/pointsvisitor_p.h>
+#include <QtCore/QVarLengthArray>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+const uint MaxLeafSize = 4;
+const float BoundsEpsilon = 1.0e-5f;
+
+class TriangleCollector : public TrianglesVisitor
+{
+public:
+    TriangleCollector(NodeManagers *manager, MeshBVH *bvh)
+        : TrianglesVisitor(manager), m_bvh(bvh), m_triangleIndex(0)
+    {}
+
+private:
+    void visit(uint andx, const Vector3D &a, uint bndx, const Vector3D &b,
+               uint cndx, const Vector3D &c) override
+    {
+        const uint indices[3] = { andx, bndx, cndx };
+        const Vector3D vertices[3] = { a, b, c };
+        m_bvh->addPrimitive(m_triangleIndex++, indices, vertices);
+    }
+
+    MeshBVH *m_bvh;
+    uint m_triangleIndex;
+};
+
+class SegmentCollector : public SegmentsVisitor
+{
+public:
+    SegmentCollector(NodeManagers *manager, MeshBVH *bvh)
+        : SegmentsVisitor(manager), m_bvh(bvh), m_segmentIndex(0)
+    {}
+
+private:
+    void visit(uint andx, const Vector3D &a, uint bndx, const Vector3D &b) override
+    {
+        const uint indices[2] = { andx, bndx };
+        const Vector3D vertices[2] = { a, b };
+        m_bvh->addPrimitive(m_segmentIndex++, indices, vertices);
+    }
+
+    MeshBVH *m_bvh;
+    uint m_segmentIndex;
+};
+
+class PointCollector : public PointsVisitor
+{
+public:
+    PointCollector(NodeManagers *manager, MeshBVH *bvh)
+        : PointsVisitor(manager), m_bvh(bvh), m_pointIndex(0)
+    {}
+
+private:
+    void visit(uint ndx, const Vector3D &p) override
+    {
+        m_bvh->addPrimitive(m_pointIndex++, &ndx, &p);
+    }
+
+    MeshBVH *m_bvh;
+    uint m_pointIndex;
+};
+
+void recordLayout(const Attribute *attribute, uint *layout)
+{
+    layout[0] = uint(attribute->vertexBaseType());
+    layout[1] = attribute->vertexSize();
+    layout[2] = attribute->count();
+    layout[3] = attribute->byteStride();
+    layout[4] = attribute->byteOffset();
+}
+
+// Mirrors the attribute resolution of Visitor::visitPrimitives
+template<typename GeometryProvider>
+MeshBVHCache::Signature signatureOf(NodeManagers *manager, const GeometryProvider *provider)
+{
+    MeshBVHCache::Signature signature;
+    signature.primitiveType = int(provider->primitiveType());
+    signature.instanceCount = provider->instanceCount();
+    signature.restartIndexValue = provider->restartIndexValue();
+    signature.primitiveRestartEnabled = provider->primitiveRestartEnabled();
+
+    Geometry *geom = manager->lookupResource<Geometry, GeometryManager>(provider->geometryId());
+    if (!geom)
+        return signature;
+
+    const Attribute *positionAttribute = nullptr;
+    const Attribute *indexAttribute = nullptr;
+    const auto attrIds = geom->attributes();
+    for (const Qt3DCore::QNodeId &attrId : attrIds) {
+        const Attribute *attribute = manager->lookupResource<Attribute, AttributeManager>(attrId);
+        if (attribute) {
+            if (!positionAttribute && attribute->name() == Qt3DCore::QAttribute::defaultPositionAttributeName())
+                positionAttribute = attribute;
+            else if (attribute->attributeType() == Qt3DCore::QAttribute::IndexAttribute)
+                indexAttribute = attribute;
+        }
+    }
+
+    if (positionAttribute) {
+        const Buffer *buffer = manager->lookupResource<Buffer, BufferManager>(positionAttribute->bufferId());
+        signature.positionBuffer = buffer;
+        signature.positionRevision = buffer ? buffer->dataRevision() : 0;
+        recordLayout(positionAttribute, signature.positionLayout);
+    }
+    if (indexAttribute) {
+        const Buffer *buffer = manager->lookupResource<Buffer, BufferManager>(indexAttribute->bufferId());
+        signature.indexBuffer = buffer;
+        signature.indexRevision = buffer ? buffer->dataRevision() : 0;
+        recordLayout(indexAttribute, signature.indexLayout);
+    }
+    return signature;
+}
+
+} // anonymous
+
+MeshBVH::MeshBVH(PrimitiveType type)
+    : m_primitiveType(type)
+    , m_verticesPerPrimitive(type == Triangles ? 3 : (type == Segments ? 2 : 1))
+{
+}
+
+void MeshBVH::addPrimitive(uint primitiveIndex, const uint *vertexIndices, const Vector3D *vertices)
+{
+    m_primitiveIndices.push_back(primitiveIndex);
+    for (int i = 0; i < m_verticesPerPrimitive; ++i) {
+        m_vertexIndices.push_back(vertexIndices[i]);
+        m_vertices.push_back(vertices[i].x());
+        m_vertices.push_back(vertices[i].y());
+        m_vertices.push_back(vertices[i].z());
+    }
+}
+
+void MeshBVH::build()
+{
+    m_nodes.clear();
+    const uint count = uint(m_primitiveIndices.size());
+    if (count == 0)
+        return;
+
+    // Bounds of each primitive, as min xyz followed by max xyz
+    std::vector<float> bounds(6 * size_t(count));
+    for (uint slot = 0; slot < count; ++slot) {
+        float *b = bounds.data() + 6 * size_t(slot);
+        const float *v = m_vertices.data() + 3 * size_t(slot) * m_verticesPerPrimitive;
+        for (int axis = 0; axis < 3; ++axis)
+            b[axis] = b[axis + 3] = v[axis];
+        for (int i = 1; i < m_verticesPerPrimitive; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                b[axis] = std::min(b[axis], v[3 * i + axis]);
+                b[axis + 3] = std::max(b[axis + 3], v[3 * i + axis]);
+            }
+        }
+    }
+
+    std::vector<uint> order(count);
+    std::iota(order.begin(), order.end(), 0U);
+    m_nodes.reserve(2 * (count / MaxLeafSize + 1));
+    buildNode(0, count, order, bounds);
+
+    // Store the primitives in leaf order
+    std::vector<uint> primitiveIndices(count);
+    std::vector<uint> vertexIndices(m_vertexIndices.size());
+    std::vector<float> vertices(m_vertices.size());
+    const size_t vpp = size_t(m_verticesPerPrimitive);
+    for (uint slot = 0; slot < count; ++slot) {
+        const size_t from = order[slot];
+        primitiveIndices[slot] = m_primitiveIndices[from];
+        std::copy_n(m_vertexIndices.begin() + from * vpp, vpp, vertexIndices.begin() + slot * vpp);
+        std::copy_n(m_vertices.begin() + 3 * from * vpp, 3 * vpp, vertices.begin() + 3 * slot * vpp);
+    }
+    m_primitiveIndices = std::move(primitiveIndices);
+    m_vertexIndices = std::move(vertexIndices);
+    m_vertices = std::move(vertices);
+}
+
+uint MeshBVH::buildNode(uint begin, uint end, std::vector<uint> &order,
+                        const std::vector<float> &bounds)
+{
+    const uint nodeIndex = uint(m_nodes.size());
+    m_nodes.emplace_back();
+
+    Node node;
+    float centroidMin[3];
+    float centroidMax[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = centroidMin[axis] = std::numeric_limits<float>::max();
+        node.max[axis] = centroidMax[axis] = std::numeric_limits<float>::lowest();
+    }
+    for (uint i = begin; i < end; ++i) {
+        const float *b = bounds.data() + 6 * size_t(order[i]);
+        for (int axis = 0; axis < 3; ++axis) {
+            node.min[axis] = std::min(node.min[axis], b[axis]);
+            node.max[axis] = std::max(node.max[axis], b[axis + 3]);
+            const float centroid = b[axis] + b[axis + 3];
+            centroidMin[axis] = std::min(centroidMin[axis], centroid);
+            centroidMax[axis] = std::max(centroidMax[axis], centroid);
+        }
+    }
+
+    if (end - begin <= MaxLeafSize) {
+        node.first = begin;
+        node.count = end - begin;
+        m_nodes[nodeIndex] = node;
+        return nodeIndex;
+    }
+
+    // Median split along the axis where the centroids are the most spread
+    int splitAxis = 0;
+    for (int axis = 1; axis < 3; ++axis) {
+        if (centroidMax[axis] - centroidMin[axis] > centroidMax[splitAxis] - centroidMin[splitAxis])
+            splitAxis = axis;
+    }
+    const uint middle = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                     [&bounds, splitAxis] (uint a, uint b) {
+        return bounds[6 * size_t(a) + splitAxis] + bounds[6 * size_t(a) + splitAxis + 3]
+                < bounds[6 * size_t(b) + splitAxis] + bounds[6 * size_t(b) + splitAxis + 3];
+    });
+
+    buildNode(begin, middle, order, bounds);
+    node.first = buildNode(middle, end, order, bounds);
+    node.count = 0;
+    m_nodes[nodeIndex] = node;
+    return nodeIndex;
+}
+
+void MeshBVH::collectCandidates(const Vector3D &origin, const Vector3D &end, bool infinite,
+                                float margin, std::vector<uint> &slots) const
+{
+    slots.clear();
+    if (m_nodes.empty())
+        return;
+
+    const float o[3] = { origin.x(), origin.y(), origin.z() };
+    const float d[3] = { end.x() - origin.x(), end.y() - origin.y(), end.z() - origin.z() };
+    const float tStart = infinite ? std::numeric_limits<float>::lowest() : 0.0f;
+    const float tEnd = infinite ? std::numeric_limits<float>::max() : 1.0f;
+
+    const auto crossesNode = [&] (const Node &node) {
+        float tMin = tStart;
+        float tMax = tEnd;
+        for (int axis = 0; axis < 3; ++axis) {
+            // Relative padding so that flat nodes aren't missed to rounding
+            const float lo = node.min[axis] - margin - BoundsEpsilon * (1.0f + std::abs(node.min[axis]));
+            const float hi = node.max[axis] + margin + BoundsEpsilon * (1.0f + std::abs(node.max[axis]));
+            if (std::abs(d[axis]) < std::numeric_limits<float>::min()) {
+                if (o[axis] < lo || o[axis] > hi)
+                    return false;
+                continue;
+            }
+            const float invD = 1.0f / d[axis];
+            float t0 = (lo - o[axis]) * invD;
+            float t1 = (hi - o[axis]) * invD;
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if (tMin > tMax)
+                return false;
+        }
+        return true;
+    };
+
+    QVarLengthArray<uint, 64> stack;
+    stack.push_back(0);
+    while (!stack.isEmpty()) {
+        const uint nodeIndex = stack.takeLast();
+        const Node &node = m_nodes[nodeIndex];
+        if (!crossesNode(node))
+            continue;
+        if (node.count > 0) {
+            for (uint slot = node.first, last = node.first + node.count; slot < last; ++slot)
+                slots.push_back(slot);
+        } else {
+            stack.push_back(node.first);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+
+    // Report hits in the same order as a linear visit of the mesh would
+    std::sort(slots.begin(), slots.end(), [this] (uint a, uint b) {
+        return m_primitiveIndices[a] < m_primitiveIndices[b];
+    });
+}
+
+bool MeshBVHCache::Signature::operator==(const Signature &other) const
+{
+    return positionBuffer == other.positionBuffer
+            && indexBuffer == other.indexBuffer
+            && positionRevision == other.positionRevision
+            && indexRevision == other.indexRevision
+            && std::equal(positionLayout, positionLayout + 5, other.positionLayout)
+            && std::equal(indexLayout, indexLayout + 5, other.indexLayout)
+            && primitiveType == other.primitiveType
+            && instanceCount == other.instanceCount
+            && restartIndexValue == other.restartIndexValue
+            && primitiveRestartEnabled == other.primitiveRestartEnabled;
+}
+
+MeshBVHCache::MeshBVHCache()
+    : m_buildCount(0)
+{
+}
+
+MeshBVHPtr MeshBVHCache::bvh(NodeManagers *manager, const GeometryRenderer *renderer, MeshBVH::PrimitiveType type)
+{
+    return lookup(manager, renderer, type);
+}
+
+MeshBVHPtr MeshBVHCache::bvh(NodeManagers *manager, const PickingProxy *proxy, MeshBVH::PrimitiveType type)
+{
+    return lookup(manager, proxy, type);
+}
+
+template<typename GeometryProvider>
+MeshBVHPtr MeshBVHCache::lookup(NodeManagers *manager, const GeometryProvider *provider, MeshBVH::PrimitiveType type)
+{
+    const Signature signature = signatureOf(manager, provider);
+    const auto key = qMakePair(provider->peerId(), int(type));
+    {
+        QMutexLocker lock(&m_mutex);
+        const auto it = m_entries.constFind(key);
+        if (it != m_entries.cend() && it->signature == signature)
+            return it->bvh;
+    }
+
+    // Built without holding the lock as picking gathers hits concurrently
+    QSharedPointer<MeshBVH> bvh = QSharedPointer<MeshBVH>::create(type);
+    switch (type) {
+    case MeshBVH::Triangles: {
+        TriangleCollector collector(manager, bvh.data());
+        collector.apply(provider, provider->peerId());
+        break;
+    }
+    case MeshBVH::Segments: {
+        SegmentCollector collector(manager, bvh.data());
+        collector.apply(provider, provider->peerId());
+        break;
+    }
+    case MeshBVH::Points: {
+        PointCollector collector(manager, bvh.data());
+        collector.apply(provider, provider->peerId());
+        break;
+    }
+    }
+    bvh->build();
+
+    QMutexLocker lock(&m_mutex);
+    m_entries.insert(key, { signature, bvh });
+    ++m_buildCount;
+    return bvh;
+}
+
+void MeshBVHCache::release(Qt3DCore::QNodeId providerId)
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.remove(qMakePair(providerId, int(MeshBVH::Triangles)));
+    m_entries.remove(qMakePair(providerId, int(MeshBVH::Segments)));
+    m_entries.remove(qMakePair(providerId, int(MeshBVH::Points)));
+}
+
+void MeshBVHCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.clear();
+}
+
+size_t MeshBVHCache::size() const
+{
+    QMutexLocker lock(&m_mutex);
+    return size_t(m_entries.size());
+}
+
+quint64 MeshBVHCache::buildCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_buildCount;
+}
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_MESHBVH_P_H
+#define QT3DRENDER_RENDER_MESHBVH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <Qt3DCore/qnodeid.h>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+class NodeManagers;
+class GeometryRenderer;
+class PickingProxy;
+
+// Bounding volume hierarchy over the primitives of a mesh, in object space.
+// It is used to only test a ray against the primitives it can possibly hit.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT MeshBVH
+{
+public:
+    enum PrimitiveType {
+        Triangles = 0,
+        Segments,
+        Points
+    };
+
+    explicit MeshBVH(PrimitiveType type);
+
+    inline PrimitiveType primitiveType() const noexcept { return m_primitiveType; }
+    inline int verticesPerPrimitive() const noexcept { return m_verticesPerPrimitive; }
+    inline size_t primitiveCount() const noexcept { return m_primitiveIndices.size(); }
+    inline size_t nodeCount() const noexcept { return m_nodes.size(); }
+
+    // Primitives are appended with their index in the mesh and the index and
+    // position of each of their vertices, then build() must be called
+    void addPrimitive(uint primitiveIndex, const uint *vertexIndices, const Vector3D *vertices);
+    void build();
+
+    // Collects the slots of the primitives whose bounds, grown by margin, are
+    // crossed by the segment [origin, end], or by the line going through both
+    // points if infinite is true. Slots are sorted by primitive index.
+    void collectCandidates(const Vector3D &origin, const Vector3D &end, bool infinite,
+                           float margin, std::vector<uint> &slots) const;
+
+    inline uint primitiveIndex(uint slot) const noexcept { return m_primitiveIndices[slot]; }
+    inline uint vertexIndex(uint slot, int vertex) const noexcept
+    {
+        return m_vertexIndices[slot * m_verticesPerPrimitive + vertex];
+    }
+    inline Vector3D vertex(uint slot, int vertex) const noexcept
+    {
+        const float *v = m_vertices.data() + 3 * (slot * m_verticesPerPrimitive + vertex);
+        return Vector3D(v[0], v[1], v[2]);
+    }
+
+private:
+    struct Node
+    {
+        float min[3];
+        float max[3];
+        // Leaves reference count slots from first, inner nodes have their
+        // left child right after them and their right child at first
+        uint first;
+        uint count;
+    };
+
+    uint buildNode(uint begin, uint end, std::vector<uint> &order,
+                   const std::vector<float> &bounds);
+
+    PrimitiveType m_primitiveType;
+    int m_verticesPerPrimitive;
+    std::vector<Node> m_nodes;
+    std::vector<uint> m_primitiveIndices;
+    std::vector<uint> m_vertexIndices;
+    std::vector<float> m_vertices;
+};
+
+using MeshBVHPtr = QSharedPointer<const MeshBVH>;
+
+// Keeps the MeshBVH of the GeometryRenderers and PickingProxies used for
+// picking. A BVH is rebuilt on the next request once the buffers, attributes
+// or draw parameters it was built from have changed.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT MeshBVHCache
+{
+public:
+    MeshBVHCache();
+
+    MeshBVHPtr bvh(NodeManagers *manager, const GeometryRenderer *renderer, MeshBVH::PrimitiveType type);
+    MeshBVHPtr bvh(NodeManagers *manager, const PickingProxy *proxy, MeshBVH::PrimitiveType type);
+
+    // Drops the BVHs of a destroyed GeometryRenderer or PickingProxy
+    void release(Qt3DCore::QNodeId providerId);
+    void clear();
+    size_t size() const;
+    quint64 buildCount() const;
+
+    struct Signature
+    {
+        const void *positionBuffer = nullptr;
+        const void *indexBuffer = nullptr;
+        uint positionRevision = 0;
+        uint indexRevision = 0;
+        uint positionLayout[5] = {};
+        uint indexLayout[5] = {};
+        int primitiveType = 0;
+        int instanceCount = 0;
+        int restartIndexValue = 0;
+        bool primitiveRestartEnabled = false;
+
+        bool operator==(const Signature &other) const;
+    };
+
+private:
+    template<typename GeometryProvider>
+    MeshBVHPtr lookup(NodeManagers *manager, const GeometryProvider *provider, MeshBVH::PrimitiveType type);
+
+    struct Entry
+    {
+        Signature signature;
+        MeshBVHPtr bvh;
+    };
+
+    mutable QMutex m_mutex;
+    QHash<QPair<Qt3DCore::QNodeId, int>, Entry> m_entries;
+    quint64 m_buildCount;
+};
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_MESHBVH_P_H
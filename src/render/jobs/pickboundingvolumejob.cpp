@@ -330,6 +330,7 @@ void PickBoundingVolumeJob::processPickEvent(const PickingUtils::PickConfigurati
 
         PickingUtils::HierarchicalEntityPicker entityPicker(ray);
         entityPicker.setLayerFilterIds(vca.layersFilters);
+        entityPicker.setSceneBVH(m_sceneBVH);
 
         if (entityPicker.collectHits(m_manager, m_node)) {
             if (pickConfiguration.trianglePickingRequested) {
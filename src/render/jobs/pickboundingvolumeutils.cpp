@@ -55,9 +55,13 @@
 #include <Qt3DRender/private/layerfilternode_p.h>
 #include <Qt3DRender/private/rendersettings_p.h>
 #include <Qt3DRender/private/filterlayerentityjob_p.h>
+#include <Qt3DRender/private/meshbvh_p.h>
+#include <Qt3DRender/private/scenebvh_p.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
 
 #include <vector>
 #include <algorithm>
+#include <cmath>
 #include <functional>
 
 QT_BEGIN_NAMESPACE
@@ -191,6 +195,8 @@ public:
     {
     }
 
+    void visitCandidates(const MeshBVH &bvh, const std::vector<uint> &slots);
+
 private:
     const Entity *m_root;
     RayCasting::QRay3D m_ray;
@@ -222,6 +228,16 @@ void TriangleCollisionVisitor::visit(uint andx, const Vector3D &a, uint bndx, co
     m_triangleIndex++;
 }
 
+void TriangleCollisionVisitor::visitCandidates(const MeshBVH &bvh, const std::vector<uint> &slots)
+{
+    for (const uint slot : slots) {
+        m_triangleIndex = bvh.primitiveIndex(slot);
+        visit(bvh.vertexIndex(slot, 0), bvh.vertex(slot, 0),
+              bvh.vertexIndex(slot, 1), bvh.vertex(slot, 1),
+              bvh.vertexIndex(slot, 2), bvh.vertex(slot, 2));
+    }
+}
+
 
 bool TriangleCollisionVisitor::intersectsSegmentTriangle(uint andx, const Vector3D &a, uint bndx, const Vector3D &b, uint cndx, const Vector3D &c)
 {
@@ -256,6 +272,8 @@ public:
     {
     }
 
+    void visitCandidates(const MeshBVH &bvh, const std::vector<uint> &slots);
+
 private:
     const Entity *m_root;
     RayCasting::QRay3D m_ray;
@@ -281,6 +299,15 @@ void LineCollisionVisitor::visit(uint andx, const Vector3D &a, uint bndx, const
     m_segmentIndex++;
 }
 
+void LineCollisionVisitor::visitCandidates(const MeshBVH &bvh, const std::vector<uint> &slots)
+{
+    for (const uint slot : slots) {
+        m_segmentIndex = bvh.primitiveIndex(slot);
+        visit(bvh.vertexIndex(slot, 0), bvh.vertex(slot, 0),
+              bvh.vertexIndex(slot, 1), bvh.vertex(slot, 1));
+    }
+}
+
 bool LineCollisionVisitor::intersectsSegmentSegment(uint andx, const Vector3D &a,
                                                     uint bndx, const Vector3D &b)
 {
@@ -377,6 +404,8 @@ public:
     {
     }
 
+    void visitCandidates(const MeshBVH &bvh, const std::vector<uint> &slots);
+
 private:
     const Entity *m_root;
     RayCasting::QRay3D m_ray;
@@ -416,6 +445,53 @@ void PointCollisionVisitor::visit(uint ndx, const Vector3D &p)
     m_pointIndex++;
 }
 
+void PointCollisionVisitor::visitCandidates(const MeshBVH &bvh, const std::vector<uint> &slots)
+{
+    for (const uint slot : slots) {
+        m_pointIndex = bvh.primitiveIndex(slot);
+        visit(bvh.vertexIndex(slot, 0), bvh.vertex(slot, 0));
+    }
+}
+
+namespace {
+
+// Only visits the primitives of the geometry whose bounds are crossed by the
+// ray. The ray is brought into object space so that the cached MeshBVH stays
+// valid whatever the world transform of the entity.
+template<typename CollisionVisitor, typename GeometryProvider>
+void visitPrimitivesAlongRay(CollisionVisitor &visitor, NodeManagers *manager,
+                             const Entity *entity, const GeometryProvider *provider,
+                             MeshBVH::PrimitiveType primitiveType, const RayCasting::QRay3D &ray,
+                             bool infiniteRay, float worldSpaceTolerance)
+{
+    bool invertible = false;
+    const QMatrix4x4 inverse = convertToQMatrix4x4(*entity->worldTransform()).inverted(&invertible);
+    if (!invertible) {
+        visitor.apply(provider, entity->peerId());
+        return;
+    }
+
+    // The Frobenius norm bounds how much the inverse can stretch the tolerance
+    float stretch = 0.0f;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column)
+            stretch += inverse(row, column) * inverse(row, column);
+    }
+    const float margin = worldSpaceTolerance * std::sqrt(stretch);
+
+    const QVector3D origin = inverse.map(convertToQVector3D(ray.origin()));
+    const QVector3D end = inverse.map(convertToQVector3D(ray.point(ray.distance())));
+
+    const MeshBVHPtr bvh = manager->meshBVHCache()->bvh(manager, provider, primitiveType);
+    std::vector<uint> slots;
+    bvh->collectCandidates(Vector3D(origin.x(), origin.y(), origin.z()),
+                           Vector3D(end.x(), end.y(), end.z()),
+                           infiniteRay, margin, slots);
+    visitor.visitCandidates(*bvh, slots);
+}
+
+} // anonymous
+
 HitList reduceToFirstHit(HitList &result, const HitList &intermediate)
 {
     if (!intermediate.empty()) {
@@ -627,7 +703,7 @@ HitList TriangleCollisionGathererFunctor::pick(const Entity *entity) const
     if (proxy && proxy->isEnabled() && proxy->isValid()) {
         if (rayHitsEntity(entity)) {
             TriangleCollisionVisitor visitor(m_manager, entity, m_ray, m_frontFaceRequested, m_backFaceRequested);
-            visitor.apply(proxy, entity->peerId());
+            visitPrimitivesAlongRay(visitor, m_manager, entity, proxy, MeshBVH::Triangles, m_ray, false, 0.0f);
             result = visitor.hits;
 
             sortHits(result);
@@ -639,7 +715,7 @@ HitList TriangleCollisionGathererFunctor::pick(const Entity *entity) const
 
         if (rayHitsEntity(entity)) {
             TriangleCollisionVisitor visitor(m_manager, entity, m_ray, m_frontFaceRequested, m_backFaceRequested);
-            visitor.apply(gRenderer, entity->peerId());
+            visitPrimitivesAlongRay(visitor, m_manager, entity, gRenderer, MeshBVH::Triangles, m_ray, false, 0.0f);
             result = visitor.hits;
 
             sortHits(result);
@@ -685,7 +761,8 @@ HitList LineCollisionGathererFunctor::pick(const Entity *entity) const
     if (proxy && proxy->isEnabled() && proxy->isValid()) {
         if (rayHitsEntity(entity)) {
             LineCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(proxy, entity->peerId());
+            visitPrimitivesAlongRay(visitor, m_manager, entity, proxy, MeshBVH::Segments,
+                                    m_ray, false, m_pickWorldSpaceTolerance);
             result = visitor.hits;
 
             sortHits(result);
@@ -697,7 +774,8 @@ HitList LineCollisionGathererFunctor::pick(const Entity *entity) const
 
         if (rayHitsEntity(entity)) {
             LineCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(gRenderer, entity->peerId());
+            visitPrimitivesAlongRay(visitor, m_manager, entity, gRenderer, MeshBVH::Segments,
+                                    m_ray, false, m_pickWorldSpaceTolerance);
             result = visitor.hits;
             sortHits(result);
         }
@@ -742,7 +820,8 @@ HitList PointCollisionGathererFunctor::pick(const Entity *entity) const
     if (proxy && proxy->isEnabled() && proxy->isValid() && proxy->primitiveType() != Qt3DCore::QGeometryView::Points) {
         if (rayHitsEntity(entity)) {
             PointCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(proxy, entity->peerId());
+            visitPrimitivesAlongRay(visitor, m_manager, entity, proxy, MeshBVH::Points,
+                                    m_ray, true, m_pickWorldSpaceTolerance);
             result = visitor.hits;
 
             sortHits(result);
@@ -757,7 +836,8 @@ HitList PointCollisionGathererFunctor::pick(const Entity *entity) const
 
         if (rayHitsEntity(entity)) {
             PointCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(gRenderer, entity->peerId());
+            visitPrimitivesAlongRay(visitor, m_manager, entity, gRenderer, MeshBVH::Points,
+                                    m_ray, true, m_pickWorldSpaceTolerance);
             result = visitor.hits;
             sortHits(result);
         }
@@ -784,6 +864,11 @@ void HierarchicalEntityPicker::setLayerIds(const Qt3DCore::QNodeIdVector &layerI
     m_layerFilterMode = mode;
 }
 
+void HierarchicalEntityPicker::setSceneBVH(const SceneBVH *sceneBVH)
+{
+    m_sceneBVH = sceneBVH;
+}
+
 bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
 {
     m_hits.clear();
@@ -810,6 +895,7 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
     std::vector<Entity *> layerFilterEntities;
     FilterLayerEntityJob layerFilterJob;
     layerFilterJob.setManager(manager);
+    const LayerMask layerMask = hasLayers ? layerFilterJob.layerMask(m_layerIds, false) : LayerMask();
 
     if (hasLayerFilters) {
         // Note: we expect UpdateEntityLayersJob was called beforehand to handle layer recursivness
@@ -821,31 +907,17 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
         }
     }
 
-    while (!worklist.empty()) {
-        EntityData current = worklist.back();
-        worklist.pop_back();
-
-        // first pick entry sub-scene-graph
-        QCollisionQueryResult::Hit queryResult =
-                rayCasting.query(m_ray, current.entity->worldBoundingVolumeWithChildren());
-        if (queryResult.m_distance < 0.f)
-            continue;
-
-        // if we get a hit, we check again for this specific entity
-        queryResult = rayCasting.query(m_ray, current.entity->worldBoundingVolume());
-
+    const auto recordHit = [&] (const EntityData &current, const QCollisionQueryResult::Hit &queryResult) {
         // Check Entity is in selected Layers if we have LayerIds or LayerFilterIds
         // Note: it's not because a parent doesn't satisfy the layerFiltering that a child might not.
         // Therefore we need to keep traversing children in all cases
 
         // Are we filtering against layerIds (RayCastingJob)
-        if (hasLayers) {
-            // QLayerFilter::FilterMode and QAbstractRayCaster::FilterMode are the same
-            layerFilterJob.filterEntityAgainstLayers(current.entity, m_layerIds, static_cast<QLayerFilter::FilterMode>(m_layerFilterMode));
-            layerFilterEntities = layerFilterJob.filteredEntities();
-        }
-
-        const bool isInLayers = !hasLayerFiltering || Qt3DCore::contains(layerFilterEntities, current.entity);
+        // QLayerFilter::FilterMode and QAbstractRayCaster::FilterMode are the same
+        const bool isInLayers = !hasLayerFiltering
+                || (hasLayers && FilterLayerEntityJob::matchesLayers(current.entity->layerMask(), layerMask,
+                                                                     static_cast<QLayerFilter::FilterMode>(m_layerFilterMode)))
+                || (hasLayerFilters && Qt3DCore::contains(layerFilterEntities, current.entity));
 
         if (isInLayers && queryResult.m_distance >= 0.f && (current.hasObjectPicker || !m_objectPickersRequired)) {
             m_entities.push_back(current.entity);
@@ -853,6 +925,84 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
             // Record entry for entity/priority
             m_entityToPriorityTable.insert(current.entity->peerId(), current.priority);
         }
+    };
+
+    if (m_sceneBVH != nullptr && m_sceneBVH->root() == root
+            && m_sceneBVH->hierarchyRevision() == manager->renderNodesManager()->hierarchyRevision()) {
+        // Only look at the entities whose own volume may be hit. What the walk
+        // below inherits from the ancestors of an entity is resolved by going
+        // up its parents instead.
+        struct Candidate {
+            // Position of the entity in the walk below, which visits the
+            // children last to first. Hits are recorded in that order so that
+            // sorting them by distance keeps giving the same results.
+            size_t walkIndex;
+            EntityData data;
+            QCollisionQueryResult::Hit queryResult;
+        };
+        std::vector<Candidate> hitCandidates;
+        std::vector<uint> candidates;
+        m_sceneBVH->intersect(m_ray, candidates);
+        for (const uint index : candidates) {
+            Entity *entity = m_sceneBVH->entity(index);
+            const QCollisionQueryResult::Hit queryResult = rayCasting.query(m_ray, entity->worldBoundingVolume());
+            if (queryResult.m_distance < 0.f)
+                continue;
+
+            // The walk only enters the sub-scene-graphs it hits. The priority
+            // comes from the closest object picker, the root one aside.
+            EntityData data = { entity, false, 0 };
+            bool reached = true;
+            bool hasPriority = false;
+            size_t depth = 0;
+            for (Entity *ancestor = entity; ; ++depth) {
+                if (rayCasting.query(m_ray, ancestor->worldBoundingVolumeWithChildren()).m_distance < 0.f) {
+                    reached = false;
+                    break;
+                }
+                if (const ObjectPicker *picker = ancestor->renderComponent<ObjectPicker>()) {
+                    if (!hasPriority && ancestor != root)
+                        data.priority = picker->priority();
+                    data.hasObjectPicker = true;
+                    hasPriority = true;
+                }
+                if (ancestor == root)
+                    break;
+                ancestor = ancestor->parent();
+                if (ancestor == nullptr) {
+                    reached = false;
+                    break;
+                }
+            }
+            if (!reached)
+                continue;
+
+            // Entities of later sibling subtrees, along the way up, are walked first
+            const size_t walkIndex = depth + m_sceneBVH->size() - m_sceneBVH->subtreeEnd(index);
+            hitCandidates.push_back({ walkIndex, data, queryResult });
+        }
+
+        std::sort(hitCandidates.begin(), hitCandidates.end(), [] (const Candidate &a, const Candidate &b) {
+            return a.walkIndex < b.walkIndex;
+        });
+        for (const Candidate &candidate : hitCandidates)
+            recordHit(candidate.data, candidate.queryResult);
+        return !m_hits.empty();
+    }
+
+    while (!worklist.empty()) {
+        EntityData current = worklist.back();
+        worklist.pop_back();
+
+        // first pick entry sub-scene-graph
+        QCollisionQueryResult::Hit queryResult =
+                rayCasting.query(m_ray, current.entity->worldBoundingVolumeWithChildren());
+        if (queryResult.m_distance < 0.f)
+            continue;
+
+        // if we get a hit, we check again for this specific entity
+        queryResult = rayCasting.query(m_ray, current.entity->worldBoundingVolume());
+        recordHit(current, queryResult);
 
         // and pick children
         const auto &childrenHandles = current.entity->childrenHandles();
@@ -74,6 +74,7 @@ class Renderer;
 class FrameGraphNode;
 class RenderSettings;
 class NodeManagers;
+class SceneBVH;
 
 namespace PickingUtils {
 
@@ -125,6 +126,8 @@ public:
 
     void setLayerFilterIds(const Qt3DCore::QNodeIdVector &layerFilterIds);
     void setLayerIds(const Qt3DCore::QNodeIdVector &layerIds, QAbstractRayCaster::FilterMode mode);
+    // Candidate entities are looked up in sceneBVH when it matches the scene
+    void setSceneBVH(const SceneBVH *sceneBVH);
 
     bool collectHits(NodeManagers *manager, Entity *root);
     inline HitList hits() const { return m_hits; }
@@ -140,6 +143,7 @@ private:
     Qt3DCore::QNodeIdVector m_layerIds;
     QAbstractRayCaster::FilterMode m_layerFilterMode = QAbstractRayCaster::AcceptAnyMatchingLayers;
     QHash<Qt3DCore::QNodeId, int> m_entityToPriorityTable;
+    const SceneBVH *m_sceneBVH = nullptr;
 };
 
 struct Q_AUTOTEST_EXPORT AbstractCollisionGathererFunctor
@@ -71,6 +71,8 @@ public:
     explicit EntityCasterGatherer(NodeManagers *manager, RayCaster *trigger = nullptr)
         : EntityVisitor(manager), m_trigger(trigger) {
         setPruneDisabled(true);
+        // Runs after the bounding volumes were expanded
+        setUseFlatHierarchy(true);
     }
 
     Operation visit(Entity *entity) override {
@@ -202,6 +204,7 @@ bool RayCastingJob::pick(const QList<QPair<Entity *, RayCaster *>> &entities)
             PickingUtils::HitList sphereHits;
             PickingUtils::HierarchicalEntityPicker entityPicker(ray, false);
             entityPicker.setLayerIds(pair.second->layerIds(), pair.second->filterMode());
+            entityPicker.setSceneBVH(m_sceneBVH);
             if (entityPicker.collectHits(m_manager, m_node)) {
                 if (pickConfiguration.trianglePickingRequested) {
                     PickingUtils::TriangleCollisionGathererFunctor gathererFunctor;
@@ -56,6 +56,8 @@
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/renderviewjobutils_p.h>
 #include <Qt3DRender/private/lightsource_p.h>
+#include <QRectF>
+#include <QSize>
 
 QT_BEGIN_NAMESPACE
 
@@ -63,18 +65,59 @@ namespace Qt3DRender {
 
 namespace Render {
 
+// What a RenderViewCommandUpdaterJob has to refresh on a cached RenderCommand
+enum class RenderCommandUpdate : quint8
+{
+    Frame,  // Only the values that change every frame (time, skinning palette)
+    Camera, // Depth and the camera dependent standard uniforms
+    Full    // Everything, as for a newly built command
+};
+
+// Revisions of the inputs a RenderCommand was last updated with
+struct RenderCommandUpdateStamp
+{
+    uint uniformsRevision = 0;
+    uint cameraRevision = 0;
+    uint transformRevision = 0;
+};
+
+// Values the camera dependent standard uniforms of a RenderView are computed from
+struct RenderViewCameraState
+{
+    Matrix4x4 viewMatrix;
+    Matrix4x4 viewProjectionMatrix;
+    QRectF viewport;
+    QSize surfaceSize;
+    float gamma = 0.0f;
+    float exposure = 0.0f;
+
+    bool operator==(const RenderViewCameraState &other) const noexcept
+    {
+        return viewMatrix == other.viewMatrix &&
+                viewProjectionMatrix == other.viewProjectionMatrix &&
+                viewport == other.viewport &&
+                surfaceSize == other.surfaceSize &&
+                gamma == other.gamma &&
+                exposure == other.exposure;
+    }
+
+    bool operator!=(const RenderViewCameraState &other) const noexcept { return !(*this == other); }
+};
+
 template<class RenderCommand>
 struct EntityRenderCommandData
 {
     std::vector<const Entity *> entities;
     std::vector<RenderCommand> commands;
     std::vector<RenderPassParameterData> passesData;
+    std::vector<RenderCommandUpdateStamp> updateStamps;
 
     void reserve(size_t size)
     {
         entities.reserve(size);
         commands.reserve(size);
         passesData.reserve(size);
+        updateStamps.reserve(size);
     }
 
     inline size_t size() const { return entities.size(); }
@@ -84,6 +127,7 @@ struct EntityRenderCommandData
         entities.push_back(e);
         commands.push_back(c);
         passesData.push_back(p);
+        updateStamps.push_back({});
     }
 
     inline void push_back(const Entity *e, RenderCommand &&c, RenderPassParameterData &&p)
@@ -91,6 +135,7 @@ struct EntityRenderCommandData
         entities.push_back(e);
         commands.push_back(std::move(c));
         passesData.push_back(std::move(p));
+        updateStamps.push_back({});
     }
 
     EntityRenderCommandData &operator+=(EntityRenderCommandData &&t)
@@ -98,6 +143,7 @@ struct EntityRenderCommandData
         Qt3DCore::moveAtEnd(entities, std::move(t.entities));
         Qt3DCore::moveAtEnd(commands, std::move(t.commands));
         Qt3DCore::moveAtEnd(passesData, std::move(t.passesData));
+        Qt3DCore::moveAtEnd(updateStamps, std::move(t.updateStamps));
         return *this;
     }
 
@@ -109,8 +155,19 @@ struct EntityRenderCommandDataView
     EntityRenderCommandData<RenderCommand> data;
     std::vector<size_t> indices;
 
+    // Incremented by SyncRenderViewPreCommandUpdate when the uniforms of all
+    // the commands, or only their camera dependent values, have to be updated
+    uint uniformsRevision = 1;
+    uint cameraRevision = 1;
+
     size_t size() const noexcept { return indices.size(); }
 
+    // Makes the next forEachUpdate give a Full update to the command at idx
+    void requestFullUpdate(size_t idx)
+    {
+        data.updateStamps[idx].uniformsRevision = uniformsRevision - 1;
+    }
+
     template<typename F>
     void forEachCommand(F func)
     {
@@ -150,6 +207,33 @@ struct EntityRenderCommandDataSubView
                  view->data.commands[idx]);
         }
     }
+
+    // Like forEach, but also passes what changed since the command was last
+    // updated, and records that it is now up to date
+    template<typename F>
+    void forEachUpdate(F func) const
+    {
+        const uint uniformsRevision = view->uniformsRevision;
+        const uint cameraRevision = view->cameraRevision;
+        for (size_t i = 0, m = size_t(count); i < m; ++i) {
+            const size_t idx = view->indices[offset + i];
+            const Entity *entity = view->data.entities[idx];
+            const uint transformRevision = entity->worldTransformRevision();
+            RenderCommandUpdateStamp &stamp = view->data.updateStamps[idx];
+
+            RenderCommandUpdate update = RenderCommandUpdate::Frame;
+            if (stamp.uniformsRevision != uniformsRevision || stamp.transformRevision != transformRevision)
+                update = RenderCommandUpdate::Full;
+            else if (stamp.cameraRevision != cameraRevision)
+                update = RenderCommandUpdate::Camera;
+            stamp = { uniformsRevision, cameraRevision, transformRevision };
+
+            func(entity,
+                 view->data.passesData[idx],
+                 view->data.commands[idx],
+                 update);
+        }
+    }
 };
 
 template<class RenderCommand>
@@ -164,6 +248,12 @@ struct RendererCache
 
         // Set by the MaterialParameterGatherJob
         MaterialParameterGathererData materialParameterGatherer;
+        // Used to only gather the materials affected by changes again
+        MaterialParameterGathererDependencies materialParameterGathererDependencies;
+
+        // Filled by SyncPreCommandBuilding, reset along with materialParameterGatherer
+        // State sets of the render passes, shared by the RenderCommands of the RV
+        RenderPassStateSets renderPassStateSets;
 
         // Set by the SyncRenderViewPreCommandUpdateJob
         // Contains caches of different filtering stages that can
@@ -174,6 +264,14 @@ struct RendererCache
 
         // Cache of RenderCommands
         EntityRenderCommandDataViewPtr<RenderCommand> filteredRenderCommandDataViews;
+
+        // Set by the SyncRenderViewPreCommandUpdateJob
+        // Inputs of the uniforms of the cached RenderCommands, compared from
+        // frame to frame to know which commands have to be updated
+        RenderViewCameraState cameraState;
+        std::vector<std::pair<const Entity *, uint>> lightTransformRevisions;
+        EnvironmentLight *environmentLight = nullptr;
+        uint shaderDataTransformsRevision = 0;
     };
 
     // Variabled below are shared amongst all RV
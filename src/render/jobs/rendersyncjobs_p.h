@@ -60,6 +60,8 @@
 #include <Qt3DRender/private/renderviewcommandbuilderjob_p.h>
 #include <Qt3DRender/private/renderviewcommandupdaterjob_p.h>
 #include <Qt3DRender/private/renderercache_p.h>
+#include <Qt3DRender/private/updateshaderdatatransformjob_p.h>
+#include <Qt3DRender/private/cameralens_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -71,7 +73,9 @@ enum RebuildFlag {
     FullCommandRebuild = 1 << 0,
     LayerCacheRebuild = 1 << 1,
     MaterialCacheRebuild = 1 << 2,
-    LightCacheRebuild = 1 << 3
+    LightCacheRebuild = 1 << 3,
+    MaterialCacheFullRebuild = 1 << 4,
+    CommandUniformsUpdate = 1 << 5
 };
 Q_DECLARE_FLAGS(RebuildFlagSet, RebuildFlag)
 Q_DECLARE_OPERATORS_FOR_FLAGS(RebuildFlagSet)
@@ -105,12 +109,21 @@ public:
 
         Q_ASSERT(cache->leafNodeCache.contains(m_leafNode));
         // The cache leaf should already have been created so we don't need to protect the access
-        const auto &dataCacheForLeaf = cache->leafNodeCache[m_leafNode];
+        auto &dataCacheForLeaf = cache->leafNodeCache[m_leafNode];
         RenderView *rv = m_renderViewInitializer->renderView();
         const auto &entities = !rv->isCompute() ? cache->renderableEntities : cache->computeEntities;
 
         rv->setMaterialParameterTable(dataCacheForLeaf.materialParameterGatherer);
 
+        // Build the state sets of the passes once rather than for each command,
+        // they remain valid until the materials or the FrameGraph change
+        addRenderPassStateSets(&dataCacheForLeaf.renderPassStateSets,
+                               dataCacheForLeaf.materialParameterGatherer,
+                               rv->stateSet(),
+                               m_renderer->defaultRenderState(),
+                               m_renderer->nodeManagers()->renderStateManager());
+        rv->setRenderPassStateSets(dataCacheForLeaf.renderPassStateSets);
+
         // Split among the ideal number of command builders
         const int jobCount = int(m_renderViewCommandBuilderJobs.size());
         const int entityCount = int(entities.size());
@@ -228,9 +241,12 @@ public:
             materialGatherer->setTechniqueFilter(const_cast<TechniqueFilter *>(rv->techniqueFilter()));
         }
 
-        // Command builders and updates
-        for (const auto &renderViewCommandUpdater : m_renderViewCommandUpdaterJobs)
+        // Command builders and updates. Updaters are kept across frames and
+        // must only update the commands handed to them for this frame.
+        for (const auto &renderViewCommandUpdater : m_renderViewCommandUpdaterJobs) {
             renderViewCommandUpdater->setRenderView(rv);
+            renderViewCommandUpdater->setRenderablesSubView({});
+        }
         for (const auto &renderViewCommandBuilder : m_renderViewCommandBuilderJobs)
             renderViewCommandBuilder->setRenderView(rv);
 
@@ -438,6 +454,61 @@ public:
                 cacheForLeaf.filteredRenderCommandDataViews->indices = std::move(filteredCommandIndices);
             }
 
+            // Find out which inputs of the cached commands changed since the previous
+            // frame, commands only get refreshed from what changed for them
+            {
+                bool uniformsDirty = m_rebuildFlags.testFlag(RebuildFlag::CommandUniformsUpdate);
+
+                // Lights uniforms depend on the position of the light entities
+                std::vector<std::pair<const Entity *, uint>> lightTransformRevisions;
+                lightTransformRevisions.reserve(cacheForLeaf.layeredFilteredLightSources.size());
+                for (const LightSource &lightSource : cacheForLeaf.layeredFilteredLightSources)
+                    lightTransformRevisions.push_back({ lightSource.entity, lightSource.entity->worldTransformRevision() });
+                if (lightTransformRevisions != cacheForLeaf.lightTransformRevisions) {
+                    cacheForLeaf.lightTransformRevisions = std::move(lightTransformRevisions);
+                    uniformsDirty = true;
+                }
+                if (cache->environmentLight != cacheForLeaf.environmentLight) {
+                    cacheForLeaf.environmentLight = cache->environmentLight;
+                    uniformsDirty = true;
+                }
+
+                // ShaderData values can be expressed relative to the entity they're attached to
+                const uint shaderDataTransformsRevision = m_renderer->updateShaderDataTransformJob()->transformsRevision();
+                if (shaderDataTransformsRevision != cacheForLeaf.shaderDataTransformsRevision) {
+                    cacheForLeaf.shaderDataTransformsRevision = shaderDataTransformsRevision;
+                    uniformsDirty = true;
+                }
+
+                const RenderViewCameraState cameraState = renderViewCameraState(rv);
+                const bool cameraStateDirty = cameraState != cacheForLeaf.cameraState;
+                if (cameraStateDirty)
+                    cacheForLeaf.cameraState = cameraState;
+
+                // ShaderData values transformed ModelToEye are computed from the view
+                // matrix, a Camera update doesn't refresh them
+                NodeManagers *managers = m_renderer->nodeManagers();
+                const bool viewDependentUpdates = cameraStateDirty && !uniformsDirty;
+                if (viewDependentUpdates)
+                    uniformsDirty = lightsDependOnViewMatrix(managers, cache->environmentLight,
+                                                             cacheForLeaf.layeredFilteredLightSources);
+
+                if (uniformsDirty)
+                    ++filteredCommandData->uniformsRevision;
+                if (cameraStateDirty)
+                    ++filteredCommandData->cameraRevision;
+
+                if (viewDependentUpdates && !uniformsDirty) {
+                    for (size_t idx : filteredCommandData->indices) {
+                        if (parametersDependOnViewMatrix(managers, filteredCommandData->data.passesData[idx].parameterInfo))
+                            filteredCommandData->requestFullUpdate(idx);
+                    }
+                }
+
+                // Compute the standard uniforms that don't depend on entities once for all commands
+                rv->updateViewUniforms();
+            }
+
             // Split among the number of command updaters
             const int jobCount = int(m_renderViewCommandUpdaterJobs.size());
             const int commandCount = int(filteredCommandData->size());
@@ -445,10 +516,6 @@ public:
             const int m = findIdealNumberOfWorkers(commandCount, idealPacketSize, jobCount);
 
             for (int i = 0; i < m; ++i) {
-                // TO DO: Based on whether we had to update the commands
-                // we should be able to know what needs to be recomputed
-                // -> lights/standard uniforms ... might no have to be set over and over again
-                // if they are identical
                 const RenderViewCommandUpdaterJobPtrAlias &renderViewCommandUpdater = m_renderViewCommandUpdaterJobs.at(i);
                 const size_t count = (i == m - 1) ? commandCount - (i * idealPacketSize) : idealPacketSize;
                 renderViewCommandUpdater->setRenderablesSubView({filteredCommandData, size_t(i * idealPacketSize), count});
@@ -457,6 +524,18 @@ public:
     }
 
 private:
+    static RenderViewCameraState renderViewCameraState(const RenderView *rv)
+    {
+        RenderViewCameraState state;
+        state.viewMatrix = rv->viewMatrix();
+        state.viewProjectionMatrix = rv->viewProjectionMatrix();
+        state.viewport = rv->viewport();
+        state.surfaceSize = rv->surfaceSize();
+        state.gamma = rv->gamma();
+        state.exposure = rv->renderCameraLens() ? rv->renderCameraLens()->exposure() : 0.0f;
+        return state;
+    }
+
     RenderViewInitializerJobPtrAlias m_renderViewJob;
     FrustumCullingJobPtr m_frustumCullingJob;
     FilterProximityDistanceJobPtr m_filterProximityJob;
@@ -503,10 +582,14 @@ class SyncMaterialParameterGatherer
 public:
     explicit SyncMaterialParameterGatherer(const std::vector<MaterialParameterGathererJobPtr> &materialParameterGathererJobs,
                                            Renderer *renderer,
-                                           FrameGraphNode *leafNode)
+                                           FrameGraphNode *leafNode,
+                                           bool fullRebuild,
+                                           std::vector<Qt3DCore::QNodeId> &&removedMaterials)
         : m_materialParameterGathererJobs(materialParameterGathererJobs)
         , m_renderer(renderer)
         , m_leafNode(leafNode)
+        , m_fullRebuild(fullRebuild)
+        , m_removedMaterials(std::move(removedMaterials))
     {
     }
 
@@ -516,7 +599,24 @@ public:
         // so we don't need to protect the access
         QMutexLocker lock(m_renderer->cache()->mutex());
         auto &dataCacheForLeaf = m_renderer->cache()->leafNodeCache[m_leafNode];
-        dataCacheForLeaf.materialParameterGatherer.clear();
+        // Render states might have changed as well, state sets are cheap to rebuild
+        dataCacheForLeaf.renderPassStateSets.clear();
+
+        if (m_fullRebuild) {
+            dataCacheForLeaf.materialParameterGatherer.clear();
+            dataCacheForLeaf.materialParameterGathererDependencies.clear();
+        } else {
+            // Only drop what is about to be replaced
+            for (const Qt3DCore::QNodeId &materialId : qAsConst(m_removedMaterials)) {
+                dataCacheForLeaf.materialParameterGatherer.remove(materialId);
+                dataCacheForLeaf.materialParameterGathererDependencies.remove(materialId);
+            }
+            for (const auto &materialGatherer : m_materialParameterGathererJobs) {
+                const MaterialParameterGathererDependencies &dependencies = materialGatherer->materialDependencies();
+                for (auto it = std::begin(dependencies); it != std::end(dependencies); ++it)
+                    dataCacheForLeaf.materialParameterGatherer.remove(it.key());
+            }
+        }
 
         for (const auto &materialGatherer : m_materialParameterGathererJobs) {
             const MaterialParameterGathererData &source = materialGatherer->materialToPassAndParameter();
@@ -524,6 +624,7 @@ public:
                 Q_ASSERT(!dataCacheForLeaf.materialParameterGatherer.contains(it.key()));
                 dataCacheForLeaf.materialParameterGatherer.insert(it.key(), it.value());
             }
+            dataCacheForLeaf.materialParameterGathererDependencies.insert(materialGatherer->materialDependencies());
         }
     }
 
@@ -531,6 +632,8 @@ private:
     std::vector<MaterialParameterGathererJobPtr> m_materialParameterGathererJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
+    bool m_fullRebuild;
+    std::vector<Qt3DCore::QNodeId> m_removedMaterials;
 };
 
 } // Render
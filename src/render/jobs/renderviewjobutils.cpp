@@ -47,12 +47,16 @@
 #include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/effect_p.h>
+#include <Qt3DRender/private/renderpass_p.h>
 #include <Qt3DRender/private/renderpassfilternode_p.h>
 #include <Qt3DRender/private/techniquemanager_p.h>
 #include <Qt3DRender/private/techniquefilternode_p.h>
 #include <Qt3DRender/private/renderstatenode_p.h>
 #include <Qt3DRender/private/renderstates_p.h>
 #include <Qt3DRender/private/renderstateset_p.h>
+#include <Qt3DRender/private/environmentlight_p.h>
+#include <Qt3DRender/private/light_p.h>
+#include <Qt3DRender/private/lightsource_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -157,6 +161,43 @@ RenderPassList findRenderPassesForTechnique(NodeManagers *manager,
 }
 
 
+namespace {
+
+bool shaderDataDependsOnViewMatrix(NodeManagers *manager, QNodeId shaderDataId)
+{
+    const ShaderData *shaderData = manager->shaderDataManager()->lookupResource(shaderDataId);
+    return shaderData != nullptr && shaderData->hasViewDependentProperties();
+}
+
+} // anonymous
+
+bool parametersDependOnViewMatrix(NodeManagers *manager, const ParameterInfoList &parameters)
+{
+    for (const ParameterInfo &paramInfo : parameters) {
+        const Parameter *param = manager->parameterManager()->data(paramInfo.handle);
+        const UniformValue &uniformValue = param->uniformValue();
+        if (uniformValue.valueType() == UniformValue::NodeId &&
+                shaderDataDependsOnViewMatrix(manager, *uniformValue.constData<QNodeId>()))
+            return true;
+    }
+    return false;
+}
+
+bool lightsDependOnViewMatrix(NodeManagers *manager,
+                              const EnvironmentLight *environmentLight,
+                              const std::vector<LightSource> &lightSources)
+{
+    if (environmentLight != nullptr && shaderDataDependsOnViewMatrix(manager, environmentLight->shaderData()))
+        return true;
+    for (const LightSource &lightSource : lightSources) {
+        for (const Light *light : lightSource.lights) {
+            if (shaderDataDependsOnViewMatrix(manager, light->shaderData()))
+                return true;
+        }
+    }
+    return false;
+}
+
 ParameterInfoList::const_iterator findParamInfo(ParameterInfoList *params, const int nameId)
 {
     const ParameterInfoList::const_iterator end = params->cend();
@@ -210,6 +251,63 @@ void addStatesToRenderStateSet(RenderStateSet *stateSet,
     }
 }
 
+/*!
+    \internal
+    Builds the state sets of the render passes referenced by \a parameters
+    which aren't in \a stateSets yet. Passes built from the same enabled
+    render states share the same RenderStateSet. The sets are merged with
+    \a globalState, or with \a defaultState if the RenderView has no states
+    of its own, just like the renderers did at submission time.
+*/
+void addRenderPassStateSets(RenderPassStateSets *stateSets,
+                            const MaterialParameterGathererData &parameters,
+                            const RenderStateSet *globalState,
+                            RenderStateSet *defaultState,
+                            RenderStateManager *manager)
+{
+    // Sets built so far indexed by their render states, only filled in once
+    // a pass without a set is found
+    QHash<QList<Qt3DCore::QNodeId>, RenderPassStateSet> setsByStates;
+    bool indexed = false;
+
+    for (const std::vector<RenderPassParameterData> &passesData : parameters) {
+        for (const RenderPassParameterData &passData : passesData) {
+            const RenderPass *pass = passData.pass;
+            if (!pass->hasRenderStates() || stateSets->contains(pass->peerId()))
+                continue;
+
+            if (!indexed) {
+                for (const RenderPassStateSet &other : qAsConst(*stateSets))
+                    setsByStates.insert(other.stateIds, other);
+                indexed = true;
+            }
+
+            QList<Qt3DCore::QNodeId> stateIds;
+            const QList<Qt3DCore::QNodeId> renderStates = pass->renderStates();
+            for (const Qt3DCore::QNodeId &stateId : renderStates) {
+                const RenderStateNode *node = manager->lookupResource(stateId);
+                if (node && node->isEnabled())
+                    stateIds.push_back(stateId);
+            }
+
+            auto it = setsByStates.find(stateIds);
+            if (it == setsByStates.end()) {
+                RenderPassStateSet passStateSet;
+                passStateSet.stateIds = stateIds;
+                passStateSet.stateSet = QSharedPointer<RenderStateSet>::create();
+                addStatesToRenderStateSet(passStateSet.stateSet.data(), stateIds, manager);
+                if (globalState)
+                    passStateSet.stateSet->merge(globalState);
+                passStateSet.changeCost = defaultState->changeCost(passStateSet.stateSet.data());
+                if (!globalState)
+                    passStateSet.stateSet->merge(defaultState);
+                it = setsByStates.insert(stateIds, passStateSet);
+            }
+            stateSets->insert(pass->peerId(), it.value());
+        }
+    }
+}
+
 ParameterInfo::ParameterInfo(const int nameId, const HParameter &handle)
     : nameId(nameId)
     , handle(handle)
@@ -55,6 +55,7 @@
 #include <Qt3DRender/private/qt3drender_global_p.h>
 #include <Qt3DCore/qnodeid.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qvariant.h>
 #include <Qt3DRender/private/uniform_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
@@ -80,6 +81,8 @@ class TextureManager;
 class RenderStateManager;
 class RenderStateCollection;
 class RenderStateSet;
+class EnvironmentLight;
+struct LightSource;
 
 Q_3DRENDERSHARED_PRIVATE_EXPORT Technique *findTechniqueForEffect(NodeManagers *manager,
                                                                   const TechniqueFilter *techniqueFilter,
@@ -118,6 +121,9 @@ struct RenderPassParameterData
 QT3D_DECLARE_TYPEINFO_2(Qt3DRender, Render, RenderPassParameterData, Q_RELOCATABLE_TYPE)
 
 using MaterialParameterGathererData = QMultiHash<Qt3DCore::QNodeId, std::vector<RenderPassParameterData>>;
+// Material id to the ids of the nodes its gathered parameters were built from:
+// its Effect, the RenderPasses of the selected Technique and their Parameters
+using MaterialParameterGathererDependencies = QHash<Qt3DCore::QNodeId, std::vector<Qt3DCore::QNodeId>>;
 
 Q_3DRENDERSHARED_PRIVATE_EXPORT void parametersFromMaterialEffectTechnique(ParameterInfoList *infoList,
                                              ParameterManager *manager,
@@ -136,6 +142,15 @@ void parametersFromParametersProvider(ParameterInfoList *infoList,
     addParametersForIds(infoList, manager, provider->parameters());
 }
 
+// True if a ShaderData referenced by the parameters, or by the lights, has
+// values transformed ModelToEye, which change with the view matrix
+Q_3DRENDERSHARED_PRIVATE_EXPORT bool parametersDependOnViewMatrix(NodeManagers *manager,
+                                                                  const ParameterInfoList &parameters);
+
+Q_3DRENDERSHARED_PRIVATE_EXPORT bool lightsDependOnViewMatrix(NodeManagers *manager,
+                                                              const EnvironmentLight *environmentLight,
+                                                              const std::vector<LightSource> &lightSources);
+
 Q_3DRENDERSHARED_PRIVATE_EXPORT ParameterInfoList::const_iterator findParamInfo(ParameterInfoList *infoList,
                                                                                 const int nameId);
 
@@ -143,6 +158,25 @@ Q_3DRENDERSHARED_PRIVATE_EXPORT void addStatesToRenderStateSet(RenderStateSet *s
                                                                const QList<Qt3DCore::QNodeId> stateIds,
                                                                RenderStateManager *manager);
 
+// State set of a RenderPass with render states, merged with the global states
+// of a RenderView. It is shared by all the RenderCommands built for that pass
+// and must not be modified once built.
+struct RenderPassStateSet
+{
+    QSharedPointer<RenderStateSet> stateSet;
+    // Enabled render states the set was built from, passes built from the
+    // same states share the same set
+    QList<Qt3DCore::QNodeId> stateIds;
+    int changeCost = 0;
+};
+using RenderPassStateSets = QHash<Qt3DCore::QNodeId, RenderPassStateSet>;
+
+Q_3DRENDERSHARED_PRIVATE_EXPORT void addRenderPassStateSets(RenderPassStateSets *stateSets,
+                                                            const MaterialParameterGathererData &parameters,
+                                                            const RenderStateSet *globalState,
+                                                            RenderStateSet *defaultState,
+                                                            RenderStateManager *manager);
+
 Q_3DRENDERSHARED_PRIVATE_EXPORT int findIdealNumberOfWorkers(int elementCount, int packetSize = 100, int maxJobCount = 1)
 ;
 
@@ -71,6 +71,12 @@ void UpdateEntityLayersJob::run()
 
     LayerManager *layerManager = m_manager->layerManager();
 
+    // Assign dense indices to the layers so that they can be stored as bits,
+    // LayerMask::UnknownLayerIndex is kept free
+    const std::vector<HLayer> &layerHandles = layerManager->activeHandles();
+    for (size_t i = 0, m = layerHandles.size(); i < m; ++i)
+        layerManager->data(layerHandles[i])->setLayerIndex(LayerMask::UnknownLayerIndex + 1 + int(i));
+
     // Set recursive layerIds on children
     for (const HEntity &handle : handles) {
         Entity *entity = entityManager->data(handle);
@@ -86,6 +92,21 @@ void UpdateEntityLayersJob::run()
             }
         }
     }
+
+    // Build the layer masks out of the direct and recursive layers
+    LayerMask layerMask;
+    for (const HEntity &handle : handles) {
+        Entity *entity = entityManager->data(handle);
+        const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
+
+        layerMask.clear();
+        for (const Qt3DCore::QNodeId &layerId : entityLayers) {
+            const Layer *layer = layerManager->lookupResource(layerId);
+            if (layer != nullptr)
+                layerMask.setBit(layer->layerIndex());
+        }
+        entity->setLayerMask(layerMask);
+    }
 }
 
 } // Render
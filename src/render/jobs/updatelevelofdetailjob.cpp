@@ -68,6 +68,8 @@ public:
         , m_frameGraphRoot(frameGraphRoot)
     {
         m_updatedIndices.reserve(manager->levelOfDetailManager()->count());
+        // Runs after the bounding volumes were expanded
+        setUseFlatHierarchy(true);
     }
 
     double filterValue() const { return m_filterValue; }
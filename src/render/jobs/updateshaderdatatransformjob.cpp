@@ -60,6 +60,7 @@ namespace Render {
 
 UpdateShaderDataTransformJob::UpdateShaderDataTransformJob()
     : m_manager(nullptr)
+    , m_transformsRevision(0)
 {
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::UpdateShaderDataTransform, 0)
 }
@@ -82,14 +83,18 @@ void UpdateShaderDataTransformJob::run()
 {
     EntityManager *manager = m_manager->renderNodesManager();
     const std::vector<HEntity> &handles = manager->activeHandles();
+    bool transformsChanged = false;
 
     for (const HEntity &handle : handles) {
         Entity *node = manager->data(handle);
         // Update transform properties in ShaderDatas and Lights
         const std::vector<ShaderData *> &shaderDatas = node->renderComponents<ShaderData>();
         for (ShaderData *r : shaderDatas)
-            r->updateWorldTransform(*node->worldTransform());
+            transformsChanged |= r->updateWorldTransform(*node->worldTransform());
     }
+
+    if (transformsChanged)
+        ++m_transformsRevision;
 }
 
 } // namespace Render
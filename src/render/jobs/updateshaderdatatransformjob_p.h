@@ -71,10 +71,14 @@ public:
     void setManagers(NodeManagers *manager);
     NodeManagers *managers() const;
 
+    // Incremented by every run that changed the world transform of a ShaderData
+    uint transformsRevision() const { return m_transformsRevision; }
+
     void run() final;
 
 private:
     NodeManagers *m_manager;
+    uint m_transformsRevision;
 };
 
 typedef QSharedPointer<UpdateShaderDataTransformJob> UpdateShaderDataTransformJobPtr;
@@ -51,7 +51,6 @@ namespace Render {
 UpdateSkinningPaletteJob::UpdateSkinningPaletteJob()
     : Qt3DCore::QAspectJob()
     , m_nodeManagers(nullptr)
-    , m_root()
 {
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::UpdateSkinningPalette, 0)
 }
@@ -80,26 +79,24 @@ void UpdateSkinningPaletteJob::run()
             skeleton->setLocalPose(jointHandle, joint->localPose());
     }
 
-    // Find all the armature components and update their skinning palettes
-    QList<HArmature> dirtyArmatures;
-    m_root->traverse([&dirtyArmatures](Entity *entity) {
-        const auto armatureHandle = entity->componentHandle<Armature>();
-        if (!armatureHandle.isNull() && !dirtyArmatures.contains(armatureHandle))
-            dirtyArmatures.push_back(armatureHandle);
-    });
-
-    // Update the skeleton for each dirty armature
+    // Skinning palettes are computed once per skeleton and only for the
+    // skeletons whose local poses changed. The armatures sharing a skeleton
+    // copy its palette when their copy is out of date.
     auto skeletonManager = m_nodeManagers->skeletonManager();
-    for (const auto &armatureHandle : qAsConst(dirtyArmatures)) {
-        auto armature = armatureManager->data(armatureHandle);
-        Q_ASSERT(armature);
+    const std::vector<HArmature> &armatureHandles = armatureManager->activeHandles();
+    for (const HArmature &armatureHandle : armatureHandles) {
+        Armature *armature = armatureManager->data(armatureHandle);
+        Skeleton *skeleton = skeletonManager->lookupResource(armature->skeletonId());
+        if (!skeleton)
+            continue;
 
-        auto skeletonId = armature->skeletonId();
-        auto skeleton = skeletonManager->lookupResource(skeletonId);
-        Q_ASSERT(skeleton);
+        if (skeleton->isSkinningPaletteDirty())
+            skeleton->updateSkinningPalette();
 
-        const QVector<QMatrix4x4> &skinningPalette = skeleton->calculateSkinningMatrixPalette();
-        armature->skinningPaletteUniform().setData(skinningPalette);
+        if (armature->skinningPaletteRevision() != skeleton->skinningPaletteRevision()) {
+            armature->skinningPaletteUniform() = skeleton->skinningPalette();
+            armature->setSkinningPaletteRevision(skeleton->skinningPaletteRevision());
+        }
     }
 }
 
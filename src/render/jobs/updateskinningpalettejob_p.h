@@ -71,7 +71,6 @@ public:
     explicit UpdateSkinningPaletteJob();
     ~UpdateSkinningPaletteJob();
 
-    void setRoot(Entity *root) { m_root = root; }
     void setManagers(NodeManagers *nodeManagers) { m_nodeManagers = nodeManagers; }
 
     void setDirtyJoints(const QList<HJoint> dirtyJoints) { m_dirtyJoints = dirtyJoints; }
@@ -80,7 +79,6 @@ public:
 protected:
     void run() override;
     NodeManagers *m_nodeManagers;
-    Entity *m_root;
     QList<HJoint> m_dirtyJoints;
 };
 
@@ -57,6 +57,24 @@ UpdateWorldBoundingVolumeJob::UpdateWorldBoundingVolumeJob()
 
 void UpdateWorldBoundingVolumeJob::run()
 {
+    // Stream over the flattened scene when the transform job has refreshed it
+    FlatEntityHierarchy *hierarchy = m_manager->flatHierarchy();
+    if (hierarchy->isUpToDate(m_manager->hierarchyRevision())) {
+        for (uint i = 0, m = uint(hierarchy->size()); i < m; ++i) {
+            Entity *node = hierarchy->entity(i);
+            if (!node->isEnabled())
+                continue;
+            Sphere *worldBoundingVolume = node->worldBoundingVolume();
+            const Sphere transformedBoundingVolume = node->localBoundingVolume()->transformed(*(node->worldTransform()));
+            if (transformedBoundingVolume.center() != worldBoundingVolume->center()
+                    || transformedBoundingVolume.radius() != worldBoundingVolume->radius())
+                hierarchy->markBoundsChanged(i);
+            *worldBoundingVolume = transformedBoundingVolume;
+            *(node->worldBoundingVolumeWithChildren()) = transformedBoundingVolume; // expanded in UpdateBoundingVolumeJob
+        }
+        return;
+    }
+
     const std::vector<HEntity> &handles = m_manager->activeHandles();
 
     for (const HEntity &handle : handles) {
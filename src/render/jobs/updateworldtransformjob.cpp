@@ -45,12 +45,17 @@
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/transform_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
+#include <Qt3DRender/private/genericlambdajob_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
 
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+
 #include <QThread>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -64,32 +69,90 @@ struct TransformUpdate
     QMatrix4x4 worldTransformMatrix;
 };
 
-void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Matrix4x4 &parentTransform, QList<TransformUpdate> &updatedTransforms)
+// Independent subtrees processed by a single thread, along with their results
+struct SubtreeBatch
 {
-    if (!node->isEnabled())
-        return;
+    std::vector<uint> roots;
+    QList<TransformUpdate> updatedTransforms;
+    std::vector<Transform *> dirtyTransforms;
+};
 
-    Matrix4x4 worldTransform(parentTransform);
+// How the world transform of an entity changed during a run, which tells
+// whether its children have to be revisited
+enum WorldTransformState : quint8 {
+    WorldTransformUnchanged = 0,
+    WorldTransformChanged,
+    // Entities sharing a Transform only skip their disabled subtrees, the
+    // Transform dirty flag may have been cleared while a subtree was
+    // disabled. A world dirty entity (re-enabled, reparented...) therefore
+    // forces its whole subtree to be recomputed.
+    WorldTransformSubtreeDirty
+};
+
+// Updates the world transform of the enabled node at index and returns how it
+// changed. Children of an unchanged node without changes of their own can be
+// skipped.
+quint8 updateWorldTransform(FlatEntityHierarchy *hierarchy, uint index, const Matrix4x4 &parentTransform,
+                            quint8 parentState, SubtreeBatch &batch)
+{
+    Entity *node = hierarchy->entity(index);
     Transform *nodeTransform = node->renderComponent<Transform>();
+    const bool transformDirty = nodeTransform != nullptr && nodeTransform->isTransformDirty();
+    // Transforms can be shared between entities, they are only marked
+    // clean once all of them have been updated
+    if (transformDirty)
+        batch.dirtyTransforms.push_back(nodeTransform);
 
+    const bool worldTransformDirty = node->isWorldTransformDirty();
+    if (parentState == WorldTransformUnchanged && !transformDirty && !worldTransformDirty)
+        return WorldTransformUnchanged;
+    node->unsetWorldTransformDirty();
+    const bool subtreeDirty = worldTransformDirty || parentState == WorldTransformSubtreeDirty;
+
+    Matrix4x4 worldTransform = parentTransform;
     const bool hasTransformComponent = nodeTransform != nullptr && nodeTransform->isEnabled();
     if (hasTransformComponent)
         worldTransform = worldTransform * nodeTransform->transformMatrix();
 
-    if (*(node->worldTransform()) != worldTransform) {
-        *(node->worldTransform()) = worldTransform;
-        if (hasTransformComponent)
-            updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
-    }
+    Matrix4x4 *nodeWorldTransform = node->worldTransform();
+    if (*nodeWorldTransform == worldTransform)
+        return subtreeDirty ? WorldTransformSubtreeDirty : WorldTransformUnchanged;
+
+    *nodeWorldTransform = worldTransform;
+    node->markWorldTransformChanged();
+    if (hasTransformComponent)
+        batch.updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
+    return subtreeDirty ? WorldTransformSubtreeDirty : WorldTransformChanged;
+}
 
-    const auto &childrenHandles = node->childrenHandles();
-    for (const HEntity &handle : childrenHandles) {
-        Entity *child = manager->renderNodesManager()->data(handle);
-        if (child)
-            updateWorldTransformAndBounds(manager, child, worldTransform, updatedTransforms);
+// Streams over the subtree rooted at root, parents always come first.
+// Disabled entities are skipped along with their whole subtree.
+void updateSubtree(FlatEntityHierarchy *hierarchy, uint root, const Matrix4x4 &rootParentTransform,
+                   std::vector<quint8> &changed, SubtreeBatch &batch)
+{
+    const uint end = hierarchy->subtreeEnd(root);
+    for (uint i = root; i < end; ) {
+        if (!hierarchy->entity(i)->isEnabled()) {
+            i = hierarchy->subtreeEnd(i);
+            continue;
+        }
+        const int parent = hierarchy->parentIndex(i);
+        if (parent < 0)
+            changed[i] = updateWorldTransform(hierarchy, i, rootParentTransform, WorldTransformUnchanged, batch);
+        else
+            changed[i] = updateWorldTransform(hierarchy, i, *hierarchy->entity(uint(parent))->worldTransform(),
+                                              changed[parent], batch);
+        ++i;
     }
 }
 
+void updateSubtreeBatch(FlatEntityHierarchy *hierarchy, const Matrix4x4 &rootParentTransform,
+                        std::vector<quint8> &changed, SubtreeBatch &batch)
+{
+    for (uint root : batch.roots)
+        updateSubtree(hierarchy, root, rootParentTransform, changed, batch);
+}
+
 }
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT UpdateWorldTransformJobPrivate : public Qt3DCore::QAspectJobPrivate
@@ -100,15 +163,121 @@ public:
 
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
+    void prepare(Entity *rootEntity, NodeManagers *manager);
+    void updateBatch(size_t index);
+
     QList<TransformUpdate> m_updatedTransforms;
+    // WorldTransformState of the entity at the same index of the
+    // FlatEntityHierarchy during the last run
+    std::vector<quint8> m_changed;
+
+    // Set up by prepare() for the batch jobs and the job itself
+    FlatEntityHierarchy *m_hierarchy = nullptr;
+    Matrix4x4 m_parentTransform;
+    SubtreeBatch m_topLevels;
+    std::vector<SubtreeBatch> m_batches;
+    bool m_prepared = false;
+
+    // The preparation job followed by the batch jobs, empty when there is
+    // a single thread to run them
+    std::vector<Qt3DCore::QAspectJobPtr> m_subtreeJobs;
 };
 
+// Updates the top levels of the hierarchy and splits the remaining subtrees
+// into one batch per batch job
+void UpdateWorldTransformJobPrivate::prepare(Entity *rootEntity, NodeManagers *manager)
+{
+    m_parentTransform = Matrix4x4();
+    Entity *parent = rootEntity->parent();
+    if (parent != nullptr)
+        m_parentTransform = *(parent->worldTransform());
+
+    EntityManager *entityManager = manager->renderNodesManager();
+    m_hierarchy = entityManager->flatHierarchy();
+    m_hierarchy->update(rootEntity, entityManager->hierarchyRevision());
+    m_changed.resize(m_hierarchy->size());
+
+    FlatEntityHierarchy *hierarchy = m_hierarchy;
+    std::vector<quint8> &changed = m_changed;
+
+    // Walk the top levels of the hierarchy breadth first until we have
+    // enough independent subtrees to balance the batches. Small or very
+    // deep scenes end up being entirely processed here.
+    const size_t batchJobCount = m_subtreeJobs.empty() ? 1 : m_subtreeJobs.size() - 1;
+    const size_t subtreeCountTarget = batchJobCount > 1 ? batchJobCount * 4 : 1;
+
+    m_topLevels = SubtreeBatch();
+    std::vector<uint> frontier = { 0 };
+    std::vector<uint> nextLevel;
+    while (!frontier.empty() && frontier.size() < subtreeCountTarget) {
+        nextLevel.clear();
+        for (uint root : frontier) {
+            if (!hierarchy->entity(root)->isEnabled())
+                continue;
+            const int parentIndex = hierarchy->parentIndex(root);
+            if (parentIndex < 0)
+                changed[root] = updateWorldTransform(hierarchy, root, m_parentTransform,
+                                                     WorldTransformUnchanged, m_topLevels);
+            else
+                changed[root] = updateWorldTransform(hierarchy, root, *hierarchy->entity(uint(parentIndex))->worldTransform(),
+                                                     changed[parentIndex], m_topLevels);
+            for (uint child = root + 1, end = hierarchy->subtreeEnd(root); child < end;
+                 child = hierarchy->subtreeEnd(child))
+                nextLevel.push_back(child);
+        }
+        frontier.swap(nextLevel);
+    }
+
+    // Spread the remaining subtrees over batches holding a similar number
+    // of entities, each subtree being a contiguous range of the arrays
+    size_t remainingCount = 0;
+    for (uint root : frontier)
+        remainingCount += hierarchy->subtreeEnd(root) - root;
+    const size_t batchCount = std::min(frontier.size(), batchJobCount);
+    m_batches.clear();
+    m_batches.resize(batchCount);
+    size_t accumulatedCount = 0;
+    for (uint root : frontier) {
+        m_batches[accumulatedCount * batchCount / remainingCount].roots.push_back(root);
+        accumulatedCount += hierarchy->subtreeEnd(root) - root;
+    }
+
+    m_prepared = true;
+}
+
+void UpdateWorldTransformJobPrivate::updateBatch(size_t index)
+{
+    // There can be fewer subtrees than batch jobs
+    if (index < m_batches.size())
+        updateSubtreeBatch(m_hierarchy, m_parentTransform, m_changed, m_batches[index]);
+}
+
 UpdateWorldTransformJob::UpdateWorldTransformJob()
     : Qt3DCore::QAspectJob(*new UpdateWorldTransformJobPrivate())
     , m_node(nullptr)
     , m_manager(nullptr)
 {
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::UpdateTransform, 0)
+
+    // The subtrees are updated by jobs of their own, this job merges
+    // their results once they are all done
+    Q_D(UpdateWorldTransformJob);
+    const int batchJobCount = Qt3DCore::QAspectJobManager::idealThreadCount();
+    if (batchJobCount > 1) {
+        using SubtreeJobPtr = GenericLambdaJobPtr<std::function<void ()>>;
+        const SubtreeJobPtr prepareJob = SubtreeJobPtr::create([this] {
+            d_func()->prepare(m_node, m_manager);
+        }, JobTypes::PrepareUpdateTransform, "PrepareUpdateTransform");
+        d->m_subtreeJobs.push_back(prepareJob);
+        for (int i = 0; i < batchJobCount; ++i) {
+            const SubtreeJobPtr batchJob = SubtreeJobPtr::create([d, i] {
+                d->updateBatch(size_t(i));
+            }, JobTypes::UpdateTransformBatch, "UpdateTransformBatch", i);
+            batchJob->addDependency(prepareJob);
+            addDependency(batchJob);
+            d->m_subtreeJobs.push_back(batchJob);
+        }
+    }
 }
 
 void UpdateWorldTransformJob::setRoot(Entity *root)
@@ -121,23 +290,40 @@ void UpdateWorldTransformJob::setManagers(NodeManagers *manager)
     m_manager = manager;
 }
 
+const std::vector<Qt3DCore::QAspectJobPtr> &UpdateWorldTransformJob::subtreeJobs() const
+{
+    Q_D(const UpdateWorldTransformJob);
+    return d->m_subtreeJobs;
+}
+
 void UpdateWorldTransformJob::run()
 {
     // Iterate over each level of hierarchy in our scene
     // and update each node's world transform from its
     // local transform and its parent's world transform
 
-    // TODO: Parallelise this on each level using a parallel_for
-    // implementation.
-
     Q_D(UpdateWorldTransformJob);
     qCDebug(Jobs) << "Entering" << Q_FUNC_INFO << QThread::currentThread();
 
-    Matrix4x4 parentTransform;
-    Entity *parent = m_node->parent();
-    if (parent != nullptr)
-        parentTransform = *(parent->worldTransform());
-    updateWorldTransformAndBounds(m_manager, m_node, parentTransform, d->m_updatedTransforms);
+    // Without the subtree jobs, e.g. when run on its own, everything is
+    // updated here
+    if (!d->m_prepared) {
+        d->prepare(m_node, m_manager);
+        for (size_t i = 0, m = d->m_batches.size(); i < m; ++i)
+            d->updateBatch(i);
+    }
+    d->m_prepared = false;
+
+    // Transforms can be shared between batches, they are only marked clean
+    // once every batch is done
+    d->m_updatedTransforms += d->m_topLevels.updatedTransforms;
+    for (Transform *transform : d->m_topLevels.dirtyTransforms)
+        transform->unsetTransformDirty();
+    for (const SubtreeBatch &batch : d->m_batches) {
+        d->m_updatedTransforms += batch.updatedTransforms;
+        for (Transform *transform : batch.dirtyTransforms)
+            transform->unsetTransformDirty();
+    }
 
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
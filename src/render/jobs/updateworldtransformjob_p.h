@@ -56,6 +56,8 @@
 
 #include <QSharedPointer>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -73,6 +75,10 @@ public:
     void setRoot(Entity *root);
     void setManagers(NodeManagers *manager);
 
+    // Jobs updating the subtrees in parallel, to be scheduled along with
+    // this job which depends on them
+    const std::vector<Qt3DCore::QAspectJobPtr> &subtreeJobs() const;
+
     void run() override;
 
 private:
@@ -87,8 +87,9 @@ void Effect::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (m_techniques != techniques)
         m_techniques = techniques;
 
+    // Only the materials using this effect need to be gathered again
     if (!firstTime)
-        markDirty(AbstractRenderer::AllDirty);
+        markDirty(AbstractRenderer::MaterialDirty);
 }
 
 void Effect::appendRenderTechnique(Qt3DCore::QNodeId technique)
@@ -71,24 +71,27 @@ void Material::cleanup()
 
 void Material::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
 {
+    const bool wasEnabled = isEnabled();
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
     const QMaterial *node = qobject_cast<const QMaterial *>(frontEnd);
     if (!node)
         return;
 
-    AbstractRenderer::BackendNodeDirtySet dirty = firstTime ? AbstractRenderer::MaterialDirty : static_cast<AbstractRenderer::BackendNodeDirtyFlag>(0);
+    // MaterialDirty gets this material's parameters gathered again
+    AbstractRenderer::BackendNodeDirtySet dirty = (firstTime || wasEnabled != isEnabled())
+            ? AbstractRenderer::MaterialDirty : static_cast<AbstractRenderer::BackendNodeDirtyFlag>(0);
 
     auto parameters = qIdsForNodes(node->parameters());
     std::sort(std::begin(parameters), std::end(parameters));
     if (m_parameterPack.parameters() != parameters) {
         m_parameterPack.setParameters(parameters);
-        dirty |= AbstractRenderer::AllDirty;
+        dirty |= AbstractRenderer::MaterialDirty;
     }
 
     const auto effectId = node->effect() ? node->effect()->id() : QNodeId{};
     if (effectId != m_effectUuid) {
         m_effectUuid = effectId;
-        dirty |= AbstractRenderer::AllDirty;
+        dirty |= AbstractRenderer::MaterialDirty;
     }
 
     if (dirty)
@@ -101,7 +101,8 @@ void RenderPass::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (m_renderStates != renderStates)
         m_renderStates = renderStates;
 
-    markDirty(AbstractRenderer::AllDirty);
+    // Only the materials using this pass need to be gathered again
+    markDirty(AbstractRenderer::MaterialDirty);
 }
 
 Qt3DCore::QNodeId RenderPass::shaderProgram() const
@@ -237,6 +237,30 @@ QVariant ShaderData::getTransformedProperty(const PropertyValue *v, const Matrix
     return v->value;
 }
 
+// SyncRenderViewPreCommandUpdate, values transformed ModelToEye are
+// computed from the view matrix of the RenderView
+bool ShaderData::hasViewDependentProperties() const
+{
+    for (const PropertyValue &propertyValue : m_originalProperties) {
+        if (propertyValue.isTransformed) {
+            const auto transformedIt = m_originalProperties.constFind(propertyValue.transformedPropertyName);
+            if (transformedIt != m_originalProperties.constEnd() &&
+                    static_cast<TransformType>(transformedIt.value().value.toInt()) == ModelToEye)
+                return true;
+        } else if (propertyValue.isNode && m_managers != nullptr) {
+            const QVariantList nodeIds = propertyValue.isArray
+                    ? propertyValue.value.value<QVariantList>()
+                    : QVariantList { propertyValue.value };
+            for (const QVariant &nodeId : nodeIds) {
+                const ShaderData *subShaderData = lookupResource(m_managers, nodeId.value<QNodeId>());
+                if (subShaderData != nullptr && subShaderData->hasViewDependentProperties())
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
 // Unit tests only
 ShaderData::TransformType ShaderData::propertyTransformType(const QString &name) const
 {
@@ -253,11 +277,13 @@ ShaderData::TransformType ShaderData::propertyTransformType(const QString &name)
 }
 
 // Called by FramePreparationJob or by RenderView when dealing with lights
-void ShaderData::updateWorldTransform(const Matrix4x4 &worldMatrix)
+bool ShaderData::updateWorldTransform(const Matrix4x4 &worldMatrix)
 {
     if (m_worldMatrix != worldMatrix) {
         m_worldMatrix = worldMatrix;
+        return true;
     }
+    return false;
 }
 
 RenderShaderDataFunctor::RenderShaderDataFunctor(AbstractRenderer *renderer, NodeManagers *managers)
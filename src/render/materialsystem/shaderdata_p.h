@@ -90,11 +90,14 @@ public:
 
     const QHash<QString, PropertyValue> &properties() const { return m_originalProperties; }
 
-    // Called by FramePreparationJob
-    void updateWorldTransform(const Matrix4x4 &worldMatrix);
+    // Called by FramePreparationJob, returns true if the world transform changed
+    bool updateWorldTransform(const Matrix4x4 &worldMatrix);
 
     QVariant getTransformedProperty(const PropertyValue *v, const Matrix4x4 &viewMatrix) const noexcept;
 
+    // True if a property of this ShaderData or of a nested one is expressed in eye space
+    bool hasViewDependentProperties() const;
+
     // Unit tests purposes only
     TransformType propertyTransformType(const QString &name) const;
 
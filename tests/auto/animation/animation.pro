@@ -40,5 +40,7 @@ qtConfig(private_tests) {
         clock \
         skeleton \
         findrunningclipanimatorsjob \
-        qchannelmapping
+        qchannelmapping \
+        posecache \
+        evaluateclipanimatorjob
 }
@@ -27,6 +27,11 @@
 ****************************************************************************/
 
 #include <QtTest/QTest>
+#include <Qt3DAnimation/qanimationclip.h>
+#include <Qt3DAnimation/qanimationclipdata.h>
+#include <Qt3DAnimation/qchannel.h>
+#include <Qt3DAnimation/qchannelcomponent.h>
+#include <Qt3DAnimation/qkeyframe.h>
 #include <Qt3DAnimation/private/animationclip_p.h>
 #include <Qt3DAnimation/private/animationutils_p.h>
 #include <Qt3DAnimation/private/blendedclipanimator_p.h>
@@ -132,6 +137,32 @@ public:
     void valueChanged(const QVariant &) override { }
 };
 
+class AnimatedObject : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(float scalar READ scalar WRITE setScalar)
+    Q_PROPERTY(QVector3D position READ position WRITE setPosition)
+    Q_PROPERTY(QQuaternion rotation READ rotation WRITE setRotation)
+    Q_PROPERTY(QColor color READ color WRITE setColor)
+
+public:
+    float scalar() const { return m_scalar; }
+    QVector3D position() const { return m_position; }
+    QQuaternion rotation() const { return m_rotation; }
+    QColor color() const { return m_color; }
+
+    void setScalar(float scalar) { m_scalar = scalar; }
+    void setPosition(const QVector3D &position) { m_position = position; }
+    void setRotation(const QQuaternion &rotation) { m_rotation = rotation; }
+    void setColor(const QColor &color) { m_color = color; }
+
+private:
+    float m_scalar = 0.0f;
+    QVector3D m_position;
+    QQuaternion m_rotation;
+    QColor m_color;
+};
+
 } // anonymous
 
 
@@ -797,11 +828,21 @@ private Q_SLOTS:
         QTest::addColumn<QVector<MappingData>>("mappingData");
         QTest::addColumn<QVector<float>>("channelResults");
         QTest::addColumn<AnimationRecord>("expectedChanges");
+        QTest::addColumn<QVariantList>("expectedValues");
 
         Qt3DCore::QNodeId animatorId;
         QVector<MappingData> mappingData;
         QVector<float> channelResults;
         AnimationRecord expectedChanges;
+        QVariantList expectedValues;
+
+        auto targetChange = [] (const MappingData &mapping) {
+            AnimationRecord::TargetChange change;
+            change.targetId = mapping.targetId;
+            change.propertyName = mapping.propertyName;
+            change.type = mapping.type;
+            return change;
+        };
 
         // Single property, vec3
         {
@@ -815,20 +856,22 @@ private Q_SLOTS:
             channelResults = QVector<float> { 1.0f, 2.0f, 3.0f };
             expectedChanges.normalizedTime = 1.1f; // Invalid
             expectedChanges.finalFrame = false;
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(QVector3D(1.0f, 2.0f, 3.0f))});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(QVector3D(1.0f, 2.0f, 3.0f)));
 
             QTest::newRow("vec3 translation, final = false")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             expectedChanges.normalizedTime = 1.0f;
             expectedChanges.finalFrame = true;
 
             QTest::newRow("vec3 translation, final = true, normalizedTime = 1.0f")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Multiple properties, all vec3
@@ -852,21 +895,24 @@ private Q_SLOTS:
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = -0.1f; // Invalid
 
-            expectedChanges.targetChanges.push_back({translationMapping.targetId, translationMapping.propertyName, QVariant::fromValue(QVector3D(1.0f, 2.0f, 3.0f))});
-            expectedChanges.targetChanges.push_back({scaleMapping.targetId, scaleMapping.propertyName, QVariant::fromValue(QVector3D(4.0f, 5.0f, 6.0f))});
+            expectedChanges.targetChanges.push_back(targetChange(translationMapping));
+            expectedValues.push_back(QVariant::fromValue(QVector3D(1.0f, 2.0f, 3.0f)));
+            expectedChanges.targetChanges.push_back(targetChange(scaleMapping));
+            expectedValues.push_back(QVariant::fromValue(QVector3D(4.0f, 5.0f, 6.0f)));
 
             QTest::newRow("vec3 translation, vec3 scale, final = false")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             expectedChanges.normalizedTime = 0.5f;
             expectedChanges.finalFrame = true;
 
             QTest::newRow("vec3 translation, vec3 scale, final = true")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Single property, double
@@ -881,14 +927,16 @@ private Q_SLOTS:
             channelResults = QVector<float> { 3.5f };
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = -1.0f; // Invalid
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(3.5f)});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(3.5f));
 
             QTest::newRow("double mass")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Single property, vec2
@@ -903,14 +951,16 @@ private Q_SLOTS:
             channelResults = QVector<float> { 2.0f, 1.0f };
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = 1.1f; // Invalid
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(QVector2D(2.0f, 1.0f))});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(QVector2D(2.0f, 1.0f)));
 
             QTest::newRow("vec2 pos")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Single property, vec4
@@ -925,14 +975,16 @@ private Q_SLOTS:
             channelResults = QVector<float> { 4.0f, 3.0f, 2.0f, 1.0f };
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = 1.1f; // Invalid
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(QVector4D(4.0f, 3.0f, 2.0f, 1.0f))});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(QVector4D(4.0f, 3.0f, 2.0f, 1.0f)));
 
             QTest::newRow("vec4 foo")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Single property, quaternion
@@ -947,14 +999,16 @@ private Q_SLOTS:
             channelResults = QVector<float> { 1.0f, 0.0f, 0.0f, 1.0f };
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = -0.1f; // Invalid
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(QQuaternion(1.0f, 0.0f, 0.0f, 1.0f).normalized())});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(QQuaternion(1.0f, 0.0f, 0.0f, 1.0f).normalized()));
 
             QTest::newRow("quaternion rotation")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Single property, QColor
@@ -969,14 +1023,16 @@ private Q_SLOTS:
             channelResults = QVector<float> { 0.5f, 0.4f, 0.3f };
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = 1.1f; // Invalid
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(QColor::fromRgbF(0.5f, 0.4f, 0.3f))});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(QColor::fromRgbF(0.5f, 0.4f, 0.3f)));
 
             QTest::newRow("QColor rgb color")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Single property, QColor
@@ -991,14 +1047,16 @@ private Q_SLOTS:
             channelResults = QVector<float> { 0.5f, 0.4f, 0.3f, 0.2f };
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = 1.1f; // Invalid
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(QColor::fromRgbF(0.5f, 0.4f, 0.3f, 0.2f))});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(QColor::fromRgbF(0.5f, 0.4f, 0.3f, 0.2f)));
 
             QTest::newRow("QColor rgba color")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
         // Single property, QVariantList
@@ -1014,14 +1072,16 @@ private Q_SLOTS:
             expectedChanges.finalFrame = false;
             expectedChanges.normalizedTime = 1.1f; // Invalid
             QVariantList expectedValue = QVariantList { 0.5f, 0.4f, 0.3f, 0.0f, 1.0f, 0.6f, 0.9f };
-            expectedChanges.targetChanges.push_back({mapping.targetId, mapping.propertyName, QVariant::fromValue(expectedValue)});
+            expectedChanges.targetChanges.push_back(targetChange(mapping));
+            expectedValues.push_back(QVariant::fromValue(expectedValue));
 
             QTest::newRow("QVariantList weights")
-                    << animatorId << mappingData << channelResults << expectedChanges;
+                    << animatorId << mappingData << channelResults << expectedChanges << expectedValues;
 
             mappingData.clear();
             channelResults.clear();
             expectedChanges.targetChanges.clear();
+            expectedValues.clear();
         }
 
     }
@@ -1033,6 +1093,7 @@ private Q_SLOTS:
         QFETCH(QVector<MappingData>, mappingData);
         QFETCH(QVector<float>, channelResults);
         QFETCH(AnimationRecord, expectedChanges);
+        QFETCH(QVariantList, expectedValues);
 
         // WHEN
         AnimationRecord actualChanges = prepareAnimationRecord(animatorId, mappingData, channelResults,
@@ -1046,10 +1107,52 @@ private Q_SLOTS:
 
             QCOMPARE(actualChange.targetId, expectedChange.targetId);
             QCOMPARE(actualChange.propertyName, expectedChange.propertyName);
-            QCOMPARE(actualChange.value, expectedChange.value);
+            QCOMPARE(actualChange.type, expectedChange.type);
+            QCOMPARE(propertyValue(actualChanges, actualChange), expectedValues[i]);
         }
     }
 
+    void checkApplyTargetChanges()
+    {
+        // GIVEN
+        AnimatedObject target;
+        const auto mapping = [&target] (const char *propertyName, QMetaType::Type type,
+                                        const QVector<int> &channelIndices) {
+            MappingData mapping;
+            mapping.targetId = Qt3DCore::QNodeId::createId();
+            mapping.propertyName = propertyName;
+            mapping.propertyIndex = target.metaObject()->indexOfProperty(propertyName);
+            mapping.type = static_cast<int>(type);
+            mapping.channelIndices = channelIndices;
+            return mapping;
+        };
+        const QVector<MappingData> mappingData = {
+            mapping("scalar", QMetaType::Float, { 0 }),
+            mapping("position", QMetaType::QVector3D, { 1, 2, 3 }),
+            mapping("rotation", QMetaType::QQuaternion, { 4, 5, 6, 7 }),
+            mapping("color", QMetaType::QColor, { 8, 9, 10 })
+        };
+        const QVector<float> channelResults = { 2.5f,
+                                                1.0f, 2.0f, 3.0f,
+                                                2.0f, 0.0f, 2.0f, 0.0f,
+                                                0.25f, 0.5f, 0.75f };
+
+        // WHEN
+        const AnimationRecord record = prepareAnimationRecord(Qt3DCore::QNodeId::createId(), mappingData,
+                                                              channelResults, false, -1.0f);
+        for (const AnimationRecord::TargetChange &change : record.targetChanges)
+            applyTargetChange(&target, record, change);
+
+        // THEN -> All the properties are resolved and written with typed values
+        QCOMPARE(record.targetChanges.size(), mappingData.size());
+        for (const AnimationRecord::TargetChange &change : record.targetChanges)
+            QVERIFY(change.propertyIndex != -1);
+        QCOMPARE(target.scalar(), 2.5f);
+        QCOMPARE(target.position(), QVector3D(1.0f, 2.0f, 3.0f));
+        QCOMPARE(target.rotation(), QQuaternion(2.0f, 0.0f, 2.0f, 0.0f).normalized());
+        QCOMPARE(target.color(), QColor::fromRgbF(0.25f, 0.5f, 0.75f));
+    }
+
     void checkPrepareCallbacks_data()
     {
         QTest::addColumn<QVector<MappingData>>("mappingData");
@@ -1298,6 +1401,150 @@ private Q_SLOTS:
         delete handler;
     }
 
+    void checkPackedChannelGroups()
+    {
+        // GIVEN
+        Handler handler;
+        AnimationClip *clip = createAnimationClipLoader(&handler, QUrl("qrc:/clip7.json"));
+
+        // THEN
+        // Location and Scale share their keyframes, both Rotations too,
+        // Opacity has its own and Offset has components with different keyframes
+        const QVector<PackedChannelGroup> &groups = clip->packedChannelGroups();
+        QCOMPARE(groups.size(), 3);
+
+        QCOMPARE(groups[0].rotations, false);
+        QCOMPARE(groups[0].componentCount, 6);
+        QCOMPARE(groups[0].times, (QVector<float> { 0.0f, 5.0f, 10.0f }));
+        QCOMPARE(groups[0].values.size(), 18);
+        QCOMPARE(groups[0].targets.size(), 2);
+        QCOMPARE(groups[0].targets[0].resultOffset, 0);
+        QCOMPARE(groups[0].targets[0].componentOffset, 0);
+        QCOMPARE(groups[0].targets[1].resultOffset, 11);
+        QCOMPARE(groups[0].targets[1].componentOffset, 3);
+
+        QCOMPARE(groups[1].rotations, true);
+        QCOMPARE(groups[1].componentCount, 8);
+        QCOMPARE(groups[1].slerpSegments.size(), 4);
+        QCOMPARE(groups[1].slerpSegments[0].mode, PackedChannelGroup::SlerpSegment::Slerp);
+        QCOMPARE(groups[1].slerpSegments[1].mode, PackedChannelGroup::SlerpSegment::Equal);
+
+        QCOMPARE(groups[2].rotations, false);
+        QCOMPARE(groups[2].componentCount, 1);
+        QCOMPARE(groups[2].targets[0].resultOffset, 14);
+
+        QCOMPARE(clip->unpackedChannels().size(), 1);
+        QCOMPARE(clip->unpackedChannels()[0].channelIndex, 5);
+        QCOMPARE(clip->unpackedChannels()[0].resultOffset, 15);
+    }
+
+    void checkEvaluatePackedClipAtLocalTime_data()
+    {
+        QTest::addColumn<float>("localTime");
+        QTest::addColumn<ClipResults>("expectedResults");
+
+        // Location, Rotation, Rotation, Scale, Opacity, Offset
+        QTest::newRow("before start") << -1.0f
+            << ClipResults { 0.0f, 0.0f, 1.0f,
+                             1.0f, 0.0f, 0.0f, 0.0f,
+                             1.0f, 0.0f, 0.0f, 0.0f,
+                             1.0f, 1.0f, 1.0f,
+                             0.0f,
+                             0.0f, 0.0f };
+        QTest::newRow("t = 2.5") << 2.5f
+            << ClipResults { 1.0f, -0.5f, 1.0f,
+                             0.923880f, 0.382683f, 0.0f, 0.0f,
+                             1.0f, 0.0f, 0.0f, 0.0f,
+                             1.5f, 1.5f, 1.0f,
+                             0.25f,
+                             2.5f, 0.0f };
+        QTest::newRow("t = 7.5") << 7.5f
+            << ClipResults { 6.0f, -1.5f, 1.0f,
+                             0.382683f, 0.923880f, 0.0f, 0.0f,
+                             0.923880f, 0.0f, 0.382683f, 0.0f,
+                             2.5f, 2.5f, 1.0f,
+                             0.75f,
+                             7.5f, 2.5f };
+        QTest::newRow("after end") << 11.0f
+            << ClipResults { 10.0f, -2.0f, 1.0f,
+                             0.0f, 1.0f, 0.0f, 0.0f,
+                             0.707107f, 0.0f, 0.707107f, 0.0f,
+                             3.0f, 3.0f, 1.0f,
+                             1.0f,
+                             10.0f, 5.0f };
+    }
+
+    void checkEvaluatePackedClipAtLocalTime()
+    {
+        // GIVEN
+        QFETCH(float, localTime);
+        QFETCH(ClipResults, expectedResults);
+        Handler handler;
+        AnimationClip *clip = createAnimationClipLoader(&handler, QUrl("qrc:/clip7.json"));
+
+        // WHEN
+        const ClipResults actualResults = evaluateClipAtLocalTime(clip, localTime);
+
+        // THEN
+        QCOMPARE(actualResults.size(), expectedResults.size());
+        for (int i = 0; i < actualResults.size(); ++i) {
+            auto actual = actualResults[i];
+            auto expected = expectedResults[i];
+
+            QVERIFY(fuzzyCompare(actual, expected) == true);
+        }
+    }
+
+    void checkEvaluatePackedConstantRotation()
+    {
+        // GIVEN
+        // Non normalized W, X, Y, Z keyframe values
+        const QQuaternion q0(2.0f, 0.0f, 2.0f, 0.0f);
+        const QQuaternion q1(0.0f, 0.0f, 0.0f, 3.0f);
+        const float keyFrameValues[2][4] = { { q0.scalar(), q0.x(), q0.y(), q0.z() },
+                                             { q1.scalar(), q1.x(), q1.y(), q1.z() } };
+        const char *componentNames[4] = { "W", "X", "Y", "Z" };
+        Qt3DAnimation::QChannel channel(QLatin1String("Rotation"));
+        for (int i = 0; i < 4; ++i) {
+            Qt3DAnimation::QChannelComponent component(QLatin1String(componentNames[i]));
+            for (int k = 0; k < 2; ++k) {
+                Qt3DAnimation::QKeyFrame keyFrame(QVector2D(10.0f * k, keyFrameValues[k][i]));
+                keyFrame.setInterpolationType(Qt3DAnimation::QKeyFrame::ConstantInterpolation);
+                component.appendKeyFrame(keyFrame);
+            }
+            channel.appendChannelComponent(component);
+        }
+        Qt3DAnimation::QAnimationClipData clipData;
+        clipData.appendChannel(channel);
+
+        Qt3DAnimation::QAnimationClip frontendClip;
+        frontendClip.setClipData(clipData);
+
+        AnimationClip clip;
+        clip.setDataType(AnimationClip::Data);
+        clip.syncFromFrontEnd(&frontendClip, true);
+        clip.loadAnimation();
+
+        // THEN
+        QCOMPARE(clip.packedChannelGroups().size(), 1);
+        QCOMPARE(clip.packedChannelGroups()[0].rotations, true);
+
+        // WHEN
+        const QVector<float> times = { -1.0f, 5.0f, 11.0f };
+        const QQuaternion expectedRotations[3] = { q0.normalized(), q0.normalized(), q1.normalized() };
+        for (int i = 0; i < times.size(); ++i) {
+            const ClipResults results = evaluateClipAtLocalTime(&clip, times[i]);
+
+            // THEN
+            QCOMPARE(results.size(), 4);
+            const QQuaternion expected = expectedRotations[i];
+            QVERIFY(fuzzyCompare(results[0], expected.scalar()));
+            QVERIFY(fuzzyCompare(results[1], expected.x()));
+            QVERIFY(fuzzyCompare(results[2], expected.y()));
+            QVERIFY(fuzzyCompare(results[3], expected.z()));
+        }
+    }
+
     void checkEvaluateClipAtPhase_data()
     {
         QTest::addColumn<Handler *>("handler");
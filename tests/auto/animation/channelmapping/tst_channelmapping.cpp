@@ -81,6 +81,7 @@ private Q_SLOTS:
         QCOMPARE(backendMapping.targetId(), mapping.target()->id());
         QVERIFY(qstrcmp(backendMapping.propertyName(), mapping.property().toLatin1().constData()) == 0);
         QVERIFY(qstrcmp(backendMapping.propertyName(), "foo") == 0);
+        QCOMPARE(backendMapping.propertyIndex(), target->metaObject()->indexOfProperty("foo"));
         QCOMPARE(backendMapping.componentCount(), 2);
         QCOMPARE(backendMapping.type(), static_cast<int>(QMetaType::QVector2D));
         QCOMPARE(backendMapping.mappingType(), Qt3DAnimation::Animation::ChannelMapping::ChannelMappingType);
@@ -115,6 +116,7 @@ private Q_SLOTS:
         QCOMPARE(backendMapping.channelName(), QString());
         QCOMPARE(backendMapping.targetId(), Qt3DCore::QNodeId());
         QCOMPARE(backendMapping.propertyName(), nullptr);
+        QCOMPARE(backendMapping.propertyIndex(), -1);
         QCOMPARE(backendMapping.componentCount(), 0);
         QCOMPARE(backendMapping.type(), static_cast<int>(QMetaType::UnknownType));
         QCOMPARE(backendMapping.skeletonId(), Qt3DCore::QNodeId());
@@ -137,6 +139,7 @@ private Q_SLOTS:
         QCOMPARE(backendMapping.channelName(), QString());
         QCOMPARE(backendMapping.targetId(), Qt3DCore::QNodeId());
         QCOMPARE(backendMapping.propertyName(), nullptr);
+        QCOMPARE(backendMapping.propertyIndex(), -1);
         QCOMPARE(backendMapping.componentCount(), 0);
         QCOMPARE(backendMapping.type(), static_cast<int>(QMetaType::UnknownType));
         QCOMPARE(backendMapping.skeletonId(), Qt3DCore::QNodeId());
@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/clipanimator_p.h>
+#include <Qt3DAnimation/private/channelmapper_p.h>
+#include <Qt3DAnimation/private/channelmapping_p.h>
+#include <Qt3DAnimation/private/evaluateclipanimatorjob_p.h>
+#include <Qt3DAnimation/private/findrunningclipanimatorsjob_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DAnimation/private/posecache_p.h>
+#include <qbackendnodetester.h>
+
+using namespace Qt3DAnimation::Animation;
+
+class tst_EvaluateClipAnimatorJob: public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+public:
+    // Creates animators playing clip1.json from the given start times, each
+    // one animating the translation of the matching target
+    QVector<HClipAnimator> createClipAnimators(Handler *handler,
+                                               const QVector<qint64> &globalStartTimesNS,
+                                               const QVector<Qt3DCore::QNodeId> &targetIds)
+    {
+        auto clipId = Qt3DCore::QNodeId::createId();
+        AnimationClip *clip = handler->animationClipLoaderManager()->getOrCreateResource(clipId);
+        setPeerId(clip, clipId);
+        clip->setHandler(handler);
+        clip->setDataType(AnimationClip::File);
+        clip->setSource(QUrl("qrc:/clip1.json"));
+        clip->loadAnimation();
+
+        QVector<HClipAnimator> animatorHandles;
+        for (int i = 0; i < globalStartTimesNS.size(); ++i) {
+            auto channelMappingId = Qt3DCore::QNodeId::createId();
+            ChannelMapping *channelMapping = handler->channelMappingManager()->getOrCreateResource(channelMappingId);
+            setPeerId(channelMapping, channelMappingId);
+            channelMapping->setHandler(handler);
+            channelMapping->setTargetId(targetIds.at(i));
+            channelMapping->setPropertyName("translation");
+            channelMapping->setChannelName(QLatin1String("Location"));
+            channelMapping->setType(static_cast<int>(QMetaType::QVector3D));
+            channelMapping->setComponentCount(3);
+            channelMapping->setMappingType(ChannelMapping::ChannelMappingType);
+
+            auto channelMapperId = Qt3DCore::QNodeId::createId();
+            ChannelMapper *channelMapper = handler->channelMapperManager()->getOrCreateResource(channelMapperId);
+            setPeerId(channelMapper, channelMapperId);
+            channelMapper->setHandler(handler);
+            channelMapper->setMappingIds(QList<Qt3DCore::QNodeId> { channelMappingId });
+
+            auto animatorId = Qt3DCore::QNodeId::createId();
+            ClipAnimator *animator = handler->clipAnimatorManager()->getOrCreateResource(animatorId);
+            setPeerId(animator, animatorId);
+            animator->setHandler(handler);
+            animator->setStartTime(globalStartTimesNS.at(i));
+            animator->setLoops(1);
+            animator->setClipId(clipId);
+            animator->setMapperId(channelMapperId);
+            animator->setRunning(true);
+            animator->setEnabled(true);
+            animatorHandles.push_back(handler->clipAnimatorManager()->getOrAcquireHandle(animatorId));
+        }
+
+        // Build the mapping data and the clip formats
+        FindRunningClipAnimatorsJob findRunningJob;
+        findRunningJob.setHandler(handler);
+        findRunningJob.setDirtyClipAnimators(animatorHandles);
+        findRunningJob.run();
+
+        return animatorHandles;
+    }
+
+private Q_SLOTS:
+    void checkBatchedEvaluation()
+    {
+        // GIVEN
+        // The simulation time is 0, negative start times put the animators
+        // at different points of the clip. The first two play in sync.
+        const QVector<qint64> globalStartTimesNS = { -500000000, -500000000, -1000000000 };
+        const QVector<Qt3DCore::QNodeId> targetIds = { Qt3DCore::QNodeId::createId(),
+                                                       Qt3DCore::QNodeId::createId(),
+                                                       Qt3DCore::QNodeId::createId() };
+        Handler batchHandler;
+        const QVector<HClipAnimator> batchedAnimators = createClipAnimators(&batchHandler,
+                                                                            globalStartTimesNS,
+                                                                            targetIds);
+        Handler singleHandler;
+        const QVector<HClipAnimator> singleAnimators = createClipAnimators(&singleHandler,
+                                                                           globalStartTimesNS,
+                                                                           targetIds);
+
+        // WHEN
+        EvaluateClipAnimatorJob batchJob;
+        batchJob.setHandler(&batchHandler);
+        batchJob.setClipAnimators(batchedAnimators);
+        batchJob.run();
+        const QVector<AnimationRecord> batchedRecords = batchJob.records();
+
+        QVector<AnimationRecord> singleRecords;
+        for (const HClipAnimator &animator : singleAnimators) {
+            singleHandler.poseCache()->clear();
+            EvaluateClipAnimatorJob singleJob;
+            singleJob.setHandler(&singleHandler);
+            singleJob.setClipAnimators({ animator });
+            singleJob.run();
+            singleRecords += singleJob.records();
+        }
+
+        // THEN
+        // The animators in sync share their pose
+        QCOMPARE(batchHandler.poseCache()->size(), 2);
+        QCOMPARE(batchedRecords.size(), globalStartTimesNS.size());
+        QCOMPARE(singleRecords.size(), globalStartTimesNS.size());
+        for (int i = 0; i < batchedRecords.size(); ++i) {
+            const AnimationRecord &batched = batchedRecords.at(i);
+            const AnimationRecord &single = singleRecords.at(i);
+            QCOMPARE(batched.normalizedTime, single.normalizedTime);
+            QCOMPARE(batched.finalFrame, single.finalFrame);
+            QCOMPARE(batched.values, single.values);
+            QCOMPARE(batched.targetChanges.size(), 1);
+            QCOMPARE(batched.targetChanges.size(), single.targetChanges.size());
+            for (int j = 0; j < batched.targetChanges.size(); ++j) {
+                const AnimationRecord::TargetChange &batchedChange = batched.targetChanges.at(j);
+                const AnimationRecord::TargetChange &singleChange = single.targetChanges.at(j);
+                QCOMPARE(batchedChange.targetId, targetIds.at(i));
+                QCOMPARE(batchedChange.targetId, singleChange.targetId);
+                QVERIFY(qstrcmp(batchedChange.propertyName, singleChange.propertyName) == 0);
+                QCOMPARE(batchedChange.type, singleChange.type);
+                QCOMPARE(batchedChange.valueOffset, singleChange.valueOffset);
+                QCOMPARE(batchedChange.valueCount, singleChange.valueCount);
+            }
+        }
+
+        // The animators in sync end up with the same pose
+        const AnimationRecord &first = batchedRecords.at(0);
+        const AnimationRecord &second = batchedRecords.at(1);
+        QCOMPARE(first.values, second.values);
+        QVERIFY(first.values != batchedRecords.at(2).values);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_EvaluateClipAnimatorJob)
+
+#include "tst_evaluateclipanimatorjob.moc"
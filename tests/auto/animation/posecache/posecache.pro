@@ -0,0 +1,10 @@
+TEMPLATE = app
+
+TARGET = tst_posecache
+
+QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private testlib
+
+CONFIG += testcase
+
+SOURCES += \
+    tst_posecache.cpp
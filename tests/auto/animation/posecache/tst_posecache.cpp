@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DAnimation/qanimationclip.h>
+#include <Qt3DAnimation/qanimationclipdata.h>
+#include <Qt3DAnimation/qchannel.h>
+#include <Qt3DAnimation/qchannelcomponent.h>
+#include <Qt3DAnimation/qkeyframe.h>
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/animationutils_p.h>
+#include <Qt3DAnimation/private/posecache_p.h>
+
+using namespace Qt3DAnimation::Animation;
+
+class tst_PoseCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkEvaluatesOncePerClipAndPhase()
+    {
+        // GIVEN
+        Qt3DAnimation::QChannelComponent component(QLatin1String("X"));
+        component.appendKeyFrame(Qt3DAnimation::QKeyFrame(QVector2D(0.0f, 0.0f)));
+        component.appendKeyFrame(Qt3DAnimation::QKeyFrame(QVector2D(10.0f, 5.0f)));
+        Qt3DAnimation::QChannel channel(QLatin1String("Location"));
+        channel.appendChannelComponent(component);
+        Qt3DAnimation::QAnimationClipData clipData;
+        clipData.appendChannel(channel);
+
+        Qt3DAnimation::QAnimationClip frontendClip;
+        frontendClip.setClipData(clipData);
+
+        AnimationClip clip;
+        clip.setDataType(AnimationClip::Data);
+        clip.syncFromFrontEnd(&frontendClip, true);
+        clip.loadAnimation();
+
+        PoseCache cache;
+
+        // THEN
+        QCOMPARE(cache.size(), 0);
+
+        // WHEN
+        const ClipResults results = cache.evaluateClipAtPhase(&clip, 0.5f);
+        const ClipResults sharedResults = cache.evaluateClipAtPhase(&clip, 0.5f);
+
+        // THEN
+        QCOMPARE(cache.size(), 1);
+        QCOMPARE(results, evaluateClipAtPhase(&clip, 0.5f));
+        QCOMPARE(results, ClipResults { 2.5f });
+        QVERIFY(results.constData() == sharedResults.constData());
+
+        // WHEN
+        const ClipResults otherResults = cache.evaluateClipAtPhase(&clip, 1.0f);
+
+        // THEN
+        QCOMPARE(cache.size(), 2);
+        QCOMPARE(otherResults, ClipResults { 5.0f });
+
+        // WHEN
+        cache.clear();
+
+        // THEN
+        QCOMPARE(cache.size(), 0);
+    }
+};
+
+QTEST_MAIN(tst_PoseCache)
+
+#include "tst_posecache.moc"
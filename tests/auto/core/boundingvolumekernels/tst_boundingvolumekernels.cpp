@@ -0,0 +1,241 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/private/boundingvolumekernels_p.h>
+#include <Qt3DCore/private/qgeometryview_p.h>
+#include <QtCore/qrandom.h>
+#include <memory>
+
+using namespace Qt3DCore;
+
+namespace {
+
+enum Layout {
+    PackedFloat3,
+    StridedFloat3,
+    InterleavedFloat3,
+    StridedFloat4
+};
+
+// The attributes take ownership of their buffers
+struct Mesh
+{
+    std::unique_ptr<QAttribute> positionAttribute;
+    std::unique_ptr<QAttribute> indexAttribute;
+    int drawVertexCount = 0;
+};
+
+Mesh createMesh(Layout layout, QAttribute::VertexBaseType indexType, bool primitiveRestart,
+                int vertexCount, int indexCount)
+{
+    QRandomGenerator generator(vertexCount + indexCount);
+    Mesh mesh;
+
+    uint floatsPerVertex = 3;
+    uint positionOffset = 0;
+    uint byteStride = 0;
+    uint vertexSize = 3;
+    switch (layout) {
+    case PackedFloat3:
+        break;
+    case StridedFloat3:
+        byteStride = 3 * sizeof(float);
+        break;
+    case InterleavedFloat3:
+        // normal, position, texture coordinates
+        floatsPerVertex = 8;
+        positionOffset = 3 * sizeof(float);
+        byteStride = floatsPerVertex * sizeof(float);
+        break;
+    case StridedFloat4:
+        floatsPerVertex = 4;
+        vertexSize = 4;
+        byteStride = floatsPerVertex * sizeof(float);
+        break;
+    }
+
+    QByteArray vertexData(vertexCount * floatsPerVertex * sizeof(float), Qt::Uninitialized);
+    float *vertices = reinterpret_cast<float *>(vertexData.data());
+    for (uint i = 0, m = vertexCount * floatsPerVertex; i < m; ++i)
+        vertices[i] = float(generator.bounded(2000.0) - 1000.0);
+
+    Qt3DCore::QBuffer *vertexBuffer = new Qt3DCore::QBuffer;
+    vertexBuffer->setData(vertexData);
+    mesh.positionAttribute.reset(new QAttribute(vertexBuffer, QAttribute::defaultPositionAttributeName(),
+                                                QAttribute::Float, vertexSize, vertexCount,
+                                                positionOffset, byteStride));
+    mesh.drawVertexCount = vertexCount;
+
+    if (indexType == QAttribute::Float)
+        return mesh;
+
+    // Indices never exceed the range of the smallest index type, 255 is kept
+    // as the restart index
+    const int restartIndex = 255;
+    const int maxIndex = qMin(vertexCount, restartIndex);
+    QByteArray indexData;
+    for (int i = 0; i < indexCount; ++i) {
+        uint index = generator.bounded(maxIndex);
+        if (primitiveRestart && (i == 0 || generator.bounded(8) == 0))
+            index = restartIndex;
+        switch (indexType) {
+        case QAttribute::UnsignedByte: {
+            const quint8 value = quint8(index);
+            indexData.append(reinterpret_cast<const char *>(&value), sizeof(value));
+            break;
+        }
+        case QAttribute::UnsignedShort: {
+            const quint16 value = quint16(index);
+            indexData.append(reinterpret_cast<const char *>(&value), sizeof(value));
+            break;
+        }
+        default: {
+            const quint32 value = quint32(index);
+            indexData.append(reinterpret_cast<const char *>(&value), sizeof(value));
+            break;
+        }
+        }
+    }
+
+    Qt3DCore::QBuffer *indexBuffer = new Qt3DCore::QBuffer;
+    indexBuffer->setData(indexData);
+    mesh.indexAttribute.reset(new QAttribute(indexBuffer, indexType, 1, indexCount));
+    mesh.indexAttribute->setAttributeType(QAttribute::IndexAttribute);
+    mesh.drawVertexCount = indexCount;
+
+    return mesh;
+}
+
+bool fuzzyCompare(const QVector3D &a, const QVector3D &b)
+{
+    return qAbs(a.x() - b.x()) < 1e-2f && qAbs(a.y() - b.y()) < 1e-2f && qAbs(a.z() - b.z()) < 1e-2f;
+}
+
+} // anonymous
+
+class tst_BoundingVolumeKernels : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkMatchesScalarPath_data()
+    {
+        QTest::addColumn<int>("layout");
+        QTest::addColumn<int>("indexType");
+        QTest::addColumn<bool>("primitiveRestart");
+        QTest::addColumn<int>("vertexCount");
+        QTest::addColumn<int>("indexCount");
+
+        const QAttribute::VertexBaseType indexTypes[] = {
+            QAttribute::Float, // no index attribute
+            QAttribute::UnsignedByte,
+            QAttribute::UnsignedShort,
+            QAttribute::UnsignedInt
+        };
+        const char *layoutNames[] = { "packed", "strided", "interleaved", "float4" };
+        const char *indexNames[] = { "none", "uint8", "uint16", "uint32" };
+
+        for (int layout = PackedFloat3; layout <= StridedFloat4; ++layout) {
+            for (int i = 0; i < 4; ++i) {
+                for (bool restart : { false, true }) {
+                    if (restart && indexTypes[i] == QAttribute::Float)
+                        continue;
+                    for (int vertexCount : { 1, 7, 1021 }) {
+                        const QByteArray name = QByteArray(layoutNames[layout]) + '-' + indexNames[i]
+                                + (restart ? "-restart-" : "-") + QByteArray::number(vertexCount);
+                        QTest::newRow(name.constData()) << layout << int(indexTypes[i]) << restart
+                                                        << vertexCount << vertexCount * 3 + 2;
+                    }
+                }
+            }
+        }
+    }
+
+    void checkMatchesScalarPath()
+    {
+        if (!BoundingVolumeKernels::isAvailable())
+            QSKIP("Bounding volume kernels are not available on this platform");
+
+        // GIVEN
+        QFETCH(int, layout);
+        QFETCH(int, indexType);
+        QFETCH(bool, primitiveRestart);
+        QFETCH(int, vertexCount);
+        QFETCH(int, indexCount);
+
+        const Mesh mesh = createMesh(Layout(layout), QAttribute::VertexBaseType(indexType),
+                                     primitiveRestart, vertexCount, indexCount);
+
+        // WHEN
+        BoundingVolumeCalculator scalar;
+        const bool scalarResult = scalar.applyScalar(mesh.positionAttribute.get(), mesh.indexAttribute.get(),
+                                                     mesh.drawVertexCount, primitiveRestart, 255);
+        BoundingVolumeCalculator vectorized;
+        const bool vectorizedResult = vectorized.apply(mesh.positionAttribute.get(), mesh.indexAttribute.get(),
+                                                       mesh.drawVertexCount, primitiveRestart, 255);
+
+        // THEN
+        QVERIFY(scalarResult);
+        QVERIFY(vectorizedResult);
+        QCOMPARE(vectorized.min(), scalar.min());
+        QCOMPARE(vectorized.max(), scalar.max());
+        QVERIFY(fuzzyCompare(vectorized.center(), scalar.center()));
+        QVERIFY(qAbs(vectorized.radius() - scalar.radius()) < 1e-2f);
+    }
+
+    void checkKernelsRejectInputWithoutPoints()
+    {
+        // GIVEN
+        const quint16 indices[] = { 65535, 65535 };
+        const float vertices[] = { 1.0f, 2.0f, 3.0f };
+        BoundingVolumeKernelInput input;
+        input.vertices = vertices;
+        input.verticesEnd = vertices + 3;
+        input.indices = indices;
+        input.indexType = QAttribute::UnsignedShort;
+        input.primitiveRestartEnabled = true;
+        input.primitiveRestartIndex = 65535;
+        BoundingVolumeKernelResult result;
+
+        // THEN
+        QVERIFY(!BoundingVolumeKernels::compute(input, result));
+
+        // WHEN
+        input.count = 2;
+
+        // THEN -> only restart indices
+        QVERIFY(!BoundingVolumeKernels::compute(input, result));
+    }
+};
+
+QTEST_MAIN(tst_BoundingVolumeKernels)
+
+#include "tst_boundingvolumekernels.moc"
@@ -54,7 +54,13 @@ public:
             setArbiterOnNode(n);
     }
 
-    QList<Qt3DCore::QNode *> dirtyNodes() const { return m_dirtyFrontEndNodes; }
+    QList<Qt3DCore::QNode *> dirtyNodes() const
+    {
+        // Skip the holes left by nodes removed from the list
+        QList<Qt3DCore::QNode *> nodes = m_dirtyFrontEndNodes;
+        nodes.removeAll(nullptr);
+        return nodes;
+    }
     QList<Qt3DCore::ComponentRelationshipChange> dirtyComponents() const { return m_dirtyEntityComponentNodeChanges; }
 
     void clear()
@@ -23,7 +23,8 @@ qtConfig(private_tests) {
         vector4d_base \
         vector3d_base \
         aspectcommanddebugger \
-        qscheduler
+        qscheduler \
+        boundingvolumekernels
 
         QT_FOR_CONFIG += 3dcore-private
         qtConfig(qt3d-simd-sse2) {
@@ -4,4 +4,4 @@ TEMPLATE = app
 
 SOURCES += tst_qaspectjob.cpp
 
-QT += testlib 3dcore
+QT += testlib 3dcore 3dcore-private
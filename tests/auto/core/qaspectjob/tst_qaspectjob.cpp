@@ -28,6 +28,7 @@
 
 #include <QtTest/QTest>
 #include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/private/qaspectjob_p.h>
 
 using namespace Qt3DCore;
 
@@ -65,6 +66,33 @@ private Q_SLOTS:
         QVERIFY(job3->dependencies().empty());
     }
 
+    void shouldIgnoreDuplicateDependencies()
+    {
+        // GIVEN
+        QAspectJobPtr job1(new FakeAspectJob);
+        QAspectJobPtr job2(new FakeAspectJob);
+        job1->addDependency(job2);
+        const quint64 revision = QAspectJobPrivate::get(job1.data())->m_dependenciesRevision;
+
+        // WHEN
+        job1->addDependency(job2);
+
+        // THEN
+        QCOMPARE(job1->dependencies().size(), 1);
+        QCOMPARE(QAspectJobPrivate::get(job1.data())->m_dependenciesRevision, revision);
+    }
+
+    void shouldNotShareDependenciesRevisions()
+    {
+        // GIVEN
+        QAspectJobPtr job1(new FakeAspectJob);
+        QAspectJobPtr job2(new FakeAspectJob);
+
+        // THEN
+        QVERIFY(QAspectJobPrivate::get(job1.data())->m_dependenciesRevision
+                != QAspectJobPrivate::get(job2.data())->m_dependenciesRevision);
+    }
+
     void shouldRemoveDependencies()
     {
         // GIVEN
@@ -45,6 +45,7 @@ class tst_QChangeArbiter : public QObject
 
 private slots:
     void recordsDirtyNodes();
+    void takesAndRemovesDirtyNodes();
 };
 
 
@@ -133,6 +134,49 @@ void tst_QChangeArbiter::recordsDirtyNodes()
     QCOMPARE(arbiter->dirtyNodes().size(), 2);
 }
 
+void tst_QChangeArbiter::takesAndRemovesDirtyNodes()
+{
+    // GIVEN
+    QScopedPointer<TestArbiter> arbiter(new TestArbiter());
+    QScopedPointer<TestArbiter> otherArbiter(new TestArbiter());
+    QScopedPointer<Qt3DCore::QScene> scene(new Qt3DCore::QScene());
+    arbiter->setScene(scene.data());
+    scene->setArbiter(arbiter.data());
+
+    QScopedPointer<PropertyTestNode> root(new PropertyTestNode());
+    QList<PropertyTestNode *> nodes;
+    for (int i = 0; i < 4; ++i)
+        nodes.push_back(new PropertyTestNode(root.data()));
+    for (PropertyTestNode *node : qAsConst(nodes))
+        Qt3DCore::QNodePrivate::get(node)->setArbiter(arbiter.data());
+
+    // WHEN
+    for (int i = 0; i < 3; ++i) {
+        for (PropertyTestNode *node : qAsConst(nodes))
+            node->setProp1(node->prop1() + 1);
+    }
+
+    // THEN
+    QCOMPARE(arbiter->dirtyNodes().size(), 4);
+
+    // WHEN
+    Qt3DCore::QNodePrivate::get(nodes[1])->setArbiter(otherArbiter.data());
+    const QList<Qt3DCore::QNode *> dirtyNodes = arbiter->takeDirtyFrontEndNodes();
+
+    // THEN
+    QCOMPARE(dirtyNodes, QList<Qt3DCore::QNode *>({ nodes[0], nodes[2], nodes[3] }));
+    QVERIFY(arbiter->dirtyNodes().isEmpty());
+    QVERIFY(otherArbiter->dirtyNodes().isEmpty());
+
+    // WHEN
+    nodes[3]->setProp2(1584.0f);
+    nodes[1]->setProp2(1584.0f);
+    nodes[3]->setProp1(0);
+
+    // THEN
+    QCOMPARE(arbiter->takeDirtyFrontEndNodes(), QList<Qt3DCore::QNode *>({ nodes[3] }));
+    QCOMPARE(otherArbiter->takeDirtyFrontEndNodes(), QList<Qt3DCore::QNode *>({ nodes[1] }));
+}
 
 QTEST_MAIN(tst_QChangeArbiter)
 
@@ -49,6 +49,7 @@ private slots:
     void releaseResource();
     void heavyDutyMultiThreadedAccess();
     void heavyDutyMultiThreadedAccessRelease();
+    void concurrentLookupWhileInserting();
     void collectResources();
     void activeHandles();
     void checkCleanup();
@@ -369,6 +370,48 @@ void tst_QResourceManager::heavyDutyMultiThreadedAccessRelease()
     delete manager;
 }
 
+void tst_QResourceManager::concurrentLookupWhileInserting()
+{
+    // GIVEN
+    Qt3DCore::QResourceManager<tst_ArrayResource, int, Qt3DCore::ObjectLevelLockingPolicy> manager;
+    const int max = 65535;
+    QAtomicInt published(0);
+    QAtomicInt failures(0);
+
+    // Readers only look up keys which have been published, while the
+    // lookup table keeps growing and rehashing underneath them
+    QList<QThread *> readers;
+    for (int t = 0; t < 4; t++) {
+        readers << QThread::create([&] {
+            int count = 0;
+            while (count < max) {
+                count = published.loadAcquire();
+                for (int i = 0; i < count; i += 7) {
+                    if (manager.lookupResource(i) == nullptr || !manager.contains(i))
+                        failures.ref();
+                }
+                if (manager.lookupResource(max + 1) != nullptr)
+                    failures.ref();
+            }
+        });
+        readers.last()->start();
+    }
+
+    // WHEN
+    for (int i = 0; i < max; i++) {
+        manager.getOrCreateResource(i);
+        published.storeRelease(i + 1);
+    }
+    for (QThread *reader : qAsConst(readers))
+        reader->wait();
+    qDeleteAll(readers);
+
+    // THEN
+    QCOMPARE(failures.loadRelaxed(), 0);
+    for (int i = 0; i < max; i++)
+        QVERIFY(manager.lookupResource(i) != nullptr);
+}
+
 void tst_QResourceManager::collectResources()
 {
     Qt3DCore::QResourceManager<tst_ArrayResource, uint> manager;
@@ -31,6 +31,9 @@
 #include <Qt3DCore/qnode.h>
 #include <Qt3DCore/qentity.h>
 #include <Qt3DCore/qcomponent.h>
+#include <Qt3DCore/qboundingvolume.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/private/qboundingvolume_p.h>
 #include <private/qnode_p.h>
 #include <testarbiter.h>
 
@@ -50,6 +53,7 @@ private slots:
     void addEntityForComponent();
     void removeEntityForComponent();
     void hasEntityForComponent();
+    void boundingVolumeProviders();
 };
 
 class tst_Node : public Qt3DCore::QNode
@@ -344,6 +348,52 @@ void tst_QScene::hasEntityForComponent()
         QVERIFY(scene->hasEntityForComponent(components.at(i)->id(), entities.at(i)->id()));
 }
 
+void tst_QScene::boundingVolumeProviders()
+{
+    // GIVEN
+    Qt3DCore::QScene *scene = new Qt3DCore::QScene;
+    Qt3DCore::QBoundingVolume *provider = new Qt3DCore::QBoundingVolume();
+    Qt3DCore::QBoundingVolume *otherProvider = new Qt3DCore::QBoundingVolume();
+    Qt3DCore::QAttribute *attribute = new Qt3DCore::QAttribute();
+
+    Qt3DCore::QNodePrivate::get(attribute)->setScene(scene);
+
+    // THEN
+    QVERIFY(scene->boundingVolumeProviders().isEmpty());
+    QVERIFY(!(scene->dirtyBits() & Qt3DCore::QScene::BoundingVolumeDirty));
+
+    // WHEN
+    Qt3DCore::QNodePrivate::get(provider)->setScene(scene);
+    Qt3DCore::QNodePrivate::get(otherProvider)->setScene(scene);
+    scene->addObservable(otherProvider);
+
+    // THEN
+    QCOMPARE(scene->boundingVolumeProviders().size(), 2);
+    QVERIFY(scene->boundingVolumeProviders().contains(provider));
+    QVERIFY(scene->boundingVolumeProviders().contains(otherProvider));
+    QVERIFY(scene->dirtyBits() & Qt3DCore::QScene::BoundingVolumeDirty);
+    QVERIFY(Qt3DCore::QBoundingVolumePrivate::get(provider)->m_dirty);
+
+    // WHEN
+    scene->clearDirtyBits();
+    attribute->setCount(3);
+
+    // THEN
+    QVERIFY(scene->dirtyBits() & Qt3DCore::QScene::BoundingVolumeDirty);
+
+    // WHEN
+    Qt3DCore::QNodePrivate::get(provider)->setScene(nullptr);
+
+    // THEN
+    QCOMPARE(scene->boundingVolumeProviders(), QList<Qt3DCore::QBoundingVolume *>({ otherProvider }));
+
+    // WHEN
+    scene->removeObservable(otherProvider);
+
+    // THEN
+    QVERIFY(scene->boundingVolumeProviders().isEmpty());
+}
+
 QTEST_MAIN(tst_QScene)
 
 #include "tst_qscene.moc"
@@ -67,6 +67,10 @@ private Q_SLOTS:
     void dependencyAspectQueue();
     void massTest();
     void perThreadUniqueCall();
+    void perThreadDuringFrame();
+    void perThreadBackToBack();
+    void compiledGraphReuse();
+    void compiledGraphRecycledJobs();
 };
 
 typedef Qt3DCore::QAspectJobManager JobManager;
@@ -366,6 +370,171 @@ void tst_ThreadPooler::perThreadUniqueCall()
     QCOMPARE(maxValue, tester.globalAtomicValue());
 }
 
+/*
+ * Running a function on every thread while frame jobs are in flight must
+ * neither wait for nor affect the count of the frame jobs.
+ */
+void tst_ThreadPooler::perThreadDuringFrame()
+{
+    // GIVEN
+    JobManager jobManager;
+    QAtomicInt callCounter;
+    QAtomicInt perThreadCounter;
+    int value = 0; // Not used in this test
+    std::vector<QSharedPointer<Qt3DCore::QAspectJob> > jobList;
+    callCounter.storeRelaxed(0);
+    perThreadCounter.storeRelaxed(0);
+    const int jobCount = 5;
+
+    for (int i = 0; i < jobCount; i++) {
+        QSharedPointer<TestAspectJob> job(new TestAspectJob(incrementFunctionCallCounter,
+                                                            &callCounter, &value));
+        jobList.push_back(job);
+    }
+
+    // WHEN
+    jobManager.enqueueJobs(jobList);
+    jobManager.waitForPerThreadFunction(perThreadFunction, &perThreadCounter);
+    const int runJobs = jobManager.waitForAllJobs();
+
+    // THEN
+    QCOMPARE(perThreadCounter.loadRelaxed(), JobManager::idealThreadCount());
+    QCOMPARE(callCounter.loadRelaxed(), jobCount);
+    QCOMPARE(runJobs, jobCount);
+}
+
+/*
+ * Calls following each other must not be affected by workers still leaving
+ * the previous one.
+ */
+void tst_ThreadPooler::perThreadBackToBack()
+{
+    // GIVEN
+    JobManager jobManager;
+    const int callCount = 100;
+    std::vector<QAtomicInt> callCounters(callCount);
+
+    // WHEN
+    for (QAtomicInt &callCounter : callCounters)
+        jobManager.waitForPerThreadFunction(perThreadFunction, &callCounter);
+    jobManager.waitForAllJobs();
+
+    // THEN
+    for (const QAtomicInt &callCounter : callCounters)
+        QCOMPARE(callCounter.loadRelaxed(), JobManager::idealThreadCount());
+}
+
+/*
+ * The job graph should only be compiled again when the jobs or their
+ * dependencies change from one frame to the next.
+ */
+void tst_ThreadPooler::compiledGraphReuse()
+{
+    // GIVEN
+    JobManager jobManager;
+    QAtomicInt callCounter; // Not used in this test
+    int value = 2;
+    std::vector<QSharedPointer<Qt3DCore::QAspectJob> > jobList;
+    QSharedPointer<TestAspectJob> job1(new TestAspectJob(add2, &callCounter, &value));
+    QSharedPointer<TestAspectJob> job2(new TestAspectJob(multiplyBy2, &callCounter, &value));
+    jobList.push_back(job2);
+    jobList.push_back(job1);
+
+    // WHEN
+    jobManager.enqueueJobs(jobList);
+    jobManager.waitForAllJobs();
+
+    // THEN
+    QCOMPARE(jobManager.jobGraphStatistics().rebuilt, quint64(1));
+    QCOMPARE(jobManager.jobGraphStatistics().reused, quint64(0));
+
+    // WHEN
+    value = 2;
+    jobManager.enqueueJobs(jobList);
+    jobManager.waitForAllJobs();
+
+    // THEN
+    QCOMPARE(jobManager.jobGraphStatistics().rebuilt, quint64(1));
+    QCOMPARE(jobManager.jobGraphStatistics().reused, quint64(1));
+
+    // WHEN
+    value = 2;
+    job2->addDependency(job1);
+    jobManager.enqueueJobs(jobList);
+    jobManager.waitForAllJobs();
+
+    // THEN
+    QCOMPARE(jobManager.jobGraphStatistics().patched, quint64(1));
+    QCOMPARE(value, 8);
+
+    // WHEN
+    value = 2;
+    jobManager.enqueueJobs(jobList);
+    jobManager.waitForAllJobs();
+
+    // THEN
+    QCOMPARE(jobManager.jobGraphStatistics().reused, quint64(2));
+    QCOMPARE(value, 8);
+
+    // WHEN
+    QSharedPointer<TestAspectJob> job3(new TestAspectJob(add2, &callCounter, &value));
+    job3->addDependency(job2);
+    jobList.push_back(job3);
+    value = 2;
+    jobManager.enqueueJobs(jobList);
+    jobManager.waitForAllJobs();
+
+    // THEN
+    QCOMPARE(jobManager.jobGraphStatistics().rebuilt, quint64(2));
+    QCOMPARE(value, 10);
+}
+
+/*
+ * Jobs allocated after the jobs of the previous frame were deleted may reuse
+ * their addresses but must not inherit their dependencies.
+ */
+void tst_ThreadPooler::compiledGraphRecycledJobs()
+{
+    // GIVEN
+    JobManager jobManager;
+    QAtomicInt callCounter; // Not used in this test
+    int value = 2;
+
+    {
+        std::vector<QSharedPointer<Qt3DCore::QAspectJob> > jobList;
+        QSharedPointer<TestAspectJob> job1(new TestAspectJob(add2, &callCounter, &value));
+        QSharedPointer<TestAspectJob> job2(new TestAspectJob(multiplyBy2, &callCounter, &value));
+        job2->addDependency(job1);
+        jobList.push_back(job2);
+        jobList.push_back(job1);
+
+        // WHEN
+        jobManager.enqueueJobs(jobList);
+        jobManager.waitForAllJobs();
+
+        // THEN
+        QCOMPARE(value, 8);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        // WHEN -> previous jobs are gone, the dependency is now reversed
+        value = 2;
+        std::vector<QSharedPointer<Qt3DCore::QAspectJob> > jobList;
+        QSharedPointer<TestAspectJob> job1(new TestAspectJob(multiplyBy2, &callCounter, &value));
+        QSharedPointer<TestAspectJob> job2(new TestAspectJob(add2, &callCounter, &value));
+        job2->addDependency(job1);
+        jobList.push_back(job2);
+        jobList.push_back(job1);
+        jobManager.enqueueJobs(jobList);
+        jobManager.waitForAllJobs();
+
+        // THEN -> (2 * 2) + 2
+        QCOMPARE(value, 6);
+        QCOMPARE(jobManager.jobGraphStatistics().rebuilt, quint64(2 + i));
+        QCOMPARE(jobManager.jobGraphStatistics().reused, quint64(0));
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_ThreadPooler)
 
 #include "tst_threadpooler.moc"
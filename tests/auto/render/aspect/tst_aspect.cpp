@@ -104,6 +104,7 @@ private Q_SLOTS:
         QCOMPARE(jobs.size(),
                  1 + // UpdateTreeEnabled
                  1 + // UpdateTransform
+                 int(daspect->m_worldTransformJob->subtreeJobs().size()) + // PrepareUpdateTransform, UpdateTransformBatch
                  1 + // UpdateWorldBoundingVolume
                  1 + // CalcBoundingVolume
                  1 + // ExpandBoundingVolume
@@ -139,6 +140,7 @@ private Q_SLOTS:
         QCOMPARE(jobs.size(),
                  1 + // UpdateTreeEnabled
                  1 + // UpdateTransform
+                 int(daspect->m_worldTransformJob->subtreeJobs().size()) + // PrepareUpdateTransform, UpdateTransformBatch
                  1 + // UpdateWorldBoundingVolume
                  1 + // CalcBoundingVolume
                  1 + // ExpandBoundingVolume
@@ -158,6 +160,7 @@ private Q_SLOTS:
         // THEN -> transform dirty
         QCOMPARE(jobs.size(),
                  1 + // UpdateTransform
+                 int(daspect->m_worldTransformJob->subtreeJobs().size()) + // PrepareUpdateTransform, UpdateTransformBatch
                  1 + // UpdateWorldBoundingVolume
                  1 + // ExpandBoundingVolume
                  1 + // SyncLoadingJobs
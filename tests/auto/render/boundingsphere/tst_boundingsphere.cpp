@@ -56,8 +56,12 @@
 #include <Qt3DRender/private/buffermanager_p.h>
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
 #include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/boundingspherearray_p.h>
+#include <Qt3DRender/private/scenebvh_p.h>
 
 #include <qbackendnodetester.h>
+#include <algorithm>
+#include <array>
 
 QT_BEGIN_NAMESPACE
 
@@ -628,6 +632,185 @@ private Q_SLOTS:
         QCOMPARE(center.y(), expectedCenter.y());
         QCOMPARE(center.z(), expectedCenter.z());
     }
+
+    void checkBoundingSphereArrayCulling()
+    {
+        // GIVEN
+        QScopedPointer<Qt3DCore::QEntity> root(new Qt3DCore::QEntity);
+        for (int i = 0; i < 203; ++i)
+            new Qt3DCore::QEntity(root.data());
+        QScopedPointer<Qt3DRender::TestAspect> test(new Qt3DRender::TestAspect(root.data()));
+
+        // Line of spheres along the x axis, centered on [-99, 103], all
+        // contained by the root sphere
+        const QList<Qt3DRender::Render::Entity *> children = test->sceneRoot()->children();
+        QCOMPARE(children.size(), 203);
+        *test->sceneRoot()->worldBoundingVolumeWithChildren() = Qt3DRender::Render::Sphere(Vector3D(0.0f, 0.0f, 0.0f), 104.0f);
+        for (int i = 0, m = int(children.size()); i < m; ++i)
+            *children[i]->worldBoundingVolumeWithChildren() = Qt3DRender::Render::Sphere(Vector3D(float(i) - 99.0f, 0.0f, 0.0f), 0.5f);
+
+        Qt3DRender::Render::BoundingSphereArray spheres;
+        spheres.rebuild(test->sceneRoot(), test->nodeManagers()->renderNodesManager()->hierarchyRevision());
+        spheres.update();
+        QCOMPARE(spheres.size(), size_t(204));
+        QCOMPARE(spheres.entity(0), test->sceneRoot());
+        QCOMPARE(spheres.subtreeEnd(0), 204U);
+
+        const auto boxPlanes = [] (float x, float halfExtent) {
+            return std::array<Vector4D, 6> {
+                Vector4D(1.0f, 0.0f, 0.0f, halfExtent - x),
+                Vector4D(-1.0f, 0.0f, 0.0f, halfExtent + x),
+                Vector4D(0.0f, 1.0f, 0.0f, halfExtent),
+                Vector4D(0.0f, -1.0f, 0.0f, halfExtent),
+                Vector4D(0.0f, 0.0f, 1.0f, halfExtent),
+                Vector4D(0.0f, 0.0f, -1.0f, halfExtent),
+            };
+        };
+        std::vector<quint8> lastRejectingPlanes(spheres.size(), 0);
+
+        {
+            // WHEN
+            const auto planes = boxPlanes(0.0f, 10.0f);
+            std::vector<uint> visibleIndices;
+            spheres.cullSubtrees(0, uint(spheres.size()), planes.data(), Qt3DRender::Render::BoundingSphereArray::AllPlanes,
+                                 lastRejectingPlanes.data(), visibleIndices);
+
+            // THEN -> root and the 21 children in [-10, 10]
+            QCOMPARE(visibleIndices.size(), size_t(22));
+            for (uint index : visibleIndices)
+                QVERIFY(qAbs(spheres.entity(index)->worldBoundingVolumeWithChildren()->center().x()) <= 10.0f);
+        }
+        {
+            // WHEN -> root fully outside
+            const auto planes = boxPlanes(-1000.0f, 10.0f);
+            std::vector<uint> visibleIndices;
+            spheres.cullSubtrees(0, uint(spheres.size()), planes.data(), Qt3DRender::Render::BoundingSphereArray::AllPlanes,
+                                 lastRejectingPlanes.data(), visibleIndices);
+
+            // THEN
+            QVERIFY(visibleIndices.empty());
+            QCOMPARE(lastRejectingPlanes[0], quint8(1));
+        }
+        {
+            // WHEN -> root fully inside
+            const auto planes = boxPlanes(0.0f, 500.0f);
+            std::vector<uint> visibleIndices;
+            uint planeMask = Qt3DRender::Render::BoundingSphereArray::AllPlanes;
+            const bool testChildren = spheres.cullNode(0, planes.data(), planeMask, lastRejectingPlanes.data(), visibleIndices);
+
+            // THEN
+            QVERIFY(!testChildren);
+            QCOMPARE(visibleIndices.size(), spheres.size());
+        }
+    }
+
+    void checkSceneBVH()
+    {
+        // GIVEN
+        QScopedPointer<Qt3DCore::QEntity> root(new Qt3DCore::QEntity);
+        for (int i = 0; i < 203; ++i)
+            new Qt3DCore::QEntity(root.data());
+        QScopedPointer<Qt3DRender::TestAspect> test(new Qt3DRender::TestAspect(root.data()));
+
+        // Line of spheres along the x axis, centered on [-99, 103]
+        const QList<Qt3DRender::Render::Entity *> children = test->sceneRoot()->children();
+        QCOMPARE(children.size(), 203);
+        *test->sceneRoot()->worldBoundingVolumeWithChildren() = Qt3DRender::Render::Sphere(Vector3D(0.0f, 0.0f, 0.0f), 104.0f);
+        for (int i = 0, m = int(children.size()); i < m; ++i) {
+            const Qt3DRender::Render::Sphere sphere(Vector3D(float(i) - 99.0f, 0.0f, 0.0f), 0.5f);
+            *children[i]->worldBoundingVolume() = sphere;
+            *children[i]->worldBoundingVolumeWithChildren() = sphere;
+        }
+
+        Qt3DRender::Render::BoundingSphereArray spheres;
+        spheres.rebuild(test->sceneRoot(), test->nodeManagers()->renderNodesManager()->hierarchyRevision());
+        Qt3DRender::Render::SceneBVH bvh;
+        bvh.rebuild(spheres);
+        QCOMPARE(bvh.size(), size_t(204));
+        QCOMPARE(bvh.root(), test->sceneRoot());
+        QCOMPARE(bvh.buildCount(), quint64(1));
+        QCOMPARE(bvh.subtreeEnd(0), 204U);
+        QCOMPARE(bvh.subtreeEnd(1), 2U);
+
+        const auto hitEntities = [&] (const Qt3DRender::RayCasting::QRay3D &ray, const std::vector<uint> &indices) {
+            std::vector<Qt3DRender::Render::Entity *> entities;
+            for (uint index : indices) {
+                if (bvh.entity(index)->worldBoundingVolume()->intersects(ray, nullptr))
+                    entities.push_back(bvh.entity(index));
+            }
+            return entities;
+        };
+
+        {
+            // WHEN
+            const Qt3DRender::RayCasting::QRay3D ray(Vector3D(0.2f, 10.0f, 0.0f), Vector3D(0.0f, -1.0f, 0.0f));
+            std::vector<uint> indices;
+            bvh.intersect(ray, indices);
+
+            // THEN -> only a few candidates, among which the sphere at the origin
+            QVERIFY(indices.size() < 10);
+            QVERIFY(std::is_sorted(indices.begin(), indices.end()));
+            const auto entities = hitEntities(ray, indices);
+            QCOMPARE(entities.size(), size_t(1));
+            QCOMPARE(entities.front(), children[99]);
+        }
+        {
+            // WHEN
+            const Qt3DRender::RayCasting::QRay3D ray(Vector3D(-200.0f, 0.0f, 0.0f), Vector3D(1.0f, 0.0f, 0.0f));
+            std::vector<uint> indices;
+            bvh.intersect(ray, indices);
+
+            // THEN -> all the children are hit
+            QCOMPARE(hitEntities(ray, indices).size(), size_t(203));
+        }
+        {
+            // WHEN -> one child slightly moves
+            const Qt3DRender::Render::Sphere moved(Vector3D(1.0f, 0.4f, 0.0f), 0.5f);
+            *children[100]->worldBoundingVolume() = moved;
+            *children[100]->worldBoundingVolumeWithChildren() = moved;
+            // Root comes first, the children follow
+            bvh.refit({ 101 });
+
+            const Qt3DRender::RayCasting::QRay3D ray(Vector3D(1.0f, 0.8f, -10.0f), Vector3D(0.0f, 0.0f, 1.0f));
+            std::vector<uint> indices;
+            bvh.intersect(ray, indices);
+
+            // THEN -> it is found at its new place without rebuilding
+            const auto entities = hitEntities(ray, indices);
+            QCOMPARE(entities.size(), size_t(1));
+            QCOMPARE(entities.front(), children[100]);
+            QCOMPARE(bvh.buildCount(), quint64(1));
+        }
+        {
+            // WHEN -> one child moves far away
+            const Qt3DRender::Render::Sphere moved(Vector3D(0.0f, 50.0f, 0.0f), 0.5f);
+            *children[0]->worldBoundingVolume() = moved;
+            *children[0]->worldBoundingVolumeWithChildren() = moved;
+            bvh.refit({ 1 });
+
+            const Qt3DRender::RayCasting::QRay3D ray(Vector3D(0.0f, 50.0f, -10.0f), Vector3D(0.0f, 0.0f, 1.0f));
+            std::vector<uint> indices;
+            bvh.intersect(ray, indices);
+
+            // THEN
+            const auto entities = hitEntities(ray, indices);
+            QCOMPARE(entities.size(), size_t(1));
+            QCOMPARE(entities.front(), children[0]);
+        }
+        {
+            // WHEN
+            std::vector<uint> indices;
+            bvh.gatherNear(Vector3D(0.0f, 0.0f, 0.0f), 2.0f, indices);
+
+            // THEN -> root and the children centered in [-2, 2] are gathered
+            int nearCount = 0;
+            for (uint index : indices) {
+                if (bvh.entity(index)->worldBoundingVolumeWithChildren()->center().length() <= 2.0f)
+                    ++nearCount;
+            }
+            QCOMPARE(nearCount, 6);
+        }
+    }
 };
 
 QTEST_MAIN(tst_BoundingSphere)
@@ -33,6 +33,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/entityvisitor_p.h>
 #include <Qt3DRender/private/entityaccumulator_p.h>
+#include <Qt3DRender/private/flatentityhierarchy_p.h>
 
 #include <Qt3DRender/QCameraLens>
 #include <Qt3DCore/QTransform>
@@ -587,6 +588,75 @@ private slots:
         QCOMPARE(r2.count(), 0);
     }
 
+    void flatHierarchyVisitor()
+    {
+        // GIVEN
+        TestRenderer renderer;
+        NodeManagers nodeManagers;
+        Qt3DCore::QEntity frontendEntityA, frontendEntityB, frontendEntityC, frontendEntityD;
+
+        frontendEntityB.setEnabled(false);
+
+        auto backendA = createEntity(renderer, nodeManagers, frontendEntityA);
+        createEntity(renderer, nodeManagers, frontendEntityB);
+        createEntity(renderer, nodeManagers, frontendEntityC);
+        createEntity(renderer, nodeManagers, frontendEntityD);
+
+        auto sendParentChange = [&nodeManagers](const Qt3DCore::QEntity &entity) {
+            Entity *backendEntity = nodeManagers.renderNodesManager()->getOrCreateResource(entity.id());
+            backendEntity->syncFromFrontEnd(&entity, false);
+        };
+
+        // reparent B and D to A and C to B.
+        frontendEntityB.setParent(&frontendEntityA);
+        sendParentChange(frontendEntityB);
+        frontendEntityC.setParent(&frontendEntityB);
+        sendParentChange(frontendEntityC);
+        frontendEntityD.setParent(&frontendEntityA);
+        sendParentChange(frontendEntityD);
+
+        EntityManager *entityManager = nodeManagers.renderNodesManager();
+        FlatEntityHierarchy *hierarchy = entityManager->flatHierarchy();
+        hierarchy->update(backendA, entityManager->hierarchyRevision());
+
+        // WHEN
+        CompleteVisitor v1(&nodeManagers);
+        v1.setUseFlatHierarchy(true);
+        EnabledVisitor v2(&nodeManagers);
+        v2.setUseFlatHierarchy(true);
+        CompleteVisitor v3(&nodeManagers);
+        v3.setUseFlatHierarchy(true);
+        v3.setPruneDisabled(true);
+        v1.apply(backendA);
+        v2.apply(backendA);
+        v3.apply(backendA);
+
+        // THEN
+        QCOMPARE(v1.count, 4);
+        QCOMPARE(v2.count, 3); // C is pruned with B
+        QCOMPARE(v3.count, 2); // B and C are skipped
+
+        // WHEN
+        QList<Entity *> visited;
+        const bool completed = hierarchy->traverse(0, [&visited] (Entity *e, uint) {
+            visited.push_back(e);
+            return e->isEnabled() ? FlatEntityHierarchy::Continue : FlatEntityHierarchy::Stop;
+        });
+
+        // THEN
+        QVERIFY(!completed);
+        QCOMPARE(visited.size(), 2);
+        QCOMPARE(visited.first(), backendA);
+        QCOMPARE(visited.last()->peerId(), frontendEntityB.id());
+
+        // WHEN
+        int visitCount = 0;
+        backendA->traverse([&visitCount] (const Entity *) { ++visitCount; });
+
+        // THEN
+        QCOMPARE(visitCount, 4);
+    }
+
 private:
     Entity *createEntity(TestRenderer &renderer, NodeManagers &nodeManagers, const Qt3DCore::QEntity &frontEndEntity) {
         HEntity renderNodeHandle = nodeManagers.renderNodesManager()->getOrAcquireHandle(frontEndEntity.id());
@@ -0,0 +1,283 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/qmesh.h>
+#include <Qt3DRender/private/meshcache_p.h>
+#include <Qt3DRender/private/qmesh_p.h>
+#include <memory>
+#include <vector>
+
+using namespace Qt3DCore;
+using namespace Qt3DRender;
+
+namespace {
+
+const uint vertexCount = 16;
+
+QGeometry *createGeometry()
+{
+    QGeometry *geometry = new QGeometry;
+    QBuffer *buffer = new QBuffer(geometry);
+    buffer->setData(QByteArray(vertexCount * 6 * sizeof(float), '\0'));
+
+    QAttribute *position = new QAttribute(buffer, QAttribute::defaultPositionAttributeName(),
+                                          QAttribute::Float, 3, vertexCount, 0, 6 * sizeof(float));
+    QAttribute *normal = new QAttribute(buffer, QAttribute::defaultNormalAttributeName(),
+                                        QAttribute::Float, 3, vertexCount, 3 * sizeof(float), 6 * sizeof(float));
+    geometry->addAttribute(position);
+    geometry->addAttribute(normal);
+    geometry->setBoundingVolumePositionAttribute(position);
+    return geometry;
+}
+
+MeshCacheKey key(const QString &meshName = QString(), const QByteArray &version = QByteArrayLiteral("1"))
+{
+    return { QStringLiteral("/meshes/cube.obj"), meshName, version };
+}
+
+} // anonymous
+
+class tst_MeshCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void checkDefaultMaximumSize()
+    {
+        if (qEnvironmentVariableIsSet("QT3D_MESH_CACHE_SIZE"))
+            QSKIP("The maximum size is overridden by QT3D_MESH_CACHE_SIZE");
+
+        // GIVEN
+        MeshCache cache;
+
+        // THEN
+        QCOMPARE(cache.maximumSize(), qsizetype(32 * 1024 * 1024));
+    }
+
+    void checkLoadsOncePerKey()
+    {
+        // GIVEN
+        MeshCache cache;
+        cache.setMaximumSize(1024 * 1024);
+        int loadCount = 0;
+        auto load = [&loadCount] { ++loadCount; return createGeometry(); };
+
+        // WHEN
+        QScopedPointer<QGeometry> first(cache.geometry(key(), load));
+        QScopedPointer<QGeometry> second(cache.geometry(key(), load));
+
+        // THEN
+        QCOMPARE(loadCount, 1);
+        QVERIFY(first);
+        QVERIFY(second);
+        QVERIFY(first.data() != second.data());
+        QCOMPARE(cache.count(), 1);
+        QCOMPARE(cache.size(), qsizetype(vertexCount * 6 * sizeof(float)));
+
+        // WHEN
+        QScopedPointer<QGeometry> otherMesh(cache.geometry(key(QStringLiteral("Cube")), load));
+        QScopedPointer<QGeometry> otherVersion(cache.geometry(key(QString(), QByteArrayLiteral("2")), load));
+
+        // THEN
+        QCOMPARE(loadCount, 3);
+        QCOMPARE(cache.count(), 3);
+    }
+
+    void checkSharesBufferData()
+    {
+        // GIVEN
+        MeshCache cache;
+        cache.setMaximumSize(1024 * 1024);
+        auto load = [] { return createGeometry(); };
+
+        // WHEN
+        QScopedPointer<QGeometry> first(cache.geometry(key(), load));
+        QScopedPointer<QGeometry> second(cache.geometry(key(), load));
+
+        // THEN
+        const auto firstAttributes = first->attributes();
+        const auto secondAttributes = second->attributes();
+        QCOMPARE(secondAttributes.size(), firstAttributes.size());
+        for (int i = 0, m = int(firstAttributes.size()); i < m; ++i) {
+            const QAttribute *a = firstAttributes.at(i);
+            const QAttribute *b = secondAttributes.at(i);
+            QCOMPARE(b->name(), a->name());
+            QCOMPARE(b->vertexBaseType(), a->vertexBaseType());
+            QCOMPARE(b->vertexSize(), a->vertexSize());
+            QCOMPARE(b->count(), a->count());
+            QCOMPARE(b->byteOffset(), a->byteOffset());
+            QCOMPARE(b->byteStride(), a->byteStride());
+            QCOMPARE(b->buffer()->data().constData(), a->buffer()->data().constData());
+        }
+        // Both attributes still point to a single buffer
+        QCOMPARE(secondAttributes.at(0)->buffer(), secondAttributes.at(1)->buffer());
+        QCOMPARE(second->boundingVolumePositionAttribute(), secondAttributes.at(0));
+    }
+
+    void checkEviction()
+    {
+        // GIVEN
+        MeshCache cache;
+        const qsizetype geometrySize = vertexCount * 6 * sizeof(float);
+        cache.setMaximumSize(geometrySize);
+        int loadCount = 0;
+        auto load = [&loadCount] { ++loadCount; return createGeometry(); };
+
+        // WHEN
+        delete cache.geometry(key(), load);
+        delete cache.geometry(key(QStringLiteral("Cube")), load);
+
+        // THEN
+        QCOMPARE(loadCount, 2);
+        QCOMPARE(cache.count(), 1);
+        QCOMPARE(cache.size(), geometrySize);
+
+        // WHEN -> least recently used entry was evicted
+        delete cache.geometry(key(), load);
+
+        // THEN
+        QCOMPARE(loadCount, 3);
+
+        // WHEN
+        cache.clear();
+        delete cache.geometry(key(), load);
+
+        // THEN
+        QCOMPARE(loadCount, 4);
+
+        // WHEN -> geometry larger than the budget is never kept
+        cache.setMaximumSize(geometrySize - 1);
+        cache.clear();
+        delete cache.geometry(key(), load);
+        delete cache.geometry(key(), load);
+
+        // THEN
+        QCOMPARE(loadCount, 6);
+        QCOMPARE(cache.count(), 0);
+    }
+
+    void checkFailedLoadIsNotCached()
+    {
+        // GIVEN
+        MeshCache cache;
+        cache.setMaximumSize(1024 * 1024);
+        int loadCount = 0;
+        auto load = [&loadCount] () -> QGeometry * { ++loadCount; return nullptr; };
+
+        // WHEN
+        QGeometry *first = cache.geometry(key(), load);
+        QGeometry *second = cache.geometry(key(), load);
+
+        // THEN
+        QVERIFY(first == nullptr);
+        QVERIFY(second == nullptr);
+        QCOMPARE(loadCount, 2);
+        QCOMPARE(cache.count(), 0);
+    }
+
+    void checkConcurrentMeshLoads()
+    {
+        // GIVEN
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString filePath = dir.filePath(QStringLiteral("triangle.obj"));
+        {
+            QFile file(filePath);
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+        }
+
+        MeshCache *cache = MeshCache::instance();
+        const qsizetype maximumSize = cache->maximumSize();
+        cache->setMaximumSize(1024 * 1024);
+        cache->clear();
+
+        QMesh mesh;
+        mesh.setSource(QUrl::fromLocalFile(filePath));
+
+        const int threadCount = 8;
+        std::vector<MeshLoaderFunctor> functors(threadCount, MeshLoaderFunctor(&mesh));
+        std::vector<QGeometry *> geometries(threadCount, nullptr);
+        std::vector<std::unique_ptr<QThread>> threads;
+
+        // WHEN
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create([&functors, &geometries, i] {
+                geometries[i] = functors[i]();
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            QVERIFY(thread->wait());
+
+        // THEN -> the file was parsed once, all geometries share its data
+        QCOMPARE(cache->count(), 1);
+        QVERIFY(geometries.front() != nullptr);
+        const auto attributes = geometries.front()->attributes();
+        QVERIFY(!attributes.isEmpty());
+        for (int i = 0; i < threadCount; ++i) {
+            QVERIFY(geometries[i] != nullptr);
+            QCOMPARE(functors[i].status(), QMesh::Ready);
+            const auto otherAttributes = geometries[i]->attributes();
+            QCOMPARE(otherAttributes.size(), attributes.size());
+            for (int j = 0, m = int(attributes.size()); j < m; ++j) {
+                QCOMPARE(otherAttributes.at(j)->count(), attributes.at(j)->count());
+                QCOMPARE(otherAttributes.at(j)->buffer()->data().constData(),
+                         attributes.at(j)->buffer()->data().constData());
+            }
+        }
+
+        qDeleteAll(geometries);
+        cache->clear();
+        cache->setMaximumSize(maximumSize);
+    }
+};
+
+QTEST_MAIN(tst_MeshCache)
+
+#include "tst_meshcache.moc"
@@ -474,6 +474,71 @@ private Q_SLOTS:
         QCOMPARE(gatherer->materialToPassAndParameter().size(), 0);
     }
 
+    void checkDependenciesIncludeFilteredOutPasses()
+    {
+        // GIVEN
+        Qt3DRender::QRenderPassFilter *frameGraphFilter = renderPassFilter();
+        TestMaterial material;
+
+        Qt3DRender::QFilterKey passFilterFilterKey;
+        passFilterFilterKey.setName(QStringLiteral("renderingStyle"));
+        passFilterFilterKey.setValue(QVariant(QStringLiteral("forward")));
+
+        Qt3DRender::QFilterKey passFilterKey;
+        passFilterKey.setName(QStringLiteral("renderingStyle"));
+        passFilterKey.setValue(QVariant(QStringLiteral("backward")));
+
+        frameGraphFilter->addMatch(&passFilterFilterKey);
+
+        material.gl3Pass()->addFilterKey(&passFilterKey);
+        material.gl2Pass()->addFilterKey(&passFilterKey);
+        material.es2Pass()->addFilterKey(&passFilterKey);
+
+        Qt3DCore::QEntity *sceneRoot = buildScene(frameGraphFilter, &material);
+        Qt3DRender::TestAspect testAspect(sceneRoot);
+        Qt3DRender::Render::MaterialParameterGathererJobPtr gatherer = testAspect.materialGathererJob();
+
+        testAspect.initializeRenderer();
+
+        Qt3DRender::Render::RenderPassFilter *backendPassFilter = static_cast<Qt3DRender::Render::RenderPassFilter *>(testAspect.nodeManagers()->frameGraphManager()->lookupNode(frameGraphFilter->id()));
+        QVERIFY(backendPassFilter != nullptr);
+
+        // WHEN
+        Qt3DRender::Render::MaterialManager *materialManager = testAspect.nodeManagers()->materialManager();
+        gatherer->setHandles(materialManager->activeHandles());
+        gatherer->setRenderPassFilter(backendPassFilter);
+        gatherer->run();
+
+        // THEN -> no pass matches, yet they are all dependencies
+        QCOMPARE(gatherer->materialToPassAndParameter().size(), 0);
+        QVERIFY(gatherer->materialDependencies().contains(material.id()));
+        const std::vector<Qt3DCore::QNodeId> dependencies = gatherer->materialDependencies().value(material.id());
+        const auto dependsOn = [&dependencies] (Qt3DCore::QNodeId id) {
+            return std::find(dependencies.begin(), dependencies.end(), id) != dependencies.end();
+        };
+        QVERIFY(dependsOn(frameGraphFilter->id()));
+        Qt3DCore::QNodeId filteredOutPassId;
+        for (Qt3DRender::QRenderPass *pass : { material.gl3Pass(), material.gl2Pass(), material.es2Pass() }) {
+            if (dependsOn(pass->id()))
+                filteredOutPassId = pass->id();
+        }
+        QVERIFY(!filteredOutPassId.isNull());
+        QVERIFY(dependsOn(passFilterKey.id()));
+
+        // WHEN -> the filter keys of the pass change
+        std::vector<Qt3DCore::QNodeId> removedMaterials;
+        const std::vector<Qt3DRender::Render::HMaterial> materialsToGather =
+                Qt3DRender::Render::MaterialParameterGathererJob::findMaterialsToGather(materialManager,
+                                                                                       gatherer->materialDependencies(),
+                                                                                       { filteredOutPassId },
+                                                                                       removedMaterials);
+
+        // THEN
+        QCOMPARE(materialsToGather.size(), size_t(1));
+        QCOMPARE(materialsToGather.front(), materialManager->lookupHandle(material.id()));
+        QVERIFY(removedMaterials.empty());
+    }
+
     void checkParameterPriorityGathering()
     {
         {
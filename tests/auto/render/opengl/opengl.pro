@@ -11,6 +11,7 @@ SUBDIRS += \
         renderviewutils \
         renderviews \
         renderqueue \
+        shaderparameterpack \
         renderviewbuilder \
         qgraphicsutils \
         computecommand \
@@ -37,6 +37,7 @@
 #include <Qt3DRender/private/viewportnode_p.h>
 #include <Qt3DRender/private/offscreensurfacehelper_p.h>
 #include <Qt3DRender/private/qrenderaspect_p.h>
+#include <Qt3DRender/private/frustumcullingjob_p.h>
 #include <Qt3DRender/qmaterial.h>
 
 #include "testaspect.h"
@@ -147,13 +148,15 @@ private Q_SLOTS:
 
         const int singleRenderViewCommandRebuildJobCount  = 1 + Qt3DCore::QAspectJobManager::idealThreadCount();
 
-        const int singleRenderViewJobCount = 8 + 1 * Qt3DCore::QAspectJobManager::idealThreadCount();
+        const int singleRenderViewJobCount = 8 + 1 * Qt3DCore::QAspectJobManager::idealThreadCount()
+                + int(Qt3DRender::Render::FrustumCullingJob().chunkJobs().size());
         // RenderViewBuilder renderViewJob,
         //                   syncRenderViewInitializationJob,
         //                   syncFrustumCullingJob,
         //                   filterProximityJob,
         //                   setClearDrawBufferIndexJob,
         //                   frustumCullingJob,
+        //                   m * (FrustumCullingChunkJobs) (where m depends on the numbers of available threads)
         //                   syncRenderCommandUpdateJob,
         //                   syncRenderViewCommandPostUpdateJob
         //                   n * (RenderViewCommandBuildJobs)
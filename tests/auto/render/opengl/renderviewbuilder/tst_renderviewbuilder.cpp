@@ -266,7 +266,8 @@ private Q_SLOTS:
 
             QCOMPARE(renderViewBuilder.renderViewCommandUpdaterJobs().size(), Qt3DCore::QAspectJobManager::idealThreadCount());
             QCOMPARE(renderViewBuilder.materialGathererJobs().size(), 0);
-            QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 8 + 1 * Qt3DCore::QAspectJobManager::idealThreadCount());
+            QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 8 + 1 * Qt3DCore::QAspectJobManager::idealThreadCount()
+                     + renderViewBuilder.frustumCullingJob()->chunkJobs().size());
         }
 
         {
@@ -282,7 +283,8 @@ private Q_SLOTS:
             QVERIFY(!renderViewBuilder.syncFilterEntityByLayerJob().isNull());
 
             // mark jobs dirty and recheck
-            QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 10 + renderViewBuilder.optimalJobCount());
+            QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 10 + renderViewBuilder.optimalJobCount()
+                     + renderViewBuilder.frustumCullingJob()->chunkJobs().size());
         }
 
         {
@@ -300,10 +302,54 @@ private Q_SLOTS:
             QVERIFY(!renderViewBuilder.syncMaterialGathererJob().isNull());
 
             // mark jobs dirty and recheck
-            QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 13);
+            QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 13 + renderViewBuilder.frustumCullingJob()->chunkJobs().size());
         }
     }
 
+    void checkJobsAreKeptAcrossFrames()
+    {
+        // GIVEN
+        Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+        Qt3DRender::QClearBuffers *clearBuffer = new Qt3DRender::QClearBuffers(viewport);
+        Qt3DRender::TestAspect testAspect(buildSimpleScene(viewport));
+        Qt3DRender::Render::FrameGraphNode *leafNode = testAspect.nodeManagers()->frameGraphManager()->lookupNode(clearBuffer->id());
+        QVERIFY(leafNode != nullptr);
+
+        Qt3DRender::Render::OpenGL::RenderViewBuilder renderViewBuilder(leafNode, 0, testAspect.renderer());
+        renderViewBuilder.setOptimalJobCount(2);
+        renderViewBuilder.setLayerCacheNeedsToBeRebuilt(true);
+        renderViewBuilder.setMaterialGathererCacheNeedsToBeRebuilt(true);
+        renderViewBuilder.setRenderCommandCacheNeedsToBeRebuilt(true);
+        renderViewBuilder.prepareJobs();
+        renderViewBuilder.buildJobHierachy();
+
+        // WHEN -> nothing needs to be rebuilt in the next frames
+        renderViewBuilder.setLayerCacheNeedsToBeRebuilt(false);
+        renderViewBuilder.setMaterialGathererCacheNeedsToBeRebuilt(false);
+        renderViewBuilder.setRenderCommandCacheNeedsToBeRebuilt(false);
+        renderViewBuilder.prepareJobs();
+        const std::vector<Qt3DCore::QAspectJobPtr> firstJobs = renderViewBuilder.buildJobHierachy();
+        std::vector<size_t> firstDependencyCounts;
+        for (const Qt3DCore::QAspectJobPtr &job : firstJobs)
+            firstDependencyCounts.push_back(job->dependencies().size());
+
+        renderViewBuilder.prepareJobs();
+        const std::vector<Qt3DCore::QAspectJobPtr> secondJobs = renderViewBuilder.buildJobHierachy();
+
+        // THEN -> same jobs, no dependencies upon the released jobs nor duplicates
+        QVERIFY(renderViewBuilder.filterEntityByLayerJob().isNull());
+        QCOMPARE(renderViewBuilder.materialGathererJobs().size(), 0);
+        QCOMPARE(renderViewBuilder.renderViewCommandBuilderJobs().size(), 0);
+        QCOMPARE(secondJobs.size(), firstJobs.size());
+        for (size_t i = 0, m = firstJobs.size(); i < m; ++i) {
+            QCOMPARE(secondJobs[i].data(), firstJobs[i].data());
+            QCOMPARE(secondJobs[i]->dependencies().size(), firstDependencyCounts[i]);
+            for (const auto &dependency : secondJobs[i]->dependencies())
+                QVERIFY(!dependency.isNull());
+        }
+        QCOMPARE(renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies().size(), 7);
+    }
+
     void checkCheckJobDependencies()
     {
         // GIVEN
@@ -353,9 +399,17 @@ private Q_SLOTS:
             QVERIFY(containsDependency(renderViewBuilder.syncPreFrustumCullingJob()->dependencies(), testAspect.renderer()->updateShaderDataTransformJob()));
 
             // Step 4
-            QCOMPARE(renderViewBuilder.frustumCullingJob()->dependencies().size(), 2);
+            const std::vector<Qt3DCore::QAspectJobPtr> &frustumCullingChunkJobs = renderViewBuilder.frustumCullingJob()->chunkJobs();
+            QCOMPARE(renderViewBuilder.frustumCullingJob()->dependencies().size(), 2 + qMax<size_t>(frustumCullingChunkJobs.size(), 1) - 1);
             QVERIFY(containsDependency(renderViewBuilder.frustumCullingJob()->dependencies(), renderViewBuilder.syncPreFrustumCullingJob()));
             QVERIFY(containsDependency(renderViewBuilder.frustumCullingJob()->dependencies(), expandBVJob));
+            if (!frustumCullingChunkJobs.empty()) {
+                QCOMPARE(frustumCullingChunkJobs.front()->dependencies().size(), 2);
+                QVERIFY(containsDependency(frustumCullingChunkJobs.front()->dependencies(), renderViewBuilder.syncPreFrustumCullingJob()));
+                QVERIFY(containsDependency(frustumCullingChunkJobs.front()->dependencies(), expandBVJob));
+                for (size_t i = 1; i < frustumCullingChunkJobs.size(); ++i)
+                    QVERIFY(containsDependency(renderViewBuilder.frustumCullingJob()->dependencies(), frustumCullingChunkJobs[i]));
+            }
 
             QCOMPARE(renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies().size(), renderViewBuilder.materialGathererJobs().size() + 7);
             QVERIFY(containsDependency(renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies(), renderViewBuilder.syncRenderViewPostInitializationJob()));
@@ -426,9 +480,17 @@ private Q_SLOTS:
             }
 
             // Step 4
-            QCOMPARE(renderViewBuilder.frustumCullingJob()->dependencies().size(), 2);
+            const std::vector<Qt3DCore::QAspectJobPtr> &frustumCullingChunkJobs = renderViewBuilder.frustumCullingJob()->chunkJobs();
+            QCOMPARE(renderViewBuilder.frustumCullingJob()->dependencies().size(), 2 + qMax<size_t>(frustumCullingChunkJobs.size(), 1) - 1);
             QVERIFY(containsDependency(renderViewBuilder.frustumCullingJob()->dependencies(), renderViewBuilder.syncPreFrustumCullingJob()));
             QVERIFY(containsDependency(renderViewBuilder.frustumCullingJob()->dependencies(), expandBVJob));
+            if (!frustumCullingChunkJobs.empty()) {
+                QCOMPARE(frustumCullingChunkJobs.front()->dependencies().size(), 2);
+                QVERIFY(containsDependency(frustumCullingChunkJobs.front()->dependencies(), renderViewBuilder.syncPreFrustumCullingJob()));
+                QVERIFY(containsDependency(frustumCullingChunkJobs.front()->dependencies(), expandBVJob));
+                for (size_t i = 1; i < frustumCullingChunkJobs.size(); ++i)
+                    QVERIFY(containsDependency(renderViewBuilder.frustumCullingJob()->dependencies(), frustumCullingChunkJobs[i]));
+            }
 
             QVERIFY(containsDependency(renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies(), renderViewBuilder.syncRenderViewPostInitializationJob()));
             QVERIFY(containsDependency(renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies(), renderViewBuilder.syncFilterEntityByLayerJob()));
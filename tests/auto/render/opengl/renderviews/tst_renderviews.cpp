@@ -28,6 +28,15 @@
 
 #include <QtTest/QTest>
 #include <qbackendnodetester.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DRender/qparameter.h>
+#include <Qt3DRender/qshaderdata.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/parameter_p.h>
+#include <Qt3DRender/private/shaderdata_p.h>
+#include <Qt3DRender/private/stringtoint_p.h>
 #include <private/memorybarrier_p.h>
 #include <testarbiter.h>
 #include <testrenderer.h>
@@ -38,6 +47,8 @@
 #include <rendercommand_p.h>
 #include <renderer_p.h>
 #include <glresourcemanagers_p.h>
+#include <glshader_p.h>
+#include <shadervariables_p.h>
 #include <private/shader_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -526,6 +537,68 @@ private Q_SLOTS:
         renderer.shutdown();
     }
 
+    void checkRenderCommandLargeCombinedSorting()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Renderer renderer;
+        RenderView renderView;
+        std::vector<RenderCommand> rawCommands;
+
+        renderer.setNodeManagers(&nodeManagers);
+        renderView.setRenderer(&renderer);
+
+        GLShader *dnas[3] = {
+            reinterpret_cast<GLShader *>(0x250),
+            reinterpret_cast<GLShader *>(0x500),
+            reinterpret_cast<GLShader *>(0x1000)
+        };
+
+        // Large enough for the sort to be split over several threads
+        const int commandCount = 100000;
+        rawCommands.reserve(commandCount);
+        for (int i = 0; i < commandCount; ++i) {
+            RenderCommand c;
+            c.m_glShader = dnas[(i * 7) % 3];
+            c.m_depth = float((i * 7919) % 1000) - 500.0f;
+            c.m_changeCost = (i * 31) % 4;
+            rawCommands.push_back(c);
+        }
+
+        // WHEN
+        renderView.addSortType(QList<QSortPolicy::SortType>
+                               { QSortPolicy::StateChangeCost,
+                                 QSortPolicy::Material,
+                                 QSortPolicy::FrontToBack });
+
+        EntityRenderCommandDataViewPtr view = EntityRenderCommandDataViewPtr::create();
+        view->data.commands = rawCommands;
+        view->indices.resize(rawCommands.size());
+        std::iota(view->indices.begin(), view->indices.end(), 0);
+
+        renderView.setRenderCommandDataView(view);
+
+        renderView.sort();
+
+        // THEN
+        std::vector<size_t> expectedIndices(rawCommands.size());
+        std::iota(expectedIndices.begin(), expectedIndices.end(), 0);
+        std::stable_sort(expectedIndices.begin(), expectedIndices.end(),
+                         [&rawCommands] (size_t iA, size_t iB) {
+            const RenderCommand &a = rawCommands[iA];
+            const RenderCommand &b = rawCommands[iB];
+            if (a.m_changeCost != b.m_changeCost)
+                return a.m_changeCost > b.m_changeCost;
+            if (a.m_glShader != b.m_glShader)
+                return a.m_glShader > b.m_glShader;
+            return a.m_depth < b.m_depth;
+        });
+        QVERIFY(view->indices == expectedIndices);
+
+        // RenderCommands are deleted by RenderView dtor
+        renderer.shutdown();
+    }
+
     void checkRenderCommandTextureSorting()
     {
         // GIVEN
@@ -608,6 +681,169 @@ private Q_SLOTS:
         QCOMPARE(sortedCommands.at(sortedCommandIndices[6]), b);
         // RenderCommands are deleted by RenderView dtor
     }
+
+    void checkRenderCommandUpdates()
+    {
+        // GIVEN
+        Entity entity;
+        EntityRenderCommandDataViewPtr view = EntityRenderCommandDataViewPtr::create();
+        view->data.push_back(&entity, RenderCommand(), RenderPassParameterData());
+        view->data.push_back(&entity, RenderCommand(), RenderPassParameterData());
+        view->indices = { 0, 1 };
+
+        std::vector<RenderCommandUpdate> updates;
+        const auto collectUpdates = [&updates] (const Entity *, const RenderPassParameterData &,
+                                                RenderCommand &, RenderCommandUpdate update) {
+            updates.push_back(update);
+        };
+        const auto updateCommands = [&] (size_t offset, size_t count) {
+            updates.clear();
+            const EntityRenderCommandDataSubView subView = { view, offset, count };
+            subView.forEachUpdate(collectUpdates);
+            return updates;
+        };
+
+        // WHEN
+        // THEN -> New commands are fully updated
+        QVERIFY(updateCommands(0, 2) == (std::vector<RenderCommandUpdate> {
+                                             RenderCommandUpdate::Full,
+                                             RenderCommandUpdate::Full }));
+
+        // WHEN
+        // THEN -> Nothing changed
+        QVERIFY(updateCommands(0, 2) == (std::vector<RenderCommandUpdate> {
+                                             RenderCommandUpdate::Frame,
+                                             RenderCommandUpdate::Frame }));
+
+        // WHEN
+        ++view->cameraRevision;
+
+        // THEN
+        QVERIFY(updateCommands(0, 2) == (std::vector<RenderCommandUpdate> {
+                                             RenderCommandUpdate::Camera,
+                                             RenderCommandUpdate::Camera }));
+
+        // WHEN
+        ++view->cameraRevision;
+        entity.markWorldTransformChanged();
+
+        // THEN -> Transform changes take precedence
+        QVERIFY(updateCommands(0, 2) == (std::vector<RenderCommandUpdate> {
+                                             RenderCommandUpdate::Full,
+                                             RenderCommandUpdate::Full }));
+
+        // WHEN -> Second command filtered out for a frame
+        ++view->uniformsRevision;
+        updateCommands(0, 1);
+
+        // THEN -> It's still updated once selected again
+        QVERIFY(updateCommands(0, 2) == (std::vector<RenderCommandUpdate> {
+                                             RenderCommandUpdate::Frame,
+                                             RenderCommandUpdate::Full }));
+    }
+
+    void checkCameraUpdateRefreshesEyeSpaceShaderData()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Renderer renderer;
+        RenderView renderView;
+
+        renderer.setNodeManagers(&nodeManagers);
+        renderView.setRenderer(&renderer);
+
+        Qt3DCore::QEntity frontendEntity;
+        Entity *entity = nodeManagers.renderNodesManager()->getOrCreateResource(frontendEntity.id());
+        entity->setNodeManagers(&nodeManagers);
+        entity->setRenderer(&renderer);
+        simulateInitializationSync(&frontendEntity, entity);
+
+        const QVector3D position(1.0f, 2.0f, 3.0f);
+        Qt3DRender::QShaderData eyeShaderData;
+        eyeShaderData.setProperty("position", position);
+        eyeShaderData.setProperty("positionTransformed", ShaderData::ModelToEye);
+        Qt3DRender::QShaderData worldShaderData;
+        worldShaderData.setProperty("position", position);
+        worldShaderData.setProperty("positionTransformed", ShaderData::ModelToWorld);
+        Qt3DRender::QParameter eyeParameter(QStringLiteral("eyeBlock"),
+                                            QVariant::fromValue<Qt3DCore::QNode *>(&eyeShaderData));
+        Qt3DRender::QParameter worldParameter(QStringLiteral("worldBlock"),
+                                              QVariant::fromValue<Qt3DCore::QNode *>(&worldShaderData));
+
+        for (Qt3DRender::QShaderData *frontend : { &eyeShaderData, &worldShaderData }) {
+            ShaderData *backend = nodeManagers.shaderDataManager()->getOrCreateResource(frontend->id());
+            backend->setManagers(&nodeManagers);
+            backend->setRenderer(&renderer);
+            simulateInitializationSync(frontend, backend);
+        }
+        for (Qt3DRender::QParameter *frontend : { &eyeParameter, &worldParameter }) {
+            Parameter *backend = nodeManagers.parameterManager()->getOrCreateResource(frontend->id());
+            backend->setRenderer(&renderer);
+            simulateInitializationSync(frontend, backend);
+        }
+
+        GLShader shader;
+        std::vector<ShaderUniform> uniforms(2);
+        uniforms[0].m_name = QStringLiteral("eyeBlock.position");
+        uniforms[1].m_name = QStringLiteral("worldBlock.position");
+        shader.initializeUniforms(uniforms);
+        std::vector<ShaderAttribute> attributes(1);
+        attributes[0].m_name = QStringLiteral("vertexPosition");
+        shader.initializeAttributes(attributes);
+        shader.setLoaded(true);
+
+        RenderPassParameterData eyePassData { nullptr, {} };
+        addParametersForIds(&eyePassData.parameterInfo, nodeManagers.parameterManager(), { eyeParameter.id() });
+        RenderPassParameterData worldPassData { nullptr, {} };
+        addParametersForIds(&worldPassData.parameterInfo, nodeManagers.parameterManager(), { worldParameter.id() });
+
+        RenderCommand command;
+        command.m_glShader = &shader;
+        EntityRenderCommandDataViewPtr view = EntityRenderCommandDataViewPtr::create();
+        view->data.push_back(entity, command, eyePassData);
+        view->data.push_back(entity, command, worldPassData);
+        view->indices = { 0, 1 };
+
+        const int eyePositionId = StringToInt::lookupId(QStringLiteral("eyeBlock.position"));
+        const int worldPositionId = StringToInt::lookupId(QStringLiteral("worldBlock.position"));
+        const auto eyePosition = [&] { return view->data.commands[0].m_parameterPack.uniforms().value(eyePositionId); };
+        const auto worldPosition = [&] { return view->data.commands[1].m_parameterPack.uniforms().value(worldPositionId); };
+
+        Matrix4x4 viewMatrix1;
+        Matrix4x4 viewMatrix2;
+        {
+            QMatrix4x4 m;
+            m.translate(0.0f, 0.0f, -10.0f);
+            viewMatrix1 = Matrix4x4(m);
+            m.rotate(90.0f, 0.0f, 1.0f, 0.0f);
+            viewMatrix2 = Matrix4x4(m);
+        }
+
+        // WHEN
+        renderView.setViewMatrix(viewMatrix1);
+        renderView.updateRenderCommand({ view, 0, 2 });
+
+        // THEN
+        QCOMPARE(eyePosition(), UniformValue(viewMatrix1 * Vector3D(position)));
+        QCOMPARE(worldPosition(), UniformValue(Vector3D(position)));
+        QVERIFY(parametersDependOnViewMatrix(&nodeManagers, eyePassData.parameterInfo));
+        QVERIFY(!parametersDependOnViewMatrix(&nodeManagers, worldPassData.parameterInfo));
+
+        // WHEN -> Only the camera moves, as done by SyncRenderViewPreCommandUpdate
+        renderView.setViewMatrix(viewMatrix2);
+        ++view->cameraRevision;
+        for (size_t idx : view->indices) {
+            if (parametersDependOnViewMatrix(&nodeManagers, view->data.passesData[idx].parameterInfo))
+                view->requestFullUpdate(idx);
+        }
+        renderView.updateRenderCommand({ view, 0, 2 });
+
+        // THEN
+        QCOMPARE(eyePosition(), UniformValue(viewMatrix2 * Vector3D(position)));
+        QCOMPARE(worldPosition(), UniformValue(Vector3D(position)));
+
+        renderer.shutdown();
+    }
 private:
 };
 
@@ -0,0 +1,230 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DRender/private/uniform_p.h>
+#include <shaderparameterpack_p.h>
+#include <glshader_p.h>
+#include <shadervariables_p.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<bool> countAllocations(false);
+std::atomic<int> allocationCount(0);
+
+// Counts the heap allocations made while alive
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+    {
+        allocationCount = 0;
+        countAllocations = true;
+    }
+
+    ~AllocationCounter()
+    {
+        countAllocations = false;
+    }
+
+    int count() const
+    {
+        return allocationCount;
+    }
+};
+
+} // anonymous
+
+void *operator new(std::size_t size)
+{
+    if (countAllocations)
+        ++allocationCount;
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace Qt3DRender::Render;
+using namespace Qt3DRender::Render::OpenGL;
+
+class tst_ShaderParameterPack : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkScalarUniformValuesDontAllocate()
+    {
+        // GIVEN
+        QMatrix4x4 qm;
+        qm.translate(1.0f, 2.0f, 3.0f);
+        const Matrix4x4 m(qm);
+        int allocations = 0;
+
+        {
+            // WHEN
+            AllocationCounter counter;
+
+            UniformValue i(883);
+            UniformValue f(454.0f);
+            UniformValue v3(Vector3D(1.0f, 2.0f, 3.0f));
+            UniformValue v4(Vector4D(1.0f, 2.0f, 3.0f, 4.0f));
+            UniformValue m3(QMatrix3x3{});
+            UniformValue m4(m);
+
+            UniformValue copy(m4);
+            copy = v4;
+            copy = m3;
+            UniformValue moved(std::move(copy));
+            moved = std::move(m4);
+            moved = i;
+            moved = f;
+            moved = v3;
+
+            allocations = counter.count();
+        }
+
+        // THEN
+        QCOMPARE(allocations, 0);
+    }
+
+    void checkArrayUniformValueReusesStorage()
+    {
+        // GIVEN
+        const QVector<QMatrix4x4> matrices(32);
+        const UniformValue source(matrices);
+        UniformValue target(matrices);
+        int allocations = 0;
+
+        {
+            // WHEN
+            AllocationCounter counter;
+
+            target = source;
+            target = UniformValue(1.0f);
+            target = source;
+
+            allocations = counter.count();
+        }
+
+        // THEN
+        QCOMPARE(allocations, 0);
+        QVERIFY(target == source);
+    }
+
+    void checkSteadyStateUniformUpdatesDontAllocate()
+    {
+        // GIVEN
+        GLShader shader;
+        std::vector<ShaderUniform> uniformDescriptions;
+        for (int i = 0; i < 30; ++i) {
+            ShaderUniform u;
+            u.m_name = QString::number(i);
+            uniformDescriptions.push_back(u);
+        }
+        shader.initializeUniforms(uniformDescriptions);
+
+        std::vector<int> nameIds;
+        for (const ShaderUniform &u : shader.uniforms())
+            nameIds.push_back(u.m_nameId);
+
+        const auto updateUniforms = [&] (ShaderParameterPack &pack, float t) {
+            QMatrix4x4 qm;
+            qm.translate(t, t, t);
+            const Matrix4x4 m(qm);
+            for (size_t i = 0; i < nameIds.size(); ++i) {
+                switch (i % 3) {
+                case 0:
+                    pack.setUniform(nameIds[i], UniformValue(m));
+                    break;
+                case 1:
+                    pack.setUniform(nameIds[i], UniformValue(Vector3D(t, 0.0f, 1.0f)));
+                    break;
+                default:
+                    pack.setUniform(nameIds[i], UniformValue(t));
+                    break;
+                }
+            }
+            shader.prepareUniforms(pack);
+        };
+
+        // First frame fills the pack
+        ShaderParameterPack pack;
+        pack.reserve(shader.parameterPackSize());
+        updateUniforms(pack, 0.0f);
+        const size_t submissionUniformCount = pack.submissionUniformIndices().size();
+
+        int allocations = 0;
+        {
+            // WHEN
+            AllocationCounter counter;
+
+            for (int frame = 1; frame < 10; ++frame)
+                updateUniforms(pack, float(frame));
+
+            allocations = counter.count();
+        }
+
+        // THEN
+        QCOMPARE(allocations, 0);
+        QCOMPARE(pack.uniforms().size(), nameIds.size());
+        QCOMPARE(pack.submissionUniformIndices().size(), submissionUniformCount);
+        QCOMPARE(pack.uniform(nameIds[2]).constData<float>()[0], 9.0f);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_ShaderParameterPack)
+
+#include "tst_shaderparameterpack.moc"
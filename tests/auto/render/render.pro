@@ -26,6 +26,7 @@ qtConfig(private_tests) {
         loadscenejob \
         material \
         memorybarrier \
+        meshcache \
         meshfunctors \
         objectpicker \
         parameter \
@@ -102,6 +103,7 @@ qtConfig(private_tests) {
         transform \
         trianglevisitor \
         uniform \
+        updateworldtransformjob \
         vsyncframeadvanceservice \
         waitfence
 
@@ -514,6 +514,68 @@ private Q_SLOTS:
         renderer.shutdown();
     }
 
+    void checkRenderCommandLargeCombinedSorting()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Renderer renderer;
+        RenderView renderView;
+        std::vector<RenderCommand> rawCommands;
+
+        renderer.setNodeManagers(&nodeManagers);
+        renderView.setRenderer(&renderer);
+
+        RHIShader *dnas[3] = {
+            reinterpret_cast<RHIShader *>(0x250),
+            reinterpret_cast<RHIShader *>(0x500),
+            reinterpret_cast<RHIShader *>(0x1000)
+        };
+
+        // Large enough for the sort to be split over several threads
+        const int commandCount = 100000;
+        rawCommands.reserve(commandCount);
+        for (int i = 0; i < commandCount; ++i) {
+            RenderCommand c;
+            c.m_rhiShader = dnas[(i * 7) % 3];
+            c.m_depth = float((i * 7919) % 1000) - 500.0f;
+            c.m_changeCost = (i * 31) % 4;
+            rawCommands.push_back(c);
+        }
+
+        // WHEN
+        renderView.addSortType(QList<QSortPolicy::SortType>
+                               { QSortPolicy::StateChangeCost,
+                                 QSortPolicy::Material,
+                                 QSortPolicy::FrontToBack });
+
+        EntityRenderCommandDataViewPtr view = EntityRenderCommandDataViewPtr::create();
+        view->data.commands = rawCommands;
+        view->indices.resize(rawCommands.size());
+        std::iota(view->indices.begin(), view->indices.end(), 0);
+
+        renderView.setRenderCommandDataView(view);
+
+        renderView.sort();
+
+        // THEN
+        std::vector<size_t> expectedIndices(rawCommands.size());
+        std::iota(expectedIndices.begin(), expectedIndices.end(), 0);
+        std::stable_sort(expectedIndices.begin(), expectedIndices.end(),
+                         [&rawCommands] (size_t iA, size_t iB) {
+            const RenderCommand &a = rawCommands[iA];
+            const RenderCommand &b = rawCommands[iB];
+            if (a.m_changeCost != b.m_changeCost)
+                return a.m_changeCost > b.m_changeCost;
+            if (a.m_rhiShader != b.m_rhiShader)
+                return a.m_rhiShader > b.m_rhiShader;
+            return a.m_depth < b.m_depth;
+        });
+        QVERIFY(view->indices == expectedIndices);
+
+        // RenderCommands are deleted by RenderView dtor
+        renderer.shutdown();
+    }
+
     void checkRenderCommandTextureSorting()
     {
         // GIVEN
@@ -198,6 +198,57 @@ private Q_SLOTS:
         joint->setName(name);
         QTest::newRow("inverseBind") << m << localPose << name << joint;
     }
+
+    void checkSkinningPalette()
+    {
+        // GIVEN
+        Skeleton backendSkeleton;
+
+        Qt3DCore::Sqt rootPose;
+        rootPose.translation = QVector3D(1.0f, 2.0f, 3.0f);
+        rootPose.rotation = QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 30.0f);
+        Qt3DCore::Sqt childPose;
+        childPose.translation = QVector3D(0.0f, 4.0f, 0.0f);
+        childPose.rotation = QQuaternion::fromAxisAndAngle(1.0f, 0.0f, 1.0f, 45.0f);
+        childPose.scale = QVector3D(1.5f, 2.0f, 0.5f);
+
+        JointInfo rootJoint;
+        rootJoint.inverseBindPose.translate(-1.0f, -2.0f, -3.0f);
+        JointInfo childJoint;
+        childJoint.parentIndex = 0;
+        childJoint.inverseBindPose.translate(-1.0f, -6.0f, -3.0f);
+
+        SkeletonData data;
+        data.joints = { rootJoint, childJoint };
+        data.localPoses = { rootPose, childPose };
+
+        // WHEN
+        backendSkeleton.setSkeletonData(data);
+
+        // THEN
+        QVERIFY(backendSkeleton.isSkinningPaletteDirty());
+        QCOMPARE(backendSkeleton.skinningPalette().byteSize(), int(2 * 16 * sizeof(float)));
+
+        // WHEN
+        const uint revision = backendSkeleton.skinningPaletteRevision();
+        backendSkeleton.updateSkinningPalette();
+
+        // THEN
+        QVERIFY(!backendSkeleton.isSkinningPaletteDirty());
+        QCOMPARE(backendSkeleton.skinningPaletteRevision(), revision + 1);
+
+        const QMatrix4x4 rootGlobalPose = rootPose.toMatrix();
+        const QMatrix4x4 childGlobalPose = rootGlobalPose * childPose.toMatrix();
+        const QMatrix4x4 expected[] = {
+            rootGlobalPose * rootJoint.inverseBindPose,
+            childGlobalPose * childJoint.inverseBindPose
+        };
+        const float *palette = backendSkeleton.skinningPalette().constData<float>();
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 16; ++j)
+                QVERIFY(qAbs(palette[16 * i + j] - expected[i].constData()[j]) < 1e-5f);
+        }
+    }
 };
 
 QTEST_APPLESS_MAIN(tst_Skeleton)
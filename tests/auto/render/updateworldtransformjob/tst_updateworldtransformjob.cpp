@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/transform_p.h>
+#include <Qt3DRender/private/updateworldtransformjob_p.h>
+
+#include "testaspect.h"
+
+namespace {
+
+void runUpdateWorldTransformJob(Qt3DRender::TestAspect *aspect, Qt3DCore::QEntity *root)
+{
+    Qt3DRender::Render::UpdateWorldTransformJob updateWorldTransform;
+    updateWorldTransform.setRoot(aspect->nodeManagers()->renderNodesManager()->lookupResource(root->id()));
+    updateWorldTransform.setManagers(aspect->nodeManagers());
+    updateWorldTransform.run();
+}
+
+QMatrix4x4 worldMatrix(Qt3DRender::TestAspect *aspect, Qt3DCore::QEntity *entity)
+{
+    Qt3DRender::Render::Entity *backendEntity = aspect->nodeManagers()->renderNodesManager()->lookupResource(entity->id());
+    return convertToQMatrix4x4(*backendEntity->worldTransform());
+}
+
+void syncEntity(Qt3DRender::TestAspect *aspect, Qt3DCore::QEntity *entity)
+{
+    aspect->nodeManagers()->renderNodesManager()->lookupResource(entity->id())->syncFromFrontEnd(entity, false);
+}
+
+void syncTransform(Qt3DRender::TestAspect *aspect, Qt3DCore::QTransform *transform)
+{
+    aspect->nodeManagers()->transformManager()->lookupResource(transform->id())->syncFromFrontEnd(transform, false);
+}
+
+} // anonymous
+
+class tst_UpdateWorldTransformJob : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkSharedTransform()
+    {
+        // GIVEN
+        Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+        Qt3DCore::QTransform *sharedTransform = new Qt3DCore::QTransform(rootEntity);
+        sharedTransform->setTranslation(QVector3D(1.0f, 0.0f, 0.0f));
+        Qt3DCore::QEntity *childEntity1 = new Qt3DCore::QEntity(rootEntity);
+        childEntity1->addComponent(sharedTransform);
+        Qt3DCore::QEntity *childEntity2 = new Qt3DCore::QEntity(rootEntity);
+        childEntity2->addComponent(sharedTransform);
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(rootEntity));
+
+        // WHEN
+        runUpdateWorldTransformJob(aspect.data(), rootEntity);
+
+        // THEN
+        QCOMPARE(worldMatrix(aspect.data(), childEntity1), sharedTransform->matrix());
+        QCOMPARE(worldMatrix(aspect.data(), childEntity2), sharedTransform->matrix());
+
+        // WHEN
+        sharedTransform->setTranslation(QVector3D(2.0f, 0.0f, 0.0f));
+        syncTransform(aspect.data(), sharedTransform);
+        runUpdateWorldTransformJob(aspect.data(), rootEntity);
+
+        // THEN
+        QCOMPARE(worldMatrix(aspect.data(), childEntity1), sharedTransform->matrix());
+        QCOMPARE(worldMatrix(aspect.data(), childEntity2), sharedTransform->matrix());
+    }
+
+    void checkSharedTransformChangedWhileDisabled()
+    {
+        // GIVEN
+        Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+        Qt3DCore::QTransform *sharedTransform = new Qt3DCore::QTransform(rootEntity);
+        sharedTransform->setTranslation(QVector3D(1.0f, 0.0f, 0.0f));
+        Qt3DCore::QEntity *enabledEntity = new Qt3DCore::QEntity(rootEntity);
+        enabledEntity->addComponent(sharedTransform);
+        Qt3DCore::QEntity *disabledParentEntity = new Qt3DCore::QEntity(rootEntity);
+        Qt3DCore::QEntity *disabledEntity = new Qt3DCore::QEntity(disabledParentEntity);
+        disabledEntity->addComponent(sharedTransform);
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(rootEntity));
+        runUpdateWorldTransformJob(aspect.data(), rootEntity);
+
+        // THEN
+        const QMatrix4x4 initialMatrix = sharedTransform->matrix();
+        QCOMPARE(worldMatrix(aspect.data(), enabledEntity), initialMatrix);
+        QCOMPARE(worldMatrix(aspect.data(), disabledEntity), initialMatrix);
+
+        // WHEN
+        disabledParentEntity->setEnabled(false);
+        syncEntity(aspect.data(), disabledParentEntity);
+        sharedTransform->setTranslation(QVector3D(2.0f, 0.0f, 0.0f));
+        syncTransform(aspect.data(), sharedTransform);
+        runUpdateWorldTransformJob(aspect.data(), rootEntity);
+
+        // THEN -> disabled subtrees are not updated
+        QCOMPARE(worldMatrix(aspect.data(), enabledEntity), sharedTransform->matrix());
+        QCOMPARE(worldMatrix(aspect.data(), disabledEntity), initialMatrix);
+
+        // WHEN
+        disabledParentEntity->setEnabled(true);
+        syncEntity(aspect.data(), disabledParentEntity);
+        runUpdateWorldTransformJob(aspect.data(), rootEntity);
+
+        // THEN
+        QCOMPARE(worldMatrix(aspect.data(), enabledEntity), sharedTransform->matrix());
+        QCOMPARE(worldMatrix(aspect.data(), disabledEntity), sharedTransform->matrix());
+    }
+
+    void checkSubtreeJobs()
+    {
+        // GIVEN
+        Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+        Qt3DCore::QTransform *rootTransform = new Qt3DCore::QTransform(rootEntity);
+        rootTransform->setTranslation(QVector3D(0.0f, 1.0f, 0.0f));
+        rootEntity->addComponent(rootTransform);
+        QList<Qt3DCore::QEntity *> leafEntities;
+        for (int i = 0; i < 8; ++i) {
+            Qt3DCore::QEntity *childEntity = new Qt3DCore::QEntity(rootEntity);
+            Qt3DCore::QTransform *childTransform = new Qt3DCore::QTransform(childEntity);
+            childTransform->setTranslation(QVector3D(float(i), 0.0f, 0.0f));
+            childEntity->addComponent(childTransform);
+            for (int j = 0; j < 8; ++j) {
+                Qt3DCore::QEntity *leafEntity = new Qt3DCore::QEntity(childEntity);
+                Qt3DCore::QTransform *leafTransform = new Qt3DCore::QTransform(leafEntity);
+                leafTransform->setTranslation(QVector3D(0.0f, 0.0f, float(j)));
+                leafEntity->addComponent(leafTransform);
+                leafEntities.push_back(leafEntity);
+            }
+        }
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(rootEntity));
+        Qt3DRender::Render::UpdateWorldTransformJob updateWorldTransform;
+        updateWorldTransform.setRoot(aspect->nodeManagers()->renderNodesManager()->lookupResource(rootEntity->id()));
+        updateWorldTransform.setManagers(aspect->nodeManagers());
+
+        // WHEN -> the preparation job comes first and the job last
+        for (const Qt3DCore::QAspectJobPtr &job : updateWorldTransform.subtreeJobs())
+            job->run();
+        updateWorldTransform.run();
+
+        // THEN
+        for (int i = 0; i < leafEntities.size(); ++i) {
+            const QVector3D expectedTranslation(float(i / 8), 1.0f, float(i % 8));
+            QCOMPARE(worldMatrix(aspect.data(), leafEntities.at(i)).column(3).toVector3D(),
+                     expectedTranslation);
+        }
+    }
+};
+
+QTEST_MAIN(tst_UpdateWorldTransformJob)
+
+#include "tst_updateworldtransformjob.moc"
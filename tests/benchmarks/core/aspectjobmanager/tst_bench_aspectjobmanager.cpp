@@ -0,0 +1,201 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtGui/QMatrix4x4>
+#include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qthreadpooler_p.h>
+#include <Qt3DCore/private/task_p.h>
+
+namespace {
+
+class SyntheticJob : public Qt3DCore::QAspectJob
+{
+public:
+    explicit SyntheticJob(int workload)
+        : m_workload(workload)
+    {}
+
+    void run() override
+    {
+        QMatrix4x4 m;
+        for (int i = 0; i < m_workload; ++i)
+            m.rotate(1.0f, 0.0f, 1.0f, 0.0f);
+        m_result = m;
+    }
+
+private:
+    int m_workload;
+    QMatrix4x4 m_result;
+};
+
+enum GraphType {
+    Independent,
+    Chains,
+    Layered
+};
+
+// Builds roughly the shapes found in a Qt 3D frame: many independent jobs,
+// short chains of dependent jobs and layers of jobs joined by fences
+std::vector<Qt3DCore::QAspectJobPtr> buildGraph(GraphType type, int jobCount, int workload)
+{
+    std::vector<Qt3DCore::QAspectJobPtr> jobs;
+    jobs.reserve(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+        jobs.push_back(QSharedPointer<SyntheticJob>::create(workload));
+
+    switch (type) {
+    case Independent:
+        break;
+    case Chains:
+        for (int i = 0; i < jobCount; ++i) {
+            if (i % 4 != 0)
+                jobs[i]->addDependency(jobs[i - 1]);
+        }
+        break;
+    case Layered: {
+        const int layerSize = 20;
+        for (int i = layerSize; i < jobCount; ++i) {
+            const int previousLayer = (i / layerSize - 1) * layerSize;
+            jobs[i]->addDependency(jobs[previousLayer]);
+            jobs[i]->addDependency(jobs[previousLayer + (i % layerSize)]);
+        }
+        break;
+    }
+    }
+    return jobs;
+}
+
+// Replicates how the job manager used to drive the QThreadPooler
+int runWithThreadPooler(Qt3DCore::QThreadPooler *pooler,
+                        const std::vector<Qt3DCore::QAspectJobPtr> &jobQueue)
+{
+    QHash<Qt3DCore::QAspectJob *, Qt3DCore::AspectTaskRunnable *> tasksMap;
+    QList<Qt3DCore::RunnableInterface *> taskList;
+    taskList.reserve(int(jobQueue.size()));
+    for (const Qt3DCore::QAspectJobPtr &job : jobQueue) {
+        auto *task = new Qt3DCore::AspectTaskRunnable(nullptr);
+        task->m_job = job;
+        tasksMap.insert(job.data(), task);
+        taskList << task;
+    }
+
+    for (const Qt3DCore::QAspectJobPtr &job : jobQueue) {
+        Qt3DCore::AspectTaskRunnable *taskDepender = tasksMap.value(job.data());
+        for (const QWeakPointer<Qt3DCore::QAspectJob> &dep : job->dependencies()) {
+            Qt3DCore::AspectTaskRunnable *taskDependee = tasksMap.value(dep.toStrongRef().data());
+            if (taskDependee) {
+                taskDependee->m_dependers.append(taskDepender);
+                ++taskDepender->m_dependerCount;
+            }
+        }
+    }
+
+    pooler->mapDependables(taskList);
+    return pooler->waitForAllJobs();
+}
+
+} // anonymous
+
+class tst_AspectJobManager : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkThreadPooler_data();
+    void benchmarkThreadPooler();
+    void benchmarkWorkStealingExecutor_data();
+    void benchmarkWorkStealingExecutor();
+};
+
+static void addGraphRows()
+{
+    QTest::addColumn<int>("graphType");
+    QTest::addColumn<int>("jobCount");
+    QTest::addColumn<int>("workload");
+
+    QTest::newRow("400 independent empty jobs") << int(Independent) << 400 << 0;
+    QTest::newRow("400 independent small jobs") << int(Independent) << 400 << 50;
+    QTest::newRow("400 chained empty jobs") << int(Chains) << 400 << 0;
+    QTest::newRow("400 chained small jobs") << int(Chains) << 400 << 50;
+    QTest::newRow("400 layered empty jobs") << int(Layered) << 400 << 0;
+    QTest::newRow("400 layered small jobs") << int(Layered) << 400 << 50;
+    QTest::newRow("4000 layered small jobs") << int(Layered) << 4000 << 50;
+}
+
+void tst_AspectJobManager::benchmarkThreadPooler_data()
+{
+    addGraphRows();
+}
+
+void tst_AspectJobManager::benchmarkThreadPooler()
+{
+    QFETCH(int, graphType);
+    QFETCH(int, jobCount);
+    QFETCH(int, workload);
+
+    // GIVEN
+    Qt3DCore::QThreadPooler pooler;
+    const std::vector<Qt3DCore::QAspectJobPtr> jobs = buildGraph(GraphType(graphType), jobCount, workload);
+
+    // WHEN
+    QBENCHMARK {
+        const int ranJobs = runWithThreadPooler(&pooler, jobs);
+        Q_UNUSED(ranJobs);
+    }
+}
+
+void tst_AspectJobManager::benchmarkWorkStealingExecutor_data()
+{
+    addGraphRows();
+}
+
+void tst_AspectJobManager::benchmarkWorkStealingExecutor()
+{
+    QFETCH(int, graphType);
+    QFETCH(int, jobCount);
+    QFETCH(int, workload);
+
+    // GIVEN
+    Qt3DCore::QAspectJobManager jobManager;
+    const std::vector<Qt3DCore::QAspectJobPtr> jobs = buildGraph(GraphType(graphType), jobCount, workload);
+
+    // Warm up so that workers are spawned and tasks allocated
+    jobManager.enqueueJobs(jobs);
+    QCOMPARE(jobManager.waitForAllJobs(), jobCount);
+
+    // WHEN
+    QBENCHMARK {
+        jobManager.enqueueJobs(jobs);
+        jobManager.waitForAllJobs();
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_AspectJobManager)
+
+#include "tst_bench_aspectjobmanager.moc"
@@ -30,9 +30,11 @@
 #include <QMatrix4x4>
 #include <Qt3DCore/private/qhandle_p.h>
 #include <Qt3DCore/private/qresourcemanager_p.h>
+#include <Qt3DCore/qnodeid.h>
 #include <ctime>
 #include <cstdlib>
 #include <random>
+#include <thread>
 
 class tst_QResourceManager : public QObject
 {
@@ -44,12 +46,14 @@ private Q_SLOTS:
     void benchmarRandomAccessSmallResources();
     void benchmarkRandomLookupSmallResources();
     void benchmarkReleaseSmallResources();
+    void benchmarkConcurrentLookupSmallResources();
     void benchmarkAllocateBigResources();
     void benchmarkAccessBigResources();
     void benchmarRandomAccessBigResources();
     void benchmarkLookupBigResources();
     void benchmarkRandomLookupBigResources();
     void benchmarkReleaseBigResources();
+    void benchmarkConcurrentLookupBigResources();
 };
 
 class tst_SmallArrayResource
@@ -176,6 +180,40 @@ void benchmarkReleaseResources()
     }
 }
 
+template<typename Resource>
+void benchmarkConcurrentLookupResources()
+{
+    Qt3DCore::QResourceManager<Resource, Qt3DCore::QNodeId, Qt3DCore::ObjectLevelLockingPolicy> manager;
+    const int max = (1 << 16) - 1;
+    std::vector<Qt3DCore::QNodeId> ids(max);
+    for (int i = 0; i < max; i++) {
+        ids[i] = Qt3DCore::QNodeId::createId();
+        manager.getOrCreateResource(ids[i]);
+    }
+
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::shuffle(ids.begin(), ids.end(), g);
+
+    const int threadCount = qMax(2, QThread::idealThreadCount());
+    QBENCHMARK {
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (int t = 0; t < threadCount; t++) {
+            threads.emplace_back([&manager, &ids, t, threadCount] {
+                volatile Resource *c;
+                // Each thread walks the whole set, starting at a different offset
+                const int offset = (max / threadCount) * t;
+                for (int i = 0; i < max; i++)
+                    c = manager.lookupResource(ids[(i + offset) % max]);
+                Q_UNUSED(c);
+            });
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+}
+
 void tst_QResourceManager::benchmarkAllocateSmallResources()
 {
     benchmarkAllocateResources<tst_SmallArrayResource>();
@@ -206,6 +244,11 @@ void tst_QResourceManager::benchmarkReleaseSmallResources()
     benchmarkReleaseResources<tst_SmallArrayResource>();
 }
 
+void tst_QResourceManager::benchmarkConcurrentLookupSmallResources()
+{
+    benchmarkConcurrentLookupResources<tst_SmallArrayResource>();
+}
+
 void tst_QResourceManager::benchmarkAllocateBigResources()
 {
     benchmarkAllocateResources<tst_BigArrayResource>();
@@ -236,6 +279,11 @@ void tst_QResourceManager::benchmarkReleaseBigResources()
     benchmarkReleaseResources<tst_BigArrayResource>();
 }
 
+void tst_QResourceManager::benchmarkConcurrentLookupBigResources()
+{
+    benchmarkConcurrentLookupResources<tst_BigArrayResource>();
+}
+
 QTEST_APPLESS_MAIN(tst_QResourceManager)
 
 #include "tst_bench_qresourcesmanager.moc"
@@ -0,0 +1,355 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qnodevisitor_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/transform_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/flatentityhierarchy_p.h>
+#include <Qt3DRender/private/updateworldtransformjob_p.h>
+#include <Qt3DRender/private/updateworldboundingvolumejob_p.h>
+#include <Qt3DRender/private/expandboundingvolumejob_p.h>
+#include <Qt3DRender/qrenderaspect.h>
+#include <Qt3DRender/private/qrenderaspect_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+class TestAspect : public Qt3DRender::QRenderAspect
+{
+public:
+    TestAspect(Qt3DCore::QNode *root)
+        : Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Manual)
+        , m_jobManager(new Qt3DCore::QAspectJobManager())
+    {
+        Qt3DCore::QAbstractAspectPrivate::get(this)->m_jobManager = m_jobManager.data();
+        QRenderAspect::onRegistered();
+
+        QList<Qt3DCore::NodeTreeChange> nodes;
+        Qt3DCore::QNodeVisitor v;
+        v.traverse(root, [&nodes](Qt3DCore::QNode *node) {
+            Qt3DCore::QNodePrivate *d = Qt3DCore::QNodePrivate::get(node);
+            d->m_typeInfo = const_cast<QMetaObject*>(Qt3DCore::QNodePrivate::findStaticMetaObject(node->metaObject()));
+            d->m_hasBackendNode = true;
+            nodes.push_back({
+                node->id(),
+                Qt3DCore::QNodePrivate::get(node)->m_typeInfo,
+                Qt3DCore::NodeTreeChange::Added,
+                node
+            });
+        });
+
+        for (const auto &node: nodes)
+            d_func()->createBackendNode(node);
+    }
+
+    ~TestAspect()
+    {
+        QRenderAspect::onUnregistered();
+    }
+
+    Qt3DRender::Render::NodeManagers *nodeManagers() const
+    {
+        return d_func()->m_renderer->nodeManagers();
+    }
+
+    void onRegistered() { QRenderAspect::onRegistered(); }
+    void onUnregistered() { QRenderAspect::onUnregistered(); }
+
+private:
+    QScopedPointer<Qt3DCore::QAspectJobManager> m_jobManager;
+};
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+namespace {
+
+using namespace Qt3DRender::Render;
+
+const int ChildrenPerEntity = 8;
+const int SharedTransformCount = 16;
+
+// Builds a tree of entityCount entities, each having up to ChildrenPerEntity
+// children. Transforms are shared between entities to keep the memory usage
+// of the biggest scenes reasonable.
+Qt3DCore::QEntity *buildScene(int entityCount)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    QList<Qt3DCore::QTransform *> transforms;
+    for (int i = 0; i < SharedTransformCount; ++i) {
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform(root);
+        transform->setTranslation(QVector3D(float(i), float(i % 3), -float(i % 5)));
+        transform->setRotationY(float(i) * 10.0f);
+        transforms.push_back(transform);
+    }
+
+    QList<Qt3DCore::QEntity *> parents = { root };
+    int created = 1;
+    while (created < entityCount) {
+        QList<Qt3DCore::QEntity *> children;
+        for (Qt3DCore::QEntity *parent : qAsConst(parents)) {
+            for (int i = 0; i < ChildrenPerEntity && created < entityCount; ++i, ++created) {
+                Qt3DCore::QEntity *child = new Qt3DCore::QEntity(parent);
+                child->addComponent(transforms.at(created % SharedTransformCount));
+                children.push_back(child);
+            }
+        }
+        parents.swap(children);
+    }
+    return root;
+}
+
+// What the jobs did before the flat hierarchy existed: recursing over the
+// children handles, looking up each entity in the manager
+void referenceUpdateWorldTransforms(EntityManager *manager, Entity *node,
+                                    const Matrix4x4 &parentTransform, bool parentChanged)
+{
+    if (!node->isEnabled())
+        return;
+
+    Transform *nodeTransform = node->renderComponent<Transform>();
+    const bool transformDirty = nodeTransform != nullptr && nodeTransform->isTransformDirty();
+    Matrix4x4 *worldTransform = node->worldTransform();
+    bool changed = false;
+    if (parentChanged || transformDirty || node->isWorldTransformDirty()) {
+        Matrix4x4 newWorldTransform = parentTransform;
+        if (nodeTransform != nullptr && nodeTransform->isEnabled())
+            newWorldTransform = newWorldTransform * nodeTransform->transformMatrix();
+        changed = !(*worldTransform == newWorldTransform);
+        *worldTransform = newWorldTransform;
+    }
+
+    const auto &childrenHandles = node->childrenHandles();
+    for (const HEntity &handle : childrenHandles) {
+        Entity *child = manager->data(handle);
+        if (child)
+            referenceUpdateWorldTransforms(manager, child, *worldTransform, changed);
+    }
+}
+
+void referenceUpdateWorldBoundingVolumes(EntityManager *manager)
+{
+    const std::vector<HEntity> &handles = manager->activeHandles();
+    for (const HEntity &handle : handles) {
+        Entity *node = manager->data(handle);
+        if (!node->isEnabled())
+            continue;
+        *(node->worldBoundingVolume()) = node->localBoundingVolume()->transformed(*(node->worldTransform()));
+        *(node->worldBoundingVolumeWithChildren()) = *(node->worldBoundingVolume());
+    }
+}
+
+void referenceExpandWorldBoundingVolumes(EntityManager *manager, Entity *node)
+{
+    const auto &childrenHandles = node->childrenHandles();
+    for (const HEntity &handle : childrenHandles) {
+        Entity *c = manager->data(handle);
+        if (c && c->isEnabled())
+            referenceExpandWorldBoundingVolumes(manager, c);
+    }
+
+    Sphere *parentBoundingVolume = node->worldBoundingVolumeWithChildren();
+    for (const HEntity &handle : childrenHandles) {
+        Entity *c = manager->data(handle);
+        if (c && c->isEnabled())
+            parentBoundingVolume->expandToContain(*c->worldBoundingVolumeWithChildren());
+    }
+}
+
+} // anonymous
+
+class tst_BenchEntityHierarchy : public QObject
+{
+    Q_OBJECT
+private:
+    void addSceneRows()
+    {
+        QTest::addColumn<int>("entityCount");
+        QTest::addColumn<bool>("flat");
+
+        for (int entityCount : { 10000, 100000, 1000000 }) {
+            QTest::newRow(qPrintable(QStringLiteral("%1-Handles").arg(entityCount))) << entityCount << false;
+            QTest::newRow(qPrintable(QStringLiteral("%1-Flat").arg(entityCount))) << entityCount << true;
+        }
+    }
+
+    struct Scene
+    {
+        QScopedPointer<Qt3DCore::QEntity> root;
+        QScopedPointer<Qt3DRender::TestAspect> aspect;
+        NodeManagers *manager = nullptr;
+        Entity *backendRoot = nullptr;
+    };
+
+    void setUpScene(Scene &scene, int entityCount)
+    {
+        scene.root.reset(buildScene(entityCount));
+        scene.aspect.reset(new Qt3DRender::TestAspect(scene.root.data()));
+        scene.manager = scene.aspect->nodeManagers();
+        scene.backendRoot = scene.manager->renderNodesManager()->lookupResource(scene.root->id());
+
+        // Give every entity a non empty volume so that expanding has work to do
+        const std::vector<HEntity> &handles = scene.manager->renderNodesManager()->activeHandles();
+        for (const HEntity &handle : handles)
+            *scene.manager->renderNodesManager()->data(handle)->localBoundingVolume() = Sphere(Vector3D(0.0f, 0.0f, 0.0f), 1.0f);
+
+        runJobs(scene);
+    }
+
+    void runJobs(Scene &scene)
+    {
+        UpdateWorldTransformJob updateWorldTransform;
+        updateWorldTransform.setRoot(scene.backendRoot);
+        updateWorldTransform.setManagers(scene.manager);
+        updateWorldTransform.run();
+
+        UpdateWorldBoundingVolumeJob updateWorldBoundingVolume;
+        updateWorldBoundingVolume.setManager(scene.manager->renderNodesManager());
+        updateWorldBoundingVolume.run();
+
+        ExpandBoundingVolumeJob expandBoundingVolume;
+        expandBoundingVolume.setRoot(scene.backendRoot);
+        expandBoundingVolume.setManagers(scene.manager);
+        expandBoundingVolume.run();
+    }
+
+private Q_SLOTS:
+    void updateWorldTransforms_data()
+    {
+        addSceneRows();
+    }
+
+    void updateWorldTransforms()
+    {
+        QFETCH(int, entityCount);
+        QFETCH(bool, flat);
+
+        // GIVEN
+        Scene scene;
+        setUpScene(scene, entityCount);
+        EntityManager *entityManager = scene.manager->renderNodesManager();
+        QCOMPARE(int(entityManager->flatHierarchy()->size()), entityCount);
+
+        // WHEN
+        if (flat) {
+            UpdateWorldTransformJob job;
+            job.setRoot(scene.backendRoot);
+            job.setManagers(scene.manager);
+            QBENCHMARK {
+                job.run();
+            }
+        } else {
+            QBENCHMARK {
+                referenceUpdateWorldTransforms(entityManager, scene.backendRoot, Matrix4x4(), false);
+            }
+        }
+    }
+
+    void updateWorldBoundingVolumes_data()
+    {
+        addSceneRows();
+    }
+
+    void updateWorldBoundingVolumes()
+    {
+        QFETCH(int, entityCount);
+        QFETCH(bool, flat);
+
+        // GIVEN
+        Scene scene;
+        setUpScene(scene, entityCount);
+        EntityManager *entityManager = scene.manager->renderNodesManager();
+
+        // WHEN
+        if (flat) {
+            UpdateWorldBoundingVolumeJob job;
+            job.setManager(entityManager);
+            QVERIFY(entityManager->flatHierarchy()->isUpToDate(entityManager->hierarchyRevision()));
+            QBENCHMARK {
+                job.run();
+            }
+        } else {
+            QBENCHMARK {
+                referenceUpdateWorldBoundingVolumes(entityManager);
+            }
+        }
+    }
+
+    void expandBoundingVolumes_data()
+    {
+        addSceneRows();
+    }
+
+    void expandBoundingVolumes()
+    {
+        QFETCH(int, entityCount);
+        QFETCH(bool, flat);
+
+        // GIVEN
+        Scene scene;
+        setUpScene(scene, entityCount);
+        EntityManager *entityManager = scene.manager->renderNodesManager();
+
+        // THEN both paths agree on the volume of the whole scene
+        const Sphere flatSceneVolume = *scene.backendRoot->worldBoundingVolumeWithChildren();
+        referenceUpdateWorldBoundingVolumes(entityManager);
+        referenceExpandWorldBoundingVolumes(entityManager, scene.backendRoot);
+        const Sphere referenceSceneVolume = *scene.backendRoot->worldBoundingVolumeWithChildren();
+        QVERIFY(qFuzzyCompare(referenceSceneVolume.radius(), flatSceneVolume.radius()));
+        QVERIFY((referenceSceneVolume.center() - flatSceneVolume.center()).length() < 1e-3f * flatSceneVolume.radius());
+
+        // WHEN
+        if (flat) {
+            ExpandBoundingVolumeJob job;
+            job.setRoot(scene.backendRoot);
+            job.setManagers(scene.manager);
+            QBENCHMARK {
+                job.run();
+            }
+        } else {
+            QBENCHMARK {
+                referenceExpandWorldBoundingVolumes(entityManager, scene.backendRoot);
+            }
+        }
+    }
+};
+
+QTEST_MAIN(tst_BenchEntityHierarchy)
+
+#include "tst_bench_entityhierarchy.moc"
@@ -44,6 +44,7 @@
 #include <Qt3DRender/private/qrenderaspect_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/updateworldtransformjob_p.h>
+#include <Qt3DRender/private/transform_p.h>
 #include <Qt3DQuick/QQmlAspectEngine>
 #include <Qt3DCore/private/qaspectjobmanager_p.h>
 #include <Qt3DCore/private/qaspectengine_p.h>
@@ -86,6 +87,11 @@ namespace Qt3DRender {
             }
         }
 
+        Render::NodeManagers *nodeManagers() const
+        {
+            return d_func()->m_renderer->nodeManagers();
+        }
+
         std::vector<Qt3DCore::QAspectJobPtr> worldTransformJob()
         {
             auto renderer = static_cast<Render::OpenGL::Renderer *>(d_func()->m_renderer);
@@ -232,16 +238,43 @@ Qt3DCore::QEntity *buildBigScene()
     return root;
 }
 
+// Hierarchy of \a depth levels where each entity has \a childCount children
+void buildTransformHierarchy(Qt3DCore::QEntity *parent, int childCount, int depth)
+{
+    if (depth == 0)
+        return;
+    for (int i = 0; i < childCount; ++i) {
+        Qt3DCore::QEntity *e = new Qt3DCore::QEntity(parent);
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+        transform->setTranslation(QVector3D(float(i), 1.0f, 0.0f));
+        transform->setRotationY(float(i));
+        e->addComponent(transform);
+        buildTransformHierarchy(e, childCount, depth - 1);
+    }
+}
+
+Qt3DCore::QEntity *buildTransformScene(int childCount, int depth)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    root->addComponent(new Qt3DCore::QTransform());
+    buildTransformHierarchy(root, childCount, depth);
+    return root;
+}
+
 class tst_benchJobs : public QObject
 {
     Q_OBJECT
 
 private:
     Qt3DCore::QEntity *m_bigSceneRoot;
+    Qt3DCore::QEntity *m_wideSceneRoot;
+    Qt3DCore::QEntity *m_deepSceneRoot;
 
 public:
     tst_benchJobs()
         : m_bigSceneRoot(buildBigScene())
+        , m_wideSceneRoot(buildTransformScene(100000, 1))
+        , m_deepSceneRoot(buildTransformScene(2, 16))
     {}
 
 private Q_SLOTS:
@@ -249,21 +282,38 @@ private Q_SLOTS:
     void updateTransformJob_data()
     {
         QTest::addColumn<Qt3DCore::QEntity*>("rootEntity");
-        QTest::newRow("bigscene") << m_bigSceneRoot;
+        QTest::addColumn<bool>("animateRoot");
+        QTest::newRow("bigscene") << m_bigSceneRoot << false;
+        QTest::newRow("wide-static") << m_wideSceneRoot << false;
+        QTest::newRow("wide-animated") << m_wideSceneRoot << true;
+        QTest::newRow("deep-static") << m_deepSceneRoot << false;
+        QTest::newRow("deep-animated") << m_deepSceneRoot << true;
     }
 
     void updateTransformJob()
     {
         // GIVEN
         QFETCH(Qt3DCore::QEntity*, rootEntity);
+        QFETCH(bool, animateRoot);
         QRenderAspectTester aspect;
 
         Qt3DCore::QAbstractAspectPrivate::get(&aspect)->setRootAndCreateNodes(qobject_cast<Qt3DCore::QEntity *>(rootEntity), {});
 
+        // Moving the root invalidates the world transform of every entity
+        const auto rootTransforms = rootEntity->componentsOfType<Qt3DCore::QTransform>();
+        Qt3DCore::QTransform *rootTransform = animateRoot && !rootTransforms.empty() ? rootTransforms.first() : nullptr;
+        Render::Transform *backendRootTransform = rootTransform
+                ? aspect.nodeManagers()->transformManager()->lookupResource(rootTransform->id())
+                : nullptr;
+
         // WHEN
         std::vector<Qt3DCore::QAspectJobPtr> jobs = aspect.worldTransformJob();
 
         QBENCHMARK {
+            if (backendRootTransform) {
+                rootTransform->setRotationX(rootTransform->rotationX() + 1.0f);
+                backendRootTransform->syncFromFrontEnd(rootTransform, false);
+            }
             Qt3DCore::QAbstractAspectPrivate::get(&aspect)->jobManager()->enqueueJobs(jobs);
             Qt3DCore::QAbstractAspectPrivate::get(&aspect)->jobManager()->waitForAllJobs();
         }
@@ -38,6 +38,7 @@
 #include <Qt3DRender/qrenderaspect.h>
 #include <Qt3DRender/private/qrenderaspect_p.h>
 #include <Qt3DRender/private/filterlayerentityjob_p.h>
+#include <Qt3DRender/private/updateentitylayersjob_p.h>
 #include <Qt3DRender/qlayer.h>
 #include <Qt3DRender/qlayerfilter.h>
 
@@ -171,6 +172,21 @@ private Q_SLOTS:
                                                          << layerFilterIds;
         }
 
+        {
+            Qt3DCore::QNodeIdVector layerFilterIds;
+            Qt3DCore::QEntity *rootEntity = buildTestScene(64, 100000, layerFilterIds);
+
+            QTest::newRow("FilterLayerFilter64Layers100kEntitiesAllEnabled") << rootEntity
+                                                                             << layerFilterIds;
+        }
+
+        {
+            Qt3DCore::QNodeIdVector layerFilterIds;
+            Qt3DCore::QEntity *rootEntity = buildTestScene(64, 100000, layerFilterIds, false);
+
+            QTest::newRow("FilterLayerFilter64Layers100kEntitiesSomeDisabled") << rootEntity
+                                                                               << layerFilterIds;
+        }
     }
 
     void filterEntities()
@@ -181,6 +197,10 @@ private Q_SLOTS:
         // GIVEN
         QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(entitySubtree));
 
+        Qt3DRender::Render::UpdateEntityLayersJob updateEntityLayersJob;
+        updateEntityLayersJob.setManager(aspect->nodeManagers());
+        updateEntityLayersJob.run();
+
         // WHEN
         Qt3DRender::Render::FilterLayerEntityJob filterJob;
         filterJob.setLayerFilters(layerFilterIds);
@@ -38,10 +38,14 @@
 #include <Qt3DRender/qrenderaspect.h>
 #include <Qt3DRender/private/qrenderaspect_p.h>
 #include <Qt3DRender/private/materialparametergathererjob_p.h>
+#include <Qt3DRender/private/material_p.h>
+#include <Qt3DRender/private/effect_p.h>
 #include <Qt3DRender/private/technique_p.h>
 #include <Qt3DRender/private/techniquemanager_p.h>
 #include <Qt3DExtras/qphongmaterial.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -145,6 +149,57 @@ private Q_SLOTS:
 
         QVERIFY(!gatheringJob->materialToPassAndParameter().empty());
     }
+
+    void incrementalParameterGathering_data()
+    {
+        QTest::addColumn<int>("dirtyMaterialCount");
+
+        QTest::newRow("1 dirty material") << 1;
+        QTest::newRow("20 dirty materials") << 20;
+        QTest::newRow("2000 dirty materials") << 2000;
+    }
+
+    void incrementalParameterGathering()
+    {
+        QFETCH(int, dirtyMaterialCount);
+
+        // GIVEN
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(buildTestScene(2000)));
+        Qt3DRender::Render::MaterialManager *materialManager = aspect->nodeManagers()->materialManager();
+
+        Qt3DRender::Render::MaterialParameterGathererJobPtr fullGatheringJob = aspect->materialGathererJob();
+        fullGatheringJob->setHandles(materialManager->activeHandles());
+        fullGatheringJob->run();
+        const Qt3DRender::Render::MaterialParameterGathererDependencies dependencies = fullGatheringJob->materialDependencies();
+
+        // Change a parameter of some of the materials, each QPhongMaterial
+        // has its own effect holding the parameters
+        std::vector<Qt3DCore::QNodeId> dirtyNodes;
+        const std::vector<Qt3DRender::Render::HMaterial> &handles = materialManager->activeHandles();
+        for (int i = 0; i < dirtyMaterialCount; ++i) {
+            const Qt3DRender::Render::Material *material = materialManager->data(handles[i]);
+            const Qt3DRender::Render::Effect *effect = aspect->nodeManagers()->effectManager()->lookupResource(material->effect());
+            dirtyNodes.push_back(effect->parameters().first());
+        }
+        std::sort(dirtyNodes.begin(), dirtyNodes.end());
+
+        // WHEN
+        Qt3DRender::Render::MaterialParameterGathererJobPtr gatheringJob = aspect->materialGathererJob();
+        std::vector<Qt3DCore::QNodeId> removedMaterials;
+
+        QBENCHMARK {
+            removedMaterials.clear();
+            gatheringJob->setHandles(Qt3DRender::Render::MaterialParameterGathererJob::findMaterialsToGather(materialManager,
+                                                                                                             dependencies,
+                                                                                                             dirtyNodes,
+                                                                                                             removedMaterials));
+            gatheringJob->run();
+        }
+
+        // THEN
+        QCOMPARE(gatheringJob->materialToPassAndParameter().size(), dirtyMaterialCount);
+        QVERIFY(removedMaterials.empty());
+    }
 };
 
 QTEST_MAIN(tst_BenchMaterialParameterGathering)
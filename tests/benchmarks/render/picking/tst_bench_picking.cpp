@@ -0,0 +1,272 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qnodevisitor_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/qrenderaspect.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/private/qrenderaspect_p.h>
+#include <Qt3DRender/private/pickboundingvolumeutils_p.h>
+#include <Qt3DRender/private/trianglesvisitor_p.h>
+#include <Qt3DRender/private/triangleboundingvolume_p.h>
+#include <Qt3DRender/private/meshbvh_p.h>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+class TestAspect : public Qt3DRender::QRenderAspect
+{
+public:
+    TestAspect(Qt3DCore::QNode *root)
+        : Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Manual)
+        , m_jobManager(new Qt3DCore::QAspectJobManager())
+    {
+        Qt3DCore::QAbstractAspectPrivate::get(this)->m_jobManager = m_jobManager.data();
+        QRenderAspect::onRegistered();
+
+        QList<Qt3DCore::NodeTreeChange> nodes;
+        Qt3DCore::QNodeVisitor v;
+        v.traverse(root, [&nodes](Qt3DCore::QNode *node) {
+            Qt3DCore::QNodePrivate *d = Qt3DCore::QNodePrivate::get(node);
+            d->m_typeInfo = const_cast<QMetaObject*>(Qt3DCore::QNodePrivate::findStaticMetaObject(node->metaObject()));
+            d->m_hasBackendNode = true;
+            nodes.push_back({
+                node->id(),
+                Qt3DCore::QNodePrivate::get(node)->m_typeInfo,
+                Qt3DCore::NodeTreeChange::Added,
+                node
+            });
+        });
+
+        for (const auto &node: nodes)
+            d_func()->createBackendNode(node);
+    }
+
+    ~TestAspect()
+    {
+        QRenderAspect::onUnregistered();
+    }
+
+    Qt3DRender::Render::NodeManagers *nodeManagers() const
+    {
+        return d_func()->m_renderer->nodeManagers();
+    }
+
+    void onRegistered() { QRenderAspect::onRegistered(); }
+    void onUnregistered() { QRenderAspect::onUnregistered(); }
+
+private:
+    QScopedPointer<Qt3DCore::QAspectJobManager> m_jobManager;
+};
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+namespace {
+
+using namespace Qt3DRender::Render;
+
+// Tests the ray against every triangle, as picking did before meshes had a BVH
+class BruteForceTriangleCounter : public TrianglesVisitor
+{
+public:
+    BruteForceTriangleCounter(NodeManagers *manager, const Qt3DRender::RayCasting::QRay3D &ray)
+        : TrianglesVisitor(manager), m_ray(ray), hitCount(0)
+    {}
+
+    void visit(uint, const Vector3D &a, uint, const Vector3D &b, uint, const Vector3D &c) override
+    {
+        Vector3D uvw;
+        float t = 0.0f;
+        if (intersectsSegmentTriangle(m_ray, c, b, a, uvw, t)
+                || intersectsSegmentTriangle(m_ray, a, b, c, uvw, t))
+            ++hitCount;
+    }
+
+private:
+    Qt3DRender::RayCasting::QRay3D m_ray;
+
+public:
+    int hitCount;
+};
+
+// Builds a wavy grid of quads, two triangles each, centered on the origin
+Qt3DCore::QEntity *buildGridMesh(int quadsPerSide, Qt3DCore::QNodeId &meshEntityId)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    Qt3DCore::QEntity *meshEntity = new Qt3DCore::QEntity(root);
+    meshEntityId = meshEntity->id();
+
+    const int verticesPerSide = quadsPerSide + 1;
+    const float halfSize = quadsPerSide * 0.5f;
+
+    QByteArray vertexData(verticesPerSide * verticesPerSide * 3 * int(sizeof(float)), Qt::Uninitialized);
+    float *v = reinterpret_cast<float *>(vertexData.data());
+    for (int z = 0; z < verticesPerSide; ++z) {
+        for (int x = 0; x < verticesPerSide; ++x) {
+            *v++ = x - halfSize;
+            *v++ = 0.25f * std::sin(x * 0.1f) * std::cos(z * 0.1f);
+            *v++ = z - halfSize;
+        }
+    }
+
+    QByteArray indexData(quadsPerSide * quadsPerSide * 6 * int(sizeof(uint)), Qt::Uninitialized);
+    uint *i = reinterpret_cast<uint *>(indexData.data());
+    for (int z = 0; z < quadsPerSide; ++z) {
+        for (int x = 0; x < quadsPerSide; ++x) {
+            const uint topLeft = uint(z * verticesPerSide + x);
+            const uint bottomLeft = topLeft + uint(verticesPerSide);
+            *i++ = topLeft;
+            *i++ = bottomLeft;
+            *i++ = topLeft + 1;
+            *i++ = topLeft + 1;
+            *i++ = bottomLeft;
+            *i++ = bottomLeft + 1;
+        }
+    }
+
+    Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry();
+
+    Qt3DCore::QBuffer *vertexBuffer = new Qt3DCore::QBuffer(geometry);
+    vertexBuffer->setData(vertexData);
+    Qt3DCore::QAttribute *positionAttribute = new Qt3DCore::QAttribute(vertexBuffer,
+                                                                       Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                                                       Qt3DCore::QAttribute::Float, 3,
+                                                                       uint(verticesPerSide * verticesPerSide));
+    geometry->addAttribute(positionAttribute);
+
+    Qt3DCore::QBuffer *indexBuffer = new Qt3DCore::QBuffer(geometry);
+    indexBuffer->setData(indexData);
+    Qt3DCore::QAttribute *indexAttribute = new Qt3DCore::QAttribute(indexBuffer,
+                                                                    Qt3DCore::QAttribute::UnsignedInt, 1,
+                                                                    uint(quadsPerSide * quadsPerSide * 6));
+    indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+    geometry->addAttribute(indexAttribute);
+
+    Qt3DRender::QGeometryRenderer *renderer = new Qt3DRender::QGeometryRenderer();
+    renderer->setGeometry(geometry);
+    renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    meshEntity->addComponent(renderer);
+
+    return root;
+}
+
+Qt3DRender::RayCasting::QRay3D rayThroughGrid(float x, float z)
+{
+    return Qt3DRender::RayCasting::QRay3D(Vector3D(x, 10.0f, z), Vector3D(0.0f, -1.0f, 0.0f), 20.0f);
+}
+
+} // anonymous
+
+class tst_BenchPicking : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void pickTriangles_data()
+    {
+        QTest::addColumn<int>("quadsPerSide");
+        QTest::addColumn<bool>("useBVH");
+
+        QTest::newRow("128x128-BruteForce") << 128 << false;
+        QTest::newRow("128x128-BVH") << 128 << true;
+        QTest::newRow("512x512-BruteForce") << 512 << false;
+        QTest::newRow("512x512-BVH") << 512 << true;
+    }
+
+    void pickTriangles()
+    {
+        QFETCH(int, quadsPerSide);
+        QFETCH(bool, useBVH);
+
+        // GIVEN
+        Qt3DCore::QNodeId meshEntityId;
+        QScopedPointer<Qt3DCore::QEntity> root(buildGridMesh(quadsPerSide, meshEntityId));
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(root.data()));
+        NodeManagers *manager = aspect->nodeManagers();
+
+        Entity *meshEntity = manager->renderNodesManager()->lookupResource(meshEntityId);
+        QVERIFY(meshEntity);
+        *meshEntity->worldBoundingVolume() = Sphere(Vector3D(0.0f, 0.0f, 0.0f), quadsPerSide);
+
+        PickingUtils::TriangleCollisionGathererFunctor gatherer;
+        gatherer.m_objectPickersRequired = false;
+        gatherer.m_manager = manager;
+        gatherer.m_frontFaceRequested = true;
+        gatherer.m_backFaceRequested = true;
+
+        // Hover like picking, the ray slightly moves between two picks
+        const float step = float(quadsPerSide) / 97.0f;
+        float x = -0.5f * quadsPerSide + 0.3f;
+
+        // THEN both paths agree
+        gatherer.m_ray = rayThroughGrid(0.3f, 0.4f);
+        BruteForceTriangleCounter counter(manager, gatherer.m_ray);
+        counter.apply(meshEntity->renderComponent<GeometryRenderer>(), meshEntityId);
+        QCOMPARE(int(gatherer.pick(meshEntity).size()), counter.hitCount);
+        QCOMPARE(counter.hitCount, 1);
+        QCOMPARE(manager->meshBVHCache()->buildCount(), quint64(1));
+
+        // WHEN
+        if (useBVH) {
+            QBENCHMARK {
+                gatherer.m_ray = rayThroughGrid(x, 0.4f);
+                gatherer.pick(meshEntity);
+                x = x + step > 0.5f * quadsPerSide ? -0.5f * quadsPerSide + 0.3f : x + step;
+            }
+            // THEN the BVH was only built once
+            QCOMPARE(manager->meshBVHCache()->buildCount(), quint64(1));
+        } else {
+            QBENCHMARK {
+                BruteForceTriangleCounter bruteForce(manager, rayThroughGrid(x, 0.4f));
+                bruteForce.apply(meshEntity->renderComponent<GeometryRenderer>(), meshEntityId);
+                x = x + step > 0.5f * quadsPerSide ? -0.5f * quadsPerSide + 0.3f : x + step;
+            }
+        }
+    }
+};
+
+QTEST_MAIN(tst_BenchPicking)
+
+#include "tst_bench_picking.moc"
@@ -1,9 +1,11 @@
 TEMPLATE=subdirs
 
 qtConfig(private_tests) {
-    SUBDIRS += layerfiltering \
+    SUBDIRS += entityhierarchy \
+               layerfiltering \
                materialparametergathering \
-               opengl
+               opengl \
+               picking
 
     qtHaveModule(quick): \
         SUBDIRS += jobs